@@ -0,0 +1,180 @@
+/**
+ * BCM Submit Benchmark.
+ * Compares the frames per second of one async_send per BCM message with the batched sendmmsg of the connector.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+// Project includes
+#include "CANBenchmark.h"
+#include "../DuT_Connectors/CANConnector/BcmMessageSlab.h"
+
+// System includes
+#include <memory>
+#include <algorithm>
+#include <vector>
+#include <iostream>
+#include <linux/can/bcm.h>
+#include <boost/asio.hpp>
+
+using namespace sim_interface::benchmark;
+using namespace sim_interface::dut_connector::can;
+
+namespace {
+
+    /**
+     * Same message and sizes as the connector (bcmMsgSingleFrameCan, BCM_SLAB_CAPACITY and BCM_BATCH_SIZE).
+     * The frame follows the head directly, newer kernel headers declare the frames of the head as flexible array.
+     */
+    struct alignas(struct bcm_msg_head) BcmSingleFrame {
+        uint8_t data[sizeof(struct bcm_msg_head) + sizeof(struct can_frame)];
+    };
+    constexpr uint32_t SLAB_CAPACITY = 256;
+    constexpr size_t BATCH_SIZE = 64;
+
+    void fillTxSend(uint8_t msg[], uint64_t index) {
+        auto head = reinterpret_cast<struct bcm_msg_head *>(msg);
+        auto frame = reinterpret_cast<struct can_frame *>(msg + sizeof(struct bcm_msg_head));
+        head->opcode = TX_SEND;
+        head->can_id = 0x100 + (index & 0x3F);
+        head->nframes = 1;
+        frame->can_id = head->can_id;
+        frame->len = 8;
+        std::memcpy(frame->data, &index, sizeof(index));
+    }
+
+    /**
+     * The submission before the slab: every TX_SEND allocates its message and posts its own async_send.
+     * The io context runs after every batch of messages, like the connector thread between two events.
+     */
+    double runAsyncSend(int socketHandle, uint64_t frames, uint64_t &failed) {
+
+        boost::asio::io_context ioContext;
+        boost::asio::generic::datagram_protocol::socket bcmSocket(
+                ioContext, boost::asio::generic::datagram_protocol(PF_CAN, CAN_BCM), dup(socketHandle));
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t index = 0; index < frames; index++) {
+            auto msg = std::make_shared<BcmSingleFrame>();
+            fillTxSend(msg->data, index);
+            bcmSocket.async_send(boost::asio::buffer(msg.get(), sizeof(BcmSingleFrame)),
+                                 [msg, &failed](boost::system::error_code errorCode, std::size_t) {
+                                     if (errorCode) {
+                                         failed++;
+                                     }
+                                 });
+            if ((index + 1) % BATCH_SIZE == 0) {
+                ioContext.run();
+                ioContext.restart();
+            }
+        }
+        ioContext.run();
+
+        return secondsSince(start);
+    }
+
+    /**
+     * The submission of the connector: the messages come from the slab and a batch is sent with one sendmmsg.
+     */
+    double runSlabSendmmsg(int socketHandle, uint64_t frames, uint64_t &failed) {
+
+        BcmMessageSlab slab(SLAB_CAPACITY);
+        BcmMessageBuffer *batch[BATCH_SIZE];
+        struct iovec iovecs[BATCH_SIZE];
+        struct mmsghdr headers[BATCH_SIZE];
+
+        auto start = std::chrono::steady_clock::now();
+        uint64_t index = 0;
+        while (index < frames) {
+            size_t count = 0;
+            for (; count < BATCH_SIZE && index < frames; count++, index++) {
+                batch[count] = slab.acquire(sizeof(BcmSingleFrame), "TX_SEND");
+                fillTxSend(batch[count]->data(), index);
+                iovecs[count].iov_base = batch[count]->data();
+                iovecs[count].iov_len = batch[count]->size();
+                headers[count] = {};
+                headers[count].msg_hdr.msg_iov = &iovecs[count];
+                headers[count].msg_hdr.msg_iovlen = 1;
+            }
+
+            size_t offset = 0;
+            while (offset < count) {
+                int sent = sendmmsg(socketHandle, &headers[offset], static_cast<unsigned int>(count - offset), 0);
+                if (sent < 0) {
+                    failed++;
+                    offset++;
+                    continue;
+                }
+                offset += static_cast<size_t>(sent);
+            }
+
+            for (size_t released = 0; released < count; released++) {
+                slab.release(batch[released]);
+            }
+        }
+
+        return secondsSince(start);
+    }
+
+}
+
+/**
+ * Usage: BcmSubmitBenchmark [interface] [frames] [rounds]
+ *
+ * Sends frames TX_SEND messages with a single CAN frame over a BCM socket, once with one async_send per message
+ * (the submission before the BCM message slab) and once from the slab with sendmmsg batches of 64 (the submission
+ * of the connector). Prints the frames per second of every round and the best round of each.
+ */
+int main(int argc, char *argv[]) {
+
+    std::string interface = argc > 1 ? argv[1] : "vcan0";
+    uint64_t frames = argument(argc, argv, 2, 1000000);
+    uint64_t rounds = argument(argc, argv, 3, 5);
+
+    try {
+        int socketHandle = openCanSocket(interface, SOCK_DGRAM, CAN_BCM);
+
+        double bestAsync = 0;
+        double bestSlab = 0;
+        for (uint64_t round = 0; round < rounds; round++) {
+            uint64_t failedAsync = 0;
+            uint64_t failedSlab = 0;
+            double asyncRate = static_cast<double>(frames) / runAsyncSend(socketHandle, frames, failedAsync);
+            double slabRate = static_cast<double>(frames) / runSlabSendmmsg(socketHandle, frames, failedSlab);
+            bestAsync = std::max(bestAsync, asyncRate);
+            bestSlab = std::max(bestSlab, slabRate);
+
+            std::cout << "round " << round << ": async_send " << static_cast<uint64_t>(asyncRate) << " frames/s ("
+                      << failedAsync << " failed), slab + sendmmsg " << static_cast<uint64_t>(slabRate)
+                      << " frames/s (" << failedSlab << " failed)" << std::endl;
+        }
+
+        std::cout << interface << ": best async_send " << static_cast<uint64_t>(bestAsync)
+                  << " frames/s, best slab + sendmmsg " << static_cast<uint64_t>(bestSlab) << " frames/s, speedup "
+                  << bestSlab / bestAsync << std::endl;
+
+        close(socketHandle);
+    } catch (const std::exception &error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ * CAN Benchmarks.
+ * Helpers shared by the standalone CAN benchmarks.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_CANBENCHMARK_H
+#define SIM_TO_DUT_INTERFACE_CANBENCHMARK_H
+
+// System includes
+#include <chrono>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <functional>
+#include <stdexcept>
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <linux/can.h>
+
+namespace sim_interface::benchmark {
+
+    /**
+     * Opens a CAN socket for an interface. BCM sockets are connected, CAN_RAW and ISO-TP sockets are bound.
+     * The benchmarks need a (virtual) CAN interface, e.g.
+     * `ip link add dev vcan0 type vcan && ip link set vcan0 mtu 72 up`.
+     *
+     * @param interface - The name of the interface.
+     * @param type      - SOCK_DGRAM or SOCK_RAW.
+     * @param protocol  - CAN_BCM, CAN_RAW or CAN_ISOTP.
+     * @param address   - The address, e.g. the CAN IDs of an ISO-TP socket. can_ifindex is set by this function.
+     * @param configure - Called with the socket before it is bound or connected, e.g. to set the ISO-TP options.
+     *
+     * @return The socket.
+     *
+     * @throws std::runtime_error if the interface does not exist or the socket can not be opened or configured.
+     */
+    inline int openCanSocket(const std::string &interface, int type, int protocol, struct sockaddr_can address = {},
+                             const std::function<void(int)> &configure = {}) {
+
+        address.can_family = AF_CAN;
+        address.can_ifindex = static_cast<int>(if_nametoindex(interface.c_str()));
+        if (address.can_ifindex == 0) {
+            throw std::runtime_error("The interface <" + interface + "> does not exist");
+        }
+
+        int socketHandle = socket(PF_CAN, type, protocol);
+        if (socketHandle < 0) {
+            throw std::runtime_error("Could not open the CAN socket: " + std::string(std::strerror(errno)));
+        }
+
+        if (configure) {
+            try {
+                configure(socketHandle);
+            } catch (...) {
+                close(socketHandle);
+                throw;
+            }
+        }
+
+        int result = protocol != CAN_BCM
+                     ? bind(socketHandle, reinterpret_cast<struct sockaddr *>(&address), sizeof(address))
+                     : connect(socketHandle, reinterpret_cast<struct sockaddr *>(&address), sizeof(address));
+        if (result < 0) {
+            close(socketHandle);
+            throw std::runtime_error("Could not connect the CAN socket to <" + interface + ">: " +
+                                     std::string(std::strerror(errno)));
+        }
+
+        return socketHandle;
+    }
+
+    /**
+     * @param start - The start of the measurement.
+     *
+     * @return The seconds since start.
+     */
+    inline double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    /**
+     * Reads a numeric command line argument.
+     *
+     * @param argc         - The number of arguments.
+     * @param argv         - The arguments.
+     * @param index        - The index of the argument.
+     * @param defaultValue - The value if the argument is missing.
+     *
+     * @return The value of the argument.
+     */
+    inline unsigned long argument(int argc, char *argv[], int index, unsigned long defaultValue) {
+        return argc > index ? std::strtoul(argv[index], nullptr, 10) : defaultValue;
+    }
+
+}
+
+#endif //SIM_TO_DUT_INTERFACE_CANBENCHMARK_H
@@ -0,0 +1,226 @@
+/**
+ * Codec Benchmark.
+ * Checks that the BmwDuTCodec generated from BmwDuT.dbc gives the same frames and events as the DbcCodec and
+ * measures the encode and decode time of both against the handwritten BmwCodec.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+// Project includes
+#include "CANBenchmark.h"
+#include "BmwCodec.h"
+#include "DbcCodec.h"
+#include "BmwDuTCodec.h"
+
+// System includes
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+#include <iostream>
+
+using namespace sim_interface;
+using namespace sim_interface::benchmark;
+using namespace sim_interface::dut_connector::can;
+
+namespace {
+
+    /**
+     * Collects the decoded events.
+     */
+    class CollectingSink : public SimEventSink {
+    public:
+        void push(SimEvent &&event) override {
+            events.push_back(std::move(event));
+        }
+
+        std::vector<SimEvent> events;
+    };
+
+    /**
+     * A signal of the BmwCodec and its physical range in BmwDuT.dbc.
+     */
+    struct BenchmarkSignal {
+        const char *operation;
+        double minimum;
+        double maximum;
+    };
+
+    const BenchmarkSignal SIGNALS[] = {
+            {"Speed_Dynamics",            0,      1023.984375},
+            {"YawRate_Dynamics",          -163.84, 163.835},
+            {"Acceleration_Dynamics",     -65,     66.07},
+            {"Longitude_Dynamics",        -180,    180},
+            {"Latitude_Dynamics",         -90,     90},
+            {"Position_Z_Coordinate_DUT", -32768,  32767},
+            {"Heading_Dynamics",          0,       382.5}
+    };
+
+    /**
+     * Named codec under test.
+     */
+    struct CodecUnderTest {
+        std::string name;
+        std::unique_ptr<CANConnectorCodecV2> codec;
+    };
+
+    double eventNumber(const SimEvent &event) {
+        return event.value.type() == typeid(double) ? boost::get<double>(event.value)
+                                                    : static_cast<double>(boost::get<int>(event.value));
+    }
+
+    canid_t canIDOf(const EncodeResult &result) {
+        return result.sendOperation == 0 ? 0x111 : result.sendOperation == 1 ? 0x222 : 0x333;
+    }
+
+    /**
+     * Compares the frames, the cyclic patches and the decoded events of two codecs.
+     *
+     * @param isExact - Flag if every frame and event must be the same. Otherwise only the frames are compared and
+     *                  the events of the reference must be decoded by the candidate as well.
+     *
+     * @return The number of events with a different frame, patch or decoded event.
+     */
+    uint64_t compare(CodecUnderTest &reference, CodecUnderTest &candidate, const std::vector<SimEvent> &events,
+                     bool isExact) {
+
+        uint64_t differences = 0;
+        uint64_t transmission = 0;
+        struct canfd_frame referenceFrame = {};
+        struct canfd_frame candidateFrame = {};
+
+        for (const auto &event: events) {
+            EncodeResult expected = reference.codec->encode(event, &referenceFrame, 1);
+            EncodeResult actual = candidate.codec->encode(event, &candidateFrame, 1);
+            referenceFrame.can_id = candidateFrame.can_id = canIDOf(expected);
+
+            bool isSame = expected.sendOperation == actual.sendOperation && expected.nframes == actual.nframes &&
+                          referenceFrame.len == candidateFrame.len &&
+                          std::memcmp(referenceFrame.data, candidateFrame.data, referenceFrame.len) == 0;
+
+            // The alive counters and checksums of a cyclic transmission
+            if (isExact) {
+                reference.codec->patchCyclicFrame(expected.sendOperation, transmission, referenceFrame);
+                candidate.codec->patchCyclicFrame(actual.sendOperation, transmission, candidateFrame);
+                isSame = isSame && std::memcmp(referenceFrame.data, candidateFrame.data, referenceFrame.len) == 0;
+                transmission++;
+            }
+
+            CollectingSink referenceEvents;
+            CollectingSink candidateEvents;
+            reference.codec->decode(referenceFrame, false, referenceEvents);
+            candidate.codec->decode(referenceFrame, false, candidateEvents);
+
+            std::map<std::string, double> decoded;
+            for (const auto &candidateEvent: candidateEvents.events) {
+                decoded[candidateEvent.operation] = eventNumber(candidateEvent);
+            }
+            isSame = isSame && (!isExact || referenceEvents.events.size() == candidateEvents.events.size());
+            for (const auto &referenceEvent: referenceEvents.events) {
+                auto value = decoded.find(referenceEvent.operation);
+                isSame = isSame && value != decoded.end() &&
+                         (!isExact || value->second == eventNumber(referenceEvent));
+            }
+
+            if (!isSame && differences++ == 0) {
+                std::cout << candidate.name << ": first difference to the " << reference.name << " for <"
+                          << event.operation << "> = " << eventNumber(event) << std::endl;
+            }
+        }
+
+        return differences;
+    }
+
+}
+
+/**
+ * Usage: CodecBenchmark [events] [DBC file of the BMW DuT]
+ *
+ * Encodes random in-range values of the signals of the BmwCodec with the BmwCodec, the DbcCodec loaded from
+ * BmwDuT.dbc and the BmwDuTCodec generated from it. First the frames, cyclic patches and decoded events of the
+ * generated codec are compared with the DbcCodec and the frames of both with the BmwCodec, then the time per encode
+ * and per decode is measured. The decode time includes the construction of the SimEvents. Exits with 1 if the
+ * generated codec differs from the DbcCodec.
+ */
+int main(int argc, char *argv[]) {
+
+    uint64_t count = argument(argc, argv, 1, 1000000);
+    std::string dbcFile = argc > 2 ? argv[2] : BMW_DUT_DBC;
+
+    std::vector<CodecUnderTest> codecs;
+    codecs.push_back({"BmwCodec", std::make_unique<BmwCodec>()});
+    codecs.push_back({"DbcCodec", std::make_unique<DbcCodec>(dbcFile)});
+    codecs.push_back({"BmwDuTCodec", std::make_unique<generated::BmwDuTCodec>()});
+    for (auto &codec: codecs) {
+        codec.codec->bindSendOperations({GESCHWINDIGKEIT_SENDOPERATION, GPS_LOCA_SENDOPERATION,
+                                         GPS_LOCB_SENDOPERATION});
+    }
+
+    // The same random events for all codecs, so the run is reproducible
+    std::mt19937_64 random(42);
+    std::vector<SimEvent> events;
+    events.reserve(count);
+    for (uint64_t index = 0; index < count; index++) {
+        const BenchmarkSignal &signal = SIGNALS[index % (sizeof(SIGNALS) / sizeof(SIGNALS[0]))];
+        std::uniform_real_distribution<double> value(signal.minimum, signal.maximum);
+        events.emplace_back(signal.operation, value(random), "CodecBenchmark");
+    }
+
+    // The generated codec must give exactly the same frames and events as the DbcCodec of the same DBC file
+    uint64_t differences = compare(codecs[1], codecs[2], events, true);
+    std::cout << codecs[2].name << ": " << differences << " of " << count << " events differ from the "
+              << codecs[1].name << std::endl;
+
+    // The BmwCodec truncates and subtracts the offset after the scaling, so frames of signals with an offset or
+    // values between two raw steps differ from the DBC codecs by design. Informational only.
+    for (size_t index = 1; index < codecs.size(); index++) {
+        uint64_t frameDifferences = compare(codecs[0], codecs[index], events, false);
+        std::cout << codecs[index].name << ": " << frameDifferences << " of " << count << " frames differ from the "
+                  << codecs[0].name << " (truncation and offset)" << std::endl;
+    }
+
+    for (auto &codec: codecs) {
+        std::vector<struct canfd_frame> frames(count);
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t index = 0; index < count; index++) {
+            codec.codec->encode(events[index], &frames[index], 1);
+        }
+        double encodeSeconds = secondsSince(start);
+
+        for (uint64_t index = 0; index < count; index++) {
+            frames[index].can_id = 0x111 + 0x111 * (index % 7 < 3 ? 0 : index % 7 < 5 ? 1 : 2);
+        }
+
+        CollectingSink sink;
+        sink.events.reserve(4);
+        start = std::chrono::steady_clock::now();
+        for (uint64_t index = 0; index < count; index++) {
+            codec.codec->decode(frames[index], false, sink);
+            sink.events.clear();
+        }
+        double decodeSeconds = secondsSince(start);
+
+        std::cout << codec.name << ": encode " << encodeSeconds * 1e9 / static_cast<double>(count) << " ns/event, "
+                  << "decode " << decodeSeconds * 1e9 / static_cast<double>(count) << " ns/frame" << std::endl;
+    }
+
+    return differences == 0 ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+/**
+ * CRC Benchmark.
+ * Measures the time per frame of the CRC kernels and of the E2E protection.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+// Project includes
+#include "CANBenchmark.h"
+#include "Crc.h"
+#include "E2EProtection.h"
+
+// System includes
+#include <random>
+#include <vector>
+#include <iostream>
+
+using namespace sim_interface::benchmark;
+using namespace sim_interface::dut_connector::can;
+
+namespace {
+
+    /**
+     * Number of different payloads, so the CRCs do not work on the same cache line and value all the time.
+     */
+    constexpr size_t PAYLOADS = 1024;
+
+    /**
+     * Keeps the compiler from dropping the CRCs whose result is not used otherwise.
+     */
+    volatile uint32_t resultSink = 0;
+
+    /**
+     * Computes a CRC over the first length bytes of every payload in turn.
+     *
+     * @return The nanoseconds per frame.
+     */
+    template<typename Crc>
+    double measureCrc(const std::vector<struct canfd_frame> &payloads, size_t length, uint64_t frames, Crc crc) {
+        uint32_t result = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t index = 0; index < frames; index++) {
+            result ^= crc(payloads[index % PAYLOADS].data, length);
+        }
+        double seconds = secondsSince(start);
+        resultSink = result;
+        return seconds * 1e9 / static_cast<double>(frames);
+    }
+
+    /**
+     * Protects frames of the length and checks them with a second instance, like a DuT that sends the frames back.
+     *
+     * @return The nanoseconds per protect and check of a frame.
+     */
+    double measureE2E(const E2EConfig &config, std::vector<struct canfd_frame> payloads, __u8 length,
+                      uint64_t frames) {
+        E2EProtection sender(config);
+        E2EProtection receiver(config);
+        uint64_t accepted = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t index = 0; index < frames; index++) {
+            struct canfd_frame &frame = payloads[index % PAYLOADS];
+            frame.len = length;
+            sender.protect(frame);
+            accepted += E2EProtection::isAccepted(receiver.check(frame)) ? 1 : 0;
+        }
+        double seconds = secondsSince(start);
+
+        if (accepted != frames) {
+            std::cerr << config.profile << ": " << frames - accepted << " frames were not accepted" << std::endl;
+        }
+        return seconds * 1e9 / static_cast<double>(frames);
+    }
+
+}
+
+/**
+ * Usage: CrcBenchmark [frames]
+ *
+ * Needs no interface. Prints the nanoseconds per frame of the slice-by-8 CRC kernels for a CAN (8 byte) and a
+ * CANFD (64 byte) payload and of the E2E protect and check of the profiles 1 and 5.
+ */
+int main(int argc, char *argv[]) {
+
+    uint64_t frames = argument(argc, argv, 1, 10000000);
+
+    std::mt19937 random(42);
+    std::vector<struct canfd_frame> payloads(PAYLOADS);
+    for (auto &payload: payloads) {
+        for (auto &byte: payload.data) {
+            byte = static_cast<__u8>(random());
+        }
+    }
+
+    for (size_t length: {8, 64}) {
+        std::cout << length << " bytes: CRC8 SAE J1850 "
+                  << measureCrc(payloads, length, frames, crc::crc8SaeJ1850) << " ns, CRC8H2F "
+                  << measureCrc(payloads, length, frames, crc::crc8H2F) << " ns, CRC16 CCITT "
+                  << measureCrc(payloads, length, frames, crc::crc16Ccitt) << " ns, CRC32 "
+                  << measureCrc(payloads, length, frames, crc::crc32) << " ns per frame" << std::endl;
+    }
+
+    E2EConfig profile1;
+    profile1.profile = E2E_PROFILE_01;
+    profile1.dataID = 0x123;
+    E2EConfig profile5;
+    profile5.profile = E2E_PROFILE_05;
+    profile5.dataID = 0x123;
+
+    std::cout << "E2E P01 8 bytes: " << measureE2E(profile1, payloads, 8, frames) << " ns, P05 64 bytes: "
+              << measureE2E(profile5, payloads, 64, frames) << " ns per protect and check" << std::endl;
+
+    return 0;
+}
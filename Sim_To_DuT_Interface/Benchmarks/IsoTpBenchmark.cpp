@@ -0,0 +1,145 @@
+/**
+ * ISO-TP Benchmark.
+ * Measures the throughput of ISO-TP transfers over kernel CAN_ISOTP sockets for a STmin and a block size.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+// Project includes
+#include "CANBenchmark.h"
+
+// System includes
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <sys/time.h>
+#include <linux/can/isotp.h>
+
+using namespace sim_interface::benchmark;
+
+namespace {
+
+    /**
+     * The CAN IDs of the transfers, like a diagnostic request and response.
+     */
+    constexpr canid_t TESTER_ID = 0x7E0;
+    constexpr canid_t DUT_ID = 0x7E8;
+
+    /**
+     * Sets the options of an ISO-TP socket the same way as the ISO-TP operations of the connector: no gap between
+     * the frames, the STmin and block size in the flow control of received transfers and CANFD frames if enabled.
+     */
+    void configureIsoTp(int socketHandle, __u8 stMin, __u8 blockSize, bool isCANFD) {
+        struct can_isotp_options options = {};
+        options.flags = CAN_ISOTP_DEFAULT_FLAGS;
+        options.frame_txtime = CAN_ISOTP_FRAME_TXTIME_ZERO;
+        options.txpad_content = CAN_ISOTP_DEFAULT_PAD_CONTENT;
+        options.rxpad_content = CAN_ISOTP_DEFAULT_PAD_CONTENT;
+
+        struct can_isotp_fc_options flowControl = {};
+        flowControl.bs = blockSize;
+        flowControl.stmin = stMin;
+        flowControl.wftmax = CAN_ISOTP_DEFAULT_RECV_WFTMAX;
+
+        struct can_isotp_ll_options linkLayer = {};
+        linkLayer.mtu = CANFD_MTU;
+        linkLayer.tx_dl = CANFD_MAX_DLEN;
+        linkLayer.tx_flags = CANFD_BRS;
+
+        // A lost frame must not block the benchmark
+        struct timeval timeout = {1, 0};
+
+        if (setsockopt(socketHandle, SOL_CAN_ISOTP, CAN_ISOTP_OPTS, &options, sizeof(options)) < 0 ||
+            setsockopt(socketHandle, SOL_CAN_ISOTP, CAN_ISOTP_RECV_FC, &flowControl, sizeof(flowControl)) < 0 ||
+            (isCANFD && setsockopt(socketHandle, SOL_CAN_ISOTP, CAN_ISOTP_LL_OPTS, &linkLayer,
+                                   sizeof(linkLayer)) < 0) ||
+            setsockopt(socketHandle, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) < 0) {
+            throw std::runtime_error("Could not set the ISO-TP options: " + std::string(std::strerror(errno)));
+        }
+    }
+
+    int openIsoTpSocket(const std::string &interface, canid_t txID, canid_t rxID, __u8 stMin, __u8 blockSize,
+                        bool isCANFD) {
+        struct sockaddr_can address = {};
+        address.can_addr.tp.tx_id = txID;
+        address.can_addr.tp.rx_id = rxID;
+        return openCanSocket(interface, SOCK_DGRAM, CAN_ISOTP, address, [=](int socketHandle) {
+            configureIsoTp(socketHandle, stMin, blockSize, isCANFD);
+        });
+    }
+
+}
+
+/**
+ * Usage: IsoTpBenchmark [interface] [payload bytes] [transfers] [STmin] [block size] [CANFD 0/1]
+ *
+ * Sends transfers payloads (default 4095 bytes, the largest without the 32 bit length of ISO 15765-2:2016) from a
+ * tester socket to a DuT socket on the interface (default vcan0) and waits for each payload before the next transfer.
+ * The DuT socket answers the first frame with the flow control of STmin (0 - 127 ms, 241 - 249 for 100 - 900 µs) and
+ * the block size (0 = no further flow control). Prints the transfers per second, the payload throughput and the time
+ * per transfer.
+ */
+int main(int argc, char *argv[]) {
+
+    std::string interface = argc > 1 ? argv[1] : "vcan0";
+    size_t payloadSize = argument(argc, argv, 2, 4095);
+    uint64_t transfers = argument(argc, argv, 3, 1000);
+    auto stMin = static_cast<__u8>(argument(argc, argv, 4, 0));
+    auto blockSize = static_cast<__u8>(argument(argc, argv, 5, 0));
+    bool isCANFD = argument(argc, argv, 6, 0) != 0;
+
+    try {
+        int tester = openIsoTpSocket(interface, TESTER_ID, DUT_ID, stMin, blockSize, isCANFD);
+        int dut = openIsoTpSocket(interface, DUT_ID, TESTER_ID, stMin, blockSize, isCANFD);
+
+        std::vector<uint8_t> payload(payloadSize);
+        std::vector<uint8_t> received(payloadSize + 1);
+        uint64_t failed = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t transfer = 0; transfer < transfers; transfer++) {
+            std::memcpy(payload.data(), &transfer, std::min(sizeof(transfer), payloadSize));
+
+            // The kernel segments the payload and waits for the flow control of the DuT socket
+            if (write(tester, payload.data(), payload.size()) != static_cast<ssize_t>(payload.size()) ||
+                read(dut, received.data(), received.size()) != static_cast<ssize_t>(payload.size()) ||
+                std::memcmp(payload.data(), received.data(), payloadSize) != 0) {
+                failed++;
+            }
+        }
+        double seconds = secondsSince(start);
+
+        uint64_t completed = transfers - failed;
+        std::cout << interface << ", " << payloadSize << " bytes, STmin " << static_cast<int>(stMin)
+                  << ", block size " << static_cast<int>(blockSize) << (isCANFD ? ", CANFD: " : ", CAN: ")
+                  << static_cast<double>(completed) / seconds << " transfers/s, "
+                  << static_cast<double>(completed * payloadSize) / seconds / 1024 << " KiB/s, "
+                  << seconds * 1e3 / static_cast<double>(transfers) << " ms per transfer, " << failed
+                  << " failed" << std::endl;
+
+        close(dut);
+        close(tester);
+    } catch (const std::exception &error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
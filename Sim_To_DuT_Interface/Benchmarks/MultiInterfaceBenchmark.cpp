@@ -0,0 +1,243 @@
+/**
+ * Multi Interface Benchmark.
+ * Measures the frames per second and the CPU time per channel of one io context that serves several CAN interfaces,
+ * compared with one io context and thread per interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+// Project includes
+#include "CANBenchmark.h"
+
+// System includes
+#include <ctime>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <linux/can/raw.h>
+#include <boost/asio.hpp>
+
+using namespace sim_interface::benchmark;
+
+namespace {
+
+    /**
+     * Frames per sendmmsg and recvmmsg, like RAW_RX_BATCH of the connector.
+     */
+    constexpr size_t BATCH_SIZE = 64;
+
+    /**
+     * One interface: a send only CAN_RAW socket and a CAN_RAW socket that receives the frames of the first one.
+     * A batch is only sent after the previous batch was received, so the receive buffer never overflows and every
+     * channel competes for the same event loop.
+     */
+    struct Channel {
+        Channel(boost::asio::io_context &ioContext, const std::string &interface)
+                : sendSocket(ioContext), receiveSocket(ioContext) {
+            boost::asio::generic::raw_protocol rawProtocol(PF_CAN, CAN_RAW);
+
+            int sendHandle = openCanSocket(interface, SOCK_RAW, CAN_RAW);
+            if (setsockopt(sendHandle, SOL_CAN_RAW, CAN_RAW_FILTER, nullptr, 0) < 0) {
+                close(sendHandle);
+                throw std::runtime_error("Could not clear the CAN_RAW filters: " + std::string(std::strerror(errno)));
+            }
+            sendSocket.assign(rawProtocol, sendHandle);
+            receiveSocket.assign(rawProtocol, openCanSocket(interface, SOCK_RAW, CAN_RAW));
+        }
+
+        boost::asio::generic::raw_protocol::socket sendSocket;
+        boost::asio::generic::raw_protocol::socket receiveSocket;
+        struct can_frame frames[BATCH_SIZE] = {};
+        struct iovec iovecs[BATCH_SIZE] = {};
+        struct mmsghdr headers[BATCH_SIZE] = {};
+        uint64_t sent = 0;
+        uint64_t received = 0;
+        uint64_t failed = 0;
+    };
+
+    void sendBatch(Channel &channel, uint64_t frames) {
+        size_t count = std::min<uint64_t>(BATCH_SIZE, frames - channel.sent);
+        for (size_t index = 0; index < count; index++) {
+            channel.frames[index].can_id = 0x100 + static_cast<canid_t>(index);
+            channel.frames[index].len = 8;
+            std::memcpy(channel.frames[index].data, &channel.sent, sizeof(channel.sent));
+            channel.iovecs[index] = {&channel.frames[index], sizeof(struct can_frame)};
+            channel.headers[index] = {};
+            channel.headers[index].msg_hdr.msg_iov = &channel.iovecs[index];
+            channel.headers[index].msg_hdr.msg_iovlen = 1;
+        }
+
+        size_t offset = 0;
+        while (offset < count) {
+            int result = sendmmsg(channel.sendSocket.native_handle(), &channel.headers[offset],
+                                  static_cast<unsigned int>(count - offset), 0);
+            if (result < 0) {
+                channel.failed++;
+                offset++;
+                continue;
+            }
+            offset += static_cast<size_t>(result);
+        }
+        channel.sent += count;
+    }
+
+    void receiveFrames(Channel &channel, uint64_t frames) {
+        channel.receiveSocket.async_wait(boost::asio::socket_base::wait_read,
+                                         [&channel, frames](boost::system::error_code errorCode) {
+            if (errorCode) {
+                return;
+            }
+
+            int received = 0;
+            do {
+                for (size_t index = 0; index < BATCH_SIZE; index++) {
+                    channel.iovecs[index] = {&channel.frames[index], sizeof(struct can_frame)};
+                    channel.headers[index] = {};
+                    channel.headers[index].msg_hdr.msg_iov = &channel.iovecs[index];
+                    channel.headers[index].msg_hdr.msg_iovlen = 1;
+                }
+                received = recvmmsg(channel.receiveSocket.native_handle(), channel.headers, BATCH_SIZE,
+                                    MSG_DONTWAIT, nullptr);
+                channel.received += received > 0 ? static_cast<uint64_t>(received) : 0;
+            } while (received == static_cast<int>(BATCH_SIZE));
+
+            // The frames of failed sends never arrive
+            if (channel.received + channel.failed >= channel.sent && channel.sent < frames) {
+                sendBatch(channel, frames);
+            }
+            if (channel.received + channel.failed < frames) {
+                receiveFrames(channel, frames);
+            }
+        });
+    }
+
+    /**
+     * The result of a run.
+     */
+    struct RunResult {
+        double seconds = 0;         /**< The wall time.                           */
+        double cpuSeconds = 0;      /**< The CPU time of all threads.             */
+        uint64_t received = 0;      /**< The frames received on all interfaces.   */
+        uint64_t failed = 0;        /**< The frames sendmmsg did not take.        */
+    };
+
+    double processCpuSeconds() {
+        struct timespec time = {};
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+        return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) * 1e-9;
+    }
+
+    /**
+     * Sends and receives frames on every interface, with one io context for all interfaces or one io context and
+     * thread per interface.
+     */
+    RunResult run(const std::vector<std::string> &interfaces, uint64_t frames, bool isThreadPerInterface) {
+
+        std::vector<std::unique_ptr<boost::asio::io_context>> ioContexts;
+        ioContexts.push_back(std::make_unique<boost::asio::io_context>());
+        std::vector<std::unique_ptr<Channel>> channels;
+        for (const auto &interface: interfaces) {
+            if (isThreadPerInterface && !channels.empty()) {
+                ioContexts.push_back(std::make_unique<boost::asio::io_context>());
+            }
+            channels.push_back(std::make_unique<Channel>(*ioContexts.back(), interface));
+        }
+
+        double cpuStart = processCpuSeconds();
+        auto start = std::chrono::steady_clock::now();
+
+        for (auto &channel: channels) {
+            receiveFrames(*channel, frames);
+            sendBatch(*channel, frames);
+        }
+
+        std::vector<std::thread> threads;
+        for (size_t index = 1; index < ioContexts.size(); index++) {
+            threads.emplace_back([&ioContext = *ioContexts[index]]() { ioContext.run(); });
+        }
+        ioContexts.front()->run();
+        for (auto &thread: threads) {
+            thread.join();
+        }
+
+        RunResult result;
+        result.seconds = secondsSince(start);
+        result.cpuSeconds = processCpuSeconds() - cpuStart;
+        for (const auto &channel: channels) {
+            result.received += channel->received;
+            result.failed += channel->failed;
+        }
+        return result;
+    }
+
+    void printResult(const char *mode, size_t interfaces, uint64_t frames, const RunResult &result) {
+        auto channels = static_cast<double>(interfaces);
+        std::cout << interfaces << " interfaces, " << mode << ": "
+                  << static_cast<uint64_t>(static_cast<double>(result.received) / result.seconds / channels)
+                  << " frames/s per channel, " << 100 * result.cpuSeconds / result.seconds / channels
+                  << " % CPU per channel, " << result.cpuSeconds * 1e9 / static_cast<double>(result.received)
+                  << " ns CPU per frame";
+        if (result.received != frames * interfaces) {
+            std::cout << " (" << frames * interfaces - result.received << " frames lost, " << result.failed
+                      << " not sent)";
+        }
+        std::cout << std::endl;
+    }
+
+}
+
+/**
+ * Usage: MultiInterfaceBenchmark [interfaces] [frames] [interface prefix]
+ *
+ * Sends frames CAN frames per interface in batches of 64 with sendmmsg and receives them on a second CAN_RAW socket
+ * with recvmmsg, on 1, 2, 4, ... up to interfaces interfaces named <prefix>0, <prefix>1, ... (default 16 and vcan).
+ * Every interface count runs once with one io context for all interfaces, like the connector, and once with one io
+ * context and thread per interface. Prints the frames per second and the CPU time per channel.
+ */
+int main(int argc, char *argv[]) {
+
+    size_t maxInterfaces = argument(argc, argv, 1, 16);
+    uint64_t frames = argument(argc, argv, 2, 200000);
+    std::string prefix = argc > 3 ? argv[3] : "vcan";
+
+    try {
+        size_t count = 1;
+        while (true) {
+            std::vector<std::string> interfaces;
+            for (size_t index = 0; index < count; index++) {
+                interfaces.push_back(prefix + std::to_string(index));
+            }
+
+            printResult("one io context", count, frames, run(interfaces, frames, false));
+            printResult("thread per interface", count, frames, run(interfaces, frames, true));
+
+            if (count >= maxInterfaces) {
+                break;
+            }
+            count = std::min(2 * count, maxInterfaces);
+        }
+    } catch (const std::exception &error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
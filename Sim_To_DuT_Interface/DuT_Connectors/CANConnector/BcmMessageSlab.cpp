@@ -0,0 +1,115 @@
+/**
+ * BCM Message Slab.
+ * Pre-allocated BCM message buffers that are recycled through a lock-free free list.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+// Project includes
+#include "BcmMessageSlab.h"
+
+// System includes
+#include <cstring>
+
+namespace sim_interface::dut_connector::can {
+
+    uint8_t *BcmMessageBuffer::data() {
+        return usesOverflow ? overflow.data() : storage.data();
+    }
+
+    size_t BcmMessageBuffer::size() const {
+        return messageSize;
+    }
+
+    BcmMessageSlab::BcmMessageSlab(uint32_t capacity) : buffers(capacity), freeHead(INVALID_INDEX) {
+
+        // Link all buffers into the free list
+        for (uint32_t index = 0; index < capacity; index++) {
+            buffers[index].index = index;
+            buffers[index].isSlabBuffer = true;
+            buffers[index].nextFree.store(index + 1 < capacity ? index + 1 : INVALID_INDEX, std::memory_order_relaxed);
+        }
+
+        if (capacity > 0) {
+            freeHead.store(0, std::memory_order_release);
+        }
+    }
+
+    BcmMessageBuffer *BcmMessageSlab::acquire(size_t size, const char *description) {
+
+        BcmMessageBuffer *buffer = nullptr;
+
+        // Pop the head of the free list
+        uint64_t head = freeHead.load(std::memory_order_acquire);
+        while (static_cast<uint32_t>(head) != INVALID_INDEX) {
+            uint32_t index = static_cast<uint32_t>(head);
+            uint64_t next = ((head >> 32) + 1) << 32 | buffers[index].nextFree.load(std::memory_order_relaxed);
+            if (freeHead.compare_exchange_weak(head, next, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                buffer = &buffers[index];
+                break;
+            }
+        }
+
+        // Fall back to the heap if the slab is exhausted
+        if (buffer == nullptr) {
+            exhaustedCount.fetch_add(1, std::memory_order_relaxed);
+            buffer = new BcmMessageBuffer();
+        }
+
+        buffer->description = description;
+        buffer->nextPending = nullptr;
+        buffer->socketHandle = -1;
+        buffer->messageSize = size;
+        buffer->usesOverflow = size > BCM_MESSAGE_INLINE_CAPACITY;
+
+        if (buffer->usesOverflow && buffer->overflow.size() < size) {
+            buffer->overflow.resize(size);
+        }
+
+        std::memset(buffer->data(), 0, size);
+
+        return buffer;
+    }
+
+    void BcmMessageSlab::release(BcmMessageBuffer *buffer) {
+
+        if (buffer == nullptr) {
+            return;
+        }
+
+        if (!buffer->isSlabBuffer) {
+            delete buffer;
+            return;
+        }
+
+        // Push the buffer onto the free list
+        uint64_t head = freeHead.load(std::memory_order_acquire);
+        uint64_t next;
+        do {
+            buffer->nextFree.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+            next = ((head >> 32) + 1) << 32 | buffer->index;
+        } while (!freeHead.compare_exchange_weak(head, next, std::memory_order_acq_rel, std::memory_order_acquire));
+    }
+
+    uint64_t BcmMessageSlab::getExhaustedCount() const {
+        return exhaustedCount.load(std::memory_order_relaxed);
+    }
+
+}
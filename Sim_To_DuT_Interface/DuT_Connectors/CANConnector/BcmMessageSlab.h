@@ -0,0 +1,155 @@
+/**
+ * BCM Message Slab.
+ * Pre-allocated BCM message buffers that are recycled through a lock-free free list.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_BCMMESSAGESLAB_H
+#define SIM_TO_DUT_INTERFACE_BCMMESSAGESLAB_H
+
+// System includes
+#include <array>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <linux/can.h>
+#include <linux/can/bcm.h>
+
+namespace sim_interface::dut_connector::can {
+
+    /**
+     * Size of the inline storage of a BCM message buffer.
+     * Fits a bcm_msg_head with a single CANFD frame, which covers all BCM messages except sequences.
+     */
+    constexpr size_t BCM_MESSAGE_INLINE_CAPACITY = sizeof(struct bcm_msg_head) + sizeof(struct canfd_frame);
+
+    /**
+     * <summary>
+     * Buffer for a single BCM message.
+     * </summary>
+     * The buffer is also used for the frames of the CAN_RAW backend, the data is sent as is.
+     */
+    class BcmMessageBuffer {
+
+    public:
+
+        /**
+         * Gets the message data. The data is valid for size() bytes.
+         *
+         * @return Pointer to the message data.
+         */
+        uint8_t *data();
+
+        /**
+         * Gets the size of the message.
+         *
+         * @return The size of the message in bytes.
+         */
+        size_t size() const;
+
+        /**
+         * Gets the message data as the given BCM message struct.
+         *
+         * @return Pointer to the message struct.
+         */
+        template<typename T>
+        T *as() {
+            return reinterpret_cast<T *>(data());
+        }
+
+        const char *description = "";          /**< Name of the BCM operation used for logging.                 */
+        BcmMessageBuffer *nextPending = nullptr; /**< Link to the next buffer in the pending list of the connector. */
+        int socketHandle = -1;                  /**< Native handle of the socket the message is sent on.         */
+
+    private:
+
+        friend class BcmMessageSlab;
+
+        alignas(alignof(struct bcm_msg_head)) std::array<uint8_t, BCM_MESSAGE_INLINE_CAPACITY> storage{0}; /**< Inline storage.             */
+        std::vector<uint8_t> overflow;          /**< Storage for messages bigger than the inline storage.        */
+        size_t messageSize = 0;                 /**< Size of the current message.                                */
+        bool usesOverflow = false;              /**< Flag if the current message is stored in the overflow.      */
+        bool isSlabBuffer = false;              /**< Flag if the buffer belongs to the slab or the heap.         */
+        uint32_t index = 0;                     /**< Index of the buffer in the slab.                            */
+        std::atomic<uint32_t> nextFree{0};      /**< Link to the next buffer in the free list.                   */
+    };
+
+    /**
+     * <summary>
+     * Fixed number of pre-allocated BCM message buffers.
+     * </summary>
+     * Free buffers are kept in a lock-free stack (Treiber stack). The head of the stack is an index combined with a
+     * tag that is incremented on every change, which prevents the ABA problem. Acquire and release can be called from
+     * any thread. If the slab is exhausted a heap allocated buffer is returned instead.
+     */
+    class BcmMessageSlab {
+
+    public:
+
+        /**
+         * Creates the slab with the given number of buffers.
+         *
+         * @param capacity - Number of pre-allocated buffers.
+         */
+        explicit BcmMessageSlab(uint32_t capacity);
+
+        BcmMessageSlab(const BcmMessageSlab &) = delete;
+
+        BcmMessageSlab &operator=(const BcmMessageSlab &) = delete;
+
+        /**
+         * Gets a zero initialized buffer for a message of the given size.
+         * Messages bigger than the inline storage use the overflow storage of the buffer, which is only
+         * allocated the first time it is needed.
+         *
+         * @param size        - Size of the message in bytes.
+         * @param description - Name of the BCM operation used for logging.
+         * @return The buffer. Never null, if the slab is exhausted the buffer is allocated on the heap.
+         */
+        BcmMessageBuffer *acquire(size_t size, const char *description);
+
+        /**
+         * Gives the buffer back to the slab (or frees it if it was allocated on the heap).
+         *
+         * @param buffer - The buffer that is not used anymore.
+         */
+        void release(BcmMessageBuffer *buffer);
+
+        /**
+         * Gets the number of times the slab was exhausted and a buffer was allocated on the heap.
+         *
+         * @return The number of heap allocated buffers.
+         */
+        uint64_t getExhaustedCount() const;
+
+    private:
+
+        static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+        std::vector<BcmMessageBuffer> buffers;     /**< The pre-allocated buffers.                          */
+        std::atomic<uint64_t> freeHead;            /**< Tag (upper 32 bit) and index (lower 32 bit) of the head. */
+        std::atomic<uint64_t> exhaustedCount{0};   /**< Number of heap allocated buffers.                   */
+    };
+
+}
+
+#endif //SIM_TO_DUT_INTERFACE_BCMMESSAGESLAB_H
@@ -0,0 +1,380 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+// Project includes
+#include "CANBusMonitor.h"
+#include "../../Interface_Logger/InterfaceLogger.h"
+
+// System includes
+#include <vector>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <linux/can/raw.h>
+#include <linux/can/error.h>
+
+namespace sim_interface::dut_connector::can {
+
+    CANBusMonitor::CANBusMonitor(boost::asio::io_context &ioContext, int interfaceIndex, std::string interfaceName,
+                                 const CANBusMonitorConfig &config)
+            : interfaceName(std::move(interfaceName)), config(config),
+              slotLength(std::chrono::milliseconds(config.window) / BUS_MONITOR_SLOTS),
+              strand(boost::asio::make_strand(ioContext)),
+              socket(strand, boost::asio::generic::raw_protocol(PF_CAN, CAN_RAW)),
+              slotTimer(strand) {
+
+        if (config.window < BUS_MONITOR_SLOTS || config.bitrate <= 0 || config.dataBitrate <= 0) {
+            InterfaceLogger::logMessage("CAN Connector: Invalid bus monitor config of <" + this->interfaceName +
+                                        ">, the window needs at least " + std::to_string(BUS_MONITOR_SLOTS) +
+                                        " milliseconds and the bitrates must be positive", LOG_LEVEL::ERROR);
+            throw std::invalid_argument("CAN Connector: Invalid bus monitor config");
+        }
+
+        int enable = 1;
+        if (setsockopt(socket.native_handle(), SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &enable, sizeof(enable)) < 0) {
+            InterfaceLogger::logMessage("CAN Connector: Could not enable CANFD frames on the bus monitor socket: " +
+                                        std::string(std::strerror(errno)), LOG_LEVEL::WARNING);
+        }
+
+        // The default filter of a CAN_RAW socket already receives all frames, the error frames need their own filter
+        can_err_mask_t errorMask = CAN_ERR_MASK;
+        if (setsockopt(socket.native_handle(), SOL_CAN_RAW, CAN_RAW_ERR_FILTER, &errorMask, sizeof(errorMask)) < 0) {
+            InterfaceLogger::logMessage("CAN Connector: Could not set the error filter of the bus monitor: " +
+                                        std::string(std::strerror(errno)), LOG_LEVEL::ERROR);
+            throw std::runtime_error("CAN Connector: Could not set the error filter of the bus monitor");
+        }
+
+        // Bind the socket to the interface
+        sockaddr_can addr = {0};
+        addr.can_family = AF_CAN;
+        addr.can_ifindex = interfaceIndex;
+
+        boost::system::error_code errorCode;
+        socket.bind(boost::asio::generic::raw_protocol::endpoint{&addr, sizeof(addr)}, errorCode);
+        if (errorCode) {
+            InterfaceLogger::logMessage("CAN Connector: Could not bind the bus monitor to <" + this->interfaceName +
+                                        ">: " + errorCode.message(), LOG_LEVEL::ERROR);
+            throw std::runtime_error("CAN Connector: Could not bind the bus monitor to the interface");
+        }
+
+        for (size_t index = 0; index < BUS_MONITOR_BATCH; index++) {
+            rxIovecs[index].iov_base = &rxFrames[index];
+            rxIovecs[index].iov_len = sizeof(struct canfd_frame);
+        }
+
+        receiveFrames();
+
+        slotDeadline = std::chrono::steady_clock::now();
+        startSlotTimer();
+
+        InterfaceLogger::logMessage("CAN Connector: Created the bus monitor of <" + this->interfaceName + "> with a " +
+                                    std::to_string(config.window) + " ms window", LOG_LEVEL::INFO);
+    }
+
+    std::chrono::nanoseconds CANBusMonitor::frameBusTime(const struct canfd_frame &frame, bool isCANFD, int bitrate,
+                                                         int dataBitrate) {
+
+        bool isExtended = frame.can_id & CAN_EFF_FLAG;
+        uint64_t dataBits = (frame.can_id & CAN_RTR_FLAG) ? 0 : 8u * frame.len;
+
+        // CRC delimiter, ACK slot and delimiter, end of frame and interframe space are not stuffed
+        const uint64_t trailerBits = 13;
+
+        uint64_t nominalBits = 0;
+        uint64_t fastBits = 0;
+        if (!isCANFD) {
+            // SOF, identifier, RTR/SRR, IDE, reserved, DLC, data and the 15 bit CRC are stuffed
+            uint64_t stuffedBits = (isExtended ? 54 : 34) + dataBits;
+            nominalBits = stuffedBits + (stuffedBits - 1) / 4 + trailerBits;
+        } else {
+            // The arbitration up to BRS is sent with the nominal bitrate
+            uint64_t arbitrationBits = isExtended ? 36 : 17;
+
+            // ESI, DLC and data are stuffed dynamically, the stuff count and the 17 or 21 bit CRC
+            // get a fixed stuff bit every four bits
+            uint64_t crcBits = frame.len > 16 ? 21 : 17;
+            uint64_t controlBits = 5 + dataBits;
+            fastBits = controlBits + (controlBits - 1) / 4 + 4 + crcBits + (4 + crcBits + 3) / 4;
+            nominalBits = arbitrationBits + (arbitrationBits - 1) / 4 + trailerBits;
+
+            if (!(frame.flags & CANFD_BRS)) {
+                nominalBits += fastBits;
+                fastBits = 0;
+            }
+        }
+
+        return std::chrono::nanoseconds(nominalBits * 1000000000ull / static_cast<uint64_t>(bitrate) +
+                                        fastBits * 1000000000ull / static_cast<uint64_t>(dataBitrate));
+    }
+
+    void CANBusMonitor::receiveFrames() {
+
+        socket.async_wait(boost::asio::socket_base::wait_read,
+                          boost::asio::bind_executor(strand, [this](boost::system::error_code errorCode) {
+
+            if (errorCode == boost::asio::error::operation_aborted) {
+                return;
+            }
+
+            if (!errorCode) {
+                readFrames();
+            } else {
+                InterfaceLogger::logMessage("CAN Connector: An error occurred on the bus monitor wait operation: " +
+                                            errorCode.message(), LOG_LEVEL::ERROR);
+            }
+
+            // Create the next wait operation
+            receiveFrames();
+        }));
+    }
+
+    void CANBusMonitor::readFrames() {
+
+        int received = 0;
+
+        do {
+
+            for (size_t index = 0; index < BUS_MONITOR_BATCH; index++) {
+                rxHeaders[index] = {};
+                rxHeaders[index].msg_hdr.msg_iov = &rxIovecs[index];
+                rxHeaders[index].msg_hdr.msg_iovlen = 1;
+            }
+
+            received = recvmmsg(socket.native_handle(), rxHeaders.data(), BUS_MONITOR_BATCH, MSG_DONTWAIT, nullptr);
+
+            if (received < 0) {
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    InterfaceLogger::logMessage("CAN Connector: An error occurred on the bus monitor recvmmsg: " +
+                                                std::string(std::strerror(errno)), LOG_LEVEL::ERROR);
+                }
+                return;
+            }
+
+            for (int index = 0; index < received; index++) {
+
+                const struct canfd_frame &frame = rxFrames[index];
+                bool isCANFD = rxHeaders[index].msg_len == CANFD_MTU;
+                if (!isCANFD && rxHeaders[index].msg_len != CAN_MTU) {
+                    continue;
+                }
+
+                // Error frames are generated by the controller, they do not occupy the bus
+                if (frame.can_id & CAN_ERR_FLAG) {
+                    handleErrorFrame(reinterpret_cast<const struct can_frame &>(frame));
+                    continue;
+                }
+
+                frames++;
+                slotBusTime[slot] += frameBusTime(frame, isCANFD, config.bitrate, config.dataBitrate);
+
+                IDStatistics &statistics = idStatistics[frame.can_id & (CAN_EFF_FLAG | CAN_EFF_MASK)];
+                statistics.slotFrames[slot]++;
+                statistics.frames++;
+            }
+
+            // A full batch means that there may be more frames waiting
+        } while (received == BUS_MONITOR_BATCH);
+    }
+
+    void CANBusMonitor::handleErrorFrame(const struct can_frame &frame) {
+
+        errorFrames++;
+
+        if (frame.can_id & CAN_ERR_LOSTARB) {
+            lostArbitrations++;
+        }
+
+        if (frame.can_id & CAN_ERR_PROT) {
+            protocolErrors++;
+        }
+
+        if (frame.can_id & CAN_ERR_ACK) {
+            missingAcks++;
+        }
+
+        if (frame.can_id & CAN_ERR_CRTL) {
+            if (frame.data[1] & (CAN_ERR_CRTL_RX_PASSIVE | CAN_ERR_CRTL_TX_PASSIVE)) {
+                changeErrorState(ErrorState::PASSIVE);
+            } else if (frame.data[1] & (CAN_ERR_CRTL_RX_WARNING | CAN_ERR_CRTL_TX_WARNING)) {
+                changeErrorState(ErrorState::WARNING);
+            } else if (frame.data[1] & CAN_ERR_CRTL_ACTIVE) {
+                changeErrorState(ErrorState::ACTIVE);
+            }
+        }
+
+        if (frame.can_id & CAN_ERR_BUSOFF) {
+            changeErrorState(ErrorState::BUS_OFF);
+        }
+
+        if (frame.can_id & CAN_ERR_RESTARTED) {
+            restarts++;
+            changeErrorState(ErrorState::ACTIVE);
+        }
+    }
+
+    void CANBusMonitor::changeErrorState(ErrorState state) {
+
+        if (state == errorState) {
+            return;
+        }
+
+        switch (state) {
+            case ErrorState::WARNING:
+                warningTransitions++;
+                break;
+            case ErrorState::PASSIVE:
+                passiveTransitions++;
+                break;
+            case ErrorState::BUS_OFF:
+                busOffTransitions++;
+                break;
+            default:
+                break;
+        }
+
+        InterfaceLogger::logMessage("CAN Connector: The controller of <" + interfaceName + "> changed from " +
+                                    getStateName(errorState) + " to " + getStateName(state),
+                                    state == ErrorState::ACTIVE ? LOG_LEVEL::INFO : LOG_LEVEL::WARNING);
+        errorState = state;
+    }
+
+    void CANBusMonitor::startSlotTimer() {
+
+        // The deadlines advance by the slot length, so the slots do not drift
+        slotDeadline += std::chrono::duration_cast<std::chrono::steady_clock::duration>(slotLength);
+        slotTimer.expires_at(slotDeadline);
+        slotTimer.async_wait(boost::asio::bind_executor(strand, [this](boost::system::error_code errorCode) {
+            if (errorCode) {
+                return;
+            }
+
+            advanceWindow();
+            startSlotTimer();
+        }));
+    }
+
+    void CANBusMonitor::advanceWindow() {
+
+        // Until the window is filled the load refers to the completed slots
+        completedSlots++;
+        size_t windowSlots = std::min<size_t>(completedSlots, BUS_MONITOR_SLOTS);
+        double windowSeconds = std::chrono::duration<double>(slotLength).count() * static_cast<double>(windowSlots);
+
+        std::chrono::nanoseconds busTime{0};
+        for (auto const &slotTime: slotBusTime) {
+            busTime += slotTime;
+        }
+
+        load = std::chrono::duration<double>(busTime).count() / windowSeconds * 100.0;
+        peakLoad = std::max(peakLoad, load);
+        loadSum += load;
+        loadSamples++;
+
+        bool wasOverloaded = isOverloaded;
+        isOverloaded = load > config.loadWarning;
+        if (isOverloaded) {
+            overloadedWindows++;
+        }
+
+        if (isOverloaded && !wasOverloaded) {
+            InterfaceLogger::logMessage("CAN Connector: The bus load of <" + interfaceName + "> is " +
+                                        std::to_string(static_cast<int>(load)) + "%, above the warning level of " +
+                                        std::to_string(config.loadWarning) + "%", LOG_LEVEL::WARNING);
+        } else if (!isOverloaded && wasOverloaded) {
+            InterfaceLogger::logMessage("CAN Connector: The bus load of <" + interfaceName + "> is back at " +
+                                        std::to_string(static_cast<int>(load)) + "%", LOG_LEVEL::INFO);
+        }
+
+        // Advance the window, the oldest slot is reused for the next one
+        slot = (slot + 1) % BUS_MONITOR_SLOTS;
+        slotBusTime[slot] = std::chrono::nanoseconds(0);
+
+        for (auto &[canID, statistics]: idStatistics) {
+            uint32_t windowFrames = 0;
+            for (uint32_t slotFrames: statistics.slotFrames) {
+                windowFrames += slotFrames;
+            }
+            statistics.rate = windowFrames / windowSeconds;
+            statistics.peakRate = std::max(statistics.peakRate, statistics.rate);
+            statistics.slotFrames[slot] = 0;
+        }
+
+        InterfaceLogger::logMessage("CAN Connector: The bus load of <" + interfaceName + "> is " +
+                                    std::to_string(load) + "% with " + std::to_string(idStatistics.size()) +
+                                    " CAN IDs", LOG_LEVEL::DEBUG);
+    }
+
+    std::string CANBusMonitor::getStateName(ErrorState state) {
+        switch (state) {
+            case ErrorState::ACTIVE:
+                return "error active";
+            case ErrorState::WARNING:
+                return "error warning";
+            case ErrorState::PASSIVE:
+                return "error passive";
+            case ErrorState::BUS_OFF:
+                return "bus off";
+        }
+        return "unknown";
+    }
+
+    std::string CANBusMonitor::getStatistics() const {
+
+        std::stringstream statistics;
+        statistics << std::fixed << std::setprecision(1);
+
+        statistics << "CAN Connector: Bus monitor <" << interfaceName << "> received " << frames << " frames of "
+                   << idStatistics.size() << " CAN IDs, load mean " << (loadSamples > 0 ? loadSum / loadSamples : 0)
+                   << "% peak " << peakLoad << "%, " << overloadedWindows << " windows above "
+                   << config.loadWarning << "%\n";
+
+        statistics << "  " << errorFrames << " error frames, " << warningTransitions << " error warning, "
+                   << passiveTransitions << " error passive, " << busOffTransitions << " bus off, " << restarts
+                   << " restarts, " << lostArbitrations << " lost arbitrations, " << protocolErrors
+                   << " protocol errors, " << missingAcks << " missing ACKs, state " << getStateName(errorState)
+                   << "\n";
+
+        // The CAN IDs with the highest rates
+        std::vector<std::pair<canid_t, const IDStatistics *>> sorted;
+        for (auto const &[canID, idStatistic]: idStatistics) {
+            sorted.emplace_back(canID, &idStatistic);
+        }
+        std::sort(sorted.begin(), sorted.end(), [](const auto &first, const auto &second) {
+            return first.second->peakRate > second.second->peakRate;
+        });
+
+        for (size_t index = 0; index < std::min<size_t>(sorted.size(), 10); index++) {
+            statistics << "  CAN ID 0x" << std::hex << (sorted[index].first & CAN_EFF_MASK) << std::dec << ": "
+                       << sorted[index].second->frames << " frames, " << sorted[index].second->rate << "/s, peak "
+                       << sorted[index].second->peakRate << "/s\n";
+        }
+
+        return statistics.str();
+    }
+
+}
@@ -0,0 +1,215 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_CANBUSMONITOR_H
+#define SIM_TO_DUT_INTERFACE_CANBUSMONITOR_H
+
+// System includes
+#include <array>
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+#include <linux/can.h>
+#include <boost/asio.hpp>
+
+/**
+ * Number of slots of the sliding window, the load is updated each window / BUS_MONITOR_SLOTS.
+ */
+#define BUS_MONITOR_SLOTS 4
+
+/**
+ * Maximum number of frames the bus monitor reads with one recvmmsg call.
+ */
+#define BUS_MONITOR_BATCH 64
+
+namespace sim_interface::dut_connector::can {
+
+    /**
+     * <summary>
+     * The config of the bus load and error frame monitor of the interfaces.
+     * </summary>
+     */
+    struct CANBusMonitorConfig {
+        int window = 0;                   /**< Length of the sliding window in milliseconds, 0 disables the monitor. */
+        int bitrate = 500000;             /**< The nominal bitrate of the bus.                                      */
+        int dataBitrate = 2000000;        /**< The data bitrate of CANFD frames with bitrate switch.                */
+        int loadWarning = 80;             /**< Bus load in percent above which a warning is logged.                 */
+    };
+
+    /**
+     * <summary>
+     * Monitors the bus load, the frame rates per CAN ID and the error frames of an interface.
+     * </summary>
+     * A CAN_RAW socket receives all frames of the bus, including the frames of this host, and the error frames of
+     * the controller (CAN_ERR_MASK). The bus time of each frame is calculated from its length at the bitrates of the
+     * bus plus an estimate of the stuff bits. The load and the frame rates are calculated over a sliding window
+     * that advances by a slot of window / BUS_MONITOR_SLOTS.
+     *
+     * The error state of the controller is followed with the error frames: warnings, transitions to error passive
+     * and bus off, and restarts are logged as they happen, together with lost arbitrations and protocol errors.
+     *
+     * Note: All handlers run on one strand of the io context.
+     */
+    class CANBusMonitor {
+
+    public:
+
+        /**
+         * Constructor. Creates the socket and starts the monitor.
+         *
+         * @param ioContext      - The io context of the monitor.
+         * @param interfaceIndex - The index of the interface.
+         * @param interfaceName  - The name of the interface.
+         * @param config         - The config of the monitor.
+         */
+        CANBusMonitor(boost::asio::io_context &ioContext, int interfaceIndex, std::string interfaceName,
+                      const CANBusMonitorConfig &config);
+
+        CANBusMonitor(const CANBusMonitor &) = delete;
+
+        CANBusMonitor &operator=(const CANBusMonitor &) = delete;
+
+        /**
+         * Calculates the time a frame occupies the bus.
+         *
+         * @param frame       - The frame.
+         * @param isCANFD     - Flag for a CANFD frame.
+         * @param bitrate     - The nominal bitrate.
+         * @param dataBitrate - The data bitrate of CANFD frames with bitrate switch.
+         *
+         * @return The bus time including the worst case number of stuff bits.
+         */
+        static std::chrono::nanoseconds frameBusTime(const struct canfd_frame &frame, bool isCANFD, int bitrate,
+                                                     int dataBitrate);
+
+        /**
+         * Note: The counters are owned by the strand, so this is called after the io context stopped.
+         *
+         * @return The load and frame counts of the interface, the CAN IDs with the highest rates and the error
+         *         counters.
+         */
+        std::string getStatistics() const;
+
+    private:
+
+        /**
+         * The error state of the CAN controller.
+         */
+        enum class ErrorState {
+            ACTIVE,
+            WARNING,
+            PASSIVE,
+            BUS_OFF
+        };
+
+        /**
+         * <summary>
+         * The frames of a CAN ID.
+         * </summary>
+         */
+        struct IDStatistics {
+            std::array<uint32_t, BUS_MONITOR_SLOTS> slotFrames{};  /**< Frames in each slot of the window.     */
+            uint64_t frames = 0;                                   /**< Number of all frames.                  */
+            double rate = 0;                                       /**< Frames per second over the last window. */
+            double peakRate = 0;                                   /**< Highest rate of all windows.           */
+        };
+
+        /**
+         * Waits until the socket is readable and reads the frames. After processing the frames the next
+         * wait operation is created (function calls itself).
+         */
+        void receiveFrames();
+
+        /**
+         * Reads all frames that are available on the socket.
+         */
+        void readFrames();
+
+        /**
+         * Counts an error frame and follows the error state of the controller.
+         *
+         * @param frame - The error frame.
+         */
+        void handleErrorFrame(const struct can_frame &frame);
+
+        /**
+         * Changes the error state and logs the transition.
+         *
+         * @param state - The new state.
+         */
+        void changeErrorState(ErrorState state);
+
+        /**
+         * Starts the timer of the next slot.
+         */
+        void startSlotTimer();
+
+        /**
+         * Calculates the load and the rates of the window and advances the window by a slot.
+         */
+        void advanceWindow();
+
+        /**
+         * @param state - The error state.
+         *
+         * @return The name of the error state.
+         */
+        static std::string getStateName(ErrorState state);
+
+        std::string interfaceName;                                         /**< The name of the interface.           */
+        CANBusMonitorConfig config;                                        /**< The config of the monitor.           */
+        std::chrono::nanoseconds slotLength;                               /**< The length of a slot of the window.  */
+        boost::asio::strand<boost::asio::io_context::executor_type> strand; /**< Serializes the handlers.            */
+        boost::asio::generic::raw_protocol::socket socket;                 /**< Receives all frames and errors.      */
+        boost::asio::steady_timer slotTimer;                               /**< Advances the window.                 */
+        std::chrono::steady_clock::time_point slotDeadline;                /**< The end of the current slot.         */
+        size_t slot = 0;                                                   /**< The current slot.                    */
+        size_t completedSlots = 0;                                         /**< Number of slots since the start.     */
+        std::array<std::chrono::nanoseconds, BUS_MONITOR_SLOTS> slotBusTime{}; /**< Bus time in each slot.           */
+        std::unordered_map<canid_t, IDStatistics> idStatistics;            /**< The frames of each CAN ID.           */
+        double load = 0;                                                   /**< Load of the last window in percent.  */
+        double peakLoad = 0;                                               /**< Highest load of all windows.         */
+        double loadSum = 0;                                                /**< Sum of the loads of all windows.     */
+        uint64_t loadSamples = 0;                                          /**< Number of calculated windows.        */
+        uint64_t overloadedWindows = 0;                                    /**< Windows above the load warning.      */
+        bool isOverloaded = false;                                         /**< Flag if the last window was above.   */
+        uint64_t frames = 0;                                               /**< Number of received frames.           */
+        ErrorState errorState = ErrorState::ACTIVE;                        /**< The error state of the controller.   */
+        uint64_t errorFrames = 0;                                          /**< Number of error frames.              */
+        uint64_t warningTransitions = 0;                                   /**< Transitions to error warning.        */
+        uint64_t passiveTransitions = 0;                                   /**< Transitions to error passive.        */
+        uint64_t busOffTransitions = 0;                                    /**< Transitions to bus off.              */
+        uint64_t restarts = 0;                                             /**< Restarts after bus off.              */
+        uint64_t lostArbitrations = 0;                                     /**< Lost arbitrations.                   */
+        uint64_t protocolErrors = 0;                                       /**< Protocol violations.                 */
+        uint64_t missingAcks = 0;                                          /**< Frames without acknowledgement.      */
+        std::array<struct canfd_frame, BUS_MONITOR_BATCH> rxFrames{};      /**< Receive buffers for recvmmsg.        */
+        std::array<struct mmsghdr, BUS_MONITOR_BATCH> rxHeaders{};         /**< Message headers for recvmmsg.        */
+        std::array<struct iovec, BUS_MONITOR_BATCH> rxIovecs{};            /**< IO vectors for recvmmsg.             */
+    };
+
+}
+
+#endif //SIM_TO_DUT_INTERFACE_CANBUSMONITOR_H
@@ -25,6 +25,12 @@
 
 // Project includes
 #include "CANConnector.h"
+#include "../../Utility/Executor.h"
+
+// System includes
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
 
 namespace sim_interface::dut_connector::can {
 
@@ -33,52 +39,188 @@ namespace sim_interface::dut_connector::can {
             const CANConnectorConfig &config) :
             DuTConnector(std::move(queueDuTToSim), config),
             ioContext(boost::make_shared<boost::asio::io_context>()),
-            bcmSocket(createBcmSocket(config)),
-            config(config) {
+            config(config),
+            bcmSlab(BCM_SLAB_CAPACITY),
+            isRawBackend(config.backend == CAN_BACKEND_RAW) {
+
+        // Check the backend
+        if (config.backend != CAN_BACKEND_BCM && !isRawBackend) {
+            InterfaceLogger::logMessage("CAN Connector: Unknown backend <" + config.backend + ">", LOG_LEVEL::ERROR);
+            throw std::invalid_argument("CAN Connector: Unknown backend <" + config.backend + ">");
+        }
 
-        // Create the codec
-        this->codec = CANConnectorCodecFactory::createCodec(this->config.codecName);
-        InterfaceLogger::logMessage("CAN Connector: Created <" + this->config.codecName + "> codec", LOG_LEVEL::INFO);
+        // Reserve the batch so the flush does not allocate
+        flushBatch.reserve(BCM_SLAB_CAPACITY);
 
-        // Create all receive operations
-        for (auto const&[canID, receiveOperation]: config.frameToOperation) {
+        // Create the BCM sockets of all interfaces
+        createChannels();
 
-            // Check if the receive operation has a mask
-            if (receiveOperation.hasMask) {
+        // Create the codecs and the routing tables of the received CAN IDs
+        createCodecs();
 
-                // Set the CAN ID in the mask
-                struct canfd_frame mask = receiveOperation.mask;
-                mask.can_id = canID;
+        for (auto &channel: channels) {
 
-                // Create the receive operation
-                rxSetupMask(canID, mask, receiveOperation.isCANFD);
+            // Create the CAN_RAW socket, the kernel filters replace the RX setup of the BCM
+            if (isRawBackend) {
+                channel->rawSocket = createRawSocket(channel->interfaceIndex, channel->receiveOperations);
+                InterfaceLogger::logMessage("CAN Connector: Created the CAN_RAW backend on <" +
+                                            channel->interfaceName + ">", LOG_LEVEL::INFO);
+            }
 
-            } else {
+            // Create all receive operations
+            for (auto const&[canID, receiveOperation]: *channel->receiveOperations) {
 
-                // Create the receive operation
-                rxSetupCanID(canID, receiveOperation.isCANFD);
-            }
+                // The PDUs of a container are not on the bus as frames of their own
+                if (receiveOperation.isContained) {
+                    continue;
+                }
+
+                // The CAN_RAW backend filters the content changes with the routing table. Only the timeouts are
+                // monitored by the BCM, an empty mask reports nothing but the first frame after a timeout.
+                if (isRawBackend) {
+                    if (receiveOperation.timeout > 0) {
+                        struct canfd_frame mask = {0};
+                        mask.can_id = canID;
+                        mask.len = receiveOperation.isCANFD ? CANFD_MAX_DLEN : CAN_MAX_DLEN;
+                        rxSetupMask(*channel, canID, mask, receiveOperation.isCANFD, receiveOperation.timeout);
+                    }
+                    continue;
+                }
 
+                // Check if the receive operation has a mask
+                if (receiveOperation.hasMask) {
+
+                    // Set the CAN ID in the mask
+                    struct canfd_frame mask = receiveOperation.mask;
+                    mask.can_id = canID;
+
+                    // Create the receive operation
+                    rxSetupMask(*channel, canID, mask, receiveOperation.isCANFD, receiveOperation.timeout);
+
+                } else {
+
+                    // Create the receive operation
+                    rxSetupCanID(*channel, canID, receiveOperation.isCANFD, receiveOperation.timeout);
+                }
+
+            }
         }
 
         InterfaceLogger::logMessage("CAN Connector: Created initial RX setup", LOG_LEVEL::INFO);
 
-        // Create the isSetup map based on the send operations in the config.
-        // This map keeps track if we already created a cyclic send operation,
-        // so we know if we need to create a new one or only perform an update.
+        // Create the send operation table. The codec refers to the send operations by their index in this table,
+        // so the names are only resolved once. isSetup keeps track if we already created a cyclic send operation,
+        // so we know if we need to create a new one or only perform an update. The shadow frames of the cyclic
+        // send operations keep the frames that were last handed to the BCM, unchanged updates are not sent.
         for (auto const&[operation, sendOperation]: config.operationToFrame) {
+            this->sendOperationNames.push_back(operation);
+            this->sendOperations.push_back(sendOperation);
+            this->sendChannels.push_back(findChannel(sendOperation.interfaceName));
+            this->shadowFrames.emplace_back(sendOperation.isCyclic ? sendOperation.nframes : 0);
+            this->sendProtection.push_back(sendOperation.e2e.profile == E2E_PROFILE_NONE ? nullptr :
+                                           createE2EProtection(sendOperation.e2e, operation));
+        }
+
+        this->isSetup.assign(this->sendOperations.size(), false);
+        for (auto &codec: this->codecs) {
+            codec->bindSendOperations(this->sendOperationNames);
+        }
+
+        // Create the userspace scheduler for the cyclic send operations that are not sent by the BCM.
+        // It sends over its own CAN_RAW socket that does not receive any frames, frames of the send
+        // operations on further interfaces are addressed to their interface.
+        bool hasScheduledOperations = false;
+        for (size_t handle = 0; handle < this->sendOperations.size(); handle++) {
+            const std::string &cyclicEngine = this->sendOperations[handle].cyclicEngine;
+            if (cyclicEngine != CAN_CYCLIC_ENGINE_BCM && cyclicEngine != CAN_CYCLIC_ENGINE_USERSPACE) {
+                InterfaceLogger::logMessage("CAN Connector: Unknown cyclic engine <" + cyclicEngine +
+                                            "> of the send operation <" + sendOperationNames[handle] + ">",
+                                            LOG_LEVEL::ERROR);
+                throw std::invalid_argument("CAN Connector: Unknown cyclic engine <" + cyclicEngine + ">");
+            }
+            hasScheduledOperations |= CANCyclicScheduler::isScheduled(this->sendOperations[handle]);
+
+            // The BCM repeats a static payload, the E2E counter only advances with the updates
+            if (sendProtection[handle] && this->sendOperations[handle].isCyclic &&
+                !CANCyclicScheduler::isScheduled(this->sendOperations[handle])) {
+                InterfaceLogger::logMessage("CAN Connector: The BCM repeats the E2E counter of the cyclic send "
+                                            "operation <" + sendOperationNames[handle] + ">, use the cyclic engine " +
+                                            CAN_CYCLIC_ENGINE_USERSPACE, LOG_LEVEL::WARNING);
+            }
+        }
+
+        if (hasScheduledOperations) {
+            std::vector<int> interfaceIndexes;
+            for (size_t channel: sendChannels) {
+                interfaceIndexes.push_back(channels[channel]->interfaceIndex);
+            }
+
+            cyclicScheduler = std::make_unique<CANCyclicScheduler>(*ioContext,
+                                                                   createRawSocket(channels.front()->interfaceIndex,
+                                                                                   nullptr),
+                                                                   this->sendOperations, this->sendOperationNames,
+                                                                   interfaceIndexes, this->sendProtection);
+        }
+
+        // Create the containers the PDUs of send operations are packed into
+        createContainers();
+
+        // Confirm the transmissions of the send operations of each interface with the echoes of the frames
+        if (config.txMonitor) {
+            for (size_t channel = 0; channel < channels.size(); channel++) {
+                std::vector<const CANConnectorSendOperation *> channelOperations;
+                std::vector<std::string> channelOperationNames;
+                for (size_t handle = 0; handle < sendOperations.size(); handle++) {
+                    if (sendChannels[handle] == channel) {
+                        channelOperations.push_back(&sendOperations[handle]);
+                        channelOperationNames.push_back(sendOperationNames[handle]);
+                    }
+                }
+
+                channels[channel]->txMonitor = std::make_unique<CANTxMonitor>(*ioContext,
+                                                                              channels[channel]->interfaceIndex,
+                                                                              channels[channel]->interfaceName,
+                                                                              channelOperations,
+                                                                              channelOperationNames);
+            }
+        }
 
-            // Add it to the map if it is a cyclic operation
-            if (sendOperation.isCyclic) {
-                this->isSetup[operation] = false;
+        InterfaceLogger::logMessage("CAN Connector: Created the send operation table", LOG_LEVEL::INFO);
+
+        // Monitor the load and the error frames of each bus
+        if (config.busMonitor.window > 0) {
+            for (auto &channel: channels) {
+                channel->busMonitor = std::make_unique<CANBusMonitor>(*ioContext, channel->interfaceIndex,
+                                                                      channel->interfaceName, config.busMonitor);
             }
+        }
+
+        // Let the kernel segment and reassemble the payloads of the ISO-TP operations
+        for (auto const &isoTpOperation: config.isoTpOperations) {
+            CANChannel &channel = *channels[findChannel(isoTpOperation.interfaceName)];
+            std::string operation = isoTpOperation.operation;
+
+            isoTpOperations[operation] = isoTpTransports.size();
+            isoTpTransports.push_back(std::make_unique<CANIsoTpTransport>(
+                    *ioContext, channel.interfaceIndex, channel.interfaceName, isoTpOperation,
+                    [this, operation](std::string payload) {
+                        sendEventToSim(SimEvent(operation, std::move(payload), "CanConnector"));
+                    }));
+        }
 
+        // Let the kernel forward the frames of the gateway routes, they do not pass the connector
+        if (!config.gatewayRoutes.empty()) {
+            gateway = std::make_unique<CANGateway>(config.gatewayRoutes, config.interfaceName);
         }
 
-        InterfaceLogger::logMessage("CAN Connector: Created initial isSetup map", LOG_LEVEL::INFO);
+        // Start the receive loops on the sockets of all interfaces
+        for (auto &channel: channels) {
+            receiveOnSocket(*channel);
 
-        // Start the receive loop on the socket
-        receiveOnSocket();
+            if (isRawBackend) {
+                receiveOnRawSocket(*channel);
+            }
+        }
 
         // Start the io context loop
         startProcessing();
@@ -91,11 +233,126 @@ namespace sim_interface::dut_connector::can {
         // Stop the io context loop
         stopProcessing();
 
+        // Give back all BCM messages that could not be sent anymore
+        releasePendingBcmMessages();
+
+        InterfaceLogger::logMessage(
+                "CAN Connector: Sent " + std::to_string(sentMessages.load()) + " BCM messages with " +
+                std::to_string(sendCalls.load()) + " sendmmsg calls, BCM message slab exhausted " +
+                std::to_string(bcmSlab.getExhaustedCount()) + " times", LOG_LEVEL::INFO);
+
+        InterfaceLogger::logMessage(
+                "CAN Connector: Suppressed " + std::to_string(suppressedUpdates.load()) +
+                " unchanged BCM updates with " + std::to_string(suppressedFrames.load()) + " frames", LOG_LEVEL::INFO);
+
+        for (auto &channel: channels) {
+            InterfaceLogger::logMessage(
+                    "CAN Connector: Interface <" + channel->interfaceName + "> received " +
+                    std::to_string(channel->receivedFrames.load()) + " frames and sent " +
+                    std::to_string(channel->sentMessages.load()) + " messages", LOG_LEVEL::INFO);
+
+            if (channel->txMonitor) {
+                InterfaceLogger::logMessage(channel->txMonitor->getStatistics(), LOG_LEVEL::INFO);
+            }
+
+            if (channel->busMonitor) {
+                InterfaceLogger::logMessage(channel->busMonitor->getStatistics(), LOG_LEVEL::INFO);
+            }
+        }
+
+        if (cyclicScheduler) {
+            InterfaceLogger::logMessage(cyclicScheduler->getStatistics(), LOG_LEVEL::INFO);
+        }
+
+        if (containerPacker) {
+            InterfaceLogger::logMessage(containerPacker->getStatistics(), LOG_LEVEL::INFO);
+        }
+
+        // Read the counters of the gateway routes before they are removed
+        if (gateway) {
+            InterfaceLogger::logMessage(gateway->getStatistics(), LOG_LEVEL::INFO);
+            gateway.reset();
+        }
+
+        for (size_t handle = 0; handle < sendProtection.size(); handle++) {
+            if (sendProtection[handle]) {
+                InterfaceLogger::logMessage("CAN Connector: E2E of the send operation <" +
+                                            sendOperationNames[handle] + ">: " +
+                                            sendProtection[handle]->getStatistics(), LOG_LEVEL::INFO);
+            }
+        }
+
+        for (size_t index = 0; index < receiveChecks.size(); index++) {
+            InterfaceLogger::logMessage("CAN Connector: E2E of the receive operation <" + receiveCheckNames[index] +
+                                        ">: " + receiveChecks[index]->getStatistics(), LOG_LEVEL::INFO);
+        }
+
+        for (auto const &transport: isoTpTransports) {
+            InterfaceLogger::logMessage(transport->getStatistics(), LOG_LEVEL::INFO);
+        }
+
+        for (auto const &liveness: rxLiveness) {
+            InterfaceLogger::logMessage("CAN Connector: Receive operation <" + liveness->operation + "> on <" +
+                                        liveness->interfaceName + "> timed out " +
+                                        std::to_string(liveness->timeouts.load()) + " times, recovered " +
+                                        std::to_string(liveness->recoveries.load()) + " times", LOG_LEVEL::INFO);
+        }
+
         InterfaceLogger::logMessage("CAN Connector: CAN Connector destroyed", LOG_LEVEL::INFO);
     }
 
+    void CANConnector::createChannels() {
+
+        // The interface of interfaceName is the first channel, send operations without an interface use it
+        std::vector<std::string> interfaceNames = {config.interfaceName};
+        for (auto const&[interfaceName, receiveOperations]: config.interfaceFrameToOperation) {
+            if (std::find(interfaceNames.begin(), interfaceNames.end(), interfaceName) == interfaceNames.end()) {
+                interfaceNames.push_back(interfaceName);
+            }
+        }
+        for (auto const&[operation, sendOperation]: config.operationToFrame) {
+            if (!sendOperation.interfaceName.empty() &&
+                std::find(interfaceNames.begin(), interfaceNames.end(), sendOperation.interfaceName) ==
+                interfaceNames.end()) {
+                interfaceNames.push_back(sendOperation.interfaceName);
+            }
+        }
+
+        for (auto const &interfaceName: interfaceNames) {
+
+            // The receive operations of interfaceName stay in frameToOperation, an interface
+            // without receive operations gets an empty entry in our config copy
+            auto *receiveOperations = interfaceName == config.interfaceName ? &config.frameToOperation :
+                                      &config.interfaceFrameToOperation[interfaceName];
+
+            int interfaceIndex = 0;
+            auto socket = createBcmSocket(interfaceName, interfaceIndex);
+            channels.push_back(std::make_unique<CANChannel>(interfaceName, interfaceIndex, std::move(socket),
+                                                            receiveOperations));
+        }
+
+        InterfaceLogger::logMessage("CAN Connector: Created the BCM sockets of " + std::to_string(channels.size()) +
+                                    " interfaces", LOG_LEVEL::INFO);
+    }
+
+    size_t CANConnector::findChannel(const std::string &interfaceName) const {
+
+        if (interfaceName.empty()) {
+            return 0;
+        }
+
+        for (size_t index = 0; index < channels.size(); index++) {
+            if (channels[index]->interfaceName == interfaceName) {
+                return index;
+            }
+        }
+
+        InterfaceLogger::logMessage("CAN Connector: Unknown interface <" + interfaceName + ">", LOG_LEVEL::ERROR);
+        throw std::invalid_argument("CAN Connector: Unknown interface <" + interfaceName + ">");
+    }
+
     boost::asio::generic::datagram_protocol::socket
-    CANConnector::createBcmSocket(const CANConnectorConfig &connectorConfig) {
+    CANConnector::createBcmSocket(const std::string &interfaceName, int &interfaceIndex) {
 
         // Error code return value
         boost::system::error_code errorCode;
@@ -107,7 +364,7 @@ namespace sim_interface::dut_connector::can {
         boost::asio::generic::datagram_protocol::socket socket(*ioContext, bcmProtocol);
 
         // Create an I/O command and resolve the interface name to an interface index
-        InterfaceIndexIO interfaceIndexIO(connectorConfig.interfaceName);
+        InterfaceIndexIO interfaceIndexIO(interfaceName);
         socket.io_control(interfaceIndexIO, errorCode);
 
         // Check if we could resolve the interface correctly
@@ -115,13 +372,15 @@ namespace sim_interface::dut_connector::can {
             InterfaceLogger::logMessage(
                     "CAN Connector: An error occurred on the io control operation: " + errorCode.message(),
                     LOG_LEVEL::ERROR);
-            throw std::invalid_argument("CAN Connector: Could not resolve the interface name correctly");
+            throw std::invalid_argument("CAN Connector: Could not resolve the interface name <" + interfaceName +
+                                        "> correctly");
         }
 
         // Connect the socket
+        interfaceIndex = interfaceIndexIO.index();
         sockaddr_can addr = {0};
         addr.can_family = AF_CAN;
-        addr.can_ifindex = interfaceIndexIO.index();
+        addr.can_ifindex = interfaceIndex;
 
         boost::asio::generic::datagram_protocol::endpoint bcmEndpoint{&addr, sizeof(addr)};
         socket.connect(bcmEndpoint, errorCode);
@@ -140,10 +399,300 @@ namespace sim_interface::dut_connector::can {
         return socket;
     }
 
+    std::unique_ptr<boost::asio::generic::raw_protocol::socket>
+    CANConnector::createRawSocket(int interfaceIndex,
+                                  const std::map<canid_t, CANConnectorReceiveOperation> *receiveOperations) {
+
+        // Error code return value
+        boost::system::error_code errorCode;
+
+        // Define Address family and protocol
+        boost::asio::generic::raw_protocol rawProtocol(PF_CAN, CAN_RAW);
+
+        // Create a CAN_RAW socket
+        auto socket = std::make_unique<boost::asio::generic::raw_protocol::socket>(*ioContext, rawProtocol);
+
+        // Enable CANFD frames. In contrast to the BCM socket this is needed for a CAN_RAW socket.
+        int enableCANFD = 1;
+        if (setsockopt(socket->native_handle(), SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &enableCANFD, sizeof(enableCANFD)) < 0) {
+            InterfaceLogger::logMessage("CAN Connector: Could not enable CANFD frames on the CAN_RAW socket: " +
+                                        std::string(std::strerror(errno)), LOG_LEVEL::WARNING);
+        }
+
+        // Only receive the CAN IDs of the receive operations. An empty filter list receives nothing,
+        // so a send only socket has no filters.
+        std::vector<struct can_filter> filters;
+        static const std::map<canid_t, CANConnectorReceiveOperation> noReceiveOperations;
+        for (auto const&[canID, receiveOperation]: receiveOperations ? *receiveOperations : noReceiveOperations) {
+
+            // The PDUs of a container are not on the bus as frames of their own
+            if (receiveOperation.isContained) {
+                continue;
+            }
+
+            struct can_filter filter = {0};
+            filter.can_id = canID;
+            filter.can_mask = (canID & CAN_EFF_FLAG) ? (CAN_EFF_FLAG | CAN_RTR_FLAG | CAN_EFF_MASK)
+                                                     : (CAN_EFF_FLAG | CAN_RTR_FLAG | CAN_SFF_MASK);
+            filters.push_back(filter);
+        }
+
+        if (setsockopt(socket->native_handle(), SOL_CAN_RAW, CAN_RAW_FILTER, filters.data(),
+                       filters.size() * sizeof(struct can_filter)) < 0) {
+            InterfaceLogger::logMessage("CAN Connector: Could not set the CAN_RAW filters: " +
+                                        std::string(std::strerror(errno)), LOG_LEVEL::ERROR);
+            throw std::runtime_error("CAN Connector: Could not set the CAN_RAW filters");
+        }
+
+        // Bind the socket to the interface
+        sockaddr_can addr = {0};
+        addr.can_family = AF_CAN;
+        addr.can_ifindex = interfaceIndex;
+
+        boost::asio::generic::raw_protocol::endpoint rawEndpoint{&addr, sizeof(addr)};
+        socket->bind(rawEndpoint, errorCode);
+
+        // Check if we could bind correctly
+        if (errorCode) {
+            InterfaceLogger::logMessage(
+                    "CAN Connector: An error occurred on the bind operation: " + errorCode.message(),
+                    LOG_LEVEL::ERROR);
+            throw std::runtime_error("CAN Connector: Could not bind to the interface");
+        }
+
+        return socket;
+    }
+
+    void CANConnector::createCodecs() {
+
+        // The codec of codecName is the default codec with the index 0
+        codecs.emplace_back(CANConnectorCodecFactory::createCodec(config.codecName, config.dbcFile));
+        codecNames.push_back(config.codecName);
+        InterfaceLogger::logMessage("CAN Connector: Created <" + config.codecName + "> codec", LOG_LEVEL::INFO);
+
+        std::map<std::string, uint16_t> codecIndexes;
+        for (auto const&[name, codec]: config.codecs) {
+
+            // A DBC file creates a DbcCodec
+            bool isDbcFile = codec.size() > 4 && codec.compare(codec.size() - 4, 4, ".dbc") == 0;
+            codecs.emplace_back(isDbcFile ? CANConnectorCodecFactory::createCodec(CODEC_NAME_DBC, codec)
+                                          : CANConnectorCodecFactory::createCodec(codec));
+            codecNames.push_back(name);
+            codecIndexes[name] = static_cast<uint16_t>(codecs.size() - 1);
+
+            InterfaceLogger::logMessage("CAN Connector: Created <" + codec + "> codec as <" + name + ">",
+                                        LOG_LEVEL::INFO);
+        }
+
+        // Route every received CAN ID to its codec
+        size_t autoMaskCount = 0;
+        size_t routeCount = 0;
+        std::vector<size_t> codecRouteCounts(codecs.size(), 0);
+        for (auto &channel: channels) {
+            for (auto &[canID, receiveOperation]: *channel->receiveOperations) {
+
+                CANRoute route;
+                route.codec = 0;
+
+                if (!receiveOperation.codec.empty()) {
+                    auto codecIndex = codecIndexes.find(receiveOperation.codec);
+                    if (codecIndex == codecIndexes.end()) {
+                        InterfaceLogger::logMessage("CAN Connector: Unknown codec <" + receiveOperation.codec +
+                                                    "> of the receive operation <" + receiveOperation.operation + ">",
+                                                    LOG_LEVEL::ERROR);
+                        throw std::invalid_argument("CAN Connector: Unknown codec <" + receiveOperation.codec +
+                                                    "> of the receive operation <" + receiveOperation.operation + ">");
+                    }
+                    route.codec = codecIndex->second;
+                }
+
+                // E2E protected frames are checked before the codec sees them. The check has to see every frame to
+                // follow the counter, so the codec does not create a mask for them.
+                bool hasE2ECheck = receiveOperation.e2e.profile != E2E_PROFILE_NONE;
+                if (hasE2ECheck) {
+                    route.e2eCheck = static_cast<int32_t>(receiveChecks.size());
+                    receiveChecks.push_back(createE2EProtection(receiveOperation.e2e, receiveOperation.operation));
+                    receiveCheckNames.push_back(receiveOperation.operation);
+                }
+
+                // The BCM monitors the timeout of the frames, the PDUs of a container are not on the bus themselves
+                if (receiveOperation.timeout > 0 && receiveOperation.isContained) {
+                    InterfaceLogger::logMessage("CAN Connector: The timeout of the contained receive operation <" +
+                                                receiveOperation.operation + "> is not monitored",
+                                                LOG_LEVEL::WARNING);
+                } else if (receiveOperation.timeout > 0) {
+                    auto liveness = std::make_unique<RxLiveness>();
+                    liveness->operation = receiveOperation.operation;
+                    liveness->eventOperation = receiveOperation.timeoutOperation.empty() ?
+                                               receiveOperation.operation + RX_TIMEOUT_OPERATION_SUFFIX :
+                                               receiveOperation.timeoutOperation;
+                    liveness->interfaceName = channel->interfaceName;
+                    route.liveness = static_cast<int32_t>(rxLiveness.size());
+                    rxLiveness.push_back(std::move(liveness));
+                }
+
+                // Containers are unpacked and their PDUs routed by the header ID, which are never masked
+                route.isContainer = receiveOperation.isContainer;
+                bool isUnmasked = receiveOperation.isContainer || receiveOperation.isContained;
+                if (isUnmasked) {
+                    receiveOperation.hasMask = false;
+                }
+
+                // Let the codec create the mask from the signals it passes to the simulation. The mask is written into
+                // the receive operation of our config copy, so both backends use it like a configured mask.
+                if (config.autoMasks && !hasE2ECheck && !isUnmasked && !receiveOperation.hasMask &&
+                    codecs[route.codec]->receiveMask(canID, receiveOperation.mask)) {
+                    receiveOperation.mask.can_id = canID;
+                    receiveOperation.maskLength = receiveOperation.mask.len;
+                    receiveOperation.hasMask = true;
+                    autoMaskCount++;
+                }
+
+                // The CAN_RAW backend only needs to remember the last frame for the masks
+                if (isRawBackend && receiveOperation.hasMask) {
+                    route.contentFilter = static_cast<int32_t>(rawContentFilters.size());
+                    rawContentFilters.push_back({receiveOperation.mask, {0}, false});
+                }
+
+                channel->routes.add(canID, route);
+                codecRouteCounts[route.codec]++;
+            }
+
+            routeCount += channel->routes.size();
+        }
+
+        // Route every simulation event operation to the first further codec that supports it,
+        // the default codec takes the remaining operations
+        std::vector<size_t> codecOperationCounts(codecs.size(), 0);
+        if (codecs.size() > 1) {
+            for (auto const &operation: config.operations) {
+                size_t operationCodec = 0;
+                for (size_t index = 1; index < codecs.size(); index++) {
+                    if (codecs[index]->supportsOperation(operation)) {
+                        operationCodec = index;
+                        break;
+                    }
+                }
+                operationCodecs[operation] = codecs[operationCodec].get();
+                codecOperationCounts[operationCodec]++;
+            }
+        } else {
+            codecOperationCounts[0] = config.operations.size();
+        }
+
+        InterfaceLogger::logMessage("CAN Connector: Routed " + std::to_string(routeCount) + " CAN IDs to " +
+                                    std::to_string(codecs.size()) + " codecs, " + std::to_string(autoMaskCount) +
+                                    " receive masks created by the codecs", LOG_LEVEL::INFO);
+        for (size_t index = 0; index < codecs.size(); index++) {
+            InterfaceLogger::logMessage("CAN Connector: The codec <" + codecNames[index] + "> decodes " +
+                                        std::to_string(codecRouteCounts[index]) + " CAN IDs and encodes " +
+                                        std::to_string(codecOperationCounts[index]) + " operations",
+                                        LOG_LEVEL::INFO);
+        }
+    }
+
+    void CANConnector::createContainers() {
+
+        containerOf.assign(sendOperations.size(), -1);
+
+        for (size_t handle = 0; handle < sendOperations.size(); handle++) {
+            const CANConnectorSendOperation &sendOperation = sendOperations[handle];
+            if (sendOperation.container.empty()) {
+                continue;
+            }
+
+            // The container has to be a single CANFD frame that is sent once per container
+            auto container = std::find(sendOperationNames.begin(), sendOperationNames.end(), sendOperation.container);
+            size_t containerHandle = container - sendOperationNames.begin();
+            std::string error;
+            if (container == sendOperationNames.end()) {
+                error = "Unknown container <" + sendOperation.container + ">";
+            } else if (!sendOperations[containerHandle].isCANFD || sendOperations[containerHandle].isCyclic ||
+                       sendOperations[containerHandle].nframes != 1 ||
+                       !sendOperations[containerHandle].container.empty()) {
+                error = "The container <" + sendOperation.container + "> is not a single CANFD frame sent once";
+            } else if (sendOperation.isCyclic) {
+                error = "A cyclic send operation can not be packed into the container <" + sendOperation.container +
+                        ">";
+            } else if (sendOperation.canID == 0 || sendOperation.canID > CONTAINER_MAX_HEADER_ID) {
+                error = "The CAN ID " + convertCanIdToHex(sendOperation.canID) + " is no valid header ID";
+            }
+
+            if (!error.empty()) {
+                InterfaceLogger::logMessage("CAN Connector: " + error + " of the send operation <" +
+                                            sendOperationNames[handle] + ">", LOG_LEVEL::ERROR);
+                throw std::invalid_argument("CAN Connector: " + error + " of the send operation <" +
+                                            sendOperationNames[handle] + ">");
+            }
+
+            if (!containerPacker) {
+                containerPacker = std::make_unique<CANContainerPacker>(
+                        *ioContext, std::chrono::microseconds(config.containerTimeout),
+                        [this](size_t index, struct canfd_frame &frame) { sendContainerFrame(index, frame); });
+            }
+
+            // Each container send operation has one container of the packer
+            auto index = std::find(containerOperations.begin(), containerOperations.end(), containerHandle);
+            if (index == containerOperations.end()) {
+                containerPacker->addContainer(sendOperations[containerHandle].canID, sendOperation.container);
+                containerOperations.push_back(containerHandle);
+                index = containerOperations.end() - 1;
+            }
+            containerOf[handle] = static_cast<int32_t>(index - containerOperations.begin());
+        }
+
+        if (containerPacker) {
+            InterfaceLogger::logMessage("CAN Connector: Created " + std::to_string(containerOperations.size()) +
+                                        " containers", LOG_LEVEL::INFO);
+        }
+    }
+
+    void CANConnector::sendContainerFrame(size_t container, struct canfd_frame &frame) {
+
+        // Every container is a new transmission with the next E2E counter
+        int handle = static_cast<int>(containerOperations[container]);
+        protectFrames(handle, &frame, 1);
+
+        // The container is sent on the interface of its own send operation
+        CANChannel &channel = *channels[sendChannels[handle]];
+
+        if (isRawBackend) {
+            txSendRawFrame(channel, frame, true);
+        } else {
+            txSendSingleFrame(channel, frame, true);
+        }
+    }
+
+    void CANConnector::handleContainerFrame(CANChannel &channel, const struct canfd_frame &container) {
+
+        SimulationSink sink(*this);
+        bool isWellFormed = CANContainerPacker::unpack(container, [this, &channel, &sink](const struct canfd_frame &pdu) {
+
+            // The header ID is routed like a CAN ID
+            const CANRoute *route = channel.routes.find(pdu.can_id);
+            if (route == nullptr || route->isContainer) {
+                InterfaceLogger::logMessage("CAN Connector: No codec for the contained header ID: " +
+                                            convertCanIdToHex(pdu.can_id), LOG_LEVEL::WARNING);
+                return;
+            }
+
+            if (passesE2ECheck(pdu, *route)) {
+                codecs[route->codec]->decode(pdu, true, sink);
+            }
+        });
+
+        if (!isWellFormed) {
+            InterfaceLogger::logMessage("CAN Connector: Received a malformed container with the CAN ID: " +
+                                        convertCanIdToHex(container.can_id), LOG_LEVEL::WARNING);
+        }
+    }
+
     void CANConnector::startProcessing() {
 
-        // Run the io context in its own thread
-        ioContextThread = std::thread(&CANConnector::ioContextThreadFunction, this, std::ref(ioContext));
+        // Run the io context in its own thread(s) configured by the executor
+        ioContextThreads = Executor::createThreadGroup(CAN_ROLE, "can-" + config.interfaceName, [this]() {
+            ioContextThreadFunction(ioContext);
+        });
 
         InterfaceLogger::logMessage("CAN Connector: Starting the io context loop", LOG_LEVEL::INFO);
     }
@@ -155,11 +704,13 @@ namespace sim_interface::dut_connector::can {
             ioContext->stop();
         }
 
-        // Join the io context loop thread
-        if (ioContextThread.joinable()) {
-            ioContextThread.join();
-        } else {
-            InterfaceLogger::logMessage("CAN Connector: ioContextThread was not joinable", LOG_LEVEL::ERROR);
+        // Join the io context loop threads
+        for (auto &ioContextThread: ioContextThreads) {
+            if (ioContextThread.joinable()) {
+                ioContextThread.join();
+            } else {
+                InterfaceLogger::logMessage("CAN Connector: ioContextThread was not joinable", LOG_LEVEL::ERROR);
+            }
         }
 
         InterfaceLogger::logMessage("CAN Connector: Stopped the io context loop", LOG_LEVEL::INFO);
@@ -179,13 +730,13 @@ namespace sim_interface::dut_connector::can {
         return info;
     }
 
-    void CANConnector::receiveOnSocket() {
+    void CANConnector::receiveOnSocket(CANChannel &channel) {
 
         InterfaceLogger::logMessage("CAN Connector: Creating a new receive operation on the socket", LOG_LEVEL::INFO);
 
         // Create an async receive operation on the BCM socket
-        bcmSocket.async_receive(boost::asio::buffer(rxBuffer),
-                                [this](boost::system::error_code errorCode, std::size_t receivedBytes) {
+        channel.bcmSocket.async_receive(boost::asio::buffer(channel.rxBuffer),
+                                [this, &channel](boost::system::error_code errorCode, std::size_t receivedBytes) {
 
                                     // Lambda completion function for the async receive operation
 
@@ -200,7 +751,7 @@ namespace sim_interface::dut_connector::can {
                                         if (receivedBytes >= sizeof(bcm_msg_head)) {
 
                                             // Get the bcm_msg_head
-                                            const auto *head = reinterpret_cast<const bcm_msg_head *>(rxBuffer.data());
+                                            const auto *head = reinterpret_cast<const bcm_msg_head *>(channel.rxBuffer.data());
 
                                             // Check if the message contains CAN or CANFD frames
                                             bool isCANFD = false;
@@ -222,8 +773,9 @@ namespace sim_interface::dut_connector::can {
                                             if (receivedBytes == expectedBytes) {
 
                                                 // Get the pointer to the frames and call the next function to process the data
-                                                auto frames = reinterpret_cast<void *>(rxBuffer.data() + sizeof(bcm_msg_head));
-                                                handleReceivedData(head, frames, head->nframes, isCANFD);
+                                                auto frames = reinterpret_cast<void *>(channel.rxBuffer.data() + sizeof(bcm_msg_head));
+                                                channel.receivedFrames.fetch_add(head->nframes, std::memory_order_relaxed);
+                                                handleReceivedData(channel, head, frames, head->nframes, isCANFD);
 
                                             } else {
                                                 InterfaceLogger::logMessage(
@@ -240,39 +792,170 @@ namespace sim_interface::dut_connector::can {
                                     }
 
                                     // Create the next receive operation
-                                    receiveOnSocket();
+                                    receiveOnSocket(channel);
 
                                 });
 
     }
 
-    void CANConnector::txSendSingleFrame(struct canfd_frame frame, bool isCANFD) {
+    BcmMessageBuffer *CANConnector::createBcmMessage(size_t size, const char *description) {
+        return bcmSlab.acquire(size, description);
+    }
 
-        // BCM message we are sending with a single CAN or CANFD frame
-        std::shared_ptr<void> msg = nullptr;
-        size_t msgSize = 0;
+    void CANConnector::submitBcmMessage(CANChannel &channel, BcmMessageBuffer *buffer) {
+        buffer->socketHandle = channel.bcmSocket.native_handle();
+        channel.sentMessages.fetch_add(1, std::memory_order_relaxed);
+        enqueueMessage(buffer);
+    }
 
-        // Check if we are sending CAN or CANFD frames
-        // and create the according struct
-        if (isCANFD) {
-            msgSize = sizeof(struct bcmMsgSingleFrameCanFD);
-            auto msgCANFD = std::make_shared<bcmMsgSingleFrameCanFD>();
-            msg = std::reinterpret_pointer_cast<void>(msgCANFD);
-        } else {
-            msgSize = sizeof(struct bcmMsgSingleFrameCan);
-            auto msgCAN = std::make_shared<bcmMsgSingleFrameCan>();
-            msg = std::reinterpret_pointer_cast<void>(msgCAN);
+    void CANConnector::enqueueMessage(BcmMessageBuffer *buffer) {
+
+        // Push the message onto the pending list (lock-free, multiple producers)
+        BcmMessageBuffer *head = pendingHead.load(std::memory_order_relaxed);
+        do {
+            buffer->nextPending = head;
+        } while (!pendingHead.compare_exchange_weak(head, buffer, std::memory_order_release,
+                                                    std::memory_order_relaxed));
+
+        // Schedule a flush on the io context if there is none scheduled yet. All messages
+        // submitted until the flush runs are sent together with a single sendmmsg call.
+        if (!flushScheduled.exchange(true, std::memory_order_acq_rel)) {
+            boost::asio::post(*ioContext, [this]() {
+                flushBcmMessages();
+            });
         }
 
-        // Error handling / Sanity check
-        if (msg == nullptr) {
-            InterfaceLogger::logMessage("CAN Connector: Could not make the message structure", LOG_LEVEL::ERROR);
-            return;
+    }
+
+    void CANConnector::flushBcmMessages() {
+
+        // Note: Only one flush is running at any time (guarded by flushScheduled),
+        // this keeps the order of the submitted messages.
+        do {
+
+            // Take all pending messages if the previous batch was sent completely
+            if (flushBatch.empty()) {
+                BcmMessageBuffer *head = pendingHead.exchange(nullptr, std::memory_order_acquire);
+                for (; head != nullptr; head = head->nextPending) {
+                    flushBatch.push_back(head);
+                }
+
+                // The pending list is a stack, restore the submission order
+                std::reverse(flushBatch.begin(), flushBatch.end());
+                flushOffset = 0;
+            }
+
+            // Stop here if the socket is busy, the flush continues once it is writable again
+            if (!sendFlushBatch()) {
+                return;
+            }
+
+            flushScheduled.store(false, std::memory_order_release);
+
+            // Continue if messages were submitted while we were sending and no other flush was scheduled
+        } while (pendingHead.load(std::memory_order_acquire) != nullptr &&
+                 !flushScheduled.exchange(true, std::memory_order_acq_rel));
+
+    }
+
+    bool CANConnector::sendFlushBatch() {
+
+        while (flushOffset < flushBatch.size()) {
+
+            // Fill out the message headers for the next part of the batch.
+            // A batch ends at the first message for another socket to keep the order.
+            int socketHandle = flushBatch[flushOffset]->socketHandle;
+            size_t nmsgs = 0;
+            for (size_t index = 0; index < BCM_BATCH_SIZE && flushOffset + index < flushBatch.size(); index++) {
+                BcmMessageBuffer *buffer = flushBatch[flushOffset + index];
+                if (buffer->socketHandle != socketHandle) {
+                    break;
+                }
+                nmsgs++;
+                batchIovecs[index].iov_base = buffer->data();
+                batchIovecs[index].iov_len = buffer->size();
+                batchHeaders[index] = {};
+                batchHeaders[index].msg_hdr.msg_iov = &batchIovecs[index];
+                batchHeaders[index].msg_hdr.msg_iovlen = 1;
+            }
+
+            // Send all messages with one system call. The sockets are connected/bound, so no address is needed.
+            int sent = sendmmsg(socketHandle, batchHeaders.data(), nmsgs, MSG_DONTWAIT);
+            sendCalls.fetch_add(1, std::memory_order_relaxed);
+
+            if (sent < 0) {
+
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    // Wait until the socket is writable and continue the flush
+                    auto continueFlush = [this](boost::system::error_code errorCode) {
+                        if (!errorCode) {
+                            flushBcmMessages();
+                        }
+                    };
+                    for (auto &channel: channels) {
+                        if (channel->rawSocket && socketHandle == channel->rawSocket->native_handle()) {
+                            channel->rawSocket->async_wait(boost::asio::socket_base::wait_write, continueFlush);
+                            break;
+                        } else if (socketHandle == channel->bcmSocket.native_handle()) {
+                            channel->bcmSocket.async_wait(boost::asio::socket_base::wait_write, continueFlush);
+                            break;
+                        }
+                    }
+                    return false;
+                }
+
+                // The first message of the batch failed, drop it and continue with the next one
+                BcmMessageBuffer *buffer = flushBatch[flushOffset];
+                InterfaceLogger::logMessage(std::string("CAN Connector: ") + buffer->description + " failed: " +
+                                            std::strerror(errno), LOG_LEVEL::ERROR);
+                bcmSlab.release(buffer);
+                flushOffset++;
+                continue;
+            }
+
+            for (int index = 0; index < sent; index++) {
+                BcmMessageBuffer *buffer = flushBatch[flushOffset + index];
+                InterfaceLogger::logMessage(std::string("CAN Connector: ") + buffer->description +
+                                            " completed successfully", LOG_LEVEL::DEBUG);
+                bcmSlab.release(buffer);
+            }
+
+            sentMessages.fetch_add(sent, std::memory_order_relaxed);
+            flushOffset += sent;
         }
 
-        // Fill out the message
+        flushBatch.clear();
+        flushOffset = 0;
+
+        return true;
+    }
+
+    void CANConnector::releasePendingBcmMessages() {
+
+        for (size_t index = flushOffset; index < flushBatch.size(); index++) {
+            bcmSlab.release(flushBatch[index]);
+        }
+        flushBatch.clear();
+        flushOffset = 0;
+
+        BcmMessageBuffer *head = pendingHead.exchange(nullptr, std::memory_order_acquire);
+        while (head != nullptr) {
+            BcmMessageBuffer *next = head->nextPending;
+            bcmSlab.release(head);
+            head = next;
+        }
+
+    }
+
+    void CANConnector::txSendSingleFrame(CANChannel &channel, struct canfd_frame frame, bool isCANFD) {
+
+        // BCM message we are sending with a single CAN or CANFD frame
+        BcmMessageBuffer *msg = nullptr;
+
+        // Check if we are sending CAN or CANFD frames and fill out the according struct
         if (isCANFD) {
-            std::shared_ptr<bcmMsgSingleFrameCanFD> msgCANFD = std::reinterpret_pointer_cast<bcmMsgSingleFrameCanFD>(msg);
+            msg = createBcmMessage(sizeof(struct bcmMsgSingleFrameCanFD), "TX_SEND");
+            auto msgCANFD = msg->as<bcmMsgSingleFrameCanFD>();
 
             msgCANFD->msg_head.opcode = TX_SEND;
             msgCANFD->msg_head.flags = CAN_FD_FRAME;
@@ -280,7 +963,8 @@ namespace sim_interface::dut_connector::can {
             msgCANFD->msg_head.nframes = 1;
             msgCANFD->canfdFrame[0] = frame;
         } else {
-            std::shared_ptr<bcmMsgSingleFrameCan> msgCAN = std::reinterpret_pointer_cast<bcmMsgSingleFrameCan>(msg);
+            msg = createBcmMessage(sizeof(struct bcmMsgSingleFrameCan), "TX_SEND");
+            auto msgCAN = msg->as<bcmMsgSingleFrameCan>();
             auto canFrame = (struct can_frame *) &frame;
 
             msgCAN->msg_head.opcode = TX_SEND;
@@ -290,71 +974,61 @@ namespace sim_interface::dut_connector::can {
         }
 
         InterfaceLogger::logMessage("CAN Connector: TX_SEND created for the CAN ID: " + convertCanIdToHex(frame.can_id),
-                                    LOG_LEVEL::INFO);
-
-        // Note: buffer doesn't accept smart pointers. Need to use a regular pointer.
-        boost::asio::const_buffer buffer = boost::asio::buffer(msg.get(), msgSize);
+                                    LOG_LEVEL::DEBUG);
 
-        // Note: Must guarantee the validity of the argument until the handler is invoked.
-        // We guarantee the validity through the lambda capture of the smart pointer.
+        // The send waits for its echo from here on, so the latency includes the time until the flush
+        if (channel.txMonitor) {
+            channel.txMonitor->recordSend(frame.can_id);
+        }
 
         // Note: The TX_SEND operation can only handle exactly one frame!
-        bcmSocket.async_send(buffer, [msg](boost::system::error_code errorCode, std::size_t size) {
+        submitBcmMessage(channel, msg);
 
-            // Lambda completion function for the async TX_SEND operation
+    }
 
-            // Check boost asio error code
-            if (!errorCode) {
-                InterfaceLogger::logMessage("CAN Connector: TX_SEND completed successfully", LOG_LEVEL::INFO);
-            } else {
-                InterfaceLogger::logMessage("CAN Connector: TX_SEND failed: " + errorCode.message(), LOG_LEVEL::ERROR);
-            }
+    void CANConnector::txSendRawFrame(CANChannel &channel, struct canfd_frame frame, bool isCANFD) {
 
-        });
+        // The CAN_RAW socket expects exactly one CAN_MTU or CANFD_MTU sized frame per message
+        BcmMessageBuffer *msg = createBcmMessage(isCANFD ? CANFD_MTU : CAN_MTU, "CAN_RAW send");
+        std::memcpy(msg->data(), &frame, msg->size());
+        msg->socketHandle = channel.rawSocket->native_handle();
+        channel.sentMessages.fetch_add(1, std::memory_order_relaxed);
+
+        InterfaceLogger::logMessage("CAN Connector: CAN_RAW send created for the CAN ID: " +
+                                    convertCanIdToHex(frame.can_id), LOG_LEVEL::DEBUG);
+
+        if (channel.txMonitor) {
+            channel.txMonitor->recordSend(frame.can_id);
+        }
+
+        enqueueMessage(msg);
 
     }
 
-    void CANConnector::txSendMultipleFrames(struct canfd_frame frames[], int nframes, bool isCANFD) {
+    void CANConnector::txSendMultipleFrames(CANChannel &channel, struct canfd_frame frames[], int nframes,
+                                            bool isCANFD) {
 
         // Note: The TX_SEND operation can only handle exactly one frame!
         // That's why we should use this wrapper for multiple frames.
         for (int index = 0; index < nframes; index++) {
-            txSendSingleFrame(frames[index], isCANFD);
+            txSendSingleFrame(channel, frames[index], isCANFD);
         }
 
     }
 
-    void CANConnector::txSetupSingleFrame(struct canfd_frame frame, uint32_t count, struct bcm_timeval ival1,
-                                          struct bcm_timeval ival2, bool isCANFD) {
+    void CANConnector::txSetupSingleFrame(CANChannel &channel, struct canfd_frame frame, uint32_t count,
+                                          struct bcm_timeval ival1, struct bcm_timeval ival2, bool isCANFD) {
 
         // BCM message we are sending with a single CAN or CANFD frame
-        std::shared_ptr<void> msg = nullptr;
-        size_t msgSize = 0;
-
-        // Check if we are sending CAN or CANFD frames
-        // and create the according struct
-        if (isCANFD) {
-            msgSize = sizeof(struct bcmMsgSingleFrameCanFD);
-            auto msgCANFD = std::make_shared<bcmMsgSingleFrameCanFD>();
-            msg = std::reinterpret_pointer_cast<void>(msgCANFD);
-        } else {
-            msgSize = sizeof(struct bcmMsgSingleFrameCan);
-            auto msgCAN = std::make_shared<bcmMsgSingleFrameCan>();
-            msg = std::reinterpret_pointer_cast<void>(msgCAN);
-        }
-
-        // Error handling / Sanity check
-        if (msg == nullptr) {
-            InterfaceLogger::logMessage("CAN Connector: Could not make the message structure", LOG_LEVEL::ERROR);
-            return;
-        }
+        BcmMessageBuffer *msg = nullptr;
 
         // Note: By combining the flags SETTIMER and STARTTIMER
         // the BCM will start sending the messages immediately
 
-        // Fill out the message
+        // Check if we are sending CAN or CANFD frames and fill out the according struct
         if (isCANFD) {
-            std::shared_ptr<bcmMsgSingleFrameCanFD> msgCANFD = std::reinterpret_pointer_cast<bcmMsgSingleFrameCanFD>(msg);
+            msg = createBcmMessage(sizeof(struct bcmMsgSingleFrameCanFD), "TX_SETUP");
+            auto msgCANFD = msg->as<bcmMsgSingleFrameCanFD>();
 
             msgCANFD->msg_head.opcode = TX_SETUP;
             msgCANFD->msg_head.flags = CAN_FD_FRAME | SETTIMER | STARTTIMER;
@@ -365,7 +1039,8 @@ namespace sim_interface::dut_connector::can {
             msgCANFD->msg_head.nframes = 1;
             msgCANFD->canfdFrame[0] = frame;
         } else {
-            std::shared_ptr<bcmMsgSingleFrameCan> msgCAN = std::reinterpret_pointer_cast<bcmMsgSingleFrameCan>(msg);
+            msg = createBcmMessage(sizeof(struct bcmMsgSingleFrameCan), "TX_SETUP");
+            auto msgCAN = msg->as<bcmMsgSingleFrameCan>();
             auto canFrame = (struct can_frame *) &frame;
 
             msgCAN->msg_head.opcode = TX_SETUP;
@@ -379,67 +1054,39 @@ namespace sim_interface::dut_connector::can {
         }
 
         InterfaceLogger::logMessage(
-                "CAN Connector: TX_SETUP created for the CAN ID: " + convertCanIdToHex(frame.can_id), LOG_LEVEL::INFO);
-
-        // Note: buffer doesn't accept smart pointers. Need to use a regular pointer.
-        boost::asio::const_buffer buffer = boost::asio::buffer(msg.get(), msgSize);
-
-        bcmSocket.async_send(buffer, [msg](boost::system::error_code errorCode, std::size_t size) {
-
-            // Lambda completion function for the async TX_SETUP operation
-
-            // Check boost asio error code
-            if (!errorCode) {
-                InterfaceLogger::logMessage("CAN Connector: TX_SETUP completed successfully", LOG_LEVEL::INFO);
-            } else {
-                InterfaceLogger::logMessage("CAN Connector: TX_SETUP failed: " + errorCode.message(), LOG_LEVEL::ERROR);
-            }
+                "CAN Connector: TX_SETUP created for the CAN ID: " + convertCanIdToHex(frame.can_id), LOG_LEVEL::DEBUG);
 
-        });
+        submitBcmMessage(channel, msg);
 
     }
 
-    void CANConnector::txSetupMultipleFrames(struct canfd_frame frames[], int nframes, uint32_t count[],
-                                             struct bcm_timeval ival1[],
+    void CANConnector::txSetupMultipleFrames(CANChannel &channel, struct canfd_frame frames[], int nframes,
+                                             uint32_t count[], struct bcm_timeval ival1[],
                                              struct bcm_timeval ival2[], bool isCANFD) {
 
         for (int index = 0; index < nframes; index++) {
-            txSetupSingleFrame(frames[index], count[index], ival1[index], ival2[index], isCANFD);
+            txSetupSingleFrame(channel, frames[index], count[index], ival1[index], ival2[index], isCANFD);
         }
 
     }
 
-    void CANConnector::txSetupSequence(struct canfd_frame frames[], int nframes, uint32_t count,
+    void CANConnector::txSetupSequence(CANChannel &channel, struct canfd_frame frames[], int nframes, uint32_t count,
                                        struct bcm_timeval ival1, struct bcm_timeval ival2, bool isCANFD) {
 
-        // BCM message we are sending with a single CAN or CANFD frame
-        std::shared_ptr<void> msg = nullptr;
-        size_t msgSize = 0;
-
-        // Check if we are sending CAN or CANFD frames
-        // and create the according struct
-        if (isCANFD) {
-            msgSize = sizeof(struct bcmMsgMultipleFramesCanFD);
-            auto msgCANFD = std::make_shared<bcmMsgMultipleFramesCanFD>();
-            msg = std::reinterpret_pointer_cast<void>(msgCANFD);
-        } else {
-            msgSize = sizeof(struct bcmMsgMultipleFramesCan);
-            auto msgCAN = std::make_shared<bcmMsgMultipleFramesCan>();
-            msg = std::reinterpret_pointer_cast<void>(msgCAN);
-        }
-
-        // Error handling / Sanity check
-        if (msg == nullptr) {
-            InterfaceLogger::logMessage("CAN Connector: Could not make the message structure", LOG_LEVEL::ERROR);
-            return;
-        }
+        // BCM message we are sending with multiple CAN or CANFD frames
+        BcmMessageBuffer *msg = nullptr;
 
         // Note: By combining the flags SETTIMER and STARTTIMER
         // the BCM will start sending the messages immediately
 
-        // Fill out the message
+        // Note: Only the used frames are part of the message, the BCM uses
+        // nframes in the bcm_msg_head to check the size of the message.
+
+        // Check if we are sending CAN or CANFD frames and fill out the according struct
         if (isCANFD) {
-            std::shared_ptr<bcmMsgMultipleFramesCanFD> msgCANFD = std::reinterpret_pointer_cast<bcmMsgMultipleFramesCanFD>(msg);
+            msg = createBcmMessage(sizeof(struct bcm_msg_head) + sizeof(struct canfd_frame) * nframes,
+                                   "TX_SETUP (sequence)");
+            auto msgCANFD = msg->as<bcmMsgMultipleFramesCanFD>();
 
             msgCANFD->msg_head.opcode = TX_SETUP;
             msgCANFD->msg_head.flags = CAN_FD_FRAME | SETTIMER | STARTTIMER;
@@ -452,7 +1099,9 @@ namespace sim_interface::dut_connector::can {
             size_t arrSize = sizeof(struct canfd_frame) * nframes;
             std::memcpy(msgCANFD->canfdFrames, frames, arrSize);
         } else {
-            std::shared_ptr<bcmMsgMultipleFramesCan> msgCAN = std::reinterpret_pointer_cast<bcmMsgMultipleFramesCan>(msg);
+            msg = createBcmMessage(sizeof(struct bcm_msg_head) + sizeof(struct can_frame) * nframes,
+                                   "TX_SETUP (sequence)");
+            auto msgCAN = msg->as<bcmMsgMultipleFramesCan>();
             auto firstCanFrame = (struct can_frame *) &frames[0];
 
             msgCAN->msg_head.opcode = TX_SETUP;
@@ -471,56 +1120,22 @@ namespace sim_interface::dut_connector::can {
 
         InterfaceLogger::logMessage(
                 "CAN Connector: TX_SETUP (sequence) created for the CAN ID: " + convertCanIdToHex(frames[0].can_id),
-                LOG_LEVEL::INFO);
-
-        // Note: buffer doesn't accept smart pointers. Need to use a regular pointer.
-        boost::asio::const_buffer buffer = boost::asio::buffer(msg.get(), msgSize);
-
-        bcmSocket.async_send(buffer, [msg](boost::system::error_code errorCode, std::size_t size) {
-
-            // Lambda completion function for the async TX_SETUP operation
+                LOG_LEVEL::DEBUG);
 
-            // Check boost asio error code
-            if (!errorCode) {
-                InterfaceLogger::logMessage("CAN Connector: TX_SETUP (sequence) completed successfully",
-                                            LOG_LEVEL::INFO);
-            } else {
-                InterfaceLogger::logMessage("CAN Connector: TX_SETUP (sequence) failed: " + errorCode.message(),
-                                            LOG_LEVEL::ERROR);
-            }
-
-        });
+        submitBcmMessage(channel, msg);
 
     }
 
-    void CANConnector::txSetupUpdateSingleFrame(struct canfd_frame frame, bool isCANFD, bool announce) {
+    void CANConnector::txSetupUpdateSingleFrame(CANChannel &channel, struct canfd_frame frame, bool isCANFD,
+                                                bool announce) {
 
         // BCM message we are sending with a single CAN or CANFD frame
-        std::shared_ptr<void> msg = nullptr;
-        size_t msgSize = 0;
-
-        // Check if we are sending CAN or CANFD frames
-        // and create the according struct
-        if (isCANFD) {
-            msgSize = sizeof(struct bcmMsgSingleFrameCanFD);
-            auto msgCANFD = std::make_shared<bcmMsgSingleFrameCanFD>();
-            msg = std::reinterpret_pointer_cast<void>(msgCANFD);
-        } else {
-            msgSize = sizeof(struct bcmMsgSingleFrameCan);
-            auto msgCAN = std::make_shared<bcmMsgSingleFrameCan>();
-            msg = std::reinterpret_pointer_cast<void>(msgCAN);
-        }
+        BcmMessageBuffer *msg = nullptr;
 
-        // Error handling / Sanity check
-        if (msg == nullptr) {
-            InterfaceLogger::logMessage("CAN Connector: Could not make the message structure", LOG_LEVEL::ERROR);
-            return;
-        }
-
-        // Fill out the message
-        // Note: By combining the flags SETTIMER and STARTTIMER the BCM will start sending the messages immediately
+        // Check if we are sending CAN or CANFD frames and fill out the according struct
         if (isCANFD) {
-            std::shared_ptr<bcmMsgSingleFrameCanFD> msgCANFD = std::reinterpret_pointer_cast<bcmMsgSingleFrameCanFD>(msg);
+            msg = createBcmMessage(sizeof(struct bcmMsgSingleFrameCanFD), "TX_SETUP (update)");
+            auto msgCANFD = msg->as<bcmMsgSingleFrameCanFD>();
 
             msgCANFD->msg_head.opcode = TX_SETUP;
             msgCANFD->msg_head.flags = CAN_FD_FRAME;
@@ -533,7 +1148,8 @@ namespace sim_interface::dut_connector::can {
             }
 
         } else {
-            std::shared_ptr<bcmMsgSingleFrameCan> msgCAN = std::reinterpret_pointer_cast<bcmMsgSingleFrameCan>(msg);
+            msg = createBcmMessage(sizeof(struct bcmMsgSingleFrameCan), "TX_SETUP (update)");
+            auto msgCAN = msg->as<bcmMsgSingleFrameCan>();
             auto canFrame = (struct can_frame *) &frame;
 
             msgCAN->msg_head.opcode = TX_SETUP;
@@ -549,147 +1165,141 @@ namespace sim_interface::dut_connector::can {
 
         InterfaceLogger::logMessage(
                 "CAN Connector: TX_SETUP (update) created for the CAN ID: " + convertCanIdToHex(frame.can_id),
-                LOG_LEVEL::INFO);
-
-        // Note: buffer doesn't accept smart pointers. Need to use a regular pointer.
-        boost::asio::const_buffer buffer = boost::asio::buffer(msg.get(), msgSize);
-
-        bcmSocket.async_send(buffer, [msg](boost::system::error_code errorCode, std::size_t size) {
-
-            // Lambda completion function for the async TX_SETUP operation
-
-            // Check boost asio error code
-            if (!errorCode) {
-                InterfaceLogger::logMessage("CAN Connector: TX_SETUP (update) completed successfully", LOG_LEVEL::INFO);
-            } else {
-                InterfaceLogger::logMessage("CAN Connector: TX_SETUP (update) failed: " + errorCode.message(),
-                                            LOG_LEVEL::ERROR);
-            }
+                LOG_LEVEL::DEBUG);
 
-        });
+        submitBcmMessage(channel, msg);
 
     }
 
     void
-    CANConnector::txSetupUpdateMultipleFrames(struct canfd_frame frames[], int nframes, bool isCANFD, bool announce) {
+    CANConnector::txSetupUpdateMultipleFrames(CANChannel &channel, struct canfd_frame frames[], int nframes,
+                                              bool isCANFD, bool announce) {
 
         for (int index = 0; index < nframes; index++) {
-            txSetupUpdateSingleFrame(frames[index], isCANFD, announce);
+            txSetupUpdateSingleFrame(channel, frames[index], isCANFD, announce);
         }
 
     }
 
-    void CANConnector::txDelete(canid_t canID, bool isCANFD) {
+    void CANConnector::txSetupUpdateSequence(CANChannel &channel, struct canfd_frame frames[], int nframes,
+                                             bool isCANFD, bool announce) {
 
-        // BCM message we are sending
-        auto msg = std::make_shared<bcm_msg_head>();
+        // BCM message we are sending with multiple CAN or CANFD frames
+        BcmMessageBuffer *msg = nullptr;
 
-        // Error handling / Sanity check
-        if (msg == nullptr) {
-            InterfaceLogger::logMessage("CAN Connector: Could not make the message structure", LOG_LEVEL::ERROR);
-            return;
-        }
-
-        // Fill out the message
-        msg->opcode = TX_DELETE;
-        msg->can_id = canID;
+        // Note: Without SETTIMER and STARTTIMER the BCM only replaces the frames of the
+        // sequence and keeps the running cycle. The sequence is identified by the CAN ID
+        // of the first frame, like in txSetupSequence.
 
+        // Check if we are sending CAN or CANFD frames and fill out the according struct
         if (isCANFD) {
-            msg->flags = CAN_FD_FRAME;
-        }
+            msg = createBcmMessage(sizeof(struct bcm_msg_head) + sizeof(struct canfd_frame) * nframes,
+                                   "TX_SETUP (sequence update)");
+            auto msgCANFD = msg->as<bcmMsgMultipleFramesCanFD>();
 
-        InterfaceLogger::logMessage("CAN Connector: TX_DELETE created for the CAN ID: " + convertCanIdToHex(canID),
-                                    LOG_LEVEL::INFO);
+            msgCANFD->msg_head.opcode = TX_SETUP;
+            msgCANFD->msg_head.flags = CAN_FD_FRAME;
+            msgCANFD->msg_head.can_id = frames[0].can_id;
+            msgCANFD->msg_head.nframes = nframes;
 
-        // Note: buffer doesn't accept smart pointers. Need to use a regular pointer.
-        boost::asio::const_buffer buffer = boost::asio::buffer(msg.get(), sizeof(bcm_msg_head));
+            size_t arrSize = sizeof(struct canfd_frame) * nframes;
+            std::memcpy(msgCANFD->canfdFrames, frames, arrSize);
 
-        bcmSocket.async_send(buffer, [msg](boost::system::error_code errorCode, std::size_t size) {
+            if (announce) {
+                msgCANFD->msg_head.flags = msgCANFD->msg_head.flags | TX_ANNOUNCE;
+            }
 
-            // Lambda completion function for the async TX_DELETE operation
+        } else {
+            msg = createBcmMessage(sizeof(struct bcm_msg_head) + sizeof(struct can_frame) * nframes,
+                                   "TX_SETUP (sequence update)");
+            auto msgCAN = msg->as<bcmMsgMultipleFramesCan>();
+            auto firstCanFrame = (struct can_frame *) &frames[0];
 
-            // Check boost asio error code
-            if (!errorCode) {
-                InterfaceLogger::logMessage("CAN Connector: TX_DELETE completed successfully", LOG_LEVEL::INFO);
-            } else {
-                InterfaceLogger::logMessage("CAN Connector: TX_DELETE failed: " + errorCode.message(),
-                                            LOG_LEVEL::ERROR);
+            msgCAN->msg_head.opcode = TX_SETUP;
+            msgCAN->msg_head.can_id = firstCanFrame->can_id;
+            msgCAN->msg_head.nframes = nframes;
+
+            for (int index = 0; index < nframes; index++) {
+                auto canFrame = (struct can_frame *) &frames[index];
+                msgCAN->canFrames[index] = *canFrame;
             }
 
-        });
+            if (announce) {
+                msgCAN->msg_head.flags = TX_ANNOUNCE;
+            }
+
+        }
+
+        InterfaceLogger::logMessage(
+                "CAN Connector: TX_SETUP (sequence update) created for the CAN ID: " +
+                convertCanIdToHex(frames[0].can_id), LOG_LEVEL::DEBUG);
+
+        submitBcmMessage(channel, msg);
 
     }
 
-    void CANConnector::rxSetupCanID(canid_t canID, bool isCANFD) {
+    void CANConnector::txDelete(CANChannel &channel, canid_t canID, bool isCANFD) {
 
         // BCM message we are sending
-        auto msg = std::make_shared<bcm_msg_head>();
-
-        // Error handling / Sanity check
-        if (msg == nullptr) {
-            InterfaceLogger::logMessage("CAN Connector: Could not make the message structure", LOG_LEVEL::ERROR);
-            return;
-        }
+        BcmMessageBuffer *msg = createBcmMessage(sizeof(struct bcm_msg_head), "TX_DELETE");
+        auto head = msg->as<bcm_msg_head>();
 
         // Fill out the message
-        msg->opcode = RX_SETUP;
-        msg->flags = RX_FILTER_ID;
-        msg->can_id = canID;
+        head->opcode = TX_DELETE;
+        head->can_id = canID;
 
         if (isCANFD) {
-            msg->flags = msg->flags | CAN_FD_FRAME;
+            head->flags = CAN_FD_FRAME;
         }
 
-        InterfaceLogger::logMessage(
-                "CAN Connector: RX_SETUP (CAN ID) created for the CAN ID: " + convertCanIdToHex(canID),
-                LOG_LEVEL::INFO);
-
-        // Note: buffer doesn't accept smart pointers. Need to use a regular pointer.
-        boost::asio::const_buffer buffer = boost::asio::buffer(msg.get(), sizeof(bcm_msg_head));
-
-        bcmSocket.async_send(buffer, [msg](boost::system::error_code errorCode, std::size_t size) {
-
-            // Lambda completion function for the async RX_SETUP operation
-
-            // Check boost asio error code
-            if (!errorCode) {
-                InterfaceLogger::logMessage("CAN Connector: RX_SETUP (CAN ID) completed successfully", LOG_LEVEL::INFO);
-            } else {
-                InterfaceLogger::logMessage("CAN Connector: RX_SETUP (CAN ID) failed: " + errorCode.message(),
-                                            LOG_LEVEL::ERROR);
-            }
+        InterfaceLogger::logMessage("CAN Connector: TX_DELETE created for the CAN ID: " + convertCanIdToHex(canID),
+                                    LOG_LEVEL::DEBUG);
 
-        });
+        submitBcmMessage(channel, msg);
 
     }
 
-    void CANConnector::rxSetupMask(canid_t canID, struct canfd_frame mask, bool isCANFD) {
+    void CANConnector::rxSetupCanID(CANChannel &channel, canid_t canID, bool isCANFD, int timeout) {
 
-        // BCM message we are sending with a single CAN or CANFD frame
-        std::shared_ptr<void> msg = nullptr;
-        size_t msgSize = 0;
+        // BCM message we are sending
+        BcmMessageBuffer *msg = createBcmMessage(sizeof(struct bcm_msg_head), "RX_SETUP (CAN ID)");
+        auto head = msg->as<bcm_msg_head>();
+
+        // Fill out the message
+        head->opcode = RX_SETUP;
+        head->flags = RX_FILTER_ID;
+        head->can_id = canID;
 
-        // Check if we are sending CAN or CANFD frames
-        // and create the according struct
         if (isCANFD) {
-            msgSize = sizeof(struct bcmMsgSingleFrameCanFD);
-            auto msgCANFD = std::make_shared<bcmMsgSingleFrameCanFD>();
-            msg = std::reinterpret_pointer_cast<void>(msgCANFD);
-        } else {
-            msgSize = sizeof(struct bcmMsgSingleFrameCan);
-            auto msgCAN = std::make_shared<bcmMsgSingleFrameCan>();
-            msg = std::reinterpret_pointer_cast<void>(msgCAN);
+            head->flags = head->flags | CAN_FD_FRAME;
         }
 
-        // Error handling / Sanity check
-        if (msg == nullptr) {
-            InterfaceLogger::logMessage("CAN Connector: Could not make the message structure", LOG_LEVEL::ERROR);
-            return;
+        // The BCM sends RX_TIMEOUT if no frame was received within ival1
+        if (timeout > 0) {
+            head->flags = head->flags | SETTIMER | STARTTIMER;
+            head->ival1.tv_sec = timeout / 1000;
+            head->ival1.tv_usec = (timeout % 1000) * 1000;
         }
 
-        // Fill out the message
+        InterfaceLogger::logMessage(
+                "CAN Connector: RX_SETUP (CAN ID) created for the CAN ID: " + convertCanIdToHex(canID),
+                LOG_LEVEL::DEBUG);
+
+        submitBcmMessage(channel, msg);
+
+    }
+
+    void CANConnector::rxSetupMask(CANChannel &channel, canid_t canID, struct canfd_frame mask, bool isCANFD,
+                                   int timeout) {
+
+        // BCM message we are sending with a single CAN or CANFD frame
+        BcmMessageBuffer *msg = nullptr;
+        bcm_msg_head *head = nullptr;
+
+        // Check if we are sending CAN or CANFD frames and fill out the according struct
         if (isCANFD) {
-            std::shared_ptr<bcmMsgSingleFrameCanFD> msgCANFD = std::reinterpret_pointer_cast<bcmMsgSingleFrameCanFD>(msg);
+            msg = createBcmMessage(sizeof(struct bcmMsgSingleFrameCanFD), "RX_SETUP (mask)");
+            auto msgCANFD = msg->as<bcmMsgSingleFrameCanFD>();
 
             msgCANFD->msg_head.opcode = RX_SETUP;
             msgCANFD->msg_head.flags = CAN_FD_FRAME;
@@ -697,8 +1307,10 @@ namespace sim_interface::dut_connector::can {
             msgCANFD->msg_head.nframes = 1;
 
             msgCANFD->canfdFrame[0] = mask;
+            head = &msgCANFD->msg_head;
         } else {
-            std::shared_ptr<bcmMsgSingleFrameCan> msgCAN = std::reinterpret_pointer_cast<bcmMsgSingleFrameCan>(msg);
+            msg = createBcmMessage(sizeof(struct bcmMsgSingleFrameCan), "RX_SETUP (mask)");
+            auto msgCAN = msg->as<bcmMsgSingleFrameCan>();
             auto maskCAN = (struct can_frame *) &mask;
 
             msgCAN->msg_head.opcode = RX_SETUP;
@@ -706,71 +1318,47 @@ namespace sim_interface::dut_connector::can {
             msgCAN->msg_head.nframes = 1;
 
             msgCAN->canFrame[0] = *maskCAN;
+            head = &msgCAN->msg_head;
         }
 
-        InterfaceLogger::logMessage(
-                "CAN Connector: RX_SETUP (Mask) created for the CAN ID: " + convertCanIdToHex(canID), LOG_LEVEL::INFO);
-
-        // Note: buffer doesn't accept smart pointers. Need to use a regular pointer.
-        boost::asio::const_buffer buffer = boost::asio::buffer(msg.get(), msgSize);
-
-        bcmSocket.async_send(buffer, [msg](boost::system::error_code errorCode, std::size_t size) {
+        // The BCM sends RX_TIMEOUT if no frame was received within ival1. An unchanged frame after
+        // the timeout would not be reported because of the mask, so the resume is announced.
+        if (timeout > 0) {
+            head->flags = head->flags | SETTIMER | STARTTIMER | RX_ANNOUNCE_RESUME;
+            head->ival1.tv_sec = timeout / 1000;
+            head->ival1.tv_usec = (timeout % 1000) * 1000;
+        }
 
-            // Lambda completion function for the async RX_SETUP operation
+        InterfaceLogger::logMessage(
+                "CAN Connector: RX_SETUP (Mask) created for the CAN ID: " + convertCanIdToHex(canID), LOG_LEVEL::DEBUG);
 
-            // Check boost asio error code
-            if (!errorCode) {
-                InterfaceLogger::logMessage("CAN Connector: RX_SETUP (mask) completed successfully", LOG_LEVEL::INFO);
-            } else {
-                InterfaceLogger::logMessage("CAN Connector: RX_SETUP (mask) failed: " + errorCode.message(),
-                                            LOG_LEVEL::INFO);
-            }
+        submitBcmMessage(channel, msg);
 
-        });
     }
 
-    void CANConnector::rxDelete(canid_t canID, bool isCANFD) {
+    void CANConnector::rxDelete(CANChannel &channel, canid_t canID, bool isCANFD) {
 
         // BCM message we are sending
-        auto msg = std::make_shared<bcm_msg_head>();
-
-        // Error handling / Sanity check
-        if (msg == nullptr) {
-            InterfaceLogger::logMessage("CAN Connector: Could not make the message structure", LOG_LEVEL::ERROR);
-            return;
-        }
+        BcmMessageBuffer *msg = createBcmMessage(sizeof(struct bcm_msg_head), "RX_DELETE");
+        auto head = msg->as<bcm_msg_head>();
 
         // Fill out the message
-        msg->opcode = RX_DELETE;
-        msg->can_id = canID;
+        head->opcode = RX_DELETE;
+        head->can_id = canID;
 
         if (isCANFD) {
-            msg->flags = CAN_FD_FRAME;
+            head->flags = CAN_FD_FRAME;
         }
 
         InterfaceLogger::logMessage("CAN Connector: RX_DELETE created for the CAN ID: " + convertCanIdToHex(canID),
-                                    LOG_LEVEL::INFO);
-
-        // Note: buffer doesn't accept smart pointers. Need to use a regular pointer.
-        boost::asio::const_buffer buffer = boost::asio::buffer(msg.get(), sizeof(bcm_msg_head));
-
-        bcmSocket.async_send(buffer, [msg](boost::system::error_code errorCode, std::size_t size) {
-
-            // Lambda completion function for the async TX_DELETE operation
+                                    LOG_LEVEL::DEBUG);
 
-            // Check boost asio error code
-            if (!errorCode) {
-                InterfaceLogger::logMessage("CAN Connector: RX_DELETE completed successfully", LOG_LEVEL::INFO);
-            } else {
-                InterfaceLogger::logMessage("CAN Connector: RX_DELETE failed: " + errorCode.message(),
-                                            LOG_LEVEL::ERROR);
-            }
-
-        });
+        submitBcmMessage(channel, msg);
 
     }
 
-    void CANConnector::handleReceivedData(const bcm_msg_head *head, void *frames, uint32_t nframes, bool isCANFD) {
+    void CANConnector::handleReceivedData(CANChannel &channel, const bcm_msg_head *head, void *frames,
+                                          uint32_t nframes, bool isCANFD) {
 
         InterfaceLogger::logMessage("CAN Connector: Handling the received data", LOG_LEVEL::INFO);
 
@@ -790,15 +1378,13 @@ namespace sim_interface::dut_connector::can {
                     return;
                 }
 
-                CANConnector::handleRxChanged(head, frames, isCANFD);
+                handleRxChanged(channel, head, frames, isCANFD);
                 break;
 
             case RX_TIMEOUT:
 
                 // Cyclic message is detected to be absent by the timeout monitoring.
-                // There is no function implemented yet that should cause/use this.
-                InterfaceLogger::logMessage("CAN Connector: RX_TIMEOUT handling is not implemented",
-                                            LOG_LEVEL::WARNING);
+                handleRxTimeout(channel, head->can_id);
                 break;
 
             case TX_EXPIRED:
@@ -830,113 +1416,452 @@ namespace sim_interface::dut_connector::can {
 
     }
 
-    void CANConnector::handleRxChanged(const bcm_msg_head *head, void *frame, bool isCANFD) {
+    void CANConnector::handleRxChanged(CANChannel &channel, const bcm_msg_head *head, void *frame, bool isCANFD) {
 
-        // The simulation events we received
-        std::vector<SimEvent> events;
+        // The BCM of the CAN_RAW backend only monitors the timeouts, the frames are received on the CAN_RAW socket
+        if (isRawBackend) {
+            return;
+        }
 
-        // Note: We could also pass a reference instead of passing a copy of the received
-        // frame data in a struct can_fd. This way it may be a bit easier to end user that
-        // only wants to implement codec?
+        handleReceivedFrame(channel, frame, isCANFD);
+    }
 
-        // Check if it is a CAN or CANFD frame we need to fill out.
-        if (isCANFD) {
-            // Initialize the struct with zero
-            struct canfd_frame canfdFrame = {0};
+    void CANConnector::handleRxTimeout(CANChannel &channel, canid_t canID) {
 
-            // Copy the frame data
-            auto canfdFramePtr = (struct canfd_frame *) frame;
-            canfdFrame = *canfdFramePtr;
+        const CANRoute *route = channel.routes.find(canID);
+        if (route == nullptr || route->liveness < 0) {
+            InterfaceLogger::logMessage("CAN Connector: RX_TIMEOUT for the unmonitored CAN ID: " +
+                                        convertCanIdToHex(canID), LOG_LEVEL::WARNING);
+            return;
+        }
 
-            events = codec->convertFrameToSimEvent(canfdFrame, isCANFD);
-        } else {
-            // Initialize the struct with zero
-            struct canfd_frame canfdFrame = {0};
+        RxLiveness &liveness = *rxLiveness[route->liveness];
+        if (liveness.isTimedOut.exchange(true)) {
+            return;
+        }
 
-            // Copy the frame data
-            auto canFramePtr = (struct can_frame *) frame;
-            struct can_frame canFrame = *canFramePtr;
-            canfdFrame = *((struct canfd_frame *) &canFrame);
+        liveness.timeouts.fetch_add(1, std::memory_order_relaxed);
+        InterfaceLogger::logMessage("CAN Connector: The frames of the receive operation <" + liveness.operation +
+                                    "> on <" + liveness.interfaceName + "> timed out", LOG_LEVEL::WARNING);
 
-            events = codec->convertFrameToSimEvent(canfdFrame, isCANFD);
+        sendEventToSim(SimEvent(liveness.eventOperation, 1, "CanConnector"));
+    }
+
+    void CANConnector::checkRxRecovery(const CANRoute &route) {
+
+        if (route.liveness < 0) {
+            return;
+        }
+
+        RxLiveness &liveness = *rxLiveness[route.liveness];
+        if (!liveness.isTimedOut.load(std::memory_order_relaxed) || !liveness.isTimedOut.exchange(false)) {
+            return;
         }
 
+        liveness.recoveries.fetch_add(1, std::memory_order_relaxed);
+        InterfaceLogger::logMessage("CAN Connector: The frames of the receive operation <" + liveness.operation +
+                                    "> on <" + liveness.interfaceName + "> are received again", LOG_LEVEL::INFO);
+
+        sendEventToSim(SimEvent(liveness.eventOperation, 0, "CanConnector"));
+    }
+
+    void CANConnector::receiveOnRawSocket(CANChannel &channel) {
+
+        // Wait until frames are available, the frames are read with recvmmsg in the handler
+        channel.rawSocket->async_wait(boost::asio::socket_base::wait_read,
+                                      [this, &channel](boost::system::error_code errorCode) {
+
+            if (errorCode == boost::asio::error::operation_aborted) {
+                return;
+            }
+
+            if (!errorCode) {
+                readRawFrames(channel);
+            } else {
+                InterfaceLogger::logMessage(
+                        "CAN Connector: An error occurred on the CAN_RAW wait operation: " + errorCode.message(),
+                        LOG_LEVEL::ERROR);
+            }
+
+            // Create the next wait operation
+            receiveOnRawSocket(channel);
+        });
+
+    }
+
+    void CANConnector::readRawFrames(CANChannel &channel) {
+
+        int received = 0;
+
+        do {
+
+            // Prepare one receive buffer per message
+            for (size_t index = 0; index < RAW_RX_BATCH; index++) {
+                channel.rawRxIovecs[index].iov_base = &channel.rawRxFrames[index];
+                channel.rawRxIovecs[index].iov_len = sizeof(struct canfd_frame);
+                channel.rawRxHeaders[index] = {};
+                channel.rawRxHeaders[index].msg_hdr.msg_iov = &channel.rawRxIovecs[index];
+                channel.rawRxHeaders[index].msg_hdr.msg_iovlen = 1;
+            }
+
+            received = recvmmsg(channel.rawSocket->native_handle(), channel.rawRxHeaders.data(), RAW_RX_BATCH,
+                                MSG_DONTWAIT, nullptr);
+
+            if (received < 0) {
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    InterfaceLogger::logMessage("CAN Connector: An error occurred on recvmmsg: " +
+                                                std::string(std::strerror(errno)), LOG_LEVEL::ERROR);
+                }
+                return;
+            }
+
+            channel.receivedFrames.fetch_add(static_cast<uint64_t>(received), std::memory_order_relaxed);
+
+            // Move the frames that pass the content filter to the front of the buffer
+            bool isCANFD[RAW_RX_BATCH];
+            size_t accepted = 0;
+            for (int index = 0; index < received; index++) {
+
+                // The length tells us if we received a CAN or a CANFD frame
+                bool isFrameCANFD = false;
+                if (channel.rawRxHeaders[index].msg_len == CANFD_MTU) {
+                    isFrameCANFD = true;
+                } else if (channel.rawRxHeaders[index].msg_len != CAN_MTU) {
+                    InterfaceLogger::logMessage("CAN Connector: Received an incomplete frame on the CAN_RAW socket",
+                                                LOG_LEVEL::ERROR);
+                    continue;
+                } else {
+                    // The codec must not see the bytes after the CAN frame
+                    std::memset(channel.rawRxFrames[index].data + CAN_MAX_DLEN, 0, CANFD_MAX_DLEN - CAN_MAX_DLEN);
+                }
+
+                // The kernel filter only passes routed CAN IDs
+                const CANRoute *route = channel.routes.find(channel.rawRxFrames[index].can_id);
+
+                // Any frame ends a timeout, even one that fails the E2E check or has an unchanged content
+                if (route != nullptr) {
+                    checkRxRecovery(*route);
+                }
+
+                if (route != nullptr && route->isContainer) {
+                    if (passesE2ECheck(channel.rawRxFrames[index], *route)) {
+                        handleContainerFrame(channel, channel.rawRxFrames[index]);
+                    }
+                } else if (route != nullptr && passesE2ECheck(channel.rawRxFrames[index], *route) &&
+                           hasRawContentChanged(channel.rawRxFrames[index], *route)) {
+                    if (accepted != static_cast<size_t>(index)) {
+                        channel.rawRxFrames[accepted] = channel.rawRxFrames[index];
+                    }
+                    isCANFD[accepted++] = isFrameCANFD;
+                }
+            }
+
+            // Decode runs of frames with the same CAN ID together
+            size_t first = 0;
+            for (size_t index = 1; index <= accepted; index++) {
+                if (index == accepted || channel.rawRxFrames[index].can_id != channel.rawRxFrames[first].can_id ||
+                    isCANFD[index] != isCANFD[first]) {
+                    handleReceivedFrames(channel, &channel.rawRxFrames[first], index - first, isCANFD[first]);
+                    first = index;
+                }
+            }
+
+            // A full batch means that there may be more frames waiting
+        } while (received == RAW_RX_BATCH);
+
+    }
+
+    bool CANConnector::hasRawContentChanged(const struct canfd_frame &frame, const CANRoute &route) {
+
+        // Only receive operations with a mask are filtered for content changes
+        if (route.contentFilter < 0) {
+            return true;
+        }
+
+        // The first frame always passes, even if its masked content equals the zeroed last frame
+        RawContentFilter &filter = rawContentFilters[route.contentFilter];
+        bool changed = !filter.hasReceived || filter.lastFrame.len != frame.len;
+        for (size_t index = 0; index < frame.len && !changed; index++) {
+            changed = ((filter.lastFrame.data[index] ^ frame.data[index]) & filter.mask.data[index]) != 0;
+        }
+
+        filter.lastFrame = frame;
+        filter.hasReceived = true;
+        return changed;
+    }
+
+    std::unique_ptr<E2EProtection>
+    CANConnector::createE2EProtection(const E2EConfig &e2e, const std::string &operation) {
+        try {
+            return std::make_unique<E2EProtection>(e2e);
+        } catch (const std::invalid_argument &error) {
+            InterfaceLogger::logMessage("CAN Connector: Invalid E2E configuration of the operation <" + operation +
+                                        ">: " + error.what(), LOG_LEVEL::ERROR);
+            throw;
+        }
+    }
+
+    void CANConnector::protectFrames(int sendOperation, struct canfd_frame frames[], int nframes) {
+
+        E2EProtection *protection = sendProtection[sendOperation].get();
+        if (protection == nullptr) {
+            return;
+        }
+
+        for (int index = 0; index < nframes; index++) {
+            if (!protection->protect(frames[index])) {
+                InterfaceLogger::logMessage("CAN Connector: The frame of the send operation <" +
+                                            sendOperationNames[sendOperation] + "> is too short for the E2E header",
+                                            LOG_LEVEL::WARNING);
+            }
+        }
+    }
+
+    bool CANConnector::passesE2ECheck(const struct canfd_frame &frame, const CANRoute &route) {
+
+        if (route.e2eCheck < 0) {
+            return true;
+        }
+
+        E2ECheckStatus status = receiveChecks[route.e2eCheck]->check(frame);
+        if (!E2EProtection::isAccepted(status)) {
+            InterfaceLogger::logMessage("CAN Connector: Dropped a frame of the receive operation <" +
+                                        receiveCheckNames[route.e2eCheck] + "> that failed the E2E check",
+                                        LOG_LEVEL::DEBUG);
+            return false;
+        }
+        return true;
+    }
+
+    void CANConnector::SimulationSink::push(SimEvent &&event) {
+        InterfaceLogger::logMessage("CAN Connector: Send SimEvent: <" + event.operation + ">", LOG_LEVEL::DEBUG);
+        connector.sendEventToSim(event);
+        events++;
+    }
+
+    void CANConnector::handleReceivedFrame(CANChannel &channel, void *frame, bool isCANFD) {
+
+        // Find the codec of the CAN ID, the CAN ID is at the same position in CAN and CANFD frames
+        canid_t canID = static_cast<struct can_frame *>(frame)->can_id;
+        const CANRoute *route = channel.routes.find(canID);
+        if (route == nullptr) {
+            InterfaceLogger::logMessage("CAN Connector: No codec for the received CAN ID: " + convertCanIdToHex(canID),
+                                        LOG_LEVEL::WARNING);
+            return;
+        }
+
+        // Any frame ends a timeout, even one that fails the E2E check
+        checkRxRecovery(*route);
+
+        CANConnectorCodecV2 &codec = *codecs[route->codec];
+        SimulationSink sink(*this);
+
+        // Check if it is a CAN or CANFD frame we need to pass to the codec.
+        const struct canfd_frame *canfdFrame = static_cast<struct canfd_frame *>(frame);
+        struct canfd_frame canFrame = {0};
+        if (!isCANFD) {
+            // Initialize the struct with zero, so the codec does not see the bytes after the CAN frame.
+            // Copy the frame data.
+            std::memcpy(&canFrame, frame, sizeof(struct can_frame));
+            canfdFrame = &canFrame;
+        }
+
+        // Frames that fail the E2E check are not passed to the codec
+        if (!passesE2ECheck(*canfdFrame, *route)) {
+            return;
+        }
+
+        // The PDUs of a container are passed to their own codecs
+        if (route->isContainer) {
+            handleContainerFrame(channel, *canfdFrame);
+            return;
+        }
+
+        codec.decode(*canfdFrame, isCANFD, sink);
+
         // Sanity check
-        if (events.empty()) {
+        if (sink.events == 0) {
             InterfaceLogger::logMessage("CAN Connector: Codec returned no simulation events for the received frame",
                                         LOG_LEVEL::WARNING);
         }
 
-        // Send the received simulation events to the simulation
-        for (const auto &event: events) {
-            InterfaceLogger::logMessage("CAN Connector: Send SimEvent: <" + event.operation + ">", LOG_LEVEL::INFO);
-            sendEventToSim(event);
+    }
+
+    void CANConnector::handleReceivedFrames(CANChannel &channel, const struct canfd_frame frames[], size_t count,
+                                            bool isCANFD) {
+
+        // The CAN_RAW backend only passes routed CAN IDs
+        const CANRoute *route = channel.routes.find(frames[0].can_id);
+        if (route == nullptr) {
+            return;
+        }
+
+        SimulationSink sink(*this);
+        codecs[route->codec]->decodeBatch(frames, count, isCANFD, sink);
+
+        // Sanity check
+        if (sink.events == 0) {
+            InterfaceLogger::logMessage("CAN Connector: Codec returned no simulation events for the received frames",
+                                        LOG_LEVEL::WARNING);
         }
 
     }
 
     void CANConnector::handleEventSingle(const SimEvent &event) {
 
-        // Convert the simulation event to a CAN/CANFD frame payload and the sendOperation name
-        auto data = codec->convertSimEventToFrame(event);
-        auto frameData = data.first;
-        CANConnectorSendOperation sendOperation = this->config.operationToFrame.at(data.second);
-
-        // Sanity checks to identify errors made by the user written codec
-        if (frameData.empty()) {
-            InterfaceLogger::logMessage("CAN Connector: Codec returned an empty frame payload for a simulation event",
-                                        LOG_LEVEL::WARNING);
-            return;
-        } else {
-            if (sendOperation.isCANFD) {
-                if (CANFD_MAX_DLEN < frameData.size()) {
-                    InterfaceLogger::logMessage(
-                            "CAN Connector: Codec returned a frame payload that is bigger than the CANFD frame",
-                            LOG_LEVEL::ERROR);
-                    return;
-                }
-            } else {
-                if (CAN_MAX_DLEN < frameData.size()) {
-                    InterfaceLogger::logMessage(
-                            "CAN Connector: Codec returned a frame payload that is bigger than the CAN frame",
-                            LOG_LEVEL::ERROR);
+        // The payloads of ISO-TP operations are transferred as they are, without a codec
+        if (!isoTpOperations.empty()) {
+            auto isoTpOperation = isoTpOperations.find(event.operation);
+            if (isoTpOperation != isoTpOperations.end()) {
+                const std::string *payload = boost::get<std::string>(&event.value);
+                if (payload == nullptr) {
+                    InterfaceLogger::logMessage("CAN Connector: The ISO-TP operation <" + event.operation +
+                                                "> expects a string value", LOG_LEVEL::WARNING);
                     return;
                 }
+
+                isoTpTransports[isoTpOperation->second]->send(*payload);
+                return;
             }
         }
 
-        // Fill out the frame
-        struct canfd_frame canfdFrame = {0};
+        // Find the codec of the operation, with a single codec there is nothing to route
+        CANConnectorCodecV2 *codec = codecs.front().get();
+        if (codecs.size() > 1) {
+            auto operationCodec = operationCodecs.find(event.operation);
+            if (operationCodec != operationCodecs.end()) {
+                codec = operationCodec->second;
+            }
+        }
 
-        if (sendOperation.isCANFD) {
-            canfdFrame.can_id = sendOperation.canID;
-            canfdFrame.len = frameData.size();
-            memcpy((void *) &canfdFrame.data[0], frameData.data(), frameData.size());
-        } else {
-            struct can_frame canFrame = {0};
-            canFrame.can_id = sendOperation.canID;
-            canFrame.can_dlc = frameData.size();
-            memcpy((void *) &canFrame.data[0], frameData.data(), frameData.size());
-            canfdFrame = *((struct canfd_frame *) &canFrame);
+        // Let the codec write the payloads of the simulation event directly into the frames. The frames are too large
+        // for the stack, the member buffer is safe because the DuTConnector serializes the calls.
+        struct canfd_frame *canfdFrames = encodeFrames.data();
+        EncodeResult encoded = codec->encode(event, canfdFrames, MAXFRAMES);
+
+        // The codec reports the events it could not convert itself
+        if (encoded.nframes == 0) {
+            return;
+        }
+
+        // Sanity checks to identify errors made by the user written codec
+        if (encoded.sendOperation < 0 || static_cast<size_t>(encoded.sendOperation) >= sendOperations.size()) {
+            InterfaceLogger::logMessage(
+                    "CAN Connector: Codec returned frames for a sendOperation that is not configured for the "
+                    "operation <" + event.operation + ">", LOG_LEVEL::WARNING);
+            return;
+        }
+
+        const CANConnectorSendOperation &sendOperation = sendOperations[encoded.sendOperation];
+        CANChannel &channel = *channels[sendChannels[encoded.sendOperation]];
+
+        if (encoded.nframes != sendOperation.nframes) {
+            InterfaceLogger::logMessage(
+                    "CAN Connector: Codec returned " + std::to_string(encoded.nframes) + " frame payloads but the " +
+                    "sendOperation <" + sendOperationNames[encoded.sendOperation] + "> expects " +
+                    std::to_string(sendOperation.nframes), LOG_LEVEL::ERROR);
+            return;
         }
 
+        __u8 maxLength = sendOperation.isCANFD ? CANFD_MAX_DLEN : CAN_MAX_DLEN;
+
+        // Fill out the rest of the frames. CAN frames have the same layout as the start of CANFD frames.
+        for (__u32 index = 0; index < encoded.nframes; index++) {
+            struct canfd_frame &frame = canfdFrames[index];
+
+            if (frame.len == 0) {
+                InterfaceLogger::logMessage(
+                        "CAN Connector: Codec returned an empty frame payload for a simulation event",
+                        LOG_LEVEL::WARNING);
+                return;
+            } else if (frame.len > maxLength) {
+                InterfaceLogger::logMessage(
+                        std::string("CAN Connector: Codec returned a frame payload that is bigger than the ") +
+                        (sendOperation.isCANFD ? "CANFD frame" : "CAN frame"), LOG_LEVEL::ERROR);
+                return;
+            }
+
+            frame.can_id = sendOperation.canID;
+            frame.flags = 0;
+            frame.__res0 = 0;
+            frame.__res1 = 0;
+            std::memset(&frame.data[frame.len], 0, CANFD_MAX_DLEN - frame.len);
+        }
+
+        int nframes = static_cast<int>(encoded.nframes);
+
         // Check if we should send it once or cyclic
         if (sendOperation.isCyclic) {
 
+            // The BCM (or the cyclic scheduler) keeps sending the frames of a cyclic send operation,
+            // an update with the same frames would not change the bus traffic
+            std::vector<struct canfd_frame> &shadow = shadowFrames[encoded.sendOperation];
+            size_t shadowSize = encoded.nframes * sizeof(struct canfd_frame);
+
+            if (this->isSetup[encoded.sendOperation] && std::memcmp(shadow.data(), canfdFrames, shadowSize) == 0) {
+                suppressedUpdates.fetch_add(1, std::memory_order_relaxed);
+                suppressedFrames.fetch_add(encoded.nframes, std::memory_order_relaxed);
+                return;
+            }
+
+            std::memcpy(shadow.data(), canfdFrames, shadowSize);
+
+            // The userspace engine takes the frames with its next transmission
+            if (CANCyclicScheduler::isScheduled(sendOperation)) {
+                cyclicScheduler->update(encoded.sendOperation, canfdFrames, encoded.nframes, codec);
+                return;
+            }
+
+            // The BCM repeats the frames, so the E2E counter only advances with the updates
+            protectFrames(encoded.sendOperation, canfdFrames, nframes);
+
             // Check if a cyclic send operation was set up already
-            if (this->isSetup.at(data.second)) {
-                // Update the cyclic send operation with the new frame payload
-                txSetupUpdateSingleFrame(canfdFrame, sendOperation.isCANFD, sendOperation.announce);
+            if (this->isSetup[encoded.sendOperation]) {
+                // Update the cyclic send operation with the new frame payloads
+                if (nframes == 1) {
+                    txSetupUpdateSingleFrame(channel, canfdFrames[0], sendOperation.isCANFD, sendOperation.announce);
+                } else {
+                    txSetupUpdateSequence(channel, canfdFrames, nframes, sendOperation.isCANFD, sendOperation.announce);
+                }
             } else {
-                // Create a new cyclic send operation and remember that we already set it up
-                this->isSetup[data.second] = true;
-                txSetupSingleFrame(canfdFrame, sendOperation.count, sendOperation.ival1, sendOperation.ival2,
-                                   sendOperation.isCANFD);
+                // Create a new cyclic send operation and remember that we already set it up.
+                // The BCM cycles through the frames of a sequence itself, one frame per interval.
+                this->isSetup[encoded.sendOperation] = true;
+                if (nframes == 1) {
+                    txSetupSingleFrame(channel, canfdFrames[0], sendOperation.count, sendOperation.ival1,
+                                       sendOperation.ival2, sendOperation.isCANFD);
+                } else {
+                    txSetupSequence(channel, canfdFrames, nframes, sendOperation.count, sendOperation.ival1,
+                                    sendOperation.ival2, sendOperation.isCANFD);
+                }
             }
 
         } else {
-            // Send out the frame once
-            txSendSingleFrame(canfdFrame, sendOperation.isCANFD);
+
+            // Every frame is a new transmission with the next E2E counter
+            protectFrames(encoded.sendOperation, canfdFrames, nframes);
+
+            if (containerOf[encoded.sendOperation] >= 0) {
+                // Pack the frames into the container, the header ID is the CAN ID of the send operation
+                for (int index = 0; index < nframes; index++) {
+                    if (canfdFrames[index].len > CONTAINER_MAX_PDU_LENGTH) {
+                        InterfaceLogger::logMessage("CAN Connector: The frame payload of the send operation <" +
+                                                    sendOperationNames[encoded.sendOperation] +
+                                                    "> does not fit into its container", LOG_LEVEL::ERROR);
+                        continue;
+                    }
+                    containerPacker->pack(containerOf[encoded.sendOperation], sendOperation.canID,
+                                          canfdFrames[index]);
+                }
+            } else if (isRawBackend) {
+                // Send out the frames once over the CAN_RAW socket
+                for (int index = 0; index < nframes; index++) {
+                    txSendRawFrame(channel, canfdFrames[index], sendOperation.isCANFD);
+                }
+            } else {
+                // Send out the frames once
+                txSendMultipleFrames(channel, canfdFrames, nframes, sendOperation.isCANFD);
+            }
         }
 
     }
@@ -29,16 +29,30 @@
 // Project includes
 #include "../DuTConnector.h"
 #include "InterfaceIndexIO.h"
-#include "CANConnectorCodec.h"
+#include "CANConnectorCodecV2.h"
 #include "CANConnectorConfig.h"
 #include "CANConnectorCodecFactory.h"
+#include "BcmMessageSlab.h"
+#include "CANRoutingTable.h"
+#include "CANCyclicScheduler.h"
+#include "CANContainerPacker.h"
+#include "CANGateway.h"
+#include "CANTxMonitor.h"
+#include "CANBusMonitor.h"
+#include "CANIsoTp.h"
+#include "CANConnectorCodecs/E2EProtection.h"
 #include "../../Interface_Logger/InterfaceLogger.h"
 
 // System includes
+#include <atomic>
+#include <memory>
 #include <thread>
+#include <unordered_map>
+#include <sys/socket.h>
 #include <iostream>
 #include <linux/can.h>
 #include <linux/can/bcm.h>
+#include <linux/can/raw.h>
 #include <boost/asio.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/system/error_code.hpp>
@@ -50,6 +64,22 @@
  */
 #define MAXFRAMES 256
 
+/**
+ * Defines how many BCM message buffers are pre-allocated for the BCM operations of a CAN Connector.
+ * If more messages are pending at the same time the additional buffers are allocated on the heap.
+ */
+#define BCM_SLAB_CAPACITY 256
+
+/**
+ * Defines how many BCM messages are sent at most with a single sendmmsg call.
+ */
+#define BCM_BATCH_SIZE 64
+
+/**
+ * Defines how many frames are received at most with a single recvmmsg call on the CAN_RAW socket.
+ */
+#define RAW_RX_BATCH 32
+
 /**
  * <summary>
  * Struct for a BCM message with a single CAN frame.
@@ -135,12 +165,81 @@ namespace sim_interface::dut_connector::can {
     private:
 
         /**
-         * Creates the BCM socket that is used by the CAN Connector.
+         * <summary>
+         * The sockets and the routing table of one CAN interface of the connector.
+         * </summary>
+         * All channels share the io context, the codecs and the send path of the connector.
+         */
+        struct CANChannel {
+            std::string interfaceName;                                             /**< The name of the interface.    */
+            int interfaceIndex;                                                    /**< The index of the interface.   */
+            boost::asio::generic::datagram_protocol::socket bcmSocket;             /**< The BCM socket.               */
+            std::map<canid_t, CANConnectorReceiveOperation> *receiveOperations;    /**< The receive operations.       */
+            CANRoutingTable routes;                                                /**< Routes of received CAN IDs.   */
+            std::unique_ptr<boost::asio::generic::raw_protocol::socket> rawSocket; /**< The CAN_RAW socket.           */
+            std::array<struct canfd_frame, RAW_RX_BATCH> rawRxFrames{};            /**< Receive buffers for recvmmsg. */
+            std::array<struct mmsghdr, RAW_RX_BATCH> rawRxHeaders{};               /**< Message headers for recvmmsg. */
+            std::array<struct iovec, RAW_RX_BATCH> rawRxIovecs{};                  /**< IO vectors for recvmmsg.      */
+            std::atomic<uint64_t> receivedFrames{0};                               /**< Number of received frames.    */
+            std::atomic<uint64_t> sentMessages{0};                                 /**< Number of submitted messages. */
+            std::unique_ptr<CANTxMonitor> txMonitor;                               /**< Confirms the sends, optional. */
+            std::unique_ptr<CANBusMonitor> busMonitor;                             /**< Bus load and errors, optional.*/
+
+            /**
+             * Buffer for the data that is received on the BCM socket.
+             */
+            std::array<std::uint8_t, sizeof(struct bcmMsgMultipleFramesCanFD)> rxBuffer{0};
+
+            /**
+             * Constructor.
+             *
+             * @param interfaceName     - The name of the interface.
+             * @param interfaceIndex    - The index of the interface.
+             * @param bcmSocket         - The BCM socket connected to the interface.
+             * @param receiveOperations - The receive operations of the interface in the config of the connector.
+             */
+            CANChannel(std::string interfaceName, int interfaceIndex,
+                       boost::asio::generic::datagram_protocol::socket bcmSocket,
+                       std::map<canid_t, CANConnectorReceiveOperation> *receiveOperations)
+                    : interfaceName(std::move(interfaceName)), interfaceIndex(interfaceIndex),
+                      bcmSocket(std::move(bcmSocket)), receiveOperations(receiveOperations) {}
+        };
+
+        /**
+         * Creates the channels of all interfaces of the config: the interface of interfaceName, the interfaces with
+         * receive operations in interfaceFrameToOperation and the interfaces of the send operations.
+         */
+        void createChannels();
+
+        /**
+         * Finds the channel of an interface.
+         *
+         * @param interfaceName - The name of the interface, empty for the interface of interfaceName.
+         * @return The index of the channel.
+         */
+        size_t findChannel(const std::string &interfaceName) const;
+
+        /**
+         * Creates a BCM socket that is connected to an interface.
          *
-         * @param config - The config of the CAN Connector.
+         * @param interfaceName  - The name of the interface.
+         * @param interfaceIndex - Takes the index of the interface.
          * @return The BCM socket.
          */
-        boost::asio::generic::datagram_protocol::socket createBcmSocket(const CANConnectorConfig &canConfig);
+        boost::asio::generic::datagram_protocol::socket createBcmSocket(const std::string &interfaceName,
+                                                                        int &interfaceIndex);
+
+        /**
+         * Creates the CAN_RAW socket that is used by the CAN_RAW backend or the cyclic scheduler.
+         * The socket receives CAN and CANFD frames and only the CAN IDs of the receive operations.
+         *
+         * @param interfaceIndex    - The index of the interface the socket is bound to.
+         * @param receiveOperations - The receive operations of the interface, nullptr for a send only socket
+         *                            with an empty filter list.
+         * @return The CAN_RAW socket.
+         */
+        std::unique_ptr<boost::asio::generic::raw_protocol::socket>
+        createRawSocket(int interfaceIndex, const std::map<canid_t, CANConnectorReceiveOperation> *receiveOperations);
 
         /**
          * Starts the io context loop that is running in a dedicated thread.
@@ -162,48 +261,269 @@ namespace sim_interface::dut_connector::can {
          * Receives on the BCM socket. The received data is stored in the rxBuffer.
          * After processing the receive operation the next receive operation is
          * created (function calls itself) to keep the io context loop running.
+         *
+         * @param channel - The channel of the interface.
          */
-        void receiveOnSocket();
+        void receiveOnSocket(CANChannel &channel);
 
         /**
          * Decides what to do with the data we received on the socket.
          *
+         * @param channel - The channel of the interface.
          * @param head    - The received bcm msg head.
          * @param frames  - The received CAN or CANFD frames.
          * @param nframes - The number of the received frames.
          * @param isCANFD - Flag for CANFD frames.
          */
-        void handleReceivedData(const bcm_msg_head *head, void *frames, uint32_t nframes, bool isCANFD);
+        void handleReceivedData(CANChannel &channel, const bcm_msg_head *head, void *frames, uint32_t nframes,
+                                bool isCANFD);
 
         /**
          * Handles received RX_CHANGED BCM messages.
          *
+         * @param channel - The channel of the interface.
          * @param head    - The received bcm msg head.
          * @param frame   - The received CAN or CANFD frame.
          * @param isCANFD - Flag for CANFD frames.
          */
-        void handleRxChanged(const bcm_msg_head *head, void *frames, bool isCANFD);
+        void handleRxChanged(CANChannel &channel, const bcm_msg_head *head, void *frames, bool isCANFD);
+
+        /**
+         * <summary>
+         * Passes the simulation events of the codec directly to the simulation.
+         * </summary>
+         */
+        struct SimulationSink : public SimEventSink {
+            CANConnector &connector;                                    /**< Connector that sends the events.  */
+            size_t events = 0;                                          /**< Number of passed events.          */
+
+            explicit SimulationSink(CANConnector &connector) : connector(connector) {}
+
+            void push(SimEvent &&event) override;
+        };
+
+        /**
+         * <summary>
+         * Content filter of a masked receive operation of the CAN_RAW backend.
+         * </summary>
+         */
+        struct RawContentFilter {
+            struct canfd_frame mask;                                    /**< The mask of the receive operation. */
+            struct canfd_frame lastFrame;                               /**< The last received frame.           */
+            bool hasReceived;                                           /**< Flag if a frame was received.      */
+        };
+
+        /**
+         * Creates the codecs of the config and routes the receive operations and the simulation events to them.
+         * Receive operations without a mask get the mask of their codec if autoMasks is set.
+         */
+        void createCodecs();
+
+        /**
+         * Validates the send operations that are packed into containers and creates their containers.
+         * The containers have to be CANFD send operations that are sent once.
+         */
+        void createContainers();
+
+        /**
+         * Sends a complete container frame of the container packer once, E2E protected if configured.
+         *
+         * @param container - The index of the container.
+         * @param frame     - The container frame.
+         */
+        void sendContainerFrame(size_t container, struct canfd_frame &frame);
+
+        /**
+         * Unpacks a received container and converts each PDU with the codec of its header ID.
+         *
+         * @param channel   - The channel of the interface.
+         * @param container - The received container frame.
+         */
+        void handleContainerFrame(CANChannel &channel, const struct canfd_frame &container);
+
+        /**
+         * Converts a received CAN or CANFD frame with the codec of its CAN ID and sends the events to the simulation.
+         *
+         * @param channel - The channel of the interface.
+         * @param frame   - The received CAN or CANFD frame.
+         * @param isCANFD - Flag for CANFD frames.
+         */
+        void handleReceivedFrame(CANChannel &channel, void *frame, bool isCANFD);
+
+        /**
+         * Converts a batch of received frames with the same CAN ID with the codec of the CAN ID and sends the events
+         * to the simulation.
+         *
+         * @param channel - The channel of the interface.
+         * @param frames  - The received frames, CAN frames are zero padded canfd_frames.
+         * @param count   - The number of frames.
+         * @param isCANFD - Flag for CANFD frames.
+         */
+        void handleReceivedFrames(CANChannel &channel, const struct canfd_frame frames[], size_t count, bool isCANFD);
+
+        /**
+         * Waits until the CAN_RAW socket is readable and reads the frames. After processing the frames
+         * the next wait operation is created (function calls itself) to keep the io context loop running.
+         *
+         * @param channel - The channel of the interface.
+         */
+        void receiveOnRawSocket(CANChannel &channel);
+
+        /**
+         * Reads all available frames from the CAN_RAW socket with recvmmsg (up to RAW_RX_BATCH per call).
+         * Consecutive frames with the same CAN ID are decoded together (see handleReceivedFrames).
+         *
+         * @param channel - The channel of the interface.
+         */
+        void readRawFrames(CANChannel &channel);
+
+        /**
+         * Emulates the content filter of the BCM for the CAN_RAW backend.
+         * Frames of receive operations without a mask always pass.
+         *
+         * @param frame - The received frame (CAN frames are stored in a canfd_frame).
+         * @param route - The route of the CAN ID of the frame.
+         * @return True if the frame is the first one or a bit of the mask or the length changed.
+         */
+        bool hasRawContentChanged(const struct canfd_frame &frame, const CANRoute &route);
+
+        /**
+         * Creates the E2E protection of a send or receive operation.
+         *
+         * @param e2e       - The E2E configuration, the profile is not E2E_PROFILE_NONE.
+         * @param operation - The name of the operation for logging.
+         * @return The E2E protection.
+         */
+        static std::unique_ptr<E2EProtection> createE2EProtection(const E2EConfig &e2e, const std::string &operation);
+
+        /**
+         * Writes the E2E counter and CRC into the frames of a send operation, if it is protected.
+         *
+         * @param sendOperation - The handle of the send operation.
+         * @param frames        - The complete frames.
+         * @param nframes       - The number of frames.
+         */
+        void protectFrames(int sendOperation, struct canfd_frame frames[], int nframes);
+
+        /**
+         * Checks a received frame with the E2E check of its receive operation.
+         * Frames of receive operations without E2E protection always pass.
+         *
+         * @param frame - The received frame (CAN frames are stored in a canfd_frame).
+         * @param route - The route of the CAN ID of the frame.
+         * @return True if the frame is passed to the codec.
+         */
+        bool passesE2ECheck(const struct canfd_frame &frame, const CANRoute &route);
+
+        /**
+         * <summary>
+         * The timeout monitoring of a receive operation by the BCM.
+         * </summary>
+         */
+        struct RxLiveness {
+            std::string operation;                                      /**< The name of the receive operation.  */
+            std::string eventOperation;                                 /**< The operation of the events.        */
+            std::string interfaceName;                                  /**< The interface of the operation.     */
+            std::atomic<bool> isTimedOut{false};                        /**< Flag if the frames are absent.      */
+            std::atomic<uint64_t> timeouts{0};                          /**< Number of timeouts.                 */
+            std::atomic<uint64_t> recoveries{0};                        /**< Number of recoveries.               */
+        };
+
+        /**
+         * Handles a RX_TIMEOUT of the BCM: the frames of the CAN ID are absent for the timeout of the receive
+         * operation. Sends the timeout event with the value 1 to the simulation.
+         *
+         * @param channel - The channel of the interface.
+         * @param canID   - The CAN ID of the timeout.
+         */
+        void handleRxTimeout(CANChannel &channel, canid_t canID);
+
+        /**
+         * Checks if a received frame ends the timeout of its receive operation. The first frame after a timeout
+         * sends the timeout event with the value 0 to the simulation.
+         *
+         * @param route - The route of the CAN ID of the frame.
+         */
+        void checkRxRecovery(const CANRoute &route);
+
+        /**
+         * Sends a single CAN/CANFD frame once over the CAN_RAW socket. The frame is batched
+         * with the other pending messages like the BCM messages.
+         *
+         * @param channel - The channel of the interface.
+         * @param frame   - The frame that should be send.
+         * @param isCANFD - Flag for a CANFD frame.
+         */
+        void txSendRawFrame(CANChannel &channel, struct canfd_frame frame, bool isCANFD);
+
+        /**
+         * Gets a zero initialized buffer for a BCM message from the slab.
+         *
+         * @param size        - The size of the BCM message in bytes.
+         * @param description - The name of the BCM operation used for logging.
+         * @return The buffer for the BCM message.
+         */
+        BcmMessageBuffer *createBcmMessage(size_t size, const char *description);
+
+        /**
+         * Adds the BCM message to the pending messages and schedules a flush on the io context.
+         * All messages submitted until the flush runs are sent together (see flushBcmMessages).
+         * The buffer is given back to the slab after it was sent.
+         *
+         * @param channel - The channel of the interface.
+         * @param buffer - The filled out BCM message.
+         */
+        void submitBcmMessage(CANChannel &channel, BcmMessageBuffer *buffer);
+
+        /**
+         * Adds a message to the pending messages and schedules a flush on the io context.
+         * The socket the message is sent on must be set in the buffer.
+         *
+         * @param buffer - The filled out message.
+         */
+        void enqueueMessage(BcmMessageBuffer *buffer);
+
+        /**
+         * Sends all pending BCM messages in submission order with as few sendmmsg calls as possible.
+         * Runs on the io context, only one flush is running at any time.
+         */
+        void flushBcmMessages();
+
+        /**
+         * Sends the messages of the current flush batch.
+         *
+         * @return False if the socket is busy and the flush continues once it is writable again.
+         */
+        bool sendFlushBatch();
+
+        /**
+         * Gives back all BCM messages that were not sent to the slab.
+         */
+        void releasePendingBcmMessages();
 
         /**
          * Create a non cyclic transmission task for a single CAN/CANFD frame.
          *
+         * @param channel - The channel of the interface.
          * @param frame   - The frame that should be send.
          * @param isCANFD - Flag for a CANFD frame.
          */
-        void txSendSingleFrame(struct canfd_frame frame, bool isCANFD);
+        void txSendSingleFrame(CANChannel &channel, struct canfd_frame frame, bool isCANFD);
 
         /**
          * Create a non cyclic transmission task for multiple CAN/CANFD frames.
          *
+         * @param channel - The channel of the interface.
          * @param frames  - The frames that should be send.
          * @param nframes - The number of frames that should be send.
          * @param isCANFD - Flag for CANFD frames.
          */
-        void txSendMultipleFrames(struct canfd_frame frames[], int nframes, bool isCANFD);
+        void txSendMultipleFrames(CANChannel &channel, struct canfd_frame frames[], int nframes, bool isCANFD);
 
         /**
          * Create a cyclic transmission task for a CAN/CANFD frame.
          *
+         * @param channel - The channel of the interface.
          * @param frame   - The frame that should be send cyclic.
          * @param count   - Number of times the frame is send with the first interval.
          *                  If count is zero only the second interval is being used.
@@ -211,8 +531,8 @@ namespace sim_interface::dut_connector::can {
          * @param ival2   - Second interval.
          * @param isCANFD - Flag for a CANFD frames.
          */
-        void txSetupSingleFrame(struct canfd_frame frame, uint32_t count, struct bcm_timeval ival1,
-                struct bcm_timeval ival2, bool isCANFD);
+        void txSetupSingleFrame(CANChannel &channel, struct canfd_frame frame, uint32_t count,
+                                struct bcm_timeval ival1, struct bcm_timeval ival2, bool isCANFD);
 
         /**
          * Create a cyclic transmission task for multiple CAN/CANFD frames.
@@ -223,6 +543,7 @@ namespace sim_interface::dut_connector::can {
          * that was set in the bcm_msg_head. Another benefit is that each CAN/CANFD frame
          * can have different count, ival1, and ival2 values.
          *
+         * @param channel - The channel of the interface.
          * @param frames  - The frames that should be send cyclic.
          * @param nframes - The number of frames that should be send cyclic.
          * @param count   - Number of times the frame is send with the first interval.
@@ -231,8 +552,8 @@ namespace sim_interface::dut_connector::can {
          * @param ival2   - Second interval.
          * @param isCANFD - Flag for CANFD frames.
          */
-        void txSetupMultipleFrames(struct canfd_frame frames[], int nframes, uint32_t count[],
-                struct bcm_timeval ival1[], struct bcm_timeval ival2[], bool isCANFD);
+        void txSetupMultipleFrames(CANChannel &channel, struct canfd_frame frames[], int nframes, uint32_t count[],
+                                   struct bcm_timeval ival1[], struct bcm_timeval ival2[], bool isCANFD);
 
         /**
          * Create a cyclic transmission task for one or multiple CAN/CANFD frames.
@@ -242,6 +563,7 @@ namespace sim_interface::dut_connector::can {
          * Note: The cyclic transmission task for the sequence can only be deleted
          * with the CAN ID that was set in the bcm_msg_head.
          *
+         * @param channel  - The channel of the interface.
          * @param frames   - The array of CAN/CANFD frames that should be send cyclic.
          * @param nframes  - The number of CAN/CANFD frames that should be send cyclic.
          * @param count    - Number of times the frame is send with the first interval.
@@ -250,28 +572,45 @@ namespace sim_interface::dut_connector::can {
          * @param ival2    - Second interval.
          * @param isCANFD  - Flag for CANFD frames.
          */
-        void txSetupSequence(struct canfd_frame frames[], int nframes, uint32_t count, struct bcm_timeval ival1,
-                             struct bcm_timeval ival2, bool isCANFD);
+        void txSetupSequence(CANChannel &channel, struct canfd_frame frames[], int nframes, uint32_t count,
+                             struct bcm_timeval ival1, struct bcm_timeval ival2, bool isCANFD);
 
         /**
          * Updates a cyclic transmission task for a CAN/CANFD frame.
          *
+         * @param channel  - The channel of the interface.
          * @param frames   - The updated CAN/CANFD frame data.
          * @param nframes  - The number of CAN/CANFD frames that should be updated.
          * @param isCANFD  - Flag for CANFD frames.
          * @param announce - Flag for immediately sending out the changes once will retaining the cycle.
          */
-        void txSetupUpdateSingleFrame(struct canfd_frame frame, bool isCANFD, bool announce);
+        void txSetupUpdateSingleFrame(CANChannel &channel, struct canfd_frame frame, bool isCANFD, bool announce);
 
         /**
          * Updates a cyclic transmission task for one or multiple CAN/CANFD frames.
          *
+         * @param channel  - The channel of the interface.
          * @param frames   - The array of CAN/CANFD frames with the updated data.
          * @param nframes  - The number of CAN/CANFD frames that should be updated.
          * @param isCANFD  - Flag for CANFD frames.
          * @param announce - Flag for immediately sending out the changes once while retaining the cycle.
          */
-        void txSetupUpdateMultipleFrames(struct canfd_frame frames[], int nframes, bool isCANFD, bool announce);
+        void txSetupUpdateMultipleFrames(CANChannel &channel, struct canfd_frame frames[], int nframes, bool isCANFD,
+                                         bool announce);
+
+        /**
+         * Updates the frames of a cyclic transmission sequence while retaining the cycle.
+         *
+         * Note: The sequence is identified by the CAN ID of the first frame like in txSetupSequence.
+         *
+         * @param channel  - The channel of the interface.
+         * @param frames   - The array of CAN/CANFD frames with the updated data.
+         * @param nframes  - The number of CAN/CANFD frames of the sequence.
+         * @param isCANFD  - Flag for CANFD frames.
+         * @param announce - Flag for immediately sending out the changes once while retaining the cycle.
+         */
+        void txSetupUpdateSequence(CANChannel &channel, struct canfd_frame frames[], int nframes, bool isCANFD,
+                                   bool announce);
 
         /**
          * Removes a cyclic transmission task for the given CAN ID.
@@ -279,36 +618,43 @@ namespace sim_interface::dut_connector::can {
          * Note: A cyclic transmission task for a sequence of frames can only
          * be deleted with the CAN ID that was set in the bcm_msg_head.
          *
+         * @param channel - The channel of the interface.
          * @param canID - The CAN ID of the task that should be removed.
          */
-        void txDelete(canid_t canID, bool isCANFD);
+        void txDelete(CANChannel &channel, canid_t canID, bool isCANFD);
 
         /**
          * Creates a RX filter for the given CAN ID.
          * I. e. we get notified on all received frames with this CAN ID.
          *
+         * @param channel  - The channel of the interface.
          * @param canID    - The CAN ID that should be added to the RX filter.
          * @param isCANFD  - Flag for CANFD frames.
+         * @param timeout  - Milliseconds without a frame until the BCM sends RX_TIMEOUT, 0 for no timeout.
          */
-        void rxSetupCanID(canid_t canID, bool isCANFD);
+        void rxSetupCanID(CANChannel &channel, canid_t canID, bool isCANFD, int timeout = 0);
 
         /**
          * Creates a RX filter for the CAN ID and the relevant bits of the frame.
          * I. e. we only get notified on changes for the set bits in the mask.
          *
+         * @param channel  - The channel of the interface.
          * @param canID    - The CAN ID that should be added to the RX filter.
          * @param mask     - The mask for the relevant bits of the frame.
          * @param isCANFD  - Flag for CANFD frames.
+         * @param timeout  - Milliseconds without a frame until the BCM sends RX_TIMEOUT, 0 for no timeout.
+         *                   The first frame after a timeout is always reported (RX_ANNOUNCE_RESUME).
          */
-        void rxSetupMask(canid_t canID, struct canfd_frame mask, bool isCANFD);
+        void rxSetupMask(CANChannel &channel, canid_t canID, struct canfd_frame mask, bool isCANFD, int timeout = 0);
 
         /**
          * Removes the RX filter for the given CAN ID.
          *
+         * @param channel - The channel of the interface.
          * @param canID   - The CAN ID that should be removed from the RX filter.
          * @param isCANFD - Flag for CANFD frames.
          */
-        void rxDelete(canid_t canID, bool isCANFD);
+        void rxDelete(CANChannel &channel, canid_t canID, bool isCANFD);
 
         /**
          * Converts a CAN ID to a hex string.
@@ -319,12 +665,42 @@ namespace sim_interface::dut_connector::can {
         static std::string convertCanIdToHex(canid_t canID);
 
         boost::shared_ptr<boost::asio::io_context> ioContext;                           /**< The io_context used by the BCM socket.                 */
-        boost::asio::generic::datagram_protocol::socket bcmSocket;                      /**< The BCM socket that is used to send and receive.       */
-        std::array<std::uint8_t, sizeof(struct bcmMsgMultipleFramesCanFD)> rxBuffer{0}; /**< Buffer that stores the received data.                  */
-        std::thread ioContextThread;                                                    /**< Thread for the io_context loop.                        */
+        std::vector<std::thread> ioContextThreads;                                      /**< Threads for the io_context loop.                       */
         CANConnectorConfig config;                                                      /**< The config of the CAN connector.                       */
-        CANConnectorCodec *codec;                                                       /**< The codec that is used for parsing.                    */
-        std::map<std::string, bool> isSetup;                                            /**< Map that keeps track which cyclic operation are setup. */
+        std::vector<std::unique_ptr<CANChannel>> channels;                              /**< The interfaces, the one of interfaceName is the first. */
+        std::vector<size_t> sendChannels;                                               /**< The channel of each send operation by the handle.      */
+        std::vector<std::unique_ptr<CANConnectorCodecV2>> codecs;                       /**< The codecs, the codec of codecName is the first one.   */
+        std::vector<std::string> codecNames;                                            /**< Names of the codecs for logging.                       */
+        std::unordered_map<std::string, CANConnectorCodecV2 *> operationCodecs;         /**< Codec of each simulation event operation.              */
+        std::vector<std::string> sendOperationNames;                                    /**< Names of the send operations by the handle.            */
+        std::vector<CANConnectorSendOperation> sendOperations;                          /**< The send operations by the handle.                     */
+        std::vector<bool> isSetup;                                                      /**< Keeps track which cyclic operations are setup.         */
+        std::vector<std::vector<struct canfd_frame>> shadowFrames;                      /**< Last frames of each cyclic send operation.             */
+        std::array<struct canfd_frame, MAXFRAMES> encodeFrames{};                       /**< Frames of handleEventSingle, its calls are serialized. */
+        BcmMessageSlab bcmSlab;                                                         /**< Pre-allocated buffers for the BCM messages.            */
+        std::atomic<BcmMessageBuffer *> pendingHead{nullptr};                           /**< Lock-free list of the submitted BCM messages.          */
+        std::atomic<bool> flushScheduled{false};                                        /**< Flag if a flush of the pending messages is scheduled.  */
+        std::vector<BcmMessageBuffer *> flushBatch;                                     /**< The messages of the running flush in submission order. */
+        size_t flushOffset = 0;                                                         /**< Index of the next message of the flush batch to send.  */
+        std::array<struct mmsghdr, BCM_BATCH_SIZE> batchHeaders{};                      /**< Message headers for sendmmsg.                          */
+        std::array<struct iovec, BCM_BATCH_SIZE> batchIovecs{};                         /**< IO vectors for sendmmsg.                               */
+        std::atomic<uint64_t> sentMessages{0};                                          /**< Number of BCM messages sent.                           */
+        std::atomic<uint64_t> sendCalls{0};                                             /**< Number of sendmmsg calls.                              */
+        std::atomic<uint64_t> suppressedUpdates{0};                                     /**< Number of unchanged BCM updates that were not sent.    */
+        std::atomic<uint64_t> suppressedFrames{0};                                      /**< Number of frames of the suppressed BCM updates.        */
+        std::vector<std::unique_ptr<E2EProtection>> sendProtection;                     /**< E2E protection of the send operations by the handle.   */
+        std::vector<std::unique_ptr<E2EProtection>> receiveChecks;                      /**< E2E checks of the receive operations, see CANRoute.    */
+        std::vector<std::string> receiveCheckNames;                                     /**< Names of the receive operations of the E2E checks.     */
+        std::vector<std::unique_ptr<RxLiveness>> rxLiveness;                            /**< Timeout monitoring of the receive operations.          */
+        std::unique_ptr<CANCyclicScheduler> cyclicScheduler;                            /**< Userspace engine of the cyclic send operations.        */
+        std::unique_ptr<CANContainerPacker> containerPacker;                            /**< Packs the PDUs of send operations into containers.     */
+        std::vector<int32_t> containerOf;                                               /**< Container of each send operation, -1 for none.         */
+        std::vector<size_t> containerOperations;                                        /**< The send operation of each container.                  */
+        std::unique_ptr<CANGateway> gateway;                                            /**< The routes of the kernel CAN gateway.                  */
+        std::vector<std::unique_ptr<CANIsoTpTransport>> isoTpTransports;                /**< The transports of the ISO-TP operations.               */
+        std::unordered_map<std::string, size_t> isoTpOperations;                        /**< ISO-TP transport of each operation.                    */
+        bool isRawBackend;                                                              /**< Flag for the CAN_RAW backend.                          */
+        std::vector<RawContentFilter> rawContentFilters;                                /**< Content filters of the masked receive operations.      */
     };
 
 }
@@ -32,6 +32,7 @@
 
 // System includes
 #include <vector>
+#include <utility>
 #include <linux/can.h>
 
 namespace sim_interface::dut_connector::can {
@@ -45,6 +46,11 @@ namespace sim_interface::dut_connector::can {
 
     public:
 
+        /**
+         * Destructor. The codecs are deleted through this interface, e.g. by the LegacyCodecAdapter.
+         */
+        virtual ~CANConnectorCodec() = default;
+
         /**
          * Converts an simulation event to a CAN/CANFD payload and determines the sendOperation name.
          *
@@ -54,6 +60,21 @@ namespace sim_interface::dut_connector::can {
          */
         virtual std::pair<std::vector<__u8>, std::string> convertSimEventToFrame(SimEvent event) = 0;
 
+        /**
+         * Converts an simulation event to the CAN/CANFD payloads of a frame sequence and determines the
+         * sendOperation name. The number of payloads must match nframes of the sendOperation.
+         * The default implementation returns the single payload of convertSimEventToFrame. Override it
+         * for sequences (e.g. multiplexed frames or rolling counters over multiple frames).
+         *
+         * @param event - The simulation event we want to transform into CAN/CANFD frame payloads.
+         *
+         * @return The CAN/CANFD frame payloads in sequence order and the sendOperation name.
+         */
+        virtual std::pair<std::vector<std::vector<__u8>>, std::string> convertSimEventToFrames(SimEvent event) {
+            auto data = convertSimEventToFrame(std::move(event));
+            return {{std::move(data.first)}, std::move(data.second)};
+        }
+
         /**
          * Converts a CAN/CANFD frame to the corresponding simulation events.
          *
@@ -26,10 +26,11 @@
 
 // Project includes
 #include "CANConnectorCodecFactory.h"
+#include "GeneratedCanCodecs.h"
 
 namespace sim_interface::dut_connector::can {
 
-    CANConnectorCodec *CANConnectorCodecFactory::createCodec(const std::string &codecName) {
+    CANConnectorCodecV2 *CANConnectorCodecFactory::createCodec(const std::string &codecName, const std::string &dbcFile) {
 
         // Check if the codec name is empty
         if (codecName.empty()) {
@@ -38,9 +39,18 @@ namespace sim_interface::dut_connector::can {
         }
 
         // Create the right codec based on the given codec name.
-        // Add your new codec here.
+        // Add your new codec here. Legacy codecs are added with: return new LegacyCodecAdapter(new MyCodec());
         if (CODEC_NAME_BMW == codecName) {
             return new BmwCodec();
+        } else if (CODEC_NAME_DBC == codecName) {
+            if (dbcFile.empty()) {
+                InterfaceLogger::logMessage("CAN Connector: The DbcCodec needs a dbcFile in the config", LOG_LEVEL::ERROR);
+                throw std::invalid_argument("CAN Connector: The DbcCodec needs a dbcFile in the config");
+            }
+            return new DbcCodec(dbcFile);
+        } else if (CANConnectorCodecV2 *codec = createGeneratedCodec(codecName)) {
+            // Codec generated from a DBC file with add_can_codec
+            return codec;
         } else {
             // Unknown CAN codec name
             InterfaceLogger::logMessage(
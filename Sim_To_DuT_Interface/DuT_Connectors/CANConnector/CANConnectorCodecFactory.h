@@ -28,17 +28,24 @@
 #define SIM_TO_DUT_INTERFACE_CANCONNECTORCODECFACTORY_H
 
 // Project includes
-#include "CANConnectorCodec.h"
+#include "CANConnectorCodecV2.h"
+#include "LegacyCodecAdapter.h"
 #include "InterfaceLogger.h"
 
 // Codec includes.
 #include "BmwCodec.h"
+#include "DbcCodec.h"
 
 /**
  * The name of the BMW CAN codec.
  */
 #define CODEC_NAME_BMW "BmwCodec"
 
+/**
+ * The name of the generic DBC codec.
+ */
+#define CODEC_NAME_DBC "DbcCodec"
+
 namespace sim_interface::dut_connector::can {
 
     /**
@@ -52,12 +59,14 @@ namespace sim_interface::dut_connector::can {
 
         /**
          * Creates the requested CAN codec.
+         * Codecs that implement the legacy CANConnectorCodec interface are wrapped in a LegacyCodecAdapter.
          *
          * @param codecName - The name of the codec that should be created.
+         * @param dbcFile   - The DBC file for codecs that are described by a DBC file.
          *
          * @return The CAN codec.
          */
-        static CANConnectorCodec *createCodec(const std::string &codecName);
+        static CANConnectorCodecV2 *createCodec(const std::string &codecName, const std::string &dbcFile = "");
     };
 
 }
@@ -0,0 +1,180 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_CANCONNECTORCODECV2_H
+#define SIM_TO_DUT_INTERFACE_CANCONNECTORCODECV2_H
+
+// Project includes
+#include "../../Events/SimEvent.h"
+#include "InterfaceLogger.h"
+
+// System includes
+#include <string>
+#include <vector>
+#include <linux/can.h>
+
+/**
+ * Handle for a SimEvent that does not result in a send operation.
+ */
+#define INVALID_SEND_OPERATION (-1)
+
+namespace sim_interface::dut_connector::can {
+
+    /**
+     * <summary>
+     * Receives the simulation events that a codec decoded from a CAN/CANFD frame.
+     * </summary>
+     */
+    class SimEventSink {
+
+    public:
+
+        /**
+         * Destructor.
+         */
+        virtual ~SimEventSink() = default;
+
+        /**
+         * Takes a decoded simulation event.
+         *
+         * @param event - The simulation event that was contained in the CAN/CANFD frame.
+         */
+        virtual void push(SimEvent &&event) = 0;
+    };
+
+    /**
+     * <summary>
+     * The result of encoding a simulation event.
+     * </summary>
+     */
+    struct EncodeResult {
+        int sendOperation = INVALID_SEND_OPERATION; /**< Handle of the send operation, see bindSendOperations. */
+        __u32 nframes = 0;                          /**< Number of frames the codec wrote.                    */
+    };
+
+    /**
+     * <summary>
+     * The allocation-free codec interface. The codec writes the payloads directly into frames
+     * provided by the CAN Connector, identifies the send operation by a handle that was resolved
+     * once at startup and passes decoded simulation events to a sink.
+     * </summary>
+     */
+    class CANConnectorCodecV2 {
+
+    public:
+
+        /**
+         * Destructor.
+         */
+        virtual ~CANConnectorCodecV2() = default;
+
+        /**
+         * Resolves the send operations once before the first encode call.
+         * The handle of a send operation is its index in the given list.
+         *
+         * @param sendOperations - The names of all send operations of the CAN Connector config.
+         */
+        virtual void bindSendOperations(const std::vector<std::string> &sendOperations) = 0;
+
+        /**
+         * Checks if the codec can encode a simulation event. A connector with several codecs uses it
+         * once at startup to route each operation to its codec. The default accepts all operations.
+         *
+         * @param operation - The operation of the simulation event.
+         *
+         * @return True if the codec can encode events of the operation.
+         */
+        virtual bool supportsOperation(const std::string &operation) const {
+            return true;
+        }
+
+        /**
+         * Computes the content mask of a received CAN ID for the receive filter of the CAN Connector. The mask has
+         * the bits of all signals set that the codec passes to the simulation. Alive counters, checksums and unused
+         * bits are left out, so the filter only reports frames in which a relevant signal changed.
+         * The default has no mask, i.e. every received frame is passed to the codec.
+         *
+         * @param canID - The received CAN ID.
+         * @param mask  - The mask, the codec sets len and the data.
+         *
+         * @return True if the codec wrote a mask for the CAN ID.
+         */
+        virtual bool receiveMask(canid_t canID, struct canfd_frame &mask) const {
+            return false;
+        }
+
+        /**
+         * Encodes a simulation event into the given frames. The codec sets len and writes len bytes of
+         * data of each frame it uses. The CAN ID, the flags and the data after len are set by the CAN Connector.
+         *
+         * @param event     - The simulation event we want to transform into CAN/CANFD frame payloads.
+         * @param frames    - The frames the payloads are written to, in sequence order.
+         * @param maxFrames - The number of frames that can be written.
+         *
+         * @return The handle of the send operation and the number of written frames.
+         */
+        virtual EncodeResult encode(const SimEvent &event, struct canfd_frame frames[], __u32 maxFrames) = 0;
+
+        /**
+         * Patches a frame of a cyclic send operation right before it is sent by the userspace scheduler of the
+         * CAN Connector, e.g. the alive counters and checksums that have to change with every transmission.
+         * The frame holds the payload of the last encode call. The default leaves the frame unchanged.
+         *
+         * Note: Called on the io context of the CAN Connector, concurrently to encode.
+         *
+         * @param sendOperation - The handle of the send operation.
+         * @param transmission  - The number of previous transmissions of the send operation.
+         * @param frame         - The frame that is sent.
+         */
+        virtual void patchCyclicFrame(int sendOperation, uint64_t transmission, struct canfd_frame &frame) const {}
+
+        /**
+         * Decodes a CAN/CANFD frame into the corresponding simulation events.
+         *
+         * @param frame   - The frame that we want to transform.
+         * @param isCanfd - Flag for CANFD frames.
+         * @param sink    - The sink that takes the simulation events that were contained in the frame.
+         */
+        virtual void decode(const struct canfd_frame &frame, bool isCanfd, SimEventSink &sink) = 0;
+
+        /**
+         * Decodes a batch of CAN/CANFD frames with the same CAN ID, e.g. when a recorded bus is replayed.
+         * The events are passed to the sink in frame order. The default implementation decodes the frames
+         * one by one, codecs can override it to decode the signals of all frames at once.
+         *
+         * @param frames  - The frames that we want to transform, all with the same CAN ID.
+         * @param count   - The number of frames.
+         * @param isCanfd - Flag for CANFD frames.
+         * @param sink    - The sink that takes the simulation events that were contained in the frames.
+         */
+        virtual void decodeBatch(const struct canfd_frame frames[], size_t count, bool isCanfd, SimEventSink &sink) {
+            for (size_t index = 0; index < count; index++) {
+                decode(frames[index], isCanfd, sink);
+            }
+        }
+    };
+
+}
+
+#endif //SIM_TO_DUT_INTERFACE_CANCONNECTORCODECV2_H
@@ -0,0 +1,265 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_BITFIELD_H
+#define SIM_TO_DUT_INTERFACE_BITFIELD_H
+
+// System includes
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace sim_interface::dut_connector::can::bitfield {
+
+    /**
+     * Flag if the host uses big endian, known at compile time (std::endian needs C++20).
+     */
+    constexpr bool HOST_IS_BIG_ENDIAN = __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__;
+
+    /**
+     * Reverses the byte order of an integer.
+     *
+     * @param value - The integer (1, 2, 4 or 8 bytes).
+     *
+     * @return The integer with the reversed byte order.
+     */
+    template<typename T>
+    constexpr T byteSwap(T value) {
+        static_assert(std::is_integral_v<T>, "byteSwap needs an integer type");
+
+        using Unsigned = std::make_unsigned_t<T>;
+        auto bits = static_cast<Unsigned>(value);
+
+        if constexpr (sizeof(T) == 1) {
+            return value;
+        } else if constexpr (sizeof(T) == 2) {
+            return static_cast<T>(__builtin_bswap16(bits));
+        } else if constexpr (sizeof(T) == 4) {
+            return static_cast<T>(__builtin_bswap32(bits));
+        } else {
+            static_assert(sizeof(T) == 8, "byteSwap supports integers with 1, 2, 4 or 8 bytes");
+            return static_cast<T>(__builtin_bswap64(bits));
+        }
+    }
+
+    /**
+     * Converts an integer between host order and little endian (the conversion is its own inverse).
+     */
+    template<typename T>
+    constexpr T littleEndian(T value) {
+        if constexpr (HOST_IS_BIG_ENDIAN) {
+            return byteSwap(value);
+        } else {
+            return value;
+        }
+    }
+
+    /**
+     * Converts an integer between host order and big endian (the conversion is its own inverse).
+     */
+    template<typename T>
+    constexpr T bigEndian(T value) {
+        if constexpr (HOST_IS_BIG_ENDIAN) {
+            return value;
+        } else {
+            return byteSwap(value);
+        }
+    }
+
+    /**
+     * Reads an unaligned integer in little or big endian order from a buffer.
+     *
+     * @param data        - The first byte of the integer.
+     * @param isBigEndian - Flag for big endian (Motorola) order.
+     *
+     * @return The integer in host order.
+     */
+    template<typename T>
+    inline T load(const uint8_t data[], bool isBigEndian = false) {
+        T value;
+        std::memcpy(&value, data, sizeof(value));
+        return isBigEndian ? bigEndian(value) : littleEndian(value);
+    }
+
+    /**
+     * Writes an unaligned integer in little or big endian order into a buffer.
+     *
+     * @param data        - The first byte of the integer.
+     * @param value       - The integer in host order.
+     * @param isBigEndian - Flag for big endian (Motorola) order.
+     */
+    template<typename T>
+    inline void store(uint8_t data[], T value, bool isBigEndian = false) {
+        value = isBigEndian ? bigEndian(value) : littleEndian(value);
+        std::memcpy(data, &value, sizeof(value));
+    }
+
+    /**
+     * <summary>
+     * Position of a signal with an arbitrary bit position and length in a CAN payload.
+     * </summary>
+     * The signal is stored from its least significant bit: lsbBit of byte lsbByte, then the following bytes
+     * (Intel) or the preceding bytes (Motorola). This way both byte orders share one kernel.
+     */
+    struct BitField {
+        uint16_t lsbByte = 0;         /**< The byte of the least significant bit.               */
+        uint8_t lsbBit = 0;           /**< The bit of the least significant bit in that byte.   */
+        int8_t byteStep = 1;          /**< +1 for Intel, -1 for Motorola.                       */
+        uint8_t length = 0;           /**< The length of the signal in bits (1..64).            */
+    };
+
+    /**
+     * Creates the position of an Intel (little endian) signal.
+     *
+     * @param startBit - The least significant bit, counted upwards through the bytes like in DBC files.
+     * @param length   - The length in bits.
+     *
+     * @return The position of the signal.
+     */
+    constexpr BitField intelField(uint32_t startBit, uint32_t length) {
+        return {static_cast<uint16_t>(startBit / 8), static_cast<uint8_t>(startBit % 8), 1,
+                static_cast<uint8_t>(length)};
+    }
+
+    /**
+     * Creates the position of a Motorola (big endian) signal.
+     *
+     * @param startBit - The most significant bit in the sawtooth numbering of DBC files.
+     * @param length   - The length in bits.
+     *
+     * @return The position of the signal.
+     */
+    constexpr BitField motorolaField(uint32_t startBit, uint32_t length) {
+        // Counted from the most significant bit of byte 0, the least significant bit is length - 1 bits later
+        uint32_t msbIndex = (startBit / 8) * 8 + (7 - startBit % 8);
+        uint32_t lsbIndex = msbIndex + length - 1;
+        return {static_cast<uint16_t>(lsbIndex / 8), static_cast<uint8_t>(7 - lsbIndex % 8), -1,
+                static_cast<uint8_t>(length)};
+    }
+
+    /**
+     * @return The number of bytes a signal touches.
+     */
+    constexpr size_t byteCount(const BitField &field) {
+        return (field.lsbBit + field.length + 7) / 8;
+    }
+
+    /**
+     * @return The index of the byte of the most significant bit.
+     */
+    constexpr int lastByte(const BitField &field) {
+        return field.lsbByte + field.byteStep * (static_cast<int>(byteCount(field)) - 1);
+    }
+
+    /**
+     * @return A mask with the lowest length bits set.
+     */
+    constexpr uint64_t lowMask(uint32_t length) {
+        return length >= 64 ? ~uint64_t{0} : (uint64_t{1} << length) - 1;
+    }
+
+    /**
+     * Sign extension of a two's complement value.
+     *
+     * @param raw    - The raw bits of the signal.
+     * @param length - The length of the signal in bits.
+     *
+     * @return The signed value.
+     */
+    constexpr int64_t signExtend(uint64_t raw, uint32_t length) {
+        uint64_t signBit = uint64_t{1} << (length - 1);
+        return static_cast<int64_t>(((raw & lowMask(length)) ^ signBit) - signBit);
+    }
+
+    /**
+     * Reads the part of a signal in its chunk-th byte (counted from the least significant bit).
+     * With constant arguments all shifts and masks are folded, see the generated codecs.
+     */
+    constexpr uint64_t extractChunk(const uint8_t data[], const BitField &field, size_t chunk) {
+        int bit = chunk == 0 ? field.lsbBit : 0;
+        int shift = chunk == 0 ? 0 : 8 - field.lsbBit + 8 * (static_cast<int>(chunk) - 1);
+        int bits = field.length - shift < 8 - bit ? field.length - shift : 8 - bit;
+        int byte = field.lsbByte + field.byteStep * static_cast<int>(chunk);
+        return static_cast<uint64_t>((data[byte] >> bit) & ((1u << bits) - 1)) << shift;
+    }
+
+    /**
+     * Writes the part of a signal in its chunk-th byte (counted from the least significant bit).
+     * The other bits of the byte are kept.
+     */
+    constexpr void insertChunk(uint8_t data[], const BitField &field, size_t chunk, uint64_t raw) {
+        int bit = chunk == 0 ? field.lsbBit : 0;
+        int shift = chunk == 0 ? 0 : 8 - field.lsbBit + 8 * (static_cast<int>(chunk) - 1);
+        int bits = field.length - shift < 8 - bit ? field.length - shift : 8 - bit;
+        int byte = field.lsbByte + field.byteStep * static_cast<int>(chunk);
+        auto mask = static_cast<uint8_t>(((1u << bits) - 1) << bit);
+        data[byte] = static_cast<uint8_t>((data[byte] & ~mask) | (((raw >> shift) << bit) & mask));
+    }
+
+    /**
+     * Reads the raw bits of a signal.
+     *
+     * @param data  - The payload.
+     * @param field - The position of the signal.
+     *
+     * @return The raw bits, the bits above the length are zero.
+     */
+    constexpr uint64_t extract(const uint8_t data[], const BitField &field) {
+        uint64_t raw = 0;
+        for (size_t chunk = 0; chunk < byteCount(field); chunk++) {
+            raw |= extractChunk(data, field, chunk);
+        }
+        return raw;
+    }
+
+    /**
+     * Reads a two's complement signal.
+     *
+     * @param data  - The payload.
+     * @param field - The position of the signal.
+     *
+     * @return The sign extended value.
+     */
+    constexpr int64_t extractSigned(const uint8_t data[], const BitField &field) {
+        return signExtend(extract(data, field), field.length);
+    }
+
+    /**
+     * Writes the raw bits of a signal, the bits of the other signals are kept.
+     * Bits of raw above the length are ignored, so negative values can be passed directly.
+     *
+     * @param data  - The payload.
+     * @param field - The position of the signal.
+     * @param raw   - The raw bits.
+     */
+    constexpr void insert(uint8_t data[], const BitField &field, uint64_t raw) {
+        for (size_t chunk = 0; chunk < byteCount(field); chunk++) {
+            insertChunk(data, field, chunk, raw);
+        }
+    }
+
+}
+
+#endif //SIM_TO_DUT_INTERFACE_BITFIELD_H
@@ -0,0 +1,164 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+// Project includes
+#include "BitField.h"
+
+// Compile-time checks of the bit-field kernel. The translation unit contains no code,
+// a wrong kernel stops the build.
+namespace sim_interface::dut_connector::can::bitfield {
+
+    namespace {
+
+        struct Payload {
+            uint8_t data[8] = {};
+        };
+
+        constexpr Payload packed(const BitField &field, uint64_t raw) {
+            Payload payload;
+            insert(payload.data, field, raw);
+            return payload;
+        }
+
+        constexpr bool equals(const Payload &payload, const Payload &expected) {
+            for (size_t index = 0; index < 8; index++) {
+                if (payload.data[index] != expected.data[index]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        constexpr bool roundTrip(const BitField &field, uint64_t raw) {
+            Payload payload = packed(field, raw);
+            return extract(payload.data, field) == (raw & lowMask(field.length));
+        }
+
+        // Round trip of every position and length of both byte orders that fits into 8 bytes
+        constexpr bool roundTripAll() {
+            for (uint32_t length = 1; length <= 64; length++) {
+                for (uint32_t startBit = 0; startBit + length <= 64; startBit++) {
+                    uint64_t pattern = 0xA5C3F00F96695AA5 ^ (uint64_t{startBit} * 0x0101010101010101);
+                    if (!roundTrip(intelField(startBit, length), pattern) ||
+                        !roundTrip(intelField(startBit, length), ~pattern)) {
+                        return false;
+                    }
+                    // The Motorola start bit of a signal that ends in the last bit of the payload
+                    uint32_t lsbIndex = 63 - startBit;
+                    uint32_t msbIndex = lsbIndex - (length - 1);
+                    uint32_t motorolaStart = (msbIndex / 8) * 8 + (7 - msbIndex % 8);
+                    if (!roundTrip(motorolaField(motorolaStart, length), pattern) ||
+                        !roundTrip(motorolaField(motorolaStart, length), ~pattern)) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // Payload with a different value in every byte, so a write to the wrong byte is seen
+        constexpr Payload filled(uint8_t fill) {
+            Payload payload;
+            for (size_t index = 0; index < 8; index++) {
+                payload.data[index] = static_cast<uint8_t>(fill ^ (index * 0x3C));
+            }
+            return payload;
+        }
+
+        // Bit by bit reference: writes bit by bit along the DBC numbering, from the least significant bit upwards
+        // (Intel) or from the start bit along the sawtooth downwards (Motorola)
+        constexpr Payload referencePacked(Payload payload, bool isMotorola, uint32_t startBit, uint32_t length,
+                                          uint64_t raw) {
+            uint32_t position = startBit;
+            for (uint32_t bit = 0; bit < length; bit++) {
+                uint32_t signalBit = isMotorola ? length - 1 - bit : bit;
+                auto mask = static_cast<uint8_t>(1u << (position % 8));
+                payload.data[position / 8] = static_cast<uint8_t>(((raw >> signalBit) & 1)
+                                                                  ? payload.data[position / 8] | mask
+                                                                  : payload.data[position / 8] & ~mask);
+                position = !isMotorola ? position + 1 : position % 8 == 0 ? position + 15 : position - 1;
+            }
+            return payload;
+        }
+
+        // The Motorola signal ends in the payload
+        constexpr bool fitsMotorola(uint32_t startBit, uint32_t length) {
+            return motorolaField(startBit, length).lsbByte < 8;
+        }
+
+        // insert writes exactly the bits of the reference and keeps all other bits of a filled payload,
+        // extract reads the value back
+        constexpr bool keepsOtherBits(bool isMotorola, uint32_t startBit, uint32_t length, uint8_t fill,
+                                      uint64_t raw) {
+            BitField field = isMotorola ? motorolaField(startBit, length) : intelField(startBit, length);
+            Payload payload = filled(fill);
+            insert(payload.data, field, raw);
+            return equals(payload, referencePacked(filled(fill), isMotorola, startBit, length, raw)) &&
+                   extract(payload.data, field) == (raw & lowMask(length));
+        }
+
+        // Every start bit of both byte orders with every length of the range that fits into 8 bytes,
+        // split into ranges to keep each constant evaluation small
+        constexpr bool keepsOtherBitsAll(uint32_t firstLength, uint32_t lastLength) {
+            for (uint32_t length = firstLength; length <= lastLength; length++) {
+                for (uint32_t startBit = 0; startBit < 64; startBit++) {
+                    uint64_t pattern = 0x5AC3F00F9669A55A ^ (uint64_t{startBit} * 0x0101010101010101);
+                    if ((startBit + length <= 64 && (!keepsOtherBits(false, startBit, length, 0xFF, pattern) ||
+                                                     !keepsOtherBits(false, startBit, length, 0x00, ~pattern))) ||
+                        (fitsMotorola(startBit, length) && (!keepsOtherBits(true, startBit, length, 0xFF, pattern) ||
+                                                            !keepsOtherBits(true, startBit, length, 0x00, ~pattern)))) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        static_assert(byteSwap(uint16_t{0x1122}) == 0x2211);
+        static_assert(byteSwap(int32_t{0x11223344}) == 0x44332211);
+        static_assert(byteSwap(uint64_t{0x1122334455667788}) == 0x8877665544332211);
+        static_assert(bigEndian(littleEndian(byteSwap(uint32_t{0xDEADBEEF}))) == 0xDEADBEEF);
+
+        static_assert(lastByte(motorolaField(7, 16)) == 0 && motorolaField(7, 16).lsbByte == 1);
+        static_assert(lastByte(intelField(4, 12)) == 1 && intelField(4, 12).lsbBit == 4);
+        static_assert(signExtend(0xFFF, 12) == -1 && signExtend(0x7FF, 12) == 2047);
+        static_assert(signExtend(~uint64_t{0}, 64) == -1);
+
+        static_assert(equals(packed(intelField(0, 16), 0x1234), {{0x34, 0x12}}));
+        static_assert(equals(packed(motorolaField(7, 16), 0x1234), {{0x12, 0x34}}));
+        static_assert(equals(packed(intelField(4, 8), 0xAB), {{0xB0, 0x0A}}));
+        static_assert(equals(packed(motorolaField(3, 8), 0xAB), {{0x0A, 0xB0}}));
+        static_assert(equals(packed(intelField(0, 64), 0x0102030405060708),
+                             {{0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01}}));
+        static_assert(extractSigned(packed(motorolaField(39, 12), static_cast<uint64_t>(-5)).data,
+                                    motorolaField(39, 12)) == -5);
+        static_assert(roundTripAll());
+        static_assert(fitsMotorola(7, 64) && !fitsMotorola(6, 64) && fitsMotorola(63, 8) && !fitsMotorola(63, 9));
+        static_assert(keepsOtherBitsAll(1, 8));
+        static_assert(keepsOtherBitsAll(9, 16));
+        static_assert(keepsOtherBitsAll(17, 32));
+        static_assert(keepsOtherBitsAll(33, 64));
+    }
+
+}
@@ -30,78 +30,156 @@
 
 namespace sim_interface::dut_connector::can {
 
-    BmwCodec::BmwCodec() : hostIsBigEndian(CodecUtilities::checkBigEndianness()) {
+    BmwCodec::BmwCodec() {
+
+        // The shadow frames start with all signal values at zero. ACLNXCOG and DVCOVEH are not part of the
+        // simulation and keep this payload. The 0x279 LICHTER frame does not need a shadow frame because the
+        // frame can be build with only one SimEvent
+        geschwindigkeitFrame.len = 8;
+        bitfield::insert(geschwindigkeitFrame.data, V_VEHCOG_FIELD,
+                         (uint16_t) (0 / V_VEHCOG_SCALING - V_VEHCOG_OFFSET));
+        bitfield::insert(geschwindigkeitFrame.data, VYAWVEH_FIELD,
+                         (uint16_t) (0 / VYAWVEH_SCALING - VYAWVEH_OFFSET));
+        bitfield::insert(geschwindigkeitFrame.data, ACLNYCOG_FIELD,
+                         (uint16_t) (0 / ACLNYCOG_SCALING - ACLNYCOG_OFFSET));
+        bitfield::insert(geschwindigkeitFrame.data, ACLNXCOG_FIELD,
+                         (uint16_t) (0 / ACLNXCOG_SCALING - ACLNXCOG_OFFSET));
+
+        gpsLocaFrame.len = 8;
+        bitfield::insert(gpsLocaFrame.data, ST_LONGNAVI_FIELD,
+                         static_cast<uint32_t>((int32_t) (0 / ST_LONGNAVI_SCALING - ST_LONGNAVI_OFFSET)));
+        bitfield::insert(gpsLocaFrame.data, ST_LATNAVI_FIELD,
+                         static_cast<uint32_t>((int32_t) (0 / ST_LATNAVI_SCALING - ST_LATNAVI_OFFSET)));
+
+        gpsLocbFrame.len = 4;
+        bitfield::insert(gpsLocbFrame.data, ST_HGNAVI_FIELD,
+                         static_cast<uint16_t>((int16_t) (0 / ST_HGNAVI_SCALING - ST_HGNAVI_OFFSET)));
+        bitfield::insert(gpsLocbFrame.data, ST_HDG_HRZTLABSL_FIELD,
+                         (uint8_t) (0 / ST_HDG_HRZTLABSL_SCALING - ST_HDG_HRZTLABSL_OFFSET));
+        bitfield::insert(gpsLocbFrame.data, DVCOVEH_FIELD, (uint8_t) (0 / DVCOVEH_SCALING - DVCOVEH_OFFSET));
+    }
+
+    void BmwCodec::bindSendOperations(const std::vector<std::string> &sendOperations) {
+
+        // Send operations that are not configured keep the invalid handle
+        for (size_t index = 0; index < sendOperations.size(); index++) {
+            const auto &sendOperation = sendOperations[index];
+
+            if (sendOperation == GESCHWINDIGKEIT_SENDOPERATION) {
+                geschwindigkeitHandle = static_cast<int>(index);
+            } else if (sendOperation == GPS_LOCA_SENDOPERATION) {
+                gpsLocaHandle = static_cast<int>(index);
+            } else if (sendOperation == GPS_LOCB_SENDOPERATION) {
+                gpsLocbHandle = static_cast<int>(index);
+            } else if (sendOperation == LICHTER_SENDOPERATION) {
+                lichterHandle = static_cast<int>(index);
+            }
+        }
+    }
+
+    bool BmwCodec::supportsOperation(const std::string &operation) const {
+        return operation == "Speed_Dynamics" || operation == "YawRate_Dynamics" ||
+               operation == "Acceleration_Dynamics" || operation == "Latitude_Dynamics" ||
+               operation == "Longitude_Dynamics" || operation == "Position_Z_Coordinate_DUT" ||
+               operation == "Heading_Dynamics" || operation == "Signals_DUT";
+    }
+
+    bool BmwCodec::receiveMask(canid_t canID, struct canfd_frame &mask) const {
+
+        mask = {0};
+        mask.can_id = canID;
+
+        switch (canID) {
+
+            case 0x111:
+
+                // 0x275 GESCHWINDIGKEIT frame, the X acceleration is not decoded
+                mask.len = 8;
+                bitfield::insert(mask.data, V_VEHCOG_FIELD, bitfield::lowMask(16));
+                bitfield::insert(mask.data, VYAWVEH_FIELD, bitfield::lowMask(16));
+                bitfield::insert(mask.data, ACLNYCOG_FIELD, bitfield::lowMask(16));
+                return true;
+
+            case 0x222:
+
+                // 0x273 GPS_LOCA frame
+                mask.len = 8;
+                bitfield::insert(mask.data, ST_LONGNAVI_FIELD, bitfield::lowMask(32));
+                bitfield::insert(mask.data, ST_LATNAVI_FIELD, bitfield::lowMask(32));
+                return true;
+
+            case 0x333:
 
-        // Init cachedSimEventValues with zero
+                // 0x274 GPS_LOCB frame, DVCOVEH is not decoded
+                mask.len = 4;
+                bitfield::insert(mask.data, ST_HGNAVI_FIELD, bitfield::lowMask(16));
+                bitfield::insert(mask.data, ST_HDG_HRZTLABSL_FIELD, bitfield::lowMask(8));
+                return true;
 
-        // SimEvents for the 0x275 GESCHWINDIGKEIT frame
-        cachedSimEventValues["Speed_Dynamics"] = 0;
-        cachedSimEventValues["YawRate_Dynamics"] = 0;
-        cachedSimEventValues["Acceleration_Dynamics"] = 0;
+            case 0x444:
 
-        // SimEvents for the 0x273 GPS_LOCA frame
-        cachedSimEventValues["Latitude_Dynamics"] = 0;
-        cachedSimEventValues["Longitude_Dynamics"] = 0;
+                // 0x279 LICHTER frame, only the light bits that are decoded
+                mask.len = 2;
+                bitfield::insert(mask.data, LICHTER_FIELD, 0x0800 | 0x1000 | 0x0004);
+                return true;
 
-        // SimEvents for the 0x274 GPS_LOCB frame
-        cachedSimEventValues["Position_Z_Coordinate_DUT"] = 0;
-        cachedSimEventValues["Heading_Dynamics"] = 0;
+            default:
 
-        // SimEvents for the  0x279 LICHTER frame
-        // Does not need a cache because the frame can be build with only one SimEvent
+                return false;
+        }
     }
 
-    std::pair<std::vector<__u8>, std::string> BmwCodec::convertSimEventToFrame(SimEvent event) {
+    EncodeResult BmwCodec::encode(const SimEvent &event, struct canfd_frame frames[], __u32 maxFrames) {
 
-        auto result = std::pair<std::vector<__u8>, std::string>();
+        // All BMW frames are single frames
+        if (maxFrames < 1) {
+            return {};
+        }
 
         if (event.operation == "Speed_Dynamics" || event.operation == "YawRate_Dynamics" ||
             event.operation == "Acceleration_Dynamics") {
-            result = encodeGeschwindigkeit(event);
+            return encodeGeschwindigkeit(event, frames[0]);
         } else if (event.operation == "Latitude_Dynamics" || event.operation == "Longitude_Dynamics") {
-            result = encodeGPS_LOCA(event);
+            return encodeGPS_LOCA(event, frames[0]);
         } else if (event.operation == "Position_Z_Coordinate_DUT" || event.operation == "Heading_Dynamics") {
-            result = encodeGPS_LOCB(event);
+            return encodeGPS_LOCB(event, frames[0]);
         } else if (event.operation == "Signals_DUT") {
-            result = encodeLichter(event);
+            return encodeLichter(event, frames[0]);
         } else {
             InterfaceLogger::logMessage(
                     "CAN Connector: BMW codec received unknown operation: <" + event.operation + ">",
                     LOG_LEVEL::WARNING);
         }
 
-        return result;
+        return {};
     }
 
-    std::vector<SimEvent> BmwCodec::convertFrameToSimEvent(struct canfd_frame frame, bool isCanfd) {
-
-        // Vector that contains the resulting simulation events
-        std::vector<SimEvent> events;
+    void BmwCodec::decode(const struct canfd_frame &frame, bool isCanfd, SimEventSink &sink) {
 
         switch (frame.can_id) {
 
             case 0x111:
 
                 // 0x275 GESCHWINDIGKEIT frame
-                events = decodeGeschwindigkeit(frame, isCanfd);
+                decodeGeschwindigkeit(frame, isCanfd, sink);
                 break;
 
             case 0x222:
 
                 // 0x273 GPS_LOCA frame
-                events = decodeGPS_LOCA(frame, isCanfd);
+                decodeGPS_LOCA(frame, isCanfd, sink);
                 break;
 
             case 0x333:
 
                 // 0x274 GPS_LOCB frame
-                events = decodeGPS_LOCB(frame, isCanfd);
+                decodeGPS_LOCB(frame, isCanfd, sink);
                 break;
 
             case 0x444:
 
                 // 0x279 LICHTER frame
-                events = decodeLichter(frame, isCanfd);
+                decodeLichter(frame, isCanfd, sink);
                 break;
 
             default:
@@ -110,134 +188,82 @@ namespace sim_interface::dut_connector::can {
                                             "<" + std::to_string(frame.can_id) + ">", LOG_LEVEL::WARNING);
 
         }
-
-        return events;
     }
 
-    std::pair<std::vector<__u8>, std::string> BmwCodec::encodeGeschwindigkeit(SimEvent event) {
-
-        auto result = std::pair<std::vector<__u8>, std::string>();
+    double BmwCodec::getDoubleValue(const SimEvent &event) {
 
         if (event.value.type() != typeid(double)) {
             throw std::invalid_argument("BMW Codec: SimEvent value type invalid");
         }
 
-        // Cash the value of the event
-        cachedSimEventValues[event.operation] = boost::get<double>(event.value);
-
-        // Get the current event values
-        double realSpeed = cachedSimEventValues["Speed_Dynamics"];
-        double realAngularVelocity = cachedSimEventValues["YawRate_Dynamics"];
-        double realAccelerationY = cachedSimEventValues["Acceleration_Dynamics"];
-        double realAccelerationX = 0;
-
-        // Apply the scaling and offset
-        auto rawSpeed = (uint16_t) (realSpeed / V_VEHCOG_SCALING - V_VEHCOG_OFFSET);
-        auto rawAngularVelocity = (uint16_t) (realAngularVelocity / VYAWVEH_SCALING - VYAWVEH_OFFSET);
-        auto rawAccelerationY = (uint16_t) (realAccelerationY / ACLNYCOG_SCALING - ACLNYCOG_OFFSET);
-        auto rawAccelerationX = (uint16_t) (realAccelerationX / ACLNXCOG_SCALING - ACLNXCOG_OFFSET);
-
-        // Convert to host order
-        if (hostIsBigEndian) {
-            rawSpeed = CodecUtilities::convertEndianness(rawSpeed);
-            rawAngularVelocity = CodecUtilities::convertEndianness(rawAngularVelocity);
-            rawAccelerationY = CodecUtilities::convertEndianness(rawAccelerationY);
-            rawAccelerationX = CodecUtilities::convertEndianness(rawAccelerationX);
-        }
-
-        result.first = std::vector<__u8>{
-                (uint8_t) rawSpeed, (uint8_t) (rawSpeed >> 8),
-                (uint8_t) rawAngularVelocity, (uint8_t) (rawAngularVelocity >> 8),
-                (uint8_t) rawAccelerationY, (uint8_t) (rawAccelerationY >> 8),
-                (uint8_t) rawAccelerationX, (uint8_t) (rawAccelerationX >> 8),
-        };
-
-        result.second = GESCHWINDIGKEIT_SENDOPERATION;
-        return result;
+        return boost::get<double>(event.value);
     }
 
-    std::pair<std::vector<__u8>, std::string> BmwCodec::encodeGPS_LOCA(SimEvent event) {
-
-        auto result = std::pair<std::vector<__u8>, std::string>();
+    EncodeResult BmwCodec::encodeGeschwindigkeit(const SimEvent &event, struct canfd_frame &frame) {
 
-        if (event.value.type() != typeid(double)) {
-            throw std::invalid_argument("BMW Codec: SimEvent value type invalid");
-        }
-
-        // Cash the value of the event
-        cachedSimEventValues[event.operation] = boost::get<double>(event.value);
-
-        // Get the current event values
-        double realLongitude = cachedSimEventValues["Longitude_Dynamics"];
-        double realLatitude = cachedSimEventValues["Latitude_Dynamics"];
-
-        // Apply the scaling and offset
-        auto rawLongitude = (int32_t) (realLongitude / ST_LONGNAVI_SCALING - ST_LONGNAVI_OFFSET);
-        auto rawLatitude = (int32_t) (realLatitude / ST_LATNAVI_SCALING - ST_LATNAVI_OFFSET);
-
-        // Convert to host order
-        if (hostIsBigEndian) {
-            rawLongitude = CodecUtilities::convertEndianness(rawLongitude);
-            rawLatitude = CodecUtilities::convertEndianness(rawLatitude);
+        // Apply the scaling and offset and patch only the signal of the event into the shadow frame
+        double value = getDoubleValue(event);
+        if (event.operation == "Speed_Dynamics") {
+            auto rawSpeed = (uint16_t) (value / V_VEHCOG_SCALING - V_VEHCOG_OFFSET);
+            bitfield::insert(geschwindigkeitFrame.data, V_VEHCOG_FIELD, rawSpeed);
+        } else if (event.operation == "YawRate_Dynamics") {
+            auto rawAngularVelocity = (uint16_t) (value / VYAWVEH_SCALING - VYAWVEH_OFFSET);
+            bitfield::insert(geschwindigkeitFrame.data, VYAWVEH_FIELD, rawAngularVelocity);
+        } else {
+            // The simulation has only one acceleration, it is sent as the Y acceleration
+            auto rawAccelerationY = (uint16_t) (value / ACLNYCOG_SCALING - ACLNYCOG_OFFSET);
+            bitfield::insert(geschwindigkeitFrame.data, ACLNYCOG_FIELD, rawAccelerationY);
         }
 
-        result.first = std::vector<__u8>{
-                (uint8_t) rawLongitude, (uint8_t) (rawLongitude >> 8),
-                (uint8_t) (rawLongitude >> 16), (uint8_t) (rawLongitude >> 24),
-                (uint8_t) rawLatitude, (uint8_t) (rawLatitude >> 8),
-                (uint8_t) (rawLatitude >> 16), (uint8_t) (rawLatitude >> 24),
-        };
-
-        result.second = GPS_LOCA_SENDOPERATION;
-        return result;
+        copyShadowFrame(geschwindigkeitFrame, frame);
+        return {geschwindigkeitHandle, 1};
     }
 
-    std::pair<std::vector<__u8>, std::string> BmwCodec::encodeGPS_LOCB(SimEvent event) {
-
-        auto result = std::pair<std::vector<__u8>, std::string>();
+    EncodeResult BmwCodec::encodeGPS_LOCA(const SimEvent &event, struct canfd_frame &frame) {
 
-        if (event.value.type() != typeid(double)) {
-            throw std::invalid_argument("BMW Codec: SimEvent value type invalid");
+        // Apply the scaling and offset and patch only the signal of the event into the shadow frame
+        double value = getDoubleValue(event);
+        if (event.operation == "Longitude_Dynamics") {
+            auto rawLongitude = (int32_t) (value / ST_LONGNAVI_SCALING - ST_LONGNAVI_OFFSET);
+            bitfield::insert(gpsLocaFrame.data, ST_LONGNAVI_FIELD, static_cast<uint32_t>(rawLongitude));
+        } else {
+            auto rawLatitude = (int32_t) (value / ST_LATNAVI_SCALING - ST_LATNAVI_OFFSET);
+            bitfield::insert(gpsLocaFrame.data, ST_LATNAVI_FIELD, static_cast<uint32_t>(rawLatitude));
         }
 
-        // Cash the value of the event
-        cachedSimEventValues[event.operation] = boost::get<double>(event.value);
-
-        double realAltitude = cachedSimEventValues["Position_Z_Coordinate_DUT"];
-        double realHeading = cachedSimEventValues["Heading_Dynamics"];
-        double realDvcoveh = 0;
+        copyShadowFrame(gpsLocaFrame, frame);
+        return {gpsLocaHandle, 1};
+    }
 
-        auto rawAltitude = (int16_t) (realAltitude / ST_HGNAVI_SCALING - ST_HGNAVI_OFFSET);
-        auto rawHeading = (uint8_t) (realHeading / ST_HDG_HRZTLABSL_SCALING - ST_HDG_HRZTLABSL_OFFSET);
-        auto rawDvcoveh = (uint8_t) (realDvcoveh / DVCOVEH_SCALING - DVCOVEH_OFFSET);
+    EncodeResult BmwCodec::encodeGPS_LOCB(const SimEvent &event, struct canfd_frame &frame) {
 
-        // Convert to host order
-        if (hostIsBigEndian) {
-            rawAltitude = CodecUtilities::convertEndianness(rawAltitude);
-            // No need to convert rawHeading or rawDvcoveh (uint8_t) because it is a single byte
+        // Apply the scaling and offset and patch only the signal of the event into the shadow frame
+        double value = getDoubleValue(event);
+        if (event.operation == "Position_Z_Coordinate_DUT") {
+            auto rawAltitude = (int16_t) (value / ST_HGNAVI_SCALING - ST_HGNAVI_OFFSET);
+            bitfield::insert(gpsLocbFrame.data, ST_HGNAVI_FIELD, static_cast<uint16_t>(rawAltitude));
+        } else {
+            auto rawHeading = (uint8_t) (value / ST_HDG_HRZTLABSL_SCALING - ST_HDG_HRZTLABSL_OFFSET);
+            bitfield::insert(gpsLocbFrame.data, ST_HDG_HRZTLABSL_FIELD, rawHeading);
         }
 
-        result.first = std::vector<__u8>{
-                (uint8_t) rawAltitude, (uint8_t) (rawAltitude >> 8),
-                (uint8_t) rawHeading,
-                (uint8_t) rawDvcoveh,
-        };
-
-        result.second = GPS_LOCB_SENDOPERATION;
-        return result;
+        copyShadowFrame(gpsLocbFrame, frame);
+        return {gpsLocbHandle, 1};
     }
 
-    std::pair<std::vector<__u8>, std::string> BmwCodec::encodeLichter(SimEvent event) {
+    void BmwCodec::copyShadowFrame(const struct canfd_frame &shadowFrame, struct canfd_frame &frame) {
+        frame.len = shadowFrame.len;
+        std::memcpy(frame.data, shadowFrame.data, shadowFrame.len);
+    }
 
-        auto result = std::pair<std::vector<__u8>, std::string>();
+    EncodeResult BmwCodec::encodeLichter(const SimEvent &event, struct canfd_frame &frame) {
 
         if (event.value.type() != typeid(int)) {
             throw std::invalid_argument("BMW Codec: SimEvent value type invalid");
         }
 
         uint16_t rawSignals = boost::get<int>(event.value);
-        uint8_t canDataByte1 = 0;
-        uint8_t canDataByte2 = 0;
+        uint16_t rawLichter = 0;
 
         // DBC and traci:
         // Bit positions are counted from byte 0 upwards by their significance, regardless of the endianness.
@@ -246,52 +272,43 @@ namespace sim_interface::dut_connector::can {
 
         // Blinker Right:    Sumo bit 0      BMW bit 4
         if (rawSignals & 0x0001) {
-            canDataByte1 |= 0x10;
+            rawLichter |= 0x0010;
         }
 
         // Blinker Left:     Sumo bit 1      BMW bit 3
         if (rawSignals & 0x0002) {
-            canDataByte1 |= 0x04;
+            rawLichter |= 0x0004;
         }
 
         // Tagfahrlicht:     Sumo bit 4      Bmw bit 10
         if (rawSignals & 0x0008) {
-            canDataByte2 |= 0x04;
+            rawLichter |= 0x0400;
         }
 
-        result.first = std::vector<__u8>{canDataByte1, canDataByte2};
-        result.second = LICHTER_SENDOPERATION;
-        return result;
-    }
-
+        frame.len = 2;
+        std::memset(frame.data, 0, frame.len);
+        bitfield::insert(frame.data, LICHTER_FIELD, rawLichter);
 
-    std::vector<SimEvent> BmwCodec::decodeGeschwindigkeit(struct canfd_frame frame, bool isCanfd) {
+        return {lichterHandle, 1};
+    }
 
-        std::vector<SimEvent> events;
+    void BmwCodec::decodeGeschwindigkeit(const struct canfd_frame &frame, bool isCanfd, SimEventSink &sink) {
 
         // Check if we got a CAN frame
         if (isCanfd) {
             InterfaceLogger::logMessage(
                     "Got a CANFD frame but expected a CAN frame for the CAN ID 0x275 Geschwindigkeit",
                     LOG_LEVEL::ERROR);
-            return events;
+            return;
         }
 
-        struct can_frame canFrame = *((struct can_frame *) &frame);
-
-        // Get the raw values that should be in little endian order
-        uint16_t rawSpeed = canFrame.data[0] | (canFrame.data[1] << 8);
-        uint16_t rawAngularVelocity = canFrame.data[2] | (canFrame.data[3] << 8);
-        uint16_t rawAccelerationY = canFrame.data[4] | (canFrame.data[5] << 8);
-        uint16_t rawAccelerationX = canFrame.data[6] | (canFrame.data[7] << 8);
+        const auto &canFrame = *((const struct can_frame *) &frame);
 
-        // Convert to host order
-        if (hostIsBigEndian) {
-            rawSpeed = CodecUtilities::convertEndianness(rawSpeed);
-            rawAngularVelocity = CodecUtilities::convertEndianness(rawAngularVelocity);
-            rawAccelerationY = CodecUtilities::convertEndianness(rawAccelerationY);
-            rawAccelerationX = CodecUtilities::convertEndianness(rawAccelerationX);
-        }
+        // Read the little endian signals in host order
+        auto rawSpeed = static_cast<uint16_t>(bitfield::extract(canFrame.data, V_VEHCOG_FIELD));
+        auto rawAngularVelocity = static_cast<uint16_t>(bitfield::extract(canFrame.data, VYAWVEH_FIELD));
+        auto rawAccelerationY = static_cast<uint16_t>(bitfield::extract(canFrame.data, ACLNYCOG_FIELD));
+        auto rawAccelerationX = static_cast<uint16_t>(bitfield::extract(canFrame.data, ACLNXCOG_FIELD));
 
         // Apply the scaling and offset
         uint16_t realSpeed = rawSpeed * V_VEHCOG_SCALING + V_VEHCOG_OFFSET;
@@ -299,7 +316,7 @@ namespace sim_interface::dut_connector::can {
         uint16_t realAccelerationY = rawAccelerationY * ACLNYCOG_SCALING + ACLNYCOG_OFFSET;
         uint16_t realAccelerationX = rawAccelerationX * ACLNXCOG_SCALING + ACLNXCOG_OFFSET;
 
-        // Create the SimEvents and add them to the vector that will be sent to the simulation.
+        // Create the SimEvents and pass them to the sink that sends them to the simulation.
         // The simulation has only one acceleration. We only use the Y acceleration.
         SimEvent speed = SimEvent("Speed_DUT", static_cast<double>(realSpeed), "CanConnector");
         SimEvent yawRateDynamics = SimEvent("YawRate_Dynamics", static_cast<double>(realAngularVelocity),
@@ -307,103 +324,77 @@ namespace sim_interface::dut_connector::can {
         SimEvent accelerationDynamics = SimEvent("Acceleration_Dynamics", static_cast<double>(realAccelerationY),
                                                  "CanConnector");
 
-        events.push_back(speed);
-        events.push_back(yawRateDynamics);
-        events.push_back(accelerationDynamics);
-
-        return events;
+        sink.push(std::move(speed));
+        sink.push(std::move(yawRateDynamics));
+        sink.push(std::move(accelerationDynamics));
     }
 
-    std::vector<SimEvent> BmwCodec::decodeGPS_LOCA(struct canfd_frame frame, bool isCanfd) {
-
-        std::vector<SimEvent> events;
+    void BmwCodec::decodeGPS_LOCA(const struct canfd_frame &frame, bool isCanfd, SimEventSink &sink) {
 
         if (isCanfd) {
             InterfaceLogger::logMessage("Got a CANFD frame but expected a CAN frame for the CAN ID 0x273 GPS_LOCA",
                                         LOG_LEVEL::ERROR);
-            return events;
+            return;
         }
 
-        struct can_frame canFrame = *((struct can_frame *) &frame);
-
-        // Get the raw value that should be in little endian order
-        int32_t rawLongitude =
-                canFrame.data[0] | (canFrame.data[1] << 8) | (canFrame.data[2] << 16) | (canFrame.data[3] << 24);
-        int32_t rawLatitude =
-                canFrame.data[4] | (canFrame.data[5] << 8) | (canFrame.data[6] << 16) | (canFrame.data[7] << 24);
+        const auto &canFrame = *((const struct can_frame *) &frame);
 
-        // Convert to host order
-        if (hostIsBigEndian) {
-            rawLongitude = CodecUtilities::convertEndianness(rawLongitude);
-            rawLatitude = CodecUtilities::convertEndianness(rawLatitude);
-        }
+        // Read the little endian signals in host order
+        auto rawLongitude = static_cast<int32_t>(bitfield::extractSigned(canFrame.data, ST_LONGNAVI_FIELD));
+        auto rawLatitude = static_cast<int32_t>(bitfield::extractSigned(canFrame.data, ST_LATNAVI_FIELD));
 
         // Apply the scaling and offset
         int32_t realLongitude = rawLongitude * ST_LONGNAVI_SCALING + ST_LONGNAVI_OFFSET;
         int32_t realLatitude = rawLatitude * ST_LATNAVI_SCALING + ST_LATNAVI_OFFSET;
 
-        // Create the SimEvents and add them to the vector that will be sent to the simulation
+        // Create the SimEvents and pass them to the sink that sends them to the simulation
         SimEvent latitudeDynamics = SimEvent("Latitude_Dynamics", static_cast<double>(realLatitude), "CanConnector");
         SimEvent longitudeDynamics = SimEvent("Longitude_Dynamics", static_cast<double>(realLongitude), "CanConnector");
 
-        events.push_back(latitudeDynamics);
-        events.push_back(longitudeDynamics);
-
-        return events;
+        sink.push(std::move(latitudeDynamics));
+        sink.push(std::move(longitudeDynamics));
     }
 
-    std::vector<SimEvent> BmwCodec::decodeGPS_LOCB(struct canfd_frame frame, bool isCanfd) {
-
-        std::vector<SimEvent> events;
+    void BmwCodec::decodeGPS_LOCB(const struct canfd_frame &frame, bool isCanfd, SimEventSink &sink) {
 
         if (isCanfd) {
             InterfaceLogger::logMessage("Got a CANFD frame but expected a CAN frame for the CAN ID 0x274 GPS_LOCB",
                                         LOG_LEVEL::ERROR);
-            return events;
+            return;
         }
 
-        struct can_frame canFrame = *((struct can_frame *) &frame);
-
-        // Get the raw value that should be in little endian order
-        int16_t rawAltitude = canFrame.data[0] | (canFrame.data[1] << 8);
-        uint8_t rawHeading = canFrame.data[2];
-        uint8_t rawDvcoveh = canFrame.data[3];
+        const auto &canFrame = *((const struct can_frame *) &frame);
 
-        // Convert to host order
-        if (hostIsBigEndian) {
-            rawAltitude = CodecUtilities::convertEndianness(rawAltitude);
-            // No need to convert rawHeading and rawDvcoveh (uint8_t) because it is a single byte
-        }
+        // Read the little endian signals in host order
+        auto rawAltitude = static_cast<int16_t>(bitfield::extractSigned(canFrame.data, ST_HGNAVI_FIELD));
+        auto rawHeading = static_cast<uint8_t>(bitfield::extract(canFrame.data, ST_HDG_HRZTLABSL_FIELD));
+        auto rawDvcoveh = static_cast<uint8_t>(bitfield::extract(canFrame.data, DVCOVEH_FIELD));
 
         // Apply the scaling and offset
         int16_t realAltitude = rawAltitude * ST_HGNAVI_SCALING + ST_HGNAVI_OFFSET;
         uint8_t realHeading = rawHeading * ST_HDG_HRZTLABSL_SCALING + ST_HDG_HRZTLABSL_OFFSET;
         uint8_t realDvcoveh = rawDvcoveh * DVCOVEH_SCALING + DVCOVEH_OFFSET;
 
-        // Create the SimEvents and add them to the vector that will be sent to the simulation
+        // Create the SimEvents and pass them to the sink that sends them to the simulation
         SimEvent altitude = SimEvent("Position_Z_Coordinate_DUT", static_cast<double>(realAltitude), "CanConnector");
         SimEvent heading = SimEvent("Heading_Dynamics", static_cast<double>(realHeading), "CanConnector");
 
-        events.push_back(altitude);
-        events.push_back(heading);
-
-        return events;
+        sink.push(std::move(altitude));
+        sink.push(std::move(heading));
     }
 
-    std::vector<SimEvent> BmwCodec::decodeLichter(struct canfd_frame frame, bool isCanfd) {
-
-        std::vector<SimEvent> events;
+    void BmwCodec::decodeLichter(const struct canfd_frame &frame, bool isCanfd, SimEventSink &sink) {
 
         if (isCanfd) {
             InterfaceLogger::logMessage("Got a CANFD frame but expected a CAN frame for the CAN ID 0x279 LICHTER",
                                         LOG_LEVEL::ERROR);
-            return events;
+            return;
         }
 
-        struct can_frame canFrame = *((struct can_frame *) &frame);
+        const auto &canFrame = *((const struct can_frame *) &frame);
 
-        // Get the raw value that should be in little endian order
-        uint16_t rawSignals = canFrame.data[0] | (canFrame.data[1] << 8);
+        // Read the little endian light bits in host order
+        auto rawSignals = static_cast<uint16_t>(bitfield::extract(canFrame.data, LICHTER_FIELD));
 
         // DBC and traci:
         // Bit positions are counted from byte 0 upwards by their significance, regardless of the endianness.
@@ -423,11 +414,9 @@ namespace sim_interface::dut_connector::can {
             simSignals |= 0x1000;
         }
 
-        // Create the SimEvents and add them to the vector that will be sent to the simulation
+        // Create the SimEvents and pass them to the sink that sends them to the simulation
         SimEvent signals = SimEvent("Signals_DUT", static_cast<double>(simSignals), "CanConnector");
-        events.push_back(signals);
-
-        return events;
+        sink.push(std::move(signals));
     }
 
 }
\ No newline at end of file
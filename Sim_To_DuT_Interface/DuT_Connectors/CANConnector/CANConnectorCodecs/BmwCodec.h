@@ -29,14 +29,14 @@
 #define SIM_TO_DUT_INTERFACE_BMWCODEC_H
 
 // Project includes
-#include "CodecUtilities.h"
-#include "../CANConnectorCodec.h"
+#include "BitField.h"
+#include "../CANConnectorCodecV2.h"
 
 // System includes
-#include <map>
+#include <cstring>
 
 /**
- * Scaling and offset defines for the 0x275 GESCHWINDIGKEIT frame.
+ * Scaling, offset and position (DBC start bit and length, Intel order) defines for the 0x275 GESCHWINDIGKEIT frame.
  */
 #define V_VEHCOG_SCALING        0.015625
 #define V_VEHCOG_OFFSET         0
@@ -46,17 +46,23 @@
 #define ACLNYCOG_OFFSET        -65
 #define ACLNXCOG_SCALING        0.002
 #define ACLNXCOG_OFFSET        -65
+#define V_VEHCOG_FIELD          sim_interface::dut_connector::can::bitfield::intelField(0, 16)
+#define VYAWVEH_FIELD           sim_interface::dut_connector::can::bitfield::intelField(16, 16)
+#define ACLNYCOG_FIELD          sim_interface::dut_connector::can::bitfield::intelField(32, 16)
+#define ACLNXCOG_FIELD          sim_interface::dut_connector::can::bitfield::intelField(48, 16)
 
 /**
- * Scaling and offset defines for the 0x273 GPS_LOCA frame.
+ * Scaling, offset and position (DBC start bit and length, Intel order) defines for the 0x273 GPS_LOCA frame.
  */
 #define ST_LONGNAVI_SCALING     0.00000008
 #define ST_LONGNAVI_OFFSET      0
 #define ST_LATNAVI_SCALING      0.00000008
 #define ST_LATNAVI_OFFSET       0
+#define ST_LONGNAVI_FIELD       sim_interface::dut_connector::can::bitfield::intelField(0, 32)
+#define ST_LATNAVI_FIELD        sim_interface::dut_connector::can::bitfield::intelField(32, 32)
 
 /**
- * Scaling and offset defines for the 0x274 GPS_LOCB frame.
+ * Scaling, offset and position (DBC start bit and length, Intel order) defines for the 0x274 GPS_LOCB frame.
  */
 #define ST_HGNAVI_SCALING        1
 #define ST_HGNAVI_OFFSET         0
@@ -64,6 +70,14 @@
 #define ST_HDG_HRZTLABSL_OFFSET  0
 #define DVCOVEH_SCALING          1
 #define DVCOVEH_OFFSET           0
+#define ST_HGNAVI_FIELD          sim_interface::dut_connector::can::bitfield::intelField(0, 16)
+#define ST_HDG_HRZTLABSL_FIELD   sim_interface::dut_connector::can::bitfield::intelField(16, 8)
+#define DVCOVEH_FIELD            sim_interface::dut_connector::can::bitfield::intelField(24, 8)
+
+/**
+ * Position of the light bits in the 0x279 LICHTER frame.
+ */
+#define LICHTER_FIELD            sim_interface::dut_connector::can::bitfield::intelField(0, 16)
 
 /**
  * SendOperation name for the 0x275 GESCHWINDIGKEIT frame.
@@ -91,8 +105,10 @@ namespace sim_interface::dut_connector::can {
      * <summary>
      * Implements the Codec for the BMW DuT.
      * </summary>
+     * The frames that carry several SimEvents are kept as shadow frames. A SimEvent only patches the bits of
+     * its own signal into the shadow frame, the other signals keep the payload of their last event.
      */
-    class BmwCodec : public CANConnectorCodec {
+    class BmwCodec : public CANConnectorCodecV2 {
 
     public:
 
@@ -102,96 +118,154 @@ namespace sim_interface::dut_connector::can {
         BmwCodec();
 
         /**
-         * Converts an simulation event to a CAN/CANFD payload and determines the sendOperation name.
+         * Resolves the handles of the send operations of the BMW frames.
+         *
+         * @param sendOperations - The names of all send operations of the CAN Connector config.
+         */
+        void bindSendOperations(const std::vector<std::string> &sendOperations) override;
+
+        /**
+         * Checks if the operation belongs to one of the BMW frames.
+         *
+         * @param operation - The operation of the simulation event.
+         *
+         * @return True if the codec can encode events of the operation.
+         */
+        bool supportsOperation(const std::string &operation) const override;
+
+        /**
+         * Computes the content mask of a BMW frame from the signals that are decoded. ACLNXCOG, DVCOVEH and the
+         * light bits that are not passed to the simulation are left out.
+         *
+         * @param canID - The received CAN ID.
+         * @param mask  - The mask with the bits of the decoded signals.
+         *
+         * @return True if the CAN ID is one of the BMW frames.
+         */
+        bool receiveMask(canid_t canID, struct canfd_frame &mask) const override;
+
+        /**
+         * Encodes a simulation event into the payload of the corresponding BMW frame.
          *
-         * @param event - The simulation event we want to transform into a CAN/CANFD frame payload.
+         * @param event     - The simulation event we want to transform into a CAN/CANFD frame payload.
+         * @param frames    - The frames the payload is written to.
+         * @param maxFrames - The number of frames that can be written.
          *
-         * @return The CAN/CANFD frame payload and the sendOperation name
+         * @return The handle of the send operation and the number of written frames.
          */
-        std::pair<std::vector<__u8>, std::string> convertSimEventToFrame(SimEvent event) override;
+        EncodeResult encode(const SimEvent &event, struct canfd_frame frames[], __u32 maxFrames) override;
 
         /**
-         * Converts a CAN/CANFD frame to the corresponding simulation events.
+         * Decodes a CAN/CANFD frame to the corresponding simulation events.
          *
          * @param frame   - The frame that we want to transform.
          * @param isCanfd - Flag for CANFD frames.
-         *
-         * @return The simulation events that were contained in the CAN/CANFD frame.
+         * @param sink    - The sink that takes the simulation events that were contained in the frame.
          */
-        std::vector<SimEvent> convertFrameToSimEvent(struct canfd_frame frame, bool isCanfd) override;
+        void decode(const struct canfd_frame &frame, bool isCanfd, SimEventSink &sink) override;
 
     private:
 
         /**
-         * Encodes the SimEvent values to a payload for the CAN frame 0x275 GESCHWINDIGKEIT and determines the sendOperation name.
+         * Encodes the SimEvent values to a payload for the CAN frame 0x275 GESCHWINDIGKEIT.
          *
          * @param event - The simulation event.
+         * @param frame - The frame the payload is written to.
          *
-         * @return The payload for the CAN frame 0x275 GESCHWINDIGKEIT and the sendOperation name.
+         * @return The handle of the GESCHWINDIGKEIT send operation and the number of written frames.
          */
-        std::pair<std::vector<__u8>, std::string> encodeGeschwindigkeit(SimEvent event);
+        EncodeResult encodeGeschwindigkeit(const SimEvent &event, struct canfd_frame &frame);
 
         /**
-         * Encodes the SimEvent values to a payload for the CAN frame 0x273 GPS_LOCA and determines the sendOperation name.
+         * Encodes the SimEvent values to a payload for the CAN frame 0x273 GPS_LOCA.
          *
          * @param event - The simulation event.
+         * @param frame - The frame the payload is written to.
          *
-         * @retur The payload for the CAN frame 0x273 GPS_LOCA and the sendOperation name.
+         * @return The handle of the GPS_LOCA send operation and the number of written frames.
          */
-        std::pair<std::vector<__u8>, std::string> encodeGPS_LOCA(SimEvent event);
+        EncodeResult encodeGPS_LOCA(const SimEvent &event, struct canfd_frame &frame);
 
         /**
          * Encodes the SimEvent values to a payload for the CAN frame 0x274 GPS_LOCB.
          *
          * @param event - The simulation event.
+         * @param frame - The frame the payload is written to.
          *
-         * @return The payload for the CAN frame 0x274 GPS_LOCB and determines the sendOperation name.
+         * @return The handle of the GPS_LOCB send operation and the number of written frames.
          */
-        std::pair<std::vector<__u8>, std::string> encodeGPS_LOCB(SimEvent event);
+        EncodeResult encodeGPS_LOCB(const SimEvent &event, struct canfd_frame &frame);
 
         /**
-         * Encodes the SimEvent values to a payload for the CAN frame 0x279 LICHTER and the sendOperation name.
+         * Encodes the SimEvent values to a payload for the CAN frame 0x279 LICHTER.
          *
          * @param event - The simulation event.
+         * @param frame - The frame the payload is written to.
          *
-         * @return The payload for the CAN frame 0x279 LICHTER and determines the sendOperation name.
+         * @return The handle of the LICHTER send operation and the number of written frames.
          */
-        std::pair<std::vector<__u8>, std::string> encodeLichter(SimEvent event);
+        EncodeResult encodeLichter(const SimEvent &event, struct canfd_frame &frame);
 
         /**
          * Decodes the CAN frame 0x275 Geschwindigkeit to the corresponding simulation events.
          *
          * @param frame   - The received CAN/CANFD frame
          * @param isCanfd - Flag for CANFD frames
+         * @param sink    - The sink that takes the simulation events.
          */
-        std::vector<SimEvent> decodeGeschwindigkeit(struct canfd_frame frame, bool isCanfd);
+        void decodeGeschwindigkeit(const struct canfd_frame &frame, bool isCanfd, SimEventSink &sink);
 
         /**
          * Decodes the CAN frame 0x273 GPS_LOCA to the corresponding simulation events.
          *
          * @param frame   - The received CAN/CANFD frame.
          * @param isCanfd - Flag for CANFD frames.
+         * @param sink    - The sink that takes the simulation events.
          */
-        std::vector<SimEvent> decodeGPS_LOCA(struct canfd_frame frame, bool isCanfd);
+        void decodeGPS_LOCA(const struct canfd_frame &frame, bool isCanfd, SimEventSink &sink);
 
         /**
          * Decodes the CAN frame 0x274 GPS_LOCB to the corresponding simulation events.
          *
          * @param frame   - The received CAN/CANFD frame.
          * @param isCanfd - Flag for CANFD frames.
+         * @param sink    - The sink that takes the simulation events.
          */
-        std::vector<SimEvent> decodeGPS_LOCB(struct canfd_frame frame, bool isCanfd);
+        void decodeGPS_LOCB(const struct canfd_frame &frame, bool isCanfd, SimEventSink &sink);
 
         /**
          * Decodes the CAN frame 0x279 Lichter to the corresponding simulation events.
          *
          * @param frame   - The received CAN/CANFD frame.
          * @param isCanfd - Flag for CANFD frames.
+         * @param sink    - The sink that takes the simulation events.
+         */
+        void decodeLichter(const struct canfd_frame &frame, bool isCanfd, SimEventSink &sink);
+
+        /**
+         * Checks if the event value is a double.
+         *
+         * @param event - The simulation event.
+         *
+         * @return The value of the event.
+         */
+        static double getDoubleValue(const SimEvent &event);
+
+        /**
+         * Copies the payload of a shadow frame into the frame that is passed to the CAN Connector.
+         *
+         * @param shadowFrame - The shadow frame.
+         * @param frame       - The frame the payload is written to.
          */
-        std::vector<SimEvent> decodeLichter(struct canfd_frame frame, bool isCanfd);
+        static void copyShadowFrame(const struct canfd_frame &shadowFrame, struct canfd_frame &frame);
 
-        bool hostIsBigEndian;                               /**< Flag if the system uses big endianness    */
-        std::map<std::string, double> cachedSimEventValues; /**< Map to cache the previous SimEvent values */
+        int geschwindigkeitHandle = INVALID_SEND_OPERATION;       /**< Handle of the GESCHWINDIGKEIT operation    */
+        int gpsLocaHandle = INVALID_SEND_OPERATION;               /**< Handle of the GPS_LOCA operation           */
+        int gpsLocbHandle = INVALID_SEND_OPERATION;               /**< Handle of the GPS_LOCB operation           */
+        int lichterHandle = INVALID_SEND_OPERATION;               /**< Handle of the LICHTER operation            */
+        struct canfd_frame geschwindigkeitFrame{};                /**< Shadow frame of GESCHWINDIGKEIT            */
+        struct canfd_frame gpsLocaFrame{};                        /**< Shadow frame of GPS_LOCA                   */
+        struct canfd_frame gpsLocbFrame{};                        /**< Shadow frame of GPS_LOCB                   */
     };
 
 }
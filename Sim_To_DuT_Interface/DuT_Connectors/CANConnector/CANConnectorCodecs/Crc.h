@@ -0,0 +1,240 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_CRC_H
+#define SIM_TO_DUT_INTERFACE_CRC_H
+
+// System includes
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace sim_interface::dut_connector::can::crc {
+
+    /**
+     * Number of bytes the table kernels process per step (slice-by-8).
+     */
+    constexpr size_t CRC_SLICES = 8;
+
+    /**
+     * Lookup tables of a CRC. Table k holds the CRC of a byte that is followed by k zero bytes, so the kernel
+     * combines CRC_SLICES bytes with one lookup per byte and no dependency between the lookups of a step.
+     */
+    template<typename T>
+    using CrcTables = std::array<std::array<T, 256>, CRC_SLICES>;
+
+    /**
+     * Creates the tables of a CRC that shifts the most significant bit out first (not reflected).
+     *
+     * @param polynomial - The polynomial without the highest bit.
+     *
+     * @return The tables.
+     */
+    template<typename T>
+    constexpr CrcTables<T> makeNormalTables(T polynomial) {
+        constexpr unsigned WIDTH = 8 * sizeof(T);
+        constexpr T TOP_BIT = static_cast<T>(T{1} << (WIDTH - 1));
+
+        CrcTables<T> tables{};
+        for (unsigned byte = 0; byte < 256; byte++) {
+            auto crc = static_cast<T>(static_cast<T>(byte) << (WIDTH - 8));
+            for (unsigned bit = 0; bit < 8; bit++) {
+                crc = static_cast<T>((crc & TOP_BIT) ? static_cast<T>(crc << 1) ^ polynomial : crc << 1);
+            }
+            tables[0][byte] = crc;
+        }
+
+        // Feeding a zero byte into the CRC of the previous table
+        for (size_t slice = 1; slice < CRC_SLICES; slice++) {
+            for (unsigned byte = 0; byte < 256; byte++) {
+                T previous = tables[slice - 1][byte];
+                tables[slice][byte] = static_cast<T>((WIDTH > 8 ? static_cast<T>(previous << 8) : T{0}) ^
+                                                     tables[0][static_cast<uint8_t>(previous >> (WIDTH - 8))]);
+            }
+        }
+        return tables;
+    }
+
+    /**
+     * Creates the tables of a CRC that shifts the least significant bit out first (reflected).
+     *
+     * @param polynomial - The reflected polynomial.
+     *
+     * @return The tables.
+     */
+    template<typename T>
+    constexpr CrcTables<T> makeReflectedTables(T polynomial) {
+        CrcTables<T> tables{};
+        for (unsigned byte = 0; byte < 256; byte++) {
+            auto crc = static_cast<T>(byte);
+            for (unsigned bit = 0; bit < 8; bit++) {
+                crc = static_cast<T>((crc & 1) ? (crc >> 1) ^ polynomial : crc >> 1);
+            }
+            tables[0][byte] = crc;
+        }
+
+        for (size_t slice = 1; slice < CRC_SLICES; slice++) {
+            for (unsigned byte = 0; byte < 256; byte++) {
+                T previous = tables[slice - 1][byte];
+                tables[slice][byte] = static_cast<T>((sizeof(T) > 1 ? previous >> 8 : 0) ^
+                                                     tables[0][static_cast<uint8_t>(previous)]);
+            }
+        }
+        return tables;
+    }
+
+    /**
+     * Feeds bytes into the register of a not reflected CRC.
+     *
+     * @param tables - The tables of the CRC.
+     * @param crc    - The register, i.e. the start value or the result of the previous call.
+     * @param data   - The bytes.
+     * @param length - The number of bytes.
+     *
+     * @return The register without the final XOR.
+     */
+    template<typename T>
+    constexpr T updateNormal(const CrcTables<T> &tables, T crc, const uint8_t data[], size_t length) {
+        constexpr unsigned WIDTH = 8 * sizeof(T);
+
+        size_t offset = 0;
+        for (; offset + CRC_SLICES <= length; offset += CRC_SLICES) {
+            // The register overlaps the first bytes of the step, the higher byte first
+            T next = 0;
+            for (size_t index = 0; index < CRC_SLICES; index++) {
+                uint8_t byte = data[offset + index];
+                if (index < sizeof(T)) {
+                    byte ^= static_cast<uint8_t>(crc >> (WIDTH - 8 * (index + 1)));
+                }
+                next ^= tables[CRC_SLICES - 1 - index][byte];
+            }
+            crc = next;
+        }
+
+        for (; offset < length; offset++) {
+            crc = static_cast<T>((WIDTH > 8 ? static_cast<T>(crc << 8) : T{0}) ^
+                                 tables[0][static_cast<uint8_t>((crc >> (WIDTH - 8)) ^ data[offset])]);
+        }
+        return crc;
+    }
+
+    /**
+     * Feeds bytes into the register of a reflected CRC.
+     *
+     * @param tables - The tables of the CRC.
+     * @param crc    - The register, i.e. the start value or the result of the previous call.
+     * @param data   - The bytes.
+     * @param length - The number of bytes.
+     *
+     * @return The register without the final XOR.
+     */
+    template<typename T>
+    constexpr T updateReflected(const CrcTables<T> &tables, T crc, const uint8_t data[], size_t length) {
+        size_t offset = 0;
+        for (; offset + CRC_SLICES <= length; offset += CRC_SLICES) {
+            // The register overlaps the first bytes of the step, the lower byte first
+            T next = 0;
+            for (size_t index = 0; index < CRC_SLICES; index++) {
+                uint8_t byte = data[offset + index];
+                if (index < sizeof(T)) {
+                    byte ^= static_cast<uint8_t>(crc >> (8 * index));
+                }
+                next ^= tables[CRC_SLICES - 1 - index][byte];
+            }
+            crc = next;
+        }
+
+        for (; offset < length; offset++) {
+            crc = static_cast<T>((sizeof(T) > 1 ? crc >> 8 : 0) ^ tables[0][static_cast<uint8_t>(crc ^ data[offset])]);
+        }
+        return crc;
+    }
+
+    /**
+     * Tables of the CRCs of the E2E profiles and the DBC checksums, computed at compile time.
+     */
+    inline constexpr CrcTables<uint8_t> CRC8_SAE_J1850_TABLES = makeNormalTables<uint8_t>(0x1D);
+    inline constexpr CrcTables<uint8_t> CRC8_H2F_TABLES = makeNormalTables<uint8_t>(0x2F);
+    inline constexpr CrcTables<uint16_t> CRC16_CCITT_TABLES = makeNormalTables<uint16_t>(0x1021);
+    inline constexpr CrcTables<uint32_t> CRC32_TABLES = makeReflectedTables<uint32_t>(0xEDB88320);
+
+    /**
+     * Feeds bytes into a CRC8 SAE J1850 register (polynomial 0x1D), used by the E2E profiles 1 and 11.
+     */
+    constexpr uint8_t crc8SaeJ1850Update(uint8_t crc, const uint8_t data[], size_t length) {
+        return updateNormal(CRC8_SAE_J1850_TABLES, crc, data, length);
+    }
+
+    /**
+     * Feeds bytes into a CRC8H2F register (polynomial 0x2F), used by the E2E profile 2.
+     */
+    constexpr uint8_t crc8H2FUpdate(uint8_t crc, const uint8_t data[], size_t length) {
+        return updateNormal(CRC8_H2F_TABLES, crc, data, length);
+    }
+
+    /**
+     * Feeds bytes into a CRC16 CCITT register (polynomial 0x1021), used by the E2E profile 5.
+     */
+    constexpr uint16_t crc16CcittUpdate(uint16_t crc, const uint8_t data[], size_t length) {
+        return updateNormal(CRC16_CCITT_TABLES, crc, data, length);
+    }
+
+    /**
+     * Feeds bytes into a reflected CRC32 register (polynomial 0x04C11DB7, IEEE 802.3), used by the DBC checksums
+     * with more than 16 bits.
+     */
+    constexpr uint32_t crc32Update(uint32_t crc, const uint8_t data[], size_t length) {
+        return updateReflected(CRC32_TABLES, crc, data, length);
+    }
+
+    /**
+     * @return The CRC8 SAE J1850 of the bytes (start value 0xFF, final XOR 0xFF).
+     */
+    constexpr uint8_t crc8SaeJ1850(const uint8_t data[], size_t length) {
+        return crc8SaeJ1850Update(0xFF, data, length) ^ 0xFF;
+    }
+
+    /**
+     * @return The CRC8H2F of the bytes (start value 0xFF, final XOR 0xFF).
+     */
+    constexpr uint8_t crc8H2F(const uint8_t data[], size_t length) {
+        return crc8H2FUpdate(0xFF, data, length) ^ 0xFF;
+    }
+
+    /**
+     * @return The CRC16 CCITT-FALSE of the bytes (start value 0xFFFF, no final XOR).
+     */
+    constexpr uint16_t crc16Ccitt(const uint8_t data[], size_t length) {
+        return crc16CcittUpdate(0xFFFF, data, length);
+    }
+
+    /**
+     * @return The CRC32 of the bytes (start value 0xFFFFFFFF, final XOR 0xFFFFFFFF).
+     */
+    constexpr uint32_t crc32(const uint8_t data[], size_t length) {
+        return crc32Update(0xFFFFFFFF, data, length) ^ 0xFFFFFFFF;
+    }
+}
+
+#endif //SIM_TO_DUT_INTERFACE_CRC_H
@@ -0,0 +1,108 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+// Project includes
+#include "Crc.h"
+
+// Compile-time checks of the CRC kernels. The translation unit contains no code,
+// a wrong table or kernel stops the build.
+namespace sim_interface::dut_connector::can::crc {
+
+    namespace {
+
+        constexpr uint8_t CHECK_INPUT[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+        struct Payload {
+            uint8_t data[64] = {};
+        };
+
+        constexpr Payload pattern() {
+            Payload payload;
+            for (size_t index = 0; index < 64; index++) {
+                payload.data[index] = static_cast<uint8_t>(index * 37 + 11);
+            }
+            return payload;
+        }
+
+        // Bit by bit reference of a not reflected CRC
+        template<typename T>
+        constexpr T bitwiseNormal(T polynomial, T crc, const uint8_t data[], size_t length) {
+            constexpr unsigned WIDTH = 8 * sizeof(T);
+            for (size_t offset = 0; offset < length; offset++) {
+                crc = static_cast<T>(crc ^ static_cast<T>(static_cast<T>(data[offset]) << (WIDTH - 8)));
+                for (unsigned bit = 0; bit < 8; bit++) {
+                    crc = static_cast<T>((crc >> (WIDTH - 1)) & 1 ? static_cast<T>(crc << 1) ^ polynomial : crc << 1);
+                }
+            }
+            return crc;
+        }
+
+        // Bit by bit reference of a reflected CRC
+        template<typename T>
+        constexpr T bitwiseReflected(T polynomial, T crc, const uint8_t data[], size_t length) {
+            for (size_t offset = 0; offset < length; offset++) {
+                crc ^= data[offset];
+                for (unsigned bit = 0; bit < 8; bit++) {
+                    crc = static_cast<T>((crc & 1) ? (crc >> 1) ^ polynomial : crc >> 1);
+                }
+            }
+            return crc;
+        }
+
+        // The slice-by-8 kernels match the reference for every length of a CANFD payload and every start value
+        constexpr bool matchesReference() {
+            constexpr Payload payload = pattern();
+            for (size_t length = 0; length <= 64; length++) {
+                for (uint32_t start: {0x00000000u, 0xFFFFFFFFu, 0x5AC3A55Au}) {
+                    auto start8 = static_cast<uint8_t>(start);
+                    auto start16 = static_cast<uint16_t>(start);
+                    if (crc8SaeJ1850Update(start8, payload.data, length) !=
+                        bitwiseNormal<uint8_t>(0x1D, start8, payload.data, length) ||
+                        crc8H2FUpdate(start8, payload.data, length) !=
+                        bitwiseNormal<uint8_t>(0x2F, start8, payload.data, length) ||
+                        crc16CcittUpdate(start16, payload.data, length) !=
+                        bitwiseNormal<uint16_t>(0x1021, start16, payload.data, length) ||
+                        crc32Update(start, payload.data, length) !=
+                        bitwiseReflected<uint32_t>(0xEDB88320, start, payload.data, length)) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // Check values of the CRC catalogue for "123456789"
+        static_assert(crc8SaeJ1850(CHECK_INPUT, sizeof(CHECK_INPUT)) == 0x4B);
+        static_assert(crc8H2F(CHECK_INPUT, sizeof(CHECK_INPUT)) == 0xDF);
+        static_assert(crc16Ccitt(CHECK_INPUT, sizeof(CHECK_INPUT)) == 0x29B1);
+        static_assert(crc32(CHECK_INPUT, sizeof(CHECK_INPUT)) == 0xCBF43926);
+
+        // Chained calls give the same register as one call
+        static_assert(crc16CcittUpdate(crc16CcittUpdate(0xFFFF, CHECK_INPUT, 4), CHECK_INPUT + 4, 5) ==
+                      crc16Ccitt(CHECK_INPUT, sizeof(CHECK_INPUT)));
+
+        static_assert(matchesReference());
+    }
+
+}
@@ -0,0 +1,518 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+// Project includes
+#include "DbcCodec.h"
+
+// System includes
+#include <cmath>
+#include <limits>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+namespace sim_interface::dut_connector::can {
+
+    DbcCodec::DbcCodec(const std::string &dbcFile) : DbcCodec(DbcDatabase::loadFile(dbcFile)) {}
+
+    DbcCodec::DbcCodec(DbcDatabase database) : database(std::move(database)) {
+
+        const auto &messages = this->database.messages;
+        const auto &signals = this->database.signals;
+
+        values.resize(signals.size());
+        batchLayouts.resize(signals.size());
+        signalMessages.resize(signals.size());
+        eventNames.resize(signals.size());
+        messageHandles.assign(messages.size(), INVALID_SEND_OPERATION);
+        checksumSignals.resize(messages.size());
+
+        // Count the signal names to find the names that are used in more than one message
+        std::unordered_map<std::string, int> nameCount;
+        for (const auto &signal: signals) {
+            nameCount[signal.name]++;
+        }
+
+        for (uint32_t messageIndex = 0; messageIndex < messages.size(); messageIndex++) {
+            const DbcMessage &message = messages[messageIndex];
+
+            if (!messageByCanID.emplace(message.canID, messageIndex).second) {
+                throw std::invalid_argument("DBC Codec: The CAN ID of the message <" + message.name + "> is not unique");
+            }
+
+            for (uint32_t index = message.firstSignal; index < message.firstSignal + message.signalCount; index++) {
+                const DbcSignal &signal = signals[index];
+                std::string qualifiedName = message.name + "." + signal.name;
+
+                // The alive counters and checksums are written by the codec and not part of the receive mask
+                if (signal.role != SIGNAL_DATA) {
+                    InterfaceLogger::logMessage("CAN Connector: DBC codec handles the signal <" + qualifiedName +
+                                                "> as " + (signal.role == SIGNAL_ALIVE_COUNTER ? "alive counter"
+                                                                                               : "checksum"),
+                                                LOG_LEVEL::INFO);
+                }
+                if (signal.role == SIGNAL_CHECKSUM) {
+                    checksumSignals[messageIndex].push_back(index);
+                }
+
+                signalMessages[index] = messageIndex;
+                batchLayouts[index] = makeBatchLayout(signal);
+                checkBatchLayout(index);
+                eventNames[index] = nameCount[signal.name] == 1 ? signal.name : qualifiedName;
+                signalByName[qualifiedName] = index;
+                if (nameCount[signal.name] == 1) {
+                    signalByName[signal.name] = index;
+                }
+
+                // Start with raw zero, saturated into the physical range
+                values[index] = toPhysical(signal, toRaw(signal, signal.offset));
+            }
+        }
+
+        // The shadow frames hold the payload of the last encode of each message
+        shadowFrames.resize(messages.size());
+        shadowPages.resize(messages.size());
+        for (uint32_t messageIndex = 0; messageIndex < messages.size(); messageIndex++) {
+            packShadowFrame(messageIndex);
+        }
+
+        for (const auto &name: this->database.skippedMessages) {
+            InterfaceLogger::logMessage("CAN Connector: DBC codec skipped the message <" + name +
+                                        "> without payload", LOG_LEVEL::INFO);
+        }
+
+        InterfaceLogger::logMessage(
+                "CAN Connector: DBC codec loaded " + std::to_string(messages.size()) + " messages with " +
+                std::to_string(signals.size()) + " signals", LOG_LEVEL::INFO);
+    }
+
+    void DbcCodec::bindSendOperations(const std::vector<std::string> &sendOperations) {
+
+        std::fill(messageHandles.begin(), messageHandles.end(), INVALID_SEND_OPERATION);
+        sendOperationMessages.assign(sendOperations.size(), DBC_NO_MESSAGE);
+
+        // The send operations are matched with the messages by name
+        for (size_t handle = 0; handle < sendOperations.size(); handle++) {
+            for (size_t messageIndex = 0; messageIndex < database.messages.size(); messageIndex++) {
+                if (database.messages[messageIndex].name == sendOperations[handle]) {
+                    messageHandles[messageIndex] = static_cast<int>(handle);
+                    sendOperationMessages[handle] = static_cast<uint32_t>(messageIndex);
+                }
+            }
+        }
+    }
+
+    bool DbcCodec::supportsOperation(const std::string &operation) const {
+        return signalByName.find(operation) != signalByName.end();
+    }
+
+    bool DbcCodec::receiveMask(canid_t canID, struct canfd_frame &mask) const {
+
+        const DbcMessage *message = findMessage(canID);
+        if (message == nullptr) {
+            return false;
+        }
+
+        mask = database.receiveMask(*message);
+        return true;
+    }
+
+    EncodeResult DbcCodec::encode(const SimEvent &event, struct canfd_frame frames[], __u32 maxFrames) {
+
+        auto signalIndex = signalByName.find(event.operation);
+        if (signalIndex == signalByName.end() || maxFrames < 1) {
+            InterfaceLogger::logMessage(
+                    "CAN Connector: DBC codec received unknown operation: <" + event.operation + ">",
+                    LOG_LEVEL::WARNING);
+            return {};
+        }
+
+        // Cache the value of the event
+        double value;
+        if (event.value.type() == typeid(double)) {
+            value = boost::get<double>(event.value);
+        } else if (event.value.type() == typeid(int)) {
+            value = boost::get<int>(event.value);
+        } else {
+            throw std::invalid_argument("DBC Codec: SimEvent value type invalid");
+        }
+
+        const DbcSignal &signal = database.signals[signalIndex->second];
+        uint32_t messageIndex = signalMessages[signalIndex->second];
+        const DbcMessage &message = database.messages[messageIndex];
+
+        values[signalIndex->second] = value;
+
+        // A multiplexed signal is only sent on its own page
+        if (signal.multiplex == MULTIPLEXED && message.multiplexer >= 0) {
+            values[message.multiplexer] = toPhysical(database.signals[message.multiplexer], signal.multiplexValue);
+        }
+
+        // Patch only the bits of the signal into the shadow frame. A new multiplexer page changes the set of
+        // active signals, so the whole message is packed again.
+        if (message.multiplexer >= 0 && (signalIndex->second == static_cast<uint32_t>(message.multiplexer) ||
+                                         toRaw(database.signals[message.multiplexer], values[message.multiplexer]) !=
+                                         shadowPages[messageIndex])) {
+            packShadowFrame(messageIndex);
+        } else {
+            packRaw(shadowFrames[messageIndex].data, signal, toRaw(signal, value));
+        }
+
+        const struct canfd_frame &shadowFrame = shadowFrames[messageIndex];
+        frames[0].len = shadowFrame.len;
+        std::memcpy(frames[0].data, shadowFrame.data, shadowFrame.len);
+        packChecksums(messageIndex, shadowPages[messageIndex], frames[0]);
+        return {messageHandles[messageIndex], 1};
+    }
+
+    void DbcCodec::patchCyclicFrame(int sendOperation, uint64_t transmission, struct canfd_frame &frame) const {
+
+        if (sendOperation < 0 || static_cast<size_t>(sendOperation) >= sendOperationMessages.size() ||
+            sendOperationMessages[sendOperation] == DBC_NO_MESSAGE) {
+            return;
+        }
+
+        uint32_t messageIndex = sendOperationMessages[sendOperation];
+        const DbcMessage &message = database.messages[messageIndex];
+
+        uint64_t multiplexerValue = 0;
+        if (message.multiplexer >= 0) {
+            multiplexerValue = unpackRaw(frame.data, database.signals[message.multiplexer]);
+        }
+
+        // Only the bits of the counters are written, the other signals keep the payload of the last encode
+        for (uint32_t index = message.firstSignal; index < message.firstSignal + message.signalCount; index++) {
+            const DbcSignal &signal = database.signals[index];
+
+            if (DbcDatabase::isAliveCounter(signal) && isActive(message, signal, multiplexerValue)) {
+                packRaw(frame.data, signal, DbcDatabase::aliveCounterValue(signal, transmission));
+            }
+        }
+
+        // The checksums cover the new counters
+        packChecksums(messageIndex, multiplexerValue, frame);
+    }
+
+    void DbcCodec::packChecksums(uint32_t messageIndex, uint64_t multiplexerValue, struct canfd_frame &frame) const {
+
+        const DbcMessage &message = database.messages[messageIndex];
+        for (uint32_t index: checksumSignals[messageIndex]) {
+            const DbcSignal &signal = database.signals[index];
+            if (isActive(message, signal, multiplexerValue)) {
+                packRaw(frame.data, signal, DbcDatabase::checksumValue(frame.data, message.length, bitField(signal)));
+            }
+        }
+    }
+
+    void DbcCodec::decode(const struct canfd_frame &frame, bool isCanfd, SimEventSink &sink) {
+
+        auto messageIndex = messageByCanID.find(frame.can_id);
+        if (messageIndex == messageByCanID.end()) {
+            InterfaceLogger::logMessage("CAN Connector: DBC codec did not find a message for the CAN ID: "
+                                        "<" + std::to_string(frame.can_id) + ">", LOG_LEVEL::WARNING);
+            return;
+        }
+
+        const DbcMessage &message = database.messages[messageIndex->second];
+
+        if (frame.len < message.length) {
+            InterfaceLogger::logMessage(
+                    "CAN Connector: DBC codec received " + std::to_string(frame.len) + " bytes for the message <" +
+                    message.name + "> but expected " + std::to_string(message.length), LOG_LEVEL::WARNING);
+            return;
+        }
+
+        uint64_t multiplexerValue = 0;
+        if (message.multiplexer >= 0) {
+            multiplexerValue = unpackRaw(frame.data, database.signals[message.multiplexer]);
+        }
+
+        for (uint32_t index = message.firstSignal; index < message.firstSignal + message.signalCount; index++) {
+            const DbcSignal &signal = database.signals[index];
+
+            if (isActive(message, signal, multiplexerValue)) {
+                sink.push(SimEvent(eventNames[index], toPhysical(signal, unpackRaw(frame.data, signal)),
+                                   "CanConnector"));
+            }
+        }
+    }
+
+    void DbcCodec::decodeBatch(const struct canfd_frame frames[], size_t count, bool isCanfd, SimEventSink &sink) {
+
+        const DbcMessage *message = count > 1 ? findMessage(frames[0].can_id) : nullptr;
+
+        // Single frames and unknown messages take the normal path, which also reports the errors
+        if (message == nullptr) {
+            for (size_t index = 0; index < count; index++) {
+                decode(frames[index], isCanfd, sink);
+            }
+            return;
+        }
+
+        // Scratch buffer per thread, so the batch does not allocate once it has grown
+        thread_local std::vector<double> batchValues;
+        batchValues.resize(static_cast<size_t>(message->signalCount) * count);
+        unpackBatch(*message, frames, count, batchValues.data());
+
+        for (size_t index = 0; index < count; index++) {
+            const struct canfd_frame &frame = frames[index];
+
+            if (frame.len < message->length) {
+                decode(frame, isCanfd, sink);
+                continue;
+            }
+
+            uint64_t multiplexerValue = 0;
+            if (message->multiplexer >= 0) {
+                multiplexerValue = unpackRaw(frame.data, database.signals[message->multiplexer]);
+            }
+
+            for (uint32_t signal = 0; signal < message->signalCount; signal++) {
+                if (isActive(*message, database.signals[message->firstSignal + signal], multiplexerValue)) {
+                    sink.push(SimEvent(eventNames[message->firstSignal + signal], batchValues[signal * count + index],
+                                       "CanConnector"));
+                }
+            }
+        }
+    }
+
+    const DbcMessage *DbcCodec::findMessage(canid_t canID) const {
+        auto messageIndex = messageByCanID.find(canID);
+        return messageIndex == messageByCanID.end() ? nullptr : &database.messages[messageIndex->second];
+    }
+
+    void DbcCodec::unpackBatch(const DbcMessage &message, const struct canfd_frame frames[], size_t count,
+                               double values[]) const {
+
+        for (uint32_t signal = 0; signal < message.signalCount; signal++) {
+            uint32_t index = message.firstSignal + signal;
+            double *signalValues = &values[signal * count];
+
+            if (batchLayouts[index].vectorizable) {
+                unpackSignalBatch(batchLayouts[index], frames, count, signalValues);
+            } else {
+                for (size_t frame = 0; frame < count; frame++) {
+                    signalValues[frame] = toPhysical(database.signals[index],
+                                                     unpackRaw(frames[frame].data, database.signals[index]));
+                }
+            }
+        }
+    }
+
+    void DbcCodec::packBatch(const DbcMessage &message, const double values[], size_t count,
+                             struct canfd_frame frames[]) const {
+
+        for (size_t frame = 0; frame < count; frame++) {
+            frames[frame].len = message.length;
+            std::memset(frames[frame].data, 0, CANFD_MAX_DLEN);
+        }
+
+        for (uint32_t signal = 0; signal < message.signalCount; signal++) {
+            uint32_t index = message.firstSignal + signal;
+            const DbcSignal &dbcSignal = database.signals[index];
+            const double *signalValues = &values[signal * count];
+
+            if (dbcSignal.multiplex == MULTIPLEXED) {
+                // The page is selected per frame
+                if (message.multiplexer < 0) {
+                    continue;
+                }
+                const double *multiplexerValues = &values[(message.multiplexer - message.firstSignal) * count];
+                for (size_t frame = 0; frame < count; frame++) {
+                    uint64_t multiplexerValue = toRaw(database.signals[message.multiplexer], multiplexerValues[frame]);
+                    if (dbcSignal.multiplexValue == multiplexerValue) {
+                        packRaw(frames[frame].data, dbcSignal, toRaw(dbcSignal, signalValues[frame]));
+                    }
+                }
+            } else if (batchLayouts[index].vectorizable) {
+                packSignalBatch(batchLayouts[index], signalValues, count, frames);
+            } else {
+                for (size_t frame = 0; frame < count; frame++) {
+                    packRaw(frames[frame].data, dbcSignal, toRaw(dbcSignal, signalValues[frame]));
+                }
+            }
+        }
+    }
+
+    uint64_t DbcCodec::unpackRaw(const __u8 data[], const DbcSignal &signal) {
+        return bitfield::extract(data, bitField(signal));
+    }
+
+    void DbcCodec::packRaw(__u8 data[], const DbcSignal &signal, uint64_t raw) {
+        bitfield::insert(data, bitField(signal), raw);
+    }
+
+    double DbcCodec::toPhysical(const DbcSignal &signal, uint64_t raw) {
+
+        double value;
+
+        if (signal.valueType == FLOAT32) {
+            float floatValue;
+            auto bits = static_cast<uint32_t>(raw);
+            std::memcpy(&floatValue, &bits, sizeof(floatValue));
+            value = floatValue;
+        } else if (signal.valueType == FLOAT64) {
+            std::memcpy(&value, &raw, sizeof(value));
+        } else if (signal.isSigned) {
+            value = static_cast<double>(bitfield::signExtend(raw, signal.length));
+        } else {
+            value = static_cast<double>(raw);
+        }
+
+        return value * signal.factor + signal.offset;
+    }
+
+    uint64_t DbcCodec::toRaw(const DbcSignal &signal, double physical) {
+
+        // Saturate to the physical range of the DBC file
+        if (signal.minimum < signal.maximum) {
+            physical = std::clamp(physical, signal.minimum, signal.maximum);
+        }
+
+        double scaled = (physical - signal.offset) / signal.factor;
+
+        if (signal.valueType == FLOAT32) {
+            auto floatValue = static_cast<float>(scaled);
+            uint32_t bits;
+            std::memcpy(&bits, &floatValue, sizeof(bits));
+            return bits;
+        } else if (signal.valueType == FLOAT64) {
+            uint64_t bits;
+            std::memcpy(&bits, &scaled, sizeof(bits));
+            return bits;
+        }
+
+        // Saturate to the range of the raw value
+        if (signal.isSigned) {
+            int64_t maxRaw = static_cast<int64_t>((uint64_t{1} << (signal.length - 1)) - 1);
+            int64_t minRaw = -maxRaw - 1;
+            int64_t raw;
+            if (std::isnan(scaled)) {
+                raw = 0;
+            } else if (scaled >= static_cast<double>(maxRaw)) {
+                raw = maxRaw;
+            } else if (scaled <= static_cast<double>(minRaw)) {
+                raw = minRaw;
+            } else {
+                raw = std::llround(scaled);
+            }
+            return static_cast<uint64_t>(raw);
+        } else {
+            uint64_t maxRaw = bitfield::lowMask(signal.length);
+            if (std::isnan(scaled) || scaled <= 0) {
+                return 0;
+            } else if (scaled >= static_cast<double>(maxRaw)) {
+                return maxRaw;
+            }
+            return static_cast<uint64_t>(std::round(scaled));
+        }
+    }
+
+    void DbcCodec::checkBatchLayout(uint32_t signalIndex) {
+
+        BatchSignalLayout &layout = batchLayouts[signalIndex];
+        if (!layout.vectorizable) {
+            return;
+        }
+
+        // The limits of the physical and the raw range, values just inside and outside of them, rounding ties of
+        // both signs and values that are not numbers. More values than the widest kernel takes at once, so the
+        // tail of the scalar kernel is checked as well.
+        const DbcSignal &signal = database.signals[signalIndex];
+        double rawMinimum = signal.isSigned ? -std::ldexp(1.0, signal.length - 1) : 0;
+        double rawMaximum = signal.isSigned ? std::ldexp(1.0, signal.length - 1) - 1
+                                            : std::ldexp(1.0, signal.length) - 1;
+        const double probes[] = {
+                signal.minimum, signal.maximum, signal.offset,
+                signal.offset + 0.5 * signal.factor, signal.offset - 0.5 * signal.factor,
+                signal.offset + 1.5 * signal.factor, signal.offset - 1.5 * signal.factor,
+                signal.offset + 2.5 * signal.factor, signal.offset - 2.5 * signal.factor,
+                signal.offset + 2.4999 * signal.factor, signal.offset - 2.5001 * signal.factor,
+                rawMinimum * signal.factor + signal.offset, rawMaximum * signal.factor + signal.offset,
+                (rawMinimum - 0.5) * signal.factor + signal.offset, (rawMaximum + 0.5) * signal.factor + signal.offset,
+                (rawMaximum - 0.5) * signal.factor + signal.offset, -0.0,
+                std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity(),
+                -std::numeric_limits<double>::infinity(), 1e300, -1e300
+        };
+        constexpr size_t count = sizeof(probes) / sizeof(probes[0]);
+
+        // The other bits of the payload must be kept, so the frames start with a pattern
+        struct canfd_frame batchFrames[count];
+        struct canfd_frame singleFrames[count];
+        for (size_t index = 0; index < count; index++) {
+            std::memset(batchFrames[index].data, 0xA5, CANFD_MAX_DLEN);
+            std::memset(singleFrames[index].data, 0xA5, CANFD_MAX_DLEN);
+            packRaw(singleFrames[index].data, signal, toRaw(signal, probes[index]));
+        }
+        packSignalBatch(layout, probes, count, batchFrames);
+
+        double batchValues[count];
+        unpackSignalBatch(layout, singleFrames, count, batchValues);
+
+        for (size_t index = 0; index < count; index++) {
+            if (std::memcmp(batchFrames[index].data, singleFrames[index].data, CANFD_MAX_DLEN) != 0 ||
+                batchValues[index] != toPhysical(signal, unpackRaw(singleFrames[index].data, signal))) {
+                InterfaceLogger::logMessage("CAN Connector: DBC codec batch kernels differ from the single kernels "
+                                            "for the signal <" + signal.name + ">, using the single kernels",
+                                            LOG_LEVEL::WARNING);
+                layout.vectorizable = false;
+                return;
+            }
+        }
+    }
+
+    void DbcCodec::packShadowFrame(uint32_t messageIndex) {
+
+        const DbcMessage &message = database.messages[messageIndex];
+        packMessage(message, shadowFrames[messageIndex]);
+
+        if (message.multiplexer >= 0) {
+            shadowPages[messageIndex] = toRaw(database.signals[message.multiplexer], values[message.multiplexer]);
+        }
+    }
+
+    void DbcCodec::packMessage(const DbcMessage &message, struct canfd_frame &frame) const {
+
+        frame.len = message.length;
+        std::memset(frame.data, 0, message.length);
+
+        uint64_t multiplexerValue = 0;
+        if (message.multiplexer >= 0) {
+            multiplexerValue = toRaw(database.signals[message.multiplexer], values[message.multiplexer]);
+        }
+
+        for (uint32_t index = message.firstSignal; index < message.firstSignal + message.signalCount; index++) {
+            const DbcSignal &signal = database.signals[index];
+
+            if (isActive(message, signal, multiplexerValue)) {
+                packRaw(frame.data, signal, toRaw(signal, values[index]));
+            }
+        }
+    }
+
+    bool DbcCodec::isActive(const DbcMessage &message, const DbcSignal &signal, uint64_t multiplexerValue) {
+        return signal.multiplex != MULTIPLEXED || (message.multiplexer >= 0 && signal.multiplexValue == multiplexerValue);
+    }
+
+}
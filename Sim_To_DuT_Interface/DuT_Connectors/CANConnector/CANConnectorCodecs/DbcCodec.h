@@ -0,0 +1,248 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_DBCCODEC_H
+#define SIM_TO_DUT_INTERFACE_DBCCODEC_H
+
+// Project includes
+#include "DbcDatabase.h"
+#include "SignalBatchKernels.h"
+#include "../CANConnectorCodecV2.h"
+
+// System includes
+#include <unordered_map>
+
+/**
+ * Message index of a send operation that has no message in the DBC file.
+ */
+#define DBC_NO_MESSAGE UINT32_MAX
+
+namespace sim_interface::dut_connector::can {
+
+    /**
+     * <summary>
+     * Generic codec that packs and unpacks the signals described by a DBC file.
+     * </summary>
+     * The signal names are used as SimEvent operations and the message names as sendOperation names.
+     * Signal names that are used in more than one message are only available as "MESSAGE.SIGNAL".
+     * Each message keeps a shadow frame with the last received values of all its signals. A SimEvent only patches
+     * its signal into the shadow frame and resends the message. A multiplexed signal switches the multiplexer to its
+     * page, which packs the message again.
+     */
+    class DbcCodec : public CANConnectorCodecV2 {
+
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param dbcFile - The path of the DBC file.
+         */
+        explicit DbcCodec(const std::string &dbcFile);
+
+        /**
+         * Constructor.
+         *
+         * @param database - The compiled messages and signals.
+         */
+        explicit DbcCodec(DbcDatabase database);
+
+        void bindSendOperations(const std::vector<std::string> &sendOperations) override;
+
+        bool supportsOperation(const std::string &operation) const override;
+
+        /**
+         * Computes the content mask of a message with DbcDatabase::receiveMask.
+         *
+         * @param canID - The received CAN ID.
+         * @param mask  - The mask with the bits of all signals except alive counters and checksums.
+         *
+         * @return True if the DBC file has a message with the CAN ID.
+         */
+        bool receiveMask(canid_t canID, struct canfd_frame &mask) const override;
+
+        EncodeResult encode(const SimEvent &event, struct canfd_frame frames[], __u32 maxFrames) override;
+
+        /**
+         * Writes the alive counters of the message of a cyclic send operation for the transmission and computes
+         * the checksums of the patched payload again.
+         *
+         * @param sendOperation - The handle of the send operation.
+         * @param transmission  - The number of previous transmissions of the send operation.
+         * @param frame         - The frame that is sent.
+         */
+        void patchCyclicFrame(int sendOperation, uint64_t transmission, struct canfd_frame &frame) const override;
+
+        void decode(const struct canfd_frame &frame, bool isCanfd, SimEventSink &sink) override;
+
+        /**
+         * Decodes a batch of frames with the same CAN ID. The signals of all frames are unpacked with unpackBatch
+         * before the events are passed to the sink in frame order.
+         *
+         * @param frames  - The frames that we want to transform, all with the same CAN ID.
+         * @param count   - The number of frames.
+         * @param isCanfd - Flag for CANFD frames.
+         * @param sink    - The sink that takes the simulation events that were contained in the frames.
+         */
+        void decodeBatch(const struct canfd_frame frames[], size_t count, bool isCanfd, SimEventSink &sink) override;
+
+        /**
+         * Finds the message of a CAN ID.
+         *
+         * @param canID - The CAN ID.
+         *
+         * @return The message or nullptr if the DBC file has no message with the CAN ID.
+         */
+        const DbcMessage *findMessage(canid_t canID) const;
+
+        /**
+         * Unpacks all signals of count frames of one message in structure-of-arrays form: the physical value of
+         * the n-th signal of the message in frame i is values[n * count + i]. Integer signals of up to 51 bits
+         * are unpacked with the SIMD batch kernels, all others one by one. Signals of inactive multiplexer
+         * pages are unpacked as well.
+         *
+         * @param message - The message of the frames.
+         * @param frames  - The frames.
+         * @param count   - The number of frames.
+         * @param values  - The physical values, signalCount * count entries.
+         */
+        void unpackBatch(const DbcMessage &message, const struct canfd_frame frames[], size_t count,
+                         double values[]) const;
+
+        /**
+         * Packs count frames of one message from values in structure-of-arrays form, the counterpart of unpackBatch.
+         * The frames get the length of the message, the CAN ID is not set. Multiplexed signals are only packed if
+         * the multiplexer value of the frame selects their page. The raw values are the same as with toRaw.
+         *
+         * @param message - The message of the frames.
+         * @param values  - The physical values, signalCount * count entries.
+         * @param count   - The number of frames.
+         * @param frames  - The frames.
+         */
+        void packBatch(const DbcMessage &message, const double values[], size_t count,
+                       struct canfd_frame frames[]) const;
+
+        /**
+         * Reads the raw bits of a signal.
+         *
+         * @param data   - The payload.
+         * @param signal - The signal.
+         *
+         * @return The raw value, not sign extended.
+         */
+        static uint64_t unpackRaw(const __u8 data[], const DbcSignal &signal);
+
+        /**
+         * Writes the raw bits of a signal, all other bits of the payload are kept.
+         *
+         * @param data   - The payload.
+         * @param signal - The signal.
+         * @param raw    - The raw value, bits above the signal length are ignored.
+         */
+        static void packRaw(__u8 data[], const DbcSignal &signal, uint64_t raw);
+
+        /**
+         * Converts a raw value to the physical value.
+         *
+         * @param signal - The signal.
+         * @param raw    - The raw value as returned by unpackRaw.
+         *
+         * @return The physical value.
+         */
+        static double toPhysical(const DbcSignal &signal, uint64_t raw);
+
+        /**
+         * Converts a physical value to the raw value. Values outside of the signal range are saturated.
+         *
+         * @param signal   - The signal.
+         * @param physical - The physical value.
+         *
+         * @return The raw value for packRaw.
+         */
+        static uint64_t toRaw(const DbcSignal &signal, double physical);
+
+    private:
+
+        /**
+         * Packs all signals of a message that are active on the current multiplexer page.
+         *
+         * @param message - The message.
+         * @param frame   - The frame the payload is written to.
+         */
+        void packMessage(const DbcMessage &message, struct canfd_frame &frame) const;
+
+        /**
+         * Packs the shadow frame of a message again from the cached values and remembers its multiplexer page.
+         *
+         * @param messageIndex - The index of the message.
+         */
+        void packShadowFrame(uint32_t messageIndex);
+
+        /**
+         * Checks if a signal is active on the multiplexer page given by the payload or the cached values.
+         *
+         * @param message          - The message of the signal.
+         * @param signal           - The signal.
+         * @param multiplexerValue - The current value of the multiplexer signal.
+         *
+         * @return True if the signal is part of the payload.
+         */
+        static bool isActive(const DbcMessage &message, const DbcSignal &signal, uint64_t multiplexerValue);
+
+        /**
+         * Writes the checksums of a message that are active on the multiplexer page, see
+         * DbcDatabase::checksumValue.
+         *
+         * @param messageIndex     - The index of the message.
+         * @param multiplexerValue - The current value of the multiplexer signal.
+         * @param frame            - The frame with the payload of the message.
+         */
+        void packChecksums(uint32_t messageIndex, uint64_t multiplexerValue, struct canfd_frame &frame) const;
+
+        /**
+         * Checks that the batch kernels give the same payload and values as packRaw(toRaw) and toPhysical(unpackRaw)
+         * for the limits, the rounding ties and NaN of a vectorizable signal. The signal falls back to the single
+         * kernels if they do not.
+         *
+         * @param signalIndex - The index of the signal.
+         */
+        void checkBatchLayout(uint32_t signalIndex);
+
+        DbcDatabase database;                                   /**< The messages and signals.                     */
+        std::vector<double> values;                             /**< Last physical value of each signal.           */
+        std::vector<BatchSignalLayout> batchLayouts;            /**< Batch kernel layout of each signal.           */
+        std::vector<uint32_t> signalMessages;                   /**< Index of the message of each signal.          */
+        std::vector<std::string> eventNames;                    /**< SimEvent operation of each signal.            */
+        std::vector<struct canfd_frame> shadowFrames;           /**< Last packed payload of each message.          */
+        std::vector<uint64_t> shadowPages;                      /**< Multiplexer page of each shadow frame.        */
+        std::vector<std::vector<uint32_t>> checksumSignals;     /**< Indexes of the checksums of each message.     */
+        std::vector<int> messageHandles;                        /**< Send operation handle of each message.        */
+        std::vector<uint32_t> sendOperationMessages;            /**< Message index of each send operation handle.  */
+        std::unordered_map<std::string, uint32_t> signalByName; /**< Signal index by the SimEvent operation.       */
+        std::unordered_map<canid_t, uint32_t> messageByCanID;   /**< Message index by the CAN ID.                  */
+    };
+
+}
+
+#endif //SIM_TO_DUT_INTERFACE_DBCCODEC_H
@@ -0,0 +1,436 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+/**
+ * DBC to C++ code generator used by the add_can_codec CMake function.
+ *
+ * Usage: DbcCodegen <dbc file> <codec class name> <output header>
+ *
+ * The generated header contains constexpr signal descriptors per message and a codec class
+ * implementing CANConnectorCodecV2 whose pack/unpack functions are unrolled for each signal.
+ */
+
+// Project includes
+#include "DbcDatabase.h"
+
+// System includes
+#include <map>
+#include <cmath>
+#include <cctype>
+#include <limits>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+using namespace sim_interface::dut_connector::can;
+
+namespace {
+
+    /**
+     * Formats a double as C++ literal without loosing precision.
+     */
+    std::string literal(double value) {
+        std::ostringstream stream;
+        stream.precision(std::numeric_limits<double>::max_digits10);
+        stream << value;
+        std::string text = stream.str();
+        if (text.find_first_of(".e") == std::string::npos) {
+            text += ".0";
+        }
+        return text;
+    }
+
+    /**
+     * Computes the initial physical value of a signal like the DbcCodec: raw zero saturated into the range.
+     */
+    double initialValue(const DbcSignal &signal) {
+        double value = signal.offset;
+        if (signal.minimum < signal.maximum) {
+            value = std::min(std::max(value, signal.minimum), signal.maximum);
+        }
+        return value;
+    }
+
+    const char *valueType(DBC_VALUE_TYPE type) {
+        return type == FLOAT32 ? "FLOAT32" : type == FLOAT64 ? "FLOAT64" : "INTEGER";
+    }
+
+    void generate(const DbcDatabase &database, const std::string &className, const std::string &source,
+                  std::ostream &out) {
+
+        const auto &messages = database.messages;
+        const auto &signals = database.signals;
+        std::string ns = className + "_dbc";
+
+        // Signal names that are used in more than one message are only available as MESSAGE.SIGNAL
+        std::map<std::string, int> nameCount;
+        for (const auto &signal: signals) {
+            nameCount[signal.name]++;
+        }
+
+        auto eventName = [&](const DbcMessage &message, const DbcSignal &signal) {
+            return nameCount[signal.name] == 1 ? signal.name : message.name + "." + signal.name;
+        };
+        auto descriptor = [&](const DbcMessage &message, const DbcSignal &signal) {
+            return ns + "::msg_" + message.name + "::sig_" + signal.name;
+        };
+        auto member = [&](const DbcMessage &message, const DbcSignal &signal) {
+            return "value_" + message.name + "_" + signal.name;
+        };
+
+        // The checksums are written last, multiplexed ones only on their page (the payload has a multiplexer value)
+        auto writeChecksums = [&](const DbcMessage &message, const std::string &indent) {
+            for (uint32_t index = 0; index < message.signalCount; index++) {
+                const DbcSignal &signal = signals[message.firstSignal + index];
+                if (!DbcDatabase::isChecksum(signal) || (signal.multiplex == MULTIPLEXED && message.multiplexer < 0)) {
+                    continue;
+                }
+                std::string line = "packChecksum<" + descriptor(message, signal) + ", " + ns + "::msg_" +
+                                   message.name + "::LENGTH>(frame.data);\n";
+                if (signal.multiplex == MULTIPLEXED) {
+                    out << indent << "if (multiplexer == " << signal.multiplexValue << "u) {\n"
+                        << indent << "    " << line
+                        << indent << "}\n";
+                } else {
+                    out << indent << line;
+                }
+            }
+        };
+
+        std::string guard = "SIM_TO_DUT_INTERFACE_GENERATED_" + className + "_H";
+        for (auto &character: guard) {
+            character = static_cast<char>(std::toupper(static_cast<unsigned char>(character)));
+        }
+
+        out << "// Generated by DbcCodegen from " << source << ". Do not edit, changes are overwritten.\n\n"
+            << "#ifndef " << guard << "\n#define " << guard << "\n\n"
+            << "// Project includes\n#include \"GeneratedCodecSupport.h\"\n\n"
+            << "namespace sim_interface::dut_connector::can::generated {\n\n";
+
+        // Descriptors
+        out << "    namespace " << ns << " {\n";
+        for (const auto &message: messages) {
+            out << "\n        namespace msg_" << message.name << " {\n"
+                << "            inline constexpr canid_t CAN_ID = " << message.canID << "u;\n"
+                << "            inline constexpr uint8_t LENGTH = " << static_cast<int>(message.length) << ";\n";
+            for (uint32_t index = 0; index < message.signalCount; index++) {
+                const DbcSignal &signal = signals[message.firstSignal + index];
+                out << "            inline constexpr SignalDescriptor sig_" << signal.name << "{"
+                    << signal.lsbByte << ", " << static_cast<int>(signal.lsbBit) << ", "
+                    << static_cast<int>(signal.byteStep) << ", " << static_cast<int>(signal.length) << ", "
+                    << (signal.isSigned ? "true" : "false") << ", " << valueType(signal.valueType) << ", "
+                    << literal(signal.factor) << ", " << literal(signal.offset) << ", "
+                    << literal(signal.minimum) << ", " << literal(signal.maximum) << "};\n";
+            }
+            out << "        }\n";
+        }
+        out << "\n    }\n\n";
+
+        // Codec class
+        out << "    /**\n"
+            << "     * <summary>\n"
+            << "     * Codec generated from " << source << ".\n"
+            << "     * </summary>\n"
+            << "     */\n"
+            << "    class " << className << " : public CANConnectorCodecV2 {\n\n"
+            << "    public:\n\n";
+
+        // bindSendOperations
+        out << "        void bindSendOperations(const std::vector<std::string> &sendOperations) override {\n";
+        for (const auto &message: messages) {
+            out << "            handle_" << message.name << " = INVALID_SEND_OPERATION;\n";
+        }
+        out << "            for (size_t handle = 0; handle < sendOperations.size(); handle++) {\n";
+        for (const auto &message: messages) {
+            out << "                if (sendOperations[handle] == \"" << message.name << "\") {\n"
+                << "                    handle_" << message.name << " = static_cast<int>(handle);\n"
+                << "                }\n";
+        }
+        out << "            }\n        }\n\n";
+
+        // supportsOperation
+        out << "        bool supportsOperation(const std::string &operation) const override {\n"
+            << "            return ";
+        bool first = true;
+        for (const auto &message: messages) {
+            for (uint32_t index = 0; index < message.signalCount; index++) {
+                out << (first ? "" : " ||\n                   ") << "operation == \""
+                    << eventName(message, signals[message.firstSignal + index]) << "\"";
+                first = false;
+            }
+        }
+        out << (first ? "false;\n" : ";\n") << "        }\n\n";
+
+        // receiveMask: the masks are computed at generation time, only the set bytes are written
+        out << "        bool receiveMask(canid_t canID, struct canfd_frame &mask) const override {\n"
+            << "            switch (canID) {\n";
+        for (const auto &message: messages) {
+            struct canfd_frame mask = database.receiveMask(message);
+            out << "                case " << ns << "::msg_" << message.name << "::CAN_ID:\n"
+                << "                    mask = {0};\n"
+                << "                    mask.can_id = canID;\n"
+                << "                    mask.len = " << ns << "::msg_" << message.name << "::LENGTH;\n";
+            for (int index = 0; index < message.length; index++) {
+                if (mask.data[index] != 0) {
+                    out << "                    mask.data[" << index << "] = 0x" << std::hex
+                        << static_cast<int>(mask.data[index]) << std::dec << "u;\n";
+                }
+            }
+            out << "                    return true;\n";
+        }
+        out << "                default:\n"
+            << "                    return false;\n"
+            << "            }\n"
+            << "        }\n\n";
+
+        // encode: dispatch on the length of the operation first, then compare the names
+        std::map<size_t, std::vector<std::pair<const DbcMessage *, const DbcSignal *>>> byLength;
+        for (const auto &message: messages) {
+            for (uint32_t index = 0; index < message.signalCount; index++) {
+                const DbcSignal &signal = signals[message.firstSignal + index];
+                byLength[eventName(message, signal).size()].emplace_back(&message, &signal);
+            }
+        }
+
+        out << "        EncodeResult encode(const SimEvent &event, struct canfd_frame frames[], __u32 maxFrames) override {\n"
+            << "            const std::string &operation = event.operation;\n\n"
+            << "            if (maxFrames >= 1) {\n"
+            << "                switch (operation.size()) {\n";
+        for (const auto &[length, entries]: byLength) {
+            out << "                    case " << length << ":\n";
+            for (const auto &[message, signal]: entries) {
+                out << "                        if (operation == \"" << eventName(*message, *signal) << "\") {\n"
+                    << "                            " << member(*message, *signal) << " = eventValue(event);\n";
+                if (signal->multiplex == MULTIPLEXED && message->multiplexer >= 0) {
+                    const DbcSignal &multiplexer = signals[message->multiplexer];
+                    out << "                            " << member(*message, multiplexer) << " = toPhysical<"
+                        << descriptor(*message, multiplexer) << ">(" << signal->multiplexValue << ");\n";
+                }
+                out << "                            return pack_" << message->name << "(frames[0]);\n"
+                    << "                        }\n";
+            }
+            out << "                        break;\n";
+        }
+        out << "                    default:\n"
+            << "                        break;\n"
+            << "                }\n"
+            << "            }\n\n"
+            << "            InterfaceLogger::logMessage(\n"
+            << "                    \"CAN Connector: " << className << " received unknown operation: <\" + operation + \">\",\n"
+            << "                    LOG_LEVEL::WARNING);\n"
+            << "            return {};\n"
+            << "        }\n\n";
+
+        // patchCyclicFrame: the ranges of the alive counters are computed at generation time. Without alive counters
+        // the frames do not change between transmissions and the empty patchCyclicFrame of the base class is kept.
+        std::map<const DbcMessage *, std::vector<const DbcSignal *>> countersByMessage;
+        for (const auto &message: messages) {
+            for (uint32_t index = 0; index < message.signalCount; index++) {
+                if (DbcDatabase::isAliveCounter(signals[message.firstSignal + index])) {
+                    countersByMessage[&message].push_back(&signals[message.firstSignal + index]);
+                }
+            }
+        }
+
+        if (!countersByMessage.empty()) {
+            out << "        void patchCyclicFrame(int sendOperation, uint64_t transmission, struct canfd_frame &frame) "
+                << "const override {\n"
+                << "            if (sendOperation == INVALID_SEND_OPERATION) {\n"
+                << "                return;\n"
+                << "            }\n";
+        }
+        for (const auto &message: messages) {
+            auto messageCounters = countersByMessage.find(&message);
+            if (messageCounters == countersByMessage.end()) {
+                continue;
+            }
+            const std::vector<const DbcSignal *> &counters = messageCounters->second;
+
+            out << "            if (sendOperation == handle_" << message.name << ") {\n";
+            bool hasPages = message.multiplexer >= 0;
+            if (hasPages) {
+                out << "                const uint64_t multiplexer = unpackRaw<"
+                    << descriptor(message, signals[message.multiplexer]) << ">(frame.data);\n";
+            }
+            for (const DbcSignal *counter: counters) {
+                auto [first, last] = DbcDatabase::aliveCounterRange(*counter);
+                std::string value = last - first + 1 == 0 ? "transmission"
+                                                          : std::to_string(first) + "u + transmission % " +
+                                                            std::to_string(last - first + 1) + "u";
+                std::string indent = "                ";
+                if (counter->multiplex == MULTIPLEXED && hasPages) {
+                    out << indent << "if (multiplexer == " << counter->multiplexValue << "u) {\n";
+                    indent += "    ";
+                }
+                out << indent << "packRaw<" << descriptor(message, *counter) << ">(frame.data, " << value << ");\n";
+                if (counter->multiplex == MULTIPLEXED && hasPages) {
+                    out << "                }\n";
+                }
+            }
+            writeChecksums(message, "                ");
+            out << "            }\n";
+        }
+        if (!countersByMessage.empty()) {
+            out << "        }\n\n";
+        }
+
+        // decode
+        out << "        void decode(const struct canfd_frame &frame, bool isCanfd, SimEventSink &sink) override {\n"
+            << "            switch (frame.can_id) {\n";
+        for (const auto &message: messages) {
+            out << "                case " << ns << "::msg_" << message.name << "::CAN_ID:\n"
+                << "                    decode_" << message.name << "(frame, sink);\n"
+                << "                    break;\n";
+        }
+        out << "                default:\n"
+            << "                    InterfaceLogger::logMessage(\"CAN Connector: " << className
+            << " did not implement a conversion for the CAN ID: <\" +\n"
+            << "                                                std::to_string(frame.can_id) + \">\", LOG_LEVEL::WARNING);\n"
+            << "            }\n"
+            << "        }\n\n"
+            << "    private:\n";
+
+        for (const auto &message: messages) {
+            std::string msg = ns + "::msg_" + message.name;
+
+            // pack
+            out << "\n        EncodeResult pack_" << message.name << "(struct canfd_frame &frame) {\n"
+                << "            frame.len = " << msg << "::LENGTH;\n"
+                << "            std::memset(frame.data, 0, " << msg << "::LENGTH);\n";
+            if (message.multiplexer >= 0) {
+                const DbcSignal &multiplexer = signals[message.multiplexer];
+                out << "            const uint64_t multiplexer = toRaw<" << descriptor(message, multiplexer) << ">("
+                    << member(message, multiplexer) << ");\n";
+            }
+            for (uint32_t index = 0; index < message.signalCount; index++) {
+                const DbcSignal &signal = signals[message.firstSignal + index];
+                std::string indent = "            ";
+                if (signal.multiplex == MULTIPLEXED) {
+                    if (message.multiplexer < 0) {
+                        continue;
+                    }
+                    out << indent << "if (multiplexer == " << signal.multiplexValue << "u) {\n";
+                    indent += "    ";
+                }
+                out << indent << "packSignal<" << descriptor(message, signal) << ">(frame.data, "
+                    << member(message, signal) << ");\n";
+                if (signal.multiplex == MULTIPLEXED) {
+                    out << "            }\n";
+                }
+            }
+            writeChecksums(message, "            ");
+            out << "            return {handle_" << message.name << ", 1};\n"
+                << "        }\n";
+
+            // unpack
+            out << "\n        void decode_" << message.name << "(const struct canfd_frame &frame, SimEventSink &sink) {\n"
+                << "            if (frame.len < " << msg << "::LENGTH) {\n"
+                << "                InterfaceLogger::logMessage(\"CAN Connector: " << className
+                << " received a too short frame for the message <" << message.name << ">\",\n"
+                << "                                            LOG_LEVEL::WARNING);\n"
+                << "                return;\n"
+                << "            }\n";
+            if (message.multiplexer >= 0) {
+                const DbcSignal &multiplexer = signals[message.multiplexer];
+                out << "            const uint64_t multiplexer = unpackRaw<" << descriptor(message, multiplexer)
+                    << ">(frame.data);\n";
+            }
+            for (uint32_t index = 0; index < message.signalCount; index++) {
+                const DbcSignal &signal = signals[message.firstSignal + index];
+                std::string indent = "            ";
+                if (signal.multiplex == MULTIPLEXED) {
+                    if (message.multiplexer < 0) {
+                        continue;
+                    }
+                    out << indent << "if (multiplexer == " << signal.multiplexValue << "u) {\n";
+                    indent += "    ";
+                }
+                out << indent << "sink.push(SimEvent(\"" << eventName(message, signal) << "\", unpackSignal<"
+                    << descriptor(message, signal) << ">(frame.data), \"CanConnector\"));\n";
+                if (signal.multiplex == MULTIPLEXED) {
+                    out << "            }\n";
+                }
+            }
+            out << "        }\n";
+        }
+
+        // Members
+        out << "\n";
+        for (const auto &message: messages) {
+            out << "        int handle_" << message.name << " = INVALID_SEND_OPERATION;\n";
+        }
+        for (const auto &message: messages) {
+            for (uint32_t index = 0; index < message.signalCount; index++) {
+                const DbcSignal &signal = signals[message.firstSignal + index];
+                out << "        double " << member(message, signal) << " = " << literal(initialValue(signal)) << ";\n";
+            }
+        }
+
+        out << "    };\n\n}\n\n#endif //" << guard << "\n";
+    }
+
+}
+
+int main(int argc, char *argv[]) {
+
+    if (argc != 4) {
+        std::cerr << "Usage: " << argv[0] << " <dbc file> <codec class name> <output header>" << std::endl;
+        return 1;
+    }
+
+    try {
+        DbcDatabase database = DbcDatabase::loadFile(argv[1]);
+
+        for (const auto &name: database.skippedMessages) {
+            std::cout << argv[1] << ": The message <" << name << "> without payload is skipped" << std::endl;
+        }
+
+        for (const auto &message: database.messages) {
+            for (uint32_t index = message.firstSignal; index < message.firstSignal + message.signalCount; index++) {
+                const DbcSignal &signal = database.signals[index];
+                if (signal.role != SIGNAL_DATA) {
+                    std::cout << argv[1] << ": The signal <" << message.name << "." << signal.name << "> is handled as "
+                              << (signal.role == SIGNAL_ALIVE_COUNTER ? "alive counter" : "checksum") << std::endl;
+                }
+            }
+        }
+
+        // Generate into a string first, so a failing run does not leave a half written header
+        std::ostringstream header;
+        std::string source = argv[1];
+        generate(database, argv[2], source.substr(source.find_last_of('/') + 1), header);
+
+        std::ofstream out(argv[3]);
+        out << header.str();
+        if (!out) {
+            std::cerr << "Could not write <" << argv[3] << ">" << std::endl;
+            return 1;
+        }
+    } catch (const std::exception &error) {
+        std::cerr << argv[1] << ": " << error.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,371 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+// Project includes
+#include "DbcDatabase.h"
+#include "Crc.h"
+
+// System includes
+#include <cmath>
+#include <algorithm>
+#include <regex>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace sim_interface::dut_connector::can {
+
+    DbcDatabase DbcDatabase::loadFile(const std::string &path) {
+
+        std::ifstream input(path);
+        if (!input.is_open()) {
+            throw std::invalid_argument("DBC Codec: Could not open the DBC file <" + path + ">");
+        }
+
+        return parse(input);
+    }
+
+    DbcDatabase DbcDatabase::parse(std::istream &input) {
+
+        // BO_ <id> <name>: <length> <transmitter>
+        static const std::regex messagePattern(R"(^\s*BO_\s+(\d+)\s+(\w+)\s*:\s*(\d+)\s+\w+)");
+
+        // SG_ <name> [M|m<value>] : <start>|<length>@<order><sign> (<factor>,<offset>) [<min>|<max>] "<unit>" <receivers>
+        static const std::regex signalPattern(
+                R"(^\s*SG_\s+(\w+)\s*(M|m\d+M?)?\s*:\s*(\d+)\|(\d+)@([01])([+-])\s*\(\s*([^,\s]+)\s*,\s*([^)\s]+)\s*\))"
+                R"(\s*\[\s*([^|\s]+)\s*\|\s*([^\]\s]+)\s*\])");
+
+        // SIG_VALTYPE_ <id> <name> : <type>;
+        static const std::regex valueTypePattern(R"(^\s*SIG_VALTYPE_\s+(\d+)\s+(\w+)\s*:?\s*([0-3])\s*;)");
+
+        DbcDatabase database;
+        DbcMessage *message = nullptr;
+        std::vector<canid_t> skippedCanIDs;
+        bool isSkipping = false;
+        std::string line;
+        std::smatch match;
+        size_t lineNumber = 0;
+
+        while (std::getline(input, line)) {
+            lineNumber++;
+
+            try {
+                if (std::regex_search(line, match, messagePattern)) {
+
+                    DbcMessage newMessage;
+                    newMessage.canID = static_cast<canid_t>(std::stoul(match[1]));
+                    newMessage.name = match[2];
+                    unsigned long length = std::stoul(match[3]);
+                    newMessage.firstSignal = database.signals.size();
+
+                    // Messages without payload hold signals that are not sent on the bus, e.g. the
+                    // VECTOR__INDEPENDENT_SIG_MSG of Vector tools. They are skipped with their signals.
+                    if (length == 0) {
+                        database.skippedMessages.push_back(newMessage.name);
+                        skippedCanIDs.push_back(newMessage.canID);
+                        message = nullptr;
+                        isSkipping = true;
+                        continue;
+                    }
+                    if (length > CANFD_MAX_DLEN) {
+                        throw std::invalid_argument("message length must be at most 64");
+                    }
+                    newMessage.length = static_cast<uint8_t>(length);
+
+                    database.messages.push_back(newMessage);
+                    message = &database.messages.back();
+                    isSkipping = false;
+
+                } else if (std::regex_search(line, match, signalPattern)) {
+
+                    if (isSkipping) {
+                        continue;
+                    }
+                    if (message == nullptr) {
+                        throw std::invalid_argument("signal without a message");
+                    }
+
+                    DbcSignal signal;
+                    signal.name = match[1];
+                    unsigned long startBit = std::stoul(match[3]);
+                    unsigned long length = std::stoul(match[4]);
+                    signal.byteOrder = match[5] == "1" ? INTEL : MOTOROLA;
+                    signal.isSigned = match[6] == "-";
+                    signal.factor = std::stod(match[7]);
+                    signal.offset = std::stod(match[8]);
+                    signal.minimum = std::stod(match[9]);
+                    signal.maximum = std::stod(match[10]);
+
+                    if (length == 0 || length > 64 || startBit >= CANFD_MAX_DLEN * 8) {
+                        throw std::invalid_argument("signal <" + signal.name + "> has an invalid start bit or length");
+                    }
+                    if (signal.factor == 0) {
+                        throw std::invalid_argument("signal <" + signal.name + "> has a factor of zero");
+                    }
+                    signal.length = static_cast<uint8_t>(length);
+
+                    // Multiplexer switch or multiplexed signal
+                    std::string multiplex = match[2];
+                    if (multiplex == "M") {
+                        if (message->multiplexer >= 0) {
+                            throw std::invalid_argument("message has more than one multiplexer signal");
+                        }
+                        signal.multiplex = MULTIPLEXER;
+                        message->multiplexer = static_cast<int32_t>(message->signalCount);
+                    } else if (!multiplex.empty()) {
+                        signal.multiplex = MULTIPLEXED;
+                        signal.multiplexValue = std::stoul(multiplex.substr(1));
+                    }
+
+                    computePosition(signal, startBit);
+
+                    database.signals.push_back(signal);
+                    message->signalCount++;
+
+                } else if (std::regex_search(line, match, valueTypePattern)) {
+
+                    auto canID = static_cast<canid_t>(std::stoul(match[1]));
+                    std::string name = match[2];
+                    std::string type = match[3];
+                    bool found = false;
+
+                    if (std::find(skippedCanIDs.begin(), skippedCanIDs.end(), canID) != skippedCanIDs.end()) {
+                        continue;
+                    }
+
+                    for (const auto &valueMessage: database.messages) {
+                        if (valueMessage.canID != canID) {
+                            continue;
+                        }
+                        for (uint32_t index = 0; index < valueMessage.signalCount; index++) {
+                            DbcSignal &signal = database.signals[valueMessage.firstSignal + index];
+                            if (signal.name == name) {
+                                signal.valueType = type == "1" ? FLOAT32 : type == "2" ? FLOAT64 : INTEGER;
+                                found = true;
+                            }
+                        }
+                    }
+
+                    if (!found) {
+                        throw std::invalid_argument("value type for the unknown signal <" + name + ">");
+                    }
+                }
+            } catch (const std::logic_error &error) {
+                // std::invalid_argument and std::out_of_range of the number conversions
+                throw std::invalid_argument(
+                        "DBC Codec: Line " + std::to_string(lineNumber) + ": " + error.what());
+            }
+        }
+
+        // Multiplexer indexes are stored relative to the message until here
+        for (auto &dbcMessage: database.messages) {
+            if (dbcMessage.multiplexer >= 0) {
+                dbcMessage.multiplexer += static_cast<int32_t>(dbcMessage.firstSignal);
+            }
+            database.validate(dbcMessage);
+        }
+
+        for (auto &signal: database.signals) {
+            signal.role = classify(signal);
+        }
+
+        return database;
+    }
+
+    namespace {
+
+        /**
+         * Splits the name of a signal into upper case words at underscores, other separators, camel case and
+         * digits, e.g. MsgCounter_2 into MSG, COUNTER, 2 and ACRCmd into ACR, CMD.
+         */
+        std::vector<std::string> nameWords(const std::string &name) {
+
+            std::vector<std::string> words;
+            std::string word;
+            for (size_t index = 0; index < name.size(); index++) {
+                auto character = static_cast<unsigned char>(name[index]);
+
+                if (!std::isalnum(character)) {
+                    if (!word.empty()) {
+                        words.push_back(word);
+                        word.clear();
+                    }
+                    continue;
+                }
+
+                if (!word.empty()) {
+                    auto previous = static_cast<unsigned char>(name[index - 1]);
+                    bool isNext = index + 1 < name.size();
+                    bool startsWord = std::islower(previous) && std::isupper(character);
+                    bool endsAcronym = std::isupper(previous) && std::isupper(character) && isNext &&
+                                       std::islower(static_cast<unsigned char>(name[index + 1]));
+                    bool changesDigit = (std::isdigit(previous) != 0) != (std::isdigit(character) != 0);
+                    if (startsWord || endsAcronym || changesDigit) {
+                        words.push_back(word);
+                        word.clear();
+                    }
+                }
+
+                word += static_cast<char>(std::toupper(character));
+            }
+
+            if (!word.empty()) {
+                words.push_back(word);
+            }
+
+            return words;
+        }
+
+        /**
+         * Checks if one of the words of the name is one of the keywords.
+         */
+        bool nameMatches(const std::vector<std::string> &words, std::initializer_list<const char *> keywords) {
+            for (const auto &word: words) {
+                for (const char *keyword: keywords) {
+                    if (word == keyword) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        /**
+         * Checks if the signal is an unsigned raw integer of at most the given length.
+         */
+        bool hasRawShape(const DbcSignal &signal, uint8_t maxLength) {
+            return signal.valueType == INTEGER && !signal.isSigned && signal.multiplex != MULTIPLEXER &&
+                   signal.length <= maxLength && signal.factor == 1 && signal.offset == 0;
+        }
+
+    }
+
+    DBC_SIGNAL_ROLE DbcDatabase::classify(const DbcSignal &signal) {
+
+        std::vector<std::string> words = nameWords(signal.name);
+
+        if (hasRawShape(signal, 8) &&
+            nameMatches(words, {"ALIV", "ALIVE", "COUNTER", "CNT", "CNTR", "CTR", "ALV", "SQC"})) {
+            return SIGNAL_ALIVE_COUNTER;
+        }
+
+        if (hasRawShape(signal, 32) && nameMatches(words, {"CHECKSUM", "CHKSM", "CRC", "CHK"})) {
+            return SIGNAL_CHECKSUM;
+        }
+
+        return SIGNAL_DATA;
+    }
+
+    std::pair<uint64_t, uint64_t> DbcDatabase::aliveCounterRange(const DbcSignal &signal) {
+
+        uint64_t first = 0;
+        uint64_t last = bitfield::lowMask(signal.length);
+
+        if (signal.minimum < signal.maximum && signal.factor > 0) {
+            double rawMinimum = std::ceil((signal.minimum - signal.offset) / signal.factor);
+            double rawMaximum = std::floor((signal.maximum - signal.offset) / signal.factor);
+            if (rawMinimum >= 0 && rawMinimum <= rawMaximum && rawMaximum <= static_cast<double>(last)) {
+                first = static_cast<uint64_t>(rawMinimum);
+                last = static_cast<uint64_t>(rawMaximum);
+            }
+        }
+
+        return {first, last};
+    }
+
+    uint64_t DbcDatabase::aliveCounterValue(const DbcSignal &signal, uint64_t transmission) {
+
+        auto [first, last] = aliveCounterRange(signal);
+
+        // A 64 bit counter without a range wraps around by itself
+        uint64_t span = last - first + 1;
+        return span == 0 ? transmission : first + transmission % span;
+    }
+
+    uint64_t DbcDatabase::checksumValue(const uint8_t data[], size_t length, const bitfield::BitField &field) {
+
+        uint8_t payload[CANFD_MAX_DLEN] = {0};
+        std::memcpy(payload, data, std::min<size_t>(length, CANFD_MAX_DLEN));
+        bitfield::insert(payload, field, 0);
+
+        uint64_t checksum;
+        if (field.length <= 8) {
+            checksum = crc::crc8SaeJ1850(payload, length);
+        } else if (field.length <= 16) {
+            checksum = crc::crc16Ccitt(payload, length);
+        } else {
+            checksum = crc::crc32(payload, length);
+        }
+        return checksum & bitfield::lowMask(field.length);
+    }
+
+    struct canfd_frame DbcDatabase::receiveMask(const DbcMessage &message) const {
+
+        struct canfd_frame mask = {0};
+        mask.can_id = message.canID;
+        mask.len = message.length;
+
+        for (uint32_t index = message.firstSignal; index < message.firstSignal + message.signalCount; index++) {
+            const DbcSignal &signal = signals[index];
+
+            if (!isAliveCounter(signal) && !isChecksum(signal)) {
+                bitfield::insert(mask.data, bitField(signal), bitfield::lowMask(signal.length));
+            }
+        }
+
+        return mask;
+    }
+
+    void DbcDatabase::computePosition(DbcSignal &signal, uint32_t startBit) {
+
+        bitfield::BitField field = signal.byteOrder == INTEL ? bitfield::intelField(startBit, signal.length)
+                                                             : bitfield::motorolaField(startBit, signal.length);
+        signal.lsbByte = field.lsbByte;
+        signal.lsbBit = field.lsbBit;
+        signal.byteStep = field.byteStep;
+    }
+
+    void DbcDatabase::validate(const DbcMessage &message) const {
+
+        for (uint32_t index = 0; index < message.signalCount; index++) {
+            const DbcSignal &signal = signals[message.firstSignal + index];
+
+            if ((signal.valueType == FLOAT32 && signal.length != 32) ||
+                (signal.valueType == FLOAT64 && signal.length != 64)) {
+                throw std::invalid_argument(
+                        "DBC Codec: The float signal <" + signal.name + "> must have a length of 32 or 64 bits");
+            }
+
+            int lastByte = bitfield::lastByte(bitField(signal));
+
+            if (signal.lsbByte >= message.length || lastByte < 0 || lastByte >= message.length) {
+                throw std::invalid_argument(
+                        "DBC Codec: The signal <" + signal.name + "> does not fit into the message <" +
+                        message.name + ">");
+            }
+        }
+    }
+
+}
@@ -0,0 +1,252 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_DBCDATABASE_H
+#define SIM_TO_DUT_INTERFACE_DBCDATABASE_H
+
+// Project includes
+#include "BitField.h"
+
+// System includes
+#include <string>
+#include <vector>
+#include <utility>
+#include <istream>
+#include <cstdint>
+#include <linux/can.h>
+
+namespace sim_interface::dut_connector::can {
+
+    /**
+     * Byte order of a DBC signal.
+     */
+    enum DBC_BYTE_ORDER {
+        MOTOROLA = 0,
+        INTEL = 1
+    };
+
+    /**
+     * Value type of a DBC signal.
+     */
+    enum DBC_VALUE_TYPE {
+        INTEGER,
+        FLOAT32,
+        FLOAT64
+    };
+
+    /**
+     * Multiplexing role of a DBC signal.
+     */
+    enum DBC_MULTIPLEX {
+        PLAIN,
+        MULTIPLEXER,
+        MULTIPLEXED
+    };
+
+    /**
+     * Role of a DBC signal, classified by its name and shape when the database is parsed.
+     */
+    enum DBC_SIGNAL_ROLE {
+        SIGNAL_DATA,
+        SIGNAL_ALIVE_COUNTER,
+        SIGNAL_CHECKSUM
+    };
+
+    /**
+     * <summary>
+     * A signal of a DBC message compiled for the pack/unpack kernel.
+     * </summary>
+     * The kernel walks the signal from its least significant bit. Intel signals continue in the next byte,
+     * Motorola signals in the previous byte, so both layouts only differ in the byte step.
+     */
+    struct DbcSignal {
+        std::string name;                        /**< The name of the signal, used as SimEvent operation.  */
+        uint16_t lsbByte = 0;                    /**< The byte of the least significant bit.               */
+        uint8_t lsbBit = 0;                      /**< The bit of the least significant bit in that byte.   */
+        int8_t byteStep = 1;                     /**< +1 for Intel, -1 for Motorola.                       */
+        uint8_t length = 0;                      /**< The length of the signal in bits (1..64).            */
+        bool isSigned = false;                   /**< Flag for two's complement signals.                   */
+        DBC_BYTE_ORDER byteOrder = INTEL;        /**< The byte order as defined in the DBC file.           */
+        DBC_VALUE_TYPE valueType = INTEGER;      /**< Integer or IEEE float value.                         */
+        DBC_MULTIPLEX multiplex = PLAIN;         /**< The multiplexing role of the signal.                 */
+        uint32_t multiplexValue = 0;             /**< The multiplexer value of a multiplexed signal.       */
+        double factor = 1;                       /**< physical = raw * factor + offset                     */
+        double offset = 0;                       /**< physical = raw * factor + offset                     */
+        double minimum = 0;                      /**< The minimum physical value, unused if equal to max.  */
+        double maximum = 0;                      /**< The maximum physical value, unused if equal to min.  */
+        DBC_SIGNAL_ROLE role = SIGNAL_DATA;      /**< Alive counters and checksums are not simulation data.*/
+    };
+
+    /**
+     * @param signal - The signal.
+     *
+     * @return The position of the signal for the bit-field kernel.
+     */
+    inline bitfield::BitField bitField(const DbcSignal &signal) {
+        return {signal.lsbByte, signal.lsbBit, signal.byteStep, signal.length};
+    }
+
+    /**
+     * <summary>
+     * A DBC message. Its signals are stored consecutively in the signal table of the database.
+     * </summary>
+     */
+    struct DbcMessage {
+        std::string name;                        /**< The name of the message, used as sendOperation name.  */
+        canid_t canID = 0;                       /**< The CAN ID, extended IDs carry the CAN_EFF_FLAG.      */
+        uint8_t length = 0;                      /**< The payload length in bytes.                          */
+        uint32_t firstSignal = 0;                /**< Index of the first signal in the signal table.        */
+        uint32_t signalCount = 0;                /**< Number of signals of the message.                     */
+        int32_t multiplexer = -1;                /**< Index of the multiplexer signal, -1 if there is none. */
+    };
+
+    /**
+     * <summary>
+     * Messages and signals of a DBC file in flat tables.
+     * </summary>
+     * Only the parts of the DBC format needed for packing and unpacking are read (BO_, SG_ and SIG_VALTYPE_).
+     * Everything else (nodes, comments, attributes, value tables) is skipped, as well as messages of length 0
+     * (e.g. VECTOR__INDEPENDENT_SIG_MSG) and their signals.
+     */
+    class DbcDatabase {
+
+    public:
+
+        /**
+         * Loads a DBC file.
+         *
+         * @param path - The path of the DBC file.
+         *
+         * @return The database.
+         */
+        static DbcDatabase loadFile(const std::string &path);
+
+        /**
+         * Parses the content of a DBC file.
+         *
+         * @param input - The stream with the DBC content.
+         *
+         * @return The database.
+         */
+        static DbcDatabase parse(std::istream &input);
+
+        /**
+         * Classifies a signal by its name and shape. The name has to contain a counter or checksum keyword as a
+         * complete word, separated by underscores or camel case (e.g. ALIV_GESCHWINDIGKEIT, MsgCounter,
+         * CNT_LICHTER, CRC_GESCHWINDIGKEIT), so CounterSteerTorque or ACRCmd stay data. The signal also has to be
+         * an unsigned integer with factor 1 and offset 0 of at most 8 (counter) or 32 (checksum) bits.
+         *
+         * @param signal - The signal.
+         *
+         * @return The role of the signal.
+         */
+        static DBC_SIGNAL_ROLE classify(const DbcSignal &signal);
+
+        /**
+         * @param signal - The signal.
+         *
+         * @return True if the signal was classified as an alive counter.
+         */
+        static bool isAliveCounter(const DbcSignal &signal) {
+            return signal.role == SIGNAL_ALIVE_COUNTER;
+        }
+
+        /**
+         * @param signal - The signal.
+         *
+         * @return True if the signal was classified as a checksum.
+         */
+        static bool isChecksum(const DbcSignal &signal) {
+            return signal.role == SIGNAL_CHECKSUM;
+        }
+
+        /**
+         * Computes the raw values an alive counter runs through: the raw values of the range of the signal, or all
+         * values of its length if it has no range (e.g. [0|14] for counters where 15 marks an invalid value).
+         *
+         * @param signal - The alive counter.
+         *
+         * @return The first and the last raw value.
+         */
+        static std::pair<uint64_t, uint64_t> aliveCounterRange(const DbcSignal &signal);
+
+        /**
+         * Computes the raw value of an alive counter for a transmission. The counter runs through aliveCounterRange
+         * and starts over.
+         *
+         * @param signal       - The alive counter.
+         * @param transmission - The number of previous transmissions.
+         *
+         * @return The raw value of the counter.
+         */
+        static uint64_t aliveCounterValue(const DbcSignal &signal, uint64_t transmission);
+
+        /**
+         * Computes the raw value of a checksum for a payload. The checksum covers the payload bytes of the message
+         * with its own bits cleared: CRC8 SAE J1850 for checksums of up to 8 bits, CRC16 CCITT for up to 16 bits and
+         * CRC32 for longer ones, truncated to the length of the signal.
+         *
+         * @param data   - The payload.
+         * @param length - The payload length of the message in bytes.
+         * @param field  - The position of the checksum.
+         *
+         * @return The raw value of the checksum.
+         */
+        static uint64_t checksumValue(const uint8_t data[], size_t length, const bitfield::BitField &field);
+
+        /**
+         * Computes the content mask of a message for a BCM RX_SETUP. The mask has the bits of all signals set,
+         * except for the alive counters, the checksums and the unused bits of the message.
+         *
+         * @param message - The message.
+         *
+         * @return The mask with the length of the message.
+         */
+        struct canfd_frame receiveMask(const DbcMessage &message) const;
+
+        std::vector<DbcMessage> messages;         /**< The message table.                           */
+        std::vector<DbcSignal> signals;           /**< The signal table, grouped by message.         */
+        std::vector<std::string> skippedMessages; /**< The names of the skipped messages of length 0. */
+
+    private:
+
+        /**
+         * Computes the kernel position of a signal from the start bit in DBC notation.
+         *
+         * @param signal   - The signal.
+         * @param startBit - The start bit as defined in the DBC file.
+         */
+        static void computePosition(DbcSignal &signal, uint32_t startBit);
+
+        /**
+         * Checks that all bits of the signals are inside the message.
+         *
+         * @param message - The message.
+         */
+        void validate(const DbcMessage &message) const;
+    };
+
+}
+
+#endif //SIM_TO_DUT_INTERFACE_DBCDATABASE_H
@@ -0,0 +1,295 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+// Project includes
+#include "E2EProtection.h"
+#include "Crc.h"
+
+// System includes
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+
+namespace sim_interface::dut_connector::can {
+
+    namespace {
+
+        // Reads the nibble at a bit offset that is a multiple of 4
+        uint8_t readNibble(const uint8_t data[], uint16_t offset) {
+            return (data[offset / 8] >> (offset % 8)) & 0x0F;
+        }
+
+        // Writes the nibble at a bit offset that is a multiple of 4, the other nibble of the byte is kept
+        void writeNibble(uint8_t data[], uint16_t offset, uint8_t value) {
+            uint8_t shift = offset % 8;
+            data[offset / 8] = static_cast<uint8_t>((data[offset / 8] & ~(0x0F << shift)) | ((value & 0x0F) << shift));
+        }
+
+        // Feeds the payload without the bytes of the CRC into a CRC register
+        template<typename T, typename Update>
+        T feedPayload(Update update, T crc, const struct canfd_frame &frame, size_t crcByte, size_t crcLength) {
+            crc = update(crc, frame.data, crcByte);
+            return update(crc, frame.data + crcByte + crcLength, frame.len - crcByte - crcLength);
+        }
+
+    }
+
+    E2EProtection::E2EProtection(const E2EConfig &config) : dataID(config.dataID),
+                                                            maxDeltaCounter(config.maxDeltaCounter) {
+
+        if (config.profile == E2E_PROFILE_01 || config.profile == E2E_PROFILE_11) {
+            profile = config.profile == E2E_PROFILE_01 ? Profile::P01 : Profile::P11;
+
+            if (config.dataIDMode == E2E_DATA_ID_BOTH) {
+                dataIDMode = DataIDMode::BOTH;
+            } else if (config.dataIDMode == E2E_DATA_ID_NIBBLE) {
+                dataIDMode = DataIDMode::NIBBLE;
+            } else if (config.dataIDMode == E2E_DATA_ID_ALT && profile == Profile::P01) {
+                dataIDMode = DataIDMode::ALT;
+            } else if (config.dataIDMode == E2E_DATA_ID_LOW && profile == Profile::P01) {
+                dataIDMode = DataIDMode::LOW;
+            } else {
+                throw std::invalid_argument("E2E: The data ID mode <" + config.dataIDMode + "> is not supported by <" +
+                                            config.profile + ">");
+            }
+
+            if (config.crcOffset % 8 != 0 || config.counterOffset % 4 != 0 || config.dataIDNibbleOffset % 4 != 0) {
+                throw std::invalid_argument("E2E: The CRC must be byte aligned and the counter and the data ID "
+                                            "nibble must be nibble aligned");
+            }
+
+            crcByte = config.crcOffset / 8;
+            counterOffset = config.counterOffset;
+            nibbleOffset = config.dataIDNibbleOffset;
+            counterModulo = 15;
+            headerLength = std::max(crcByte, static_cast<size_t>(counterOffset / 8)) + 1;
+
+            bool overlaps = counterOffset / 8 == crcByte;
+            if (dataIDMode == DataIDMode::NIBBLE) {
+                headerLength = std::max(headerLength, static_cast<size_t>(nibbleOffset / 8) + 1);
+                overlaps |= nibbleOffset / 8 == crcByte || nibbleOffset == counterOffset;
+            }
+            if (overlaps) {
+                throw std::invalid_argument("E2E: The CRC, the counter and the data ID nibble overlap");
+            }
+
+        } else if (config.profile == E2E_PROFILE_02) {
+            profile = Profile::P02;
+
+            if (config.dataIDList.size() != dataIDList.size()) {
+                throw std::invalid_argument("E2E: Profile 2 needs a dataIDList with 16 data IDs");
+            }
+            for (size_t index = 0; index < dataIDList.size(); index++) {
+                if (config.dataIDList[index] > UINT8_MAX) {
+                    throw std::invalid_argument("E2E: The data IDs of profile 2 have 8 bits");
+                }
+                dataIDList[index] = static_cast<uint8_t>(config.dataIDList[index]);
+            }
+
+            // The layout of profile 2 is fixed
+            crcByte = 0;
+            counterOffset = 8;
+            counterModulo = 16;
+            headerLength = 2;
+
+        } else if (config.profile == E2E_PROFILE_05) {
+            profile = Profile::P05;
+
+            if (config.crcOffset % 8 != 0) {
+                throw std::invalid_argument("E2E: The CRC must be byte aligned");
+            }
+
+            // The counter byte follows the two bytes of the CRC
+            crcByte = config.crcOffset / 8;
+            counterOffset = static_cast<uint16_t>(config.crcOffset + 16);
+            counterModulo = 256;
+            headerLength = crcByte + 3;
+
+        } else {
+            throw std::invalid_argument("E2E: Unknown profile <" + config.profile + ">");
+        }
+
+        if (headerLength > CANFD_MAX_DLEN) {
+            throw std::invalid_argument("E2E: The header of <" + config.profile + "> does not fit into a CANFD frame");
+        }
+
+        if (maxDeltaCounter == 0 || maxDeltaCounter >= counterModulo) {
+            throw std::invalid_argument("E2E: maxDeltaCounter must be between 1 and " +
+                                        std::to_string(counterModulo - 1));
+        }
+    }
+
+    uint16_t E2EProtection::computeCrc(const struct canfd_frame &frame, uint8_t counter) const {
+
+        switch (profile) {
+            case Profile::P01:
+            case Profile::P11: {
+                // Start value 0x00 without a final XOR, as the chained AUTOSAR Crc_CalculateCRC8 calls compute it
+                uint8_t idBytes[2] = {static_cast<uint8_t>(dataID), static_cast<uint8_t>(dataID >> 8)};
+                uint8_t crc = 0x00;
+                switch (dataIDMode) {
+                    case DataIDMode::BOTH:
+                        crc = crc::crc8SaeJ1850Update(crc, idBytes, 2);
+                        break;
+                    case DataIDMode::ALT:
+                        crc = crc::crc8SaeJ1850Update(crc, &idBytes[counter % 2], 1);
+                        break;
+                    case DataIDMode::LOW:
+                        crc = crc::crc8SaeJ1850Update(crc, idBytes, 1);
+                        break;
+                    case DataIDMode::NIBBLE: {
+                        // The high byte is sent as nibble, the CRC covers it as zero
+                        uint8_t lowAndZero[2] = {idBytes[0], 0x00};
+                        crc = crc::crc8SaeJ1850Update(crc, lowAndZero, 2);
+                        break;
+                    }
+                }
+                return feedPayload<uint8_t>(crc::crc8SaeJ1850Update, crc, frame, crcByte, 1);
+            }
+            case Profile::P02: {
+                // The payload after the CRC byte, then the data ID of the counter
+                uint8_t crc = crc::crc8H2FUpdate(0xFF, frame.data + 1, frame.len - 1);
+                crc = crc::crc8H2FUpdate(crc, &dataIDList[counter], 1);
+                return crc ^ 0xFF;
+            }
+            case Profile::P05: {
+                uint8_t idBytes[2] = {static_cast<uint8_t>(dataID), static_cast<uint8_t>(dataID >> 8)};
+                uint16_t crc = feedPayload<uint16_t>(crc::crc16CcittUpdate, 0xFFFF, frame, crcByte, 2);
+                return crc::crc16CcittUpdate(crc, idBytes, 2);
+            }
+        }
+        return 0;
+    }
+
+    uint16_t E2EProtection::readCrc(const struct canfd_frame &frame) const {
+        if (profile == Profile::P05) {
+            return static_cast<uint16_t>(frame.data[crcByte] | (frame.data[crcByte + 1] << 8));
+        }
+        return frame.data[crcByte];
+    }
+
+    uint8_t E2EProtection::readCounter(const struct canfd_frame &frame) const {
+        if (profile == Profile::P05) {
+            return frame.data[counterOffset / 8];
+        }
+        return readNibble(frame.data, counterOffset);
+    }
+
+    void E2EProtection::writeCounter(struct canfd_frame &frame, uint8_t counter) const {
+        if (profile == Profile::P05) {
+            frame.data[counterOffset / 8] = counter;
+        } else {
+            writeNibble(frame.data, counterOffset, counter);
+        }
+    }
+
+    bool E2EProtection::protect(struct canfd_frame &frame) {
+
+        if (frame.len < headerLength) {
+            return false;
+        }
+
+        // Take the counter atomically, the CRC is computed from the taken value only
+        uint8_t counter = sendCounter.load(std::memory_order_relaxed);
+        while (!sendCounter.compare_exchange_weak(counter, static_cast<uint8_t>((counter + 1) % counterModulo),
+                                                  std::memory_order_relaxed)) {
+        }
+
+        writeCounter(frame, counter);
+        if (dataIDMode == DataIDMode::NIBBLE) {
+            writeNibble(frame.data, nibbleOffset, static_cast<uint8_t>(dataID >> 8));
+        }
+
+        // The CRC covers the counter and the nibble
+        uint16_t crc = computeCrc(frame, counter);
+        frame.data[crcByte] = static_cast<uint8_t>(crc);
+        if (profile == Profile::P05) {
+            frame.data[crcByte + 1] = static_cast<uint8_t>(crc >> 8);
+        }
+
+        protectedFrames.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    E2ECheckStatus E2EProtection::check(const struct canfd_frame &frame) {
+
+        E2ECheckStatus status;
+        uint8_t counter = 0;
+
+        if (frame.len < headerLength) {
+            status = E2ECheckStatus::WRONG_CRC;
+        } else {
+            counter = readCounter(frame);
+
+            bool isValid = counter < counterModulo && readCrc(frame) == computeCrc(frame, counter);
+            if (dataIDMode == DataIDMode::NIBBLE) {
+                isValid &= readNibble(frame.data, nibbleOffset) == ((dataID >> 8) & 0x0F);
+            }
+
+            if (!isValid) {
+                status = E2ECheckStatus::WRONG_CRC;
+            } else if (!hasReceived) {
+                status = E2ECheckStatus::INITIAL;
+            } else {
+                // The counter wraps around after counterModulo values
+                uint16_t delta = (counter + counterModulo - lastCounter) % counterModulo;
+                if (delta == 0) {
+                    status = E2ECheckStatus::REPEATED;
+                } else if (delta == 1) {
+                    status = E2ECheckStatus::OK;
+                } else if (delta <= maxDeltaCounter) {
+                    status = E2ECheckStatus::OK_SOME_LOST;
+                } else {
+                    status = E2ECheckStatus::WRONG_SEQUENCE;
+                }
+            }
+        }
+
+        // A wrong sequence synchronizes to the new counter, so the following frames are accepted again
+        if (status != E2ECheckStatus::WRONG_CRC) {
+            lastCounter = counter;
+            hasReceived = true;
+        }
+
+        checkResults[static_cast<size_t>(status)].fetch_add(1, std::memory_order_relaxed);
+        return status;
+    }
+
+    std::string E2EProtection::getStatistics() const {
+
+        auto results = [this](E2ECheckStatus status) {
+            return checkResults[static_cast<size_t>(status)].load(std::memory_order_relaxed);
+        };
+
+        std::stringstream statistics;
+        statistics << protectedFrames.load(std::memory_order_relaxed) << " protected, "
+                   << results(E2ECheckStatus::OK) + results(E2ECheckStatus::INITIAL) << " ok, "
+                   << results(E2ECheckStatus::OK_SOME_LOST) << " ok with lost frames, "
+                   << results(E2ECheckStatus::REPEATED) << " repeated, "
+                   << results(E2ECheckStatus::WRONG_SEQUENCE) << " wrong sequence, "
+                   << results(E2ECheckStatus::WRONG_CRC) << " wrong CRC";
+        return statistics.str();
+    }
+
+}
@@ -0,0 +1,248 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_E2EPROTECTION_H
+#define SIM_TO_DUT_INTERFACE_E2EPROTECTION_H
+
+// System includes
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <linux/can.h>
+
+/**
+ * No E2E protection.
+ */
+#define E2E_PROFILE_NONE ""
+
+/**
+ * AUTOSAR E2E profile 1: CRC8 SAE J1850 over the data ID and the payload, 4 bit counter (0 - 14).
+ */
+#define E2E_PROFILE_01 "P01"
+
+/**
+ * AUTOSAR E2E profile 2: CRC8H2F over the payload and a data ID from a list selected by the counter,
+ * 4 bit counter (0 - 15). The CRC is the first byte and the counter the low nibble of the second byte.
+ */
+#define E2E_PROFILE_02 "P02"
+
+/**
+ * AUTOSAR E2E profile 5: CRC16 CCITT over the payload and the data ID, 8 bit counter (0 - 255)
+ * after the little endian CRC.
+ */
+#define E2E_PROFILE_05 "P05"
+
+/**
+ * AUTOSAR E2E profile 11: like profile 1 for the data ID modes BOTH and NIBBLE.
+ */
+#define E2E_PROFILE_11 "P11"
+
+/**
+ * Data ID modes of the profiles 1 and 11: both bytes of the data ID are part of the CRC.
+ */
+#define E2E_DATA_ID_BOTH "BOTH"
+
+/**
+ * Only the low byte of the data ID is part of the CRC if the counter is even, only the high byte if it is odd.
+ */
+#define E2E_DATA_ID_ALT "ALT"
+
+/**
+ * Only the low byte of the data ID is part of the CRC.
+ */
+#define E2E_DATA_ID_LOW "LOW"
+
+/**
+ * The low byte of the data ID is part of the CRC, the low nibble of the high byte is sent in the frame.
+ */
+#define E2E_DATA_ID_NIBBLE "NIBBLE"
+
+namespace sim_interface::dut_connector::can {
+
+    /**
+     * <summary>
+     * The E2E protection of the frames of a send or receive operation.
+     * </summary>
+     * All offsets are bit positions in the payload like the start bits of Intel signals.
+     */
+    struct E2EConfig {
+        std::string profile = E2E_PROFILE_NONE;     /**< The profile (E2E_PROFILE_...).                            */
+        uint16_t dataID = 0;                        /**< The data ID (profiles 1, 5 and 11).                        */
+        std::vector<uint16_t> dataIDList;           /**< The 16 data IDs selected by the counter (profile 2).       */
+        std::string dataIDMode = E2E_DATA_ID_BOTH;  /**< The data ID mode (profiles 1 and 11, E2E_DATA_ID_...).     */
+        uint16_t crcOffset = 0;                     /**< The offset of the CRC (profiles 1, 5 and 11).              */
+        uint16_t counterOffset = 8;                 /**< The offset of the counter (profiles 1 and 11).             */
+        uint16_t dataIDNibbleOffset = 12;           /**< The offset of the data ID nibble (data ID mode NIBBLE).    */
+        uint16_t maxDeltaCounter = 1;               /**< The largest counter step that is accepted on receive.      */
+    };
+
+    /**
+     * <summary>
+     * Result of the E2E check of a received frame.
+     * </summary>
+     */
+    enum class E2ECheckStatus {
+        OK,             /**< The counter advanced by one.                                                      */
+        INITIAL,        /**< The first frame, the counter is taken as it is.                                   */
+        OK_SOME_LOST,   /**< The counter advanced by more than one but not more than maxDeltaCounter.         */
+        REPEATED,       /**< The counter did not change, the frame is a repetition.                            */
+        WRONG_SEQUENCE, /**< The counter advanced by more than maxDeltaCounter.                                */
+        WRONG_CRC       /**< The CRC (or the data ID nibble) does not match or the frame is too short.        */
+    };
+
+    /**
+     * Number of the results of an E2E check.
+     */
+    constexpr size_t E2E_CHECK_RESULTS = static_cast<size_t>(E2ECheckStatus::WRONG_CRC) + 1;
+
+    /**
+     * <summary>
+     * AUTOSAR E2E protection of one data ID: writes the counter and the CRC into sent frames and
+     * checks received frames.
+     * </summary>
+     * The counter state belongs to the data ID, so one instance is used by exactly one send operation (protect)
+     * or one receive operation (check). protect can be called from several threads, e.g. the event thread and the
+     * threads of the periodic timers: every call takes its own counter value and computes the CRC from it. check is
+     * only called by the receiving thread. The statistics can be read at any time.
+     */
+    class E2EProtection {
+
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param config - The E2E configuration of the operation, the profile must not be E2E_PROFILE_NONE.
+         *
+         * @throws std::invalid_argument if the configuration is not valid for the profile.
+         */
+        explicit E2EProtection(const E2EConfig &config);
+
+        /**
+         * @return The number of payload bytes that the header of the profile needs.
+         */
+        size_t minimumLength() const {
+            return headerLength;
+        }
+
+        /**
+         * Writes the next counter, the data ID nibble and the CRC into a frame that is sent. Thread safe.
+         *
+         * @param frame - The frame with the payload of the codec.
+         *
+         * @return False if the payload is too short for the header, the frame is not changed.
+         */
+        bool protect(struct canfd_frame &frame);
+
+        /**
+         * Checks the CRC and the counter of a received frame and updates the counter state.
+         *
+         * @param frame - The received frame.
+         *
+         * @return The result of the check.
+         */
+        E2ECheckStatus check(const struct canfd_frame &frame);
+
+        /**
+         * @param status - The result of a check.
+         *
+         * @return True if the frame is passed to the codec: OK, INITIAL and OK_SOME_LOST.
+         */
+        static bool isAccepted(E2ECheckStatus status) {
+            return status == E2ECheckStatus::OK || status == E2ECheckStatus::INITIAL ||
+                   status == E2ECheckStatus::OK_SOME_LOST;
+        }
+
+        /**
+         * @return The number of protected frames and the number of checked frames per result.
+         */
+        std::string getStatistics() const;
+
+    private:
+
+        /**
+         * <summary>
+         * The profiles as they are used at runtime.
+         * </summary>
+         */
+        enum class Profile {
+            P01, P02, P05, P11
+        };
+
+        /**
+         * <summary>
+         * The data ID modes as they are used at runtime.
+         * </summary>
+         */
+        enum class DataIDMode {
+            BOTH, ALT, LOW, NIBBLE
+        };
+
+        /**
+         * Computes the CRC of a payload, the bytes of the CRC itself are left out.
+         *
+         * @param frame   - The frame.
+         * @param counter - The counter of the frame.
+         *
+         * @return The CRC of the profile.
+         */
+        uint16_t computeCrc(const struct canfd_frame &frame, uint8_t counter) const;
+
+        /**
+         * Reads the CRC of a frame.
+         */
+        uint16_t readCrc(const struct canfd_frame &frame) const;
+
+        /**
+         * Reads the counter of a frame.
+         */
+        uint8_t readCounter(const struct canfd_frame &frame) const;
+
+        /**
+         * Writes the counter into a frame.
+         */
+        void writeCounter(struct canfd_frame &frame, uint8_t counter) const;
+
+        Profile profile;                                                     /**< The profile.                       */
+        DataIDMode dataIDMode = DataIDMode::BOTH;                            /**< The data ID mode (P01, P11).       */
+        uint16_t dataID;                                                     /**< The data ID.                       */
+        std::array<uint8_t, 16> dataIDList{};                                /**< The data IDs by counter (P02).     */
+        size_t crcByte = 0;                                                  /**< The first byte of the CRC.         */
+        uint16_t counterOffset = 8;                                          /**< The bit offset of the counter.     */
+        uint16_t nibbleOffset = 12;                                          /**< Bit offset of the ID nibble.       */
+        uint16_t counterModulo;                                              /**< The number of counter values.      */
+        uint16_t maxDeltaCounter;                                            /**< The largest accepted counter step. */
+        size_t headerLength = 0;                                             /**< Payload bytes of the header.       */
+        std::atomic<uint8_t> sendCounter{0};                                 /**< Counter of the next frame.         */
+        uint8_t lastCounter = 0;                                             /**< Counter of the last check.         */
+        bool hasReceived = false;                                            /**< Flag if a frame was checked.       */
+        std::atomic<uint64_t> protectedFrames{0};                            /**< Number of protected frames.        */
+        std::array<std::atomic<uint64_t>, E2E_CHECK_RESULTS> checkResults{}; /**< Checked frames per result.         */
+    };
+
+}
+
+#endif //SIM_TO_DUT_INTERFACE_E2EPROTECTION_H
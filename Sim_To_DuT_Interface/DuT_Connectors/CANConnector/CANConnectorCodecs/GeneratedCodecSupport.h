@@ -0,0 +1,222 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_GENERATEDCODECSUPPORT_H
+#define SIM_TO_DUT_INTERFACE_GENERATEDCODECSUPPORT_H
+
+// Project includes
+#include "DbcDatabase.h"
+#include "../CANConnectorCodecV2.h"
+
+// System includes
+#include <cmath>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+namespace sim_interface::dut_connector::can::generated {
+
+    /**
+     * <summary>
+     * Compile-time description of a DBC signal, the constexpr counterpart of DbcSignal.
+     * </summary>
+     * The codecs generated by add_can_codec pass the descriptors as template arguments,
+     * so the byte loop of the DbcCodec kernel is unrolled with constant shifts and masks.
+     */
+    struct SignalDescriptor {
+        uint16_t lsbByte;         /**< The byte of the least significant bit.             */
+        uint8_t lsbBit;           /**< The bit of the least significant bit in that byte. */
+        int8_t byteStep;          /**< +1 for Intel, -1 for Motorola.                     */
+        uint8_t length;           /**< The length of the signal in bits (1..64).          */
+        bool isSigned;            /**< Flag for two's complement signals.                 */
+        DBC_VALUE_TYPE valueType; /**< Integer or IEEE float value.                       */
+        double factor;            /**< physical = raw * factor + offset                   */
+        double offset;            /**< physical = raw * factor + offset                   */
+        double minimum;           /**< The minimum physical value, unused if equal to max. */
+        double maximum;           /**< The maximum physical value, unused if equal to min. */
+    };
+
+    /**
+     * @return The position of the signal for the bit-field kernel.
+     */
+    constexpr bitfield::BitField bitField(const SignalDescriptor &signal) {
+        return {signal.lsbByte, signal.lsbBit, signal.byteStep, signal.length};
+    }
+
+    /**
+     * Reads the part of a signal in its I-th byte (counted from the least significant bit).
+     */
+    template<const SignalDescriptor &S, size_t I>
+    constexpr uint64_t unpackChunk(const __u8 data[]) {
+        return bitfield::extractChunk(data, bitField(S), I);
+    }
+
+    /**
+     * Writes the part of a signal in its I-th byte (counted from the least significant bit).
+     */
+    template<const SignalDescriptor &S, size_t I>
+    constexpr void packChunk(__u8 data[], uint64_t raw) {
+        bitfield::insertChunk(data, bitField(S), I, raw);
+    }
+
+    template<const SignalDescriptor &S, size_t... I>
+    constexpr uint64_t unpackBytes(const __u8 data[], std::index_sequence<I...>) {
+        return (unpackChunk<S, I>(data) | ...);
+    }
+
+    template<const SignalDescriptor &S, size_t... I>
+    constexpr void packBytes(__u8 data[], uint64_t raw, std::index_sequence<I...>) {
+        (packChunk<S, I>(data, raw), ...);
+    }
+
+    /**
+     * Reads the raw bits of a signal, see DbcCodec::unpackRaw.
+     */
+    template<const SignalDescriptor &S>
+    constexpr uint64_t unpackRaw(const __u8 data[]) {
+        return unpackBytes<S>(data, std::make_index_sequence<bitfield::byteCount(bitField(S))>());
+    }
+
+    /**
+     * Writes the raw bits of a signal, see DbcCodec::packRaw.
+     */
+    template<const SignalDescriptor &S>
+    constexpr void packRaw(__u8 data[], uint64_t raw) {
+        packBytes<S>(data, raw, std::make_index_sequence<bitfield::byteCount(bitField(S))>());
+    }
+
+    /**
+     * Converts a raw value to the physical value, see DbcCodec::toPhysical.
+     */
+    template<const SignalDescriptor &S>
+    inline double toPhysical(uint64_t raw) {
+
+        double value;
+
+        if constexpr (S.valueType == FLOAT32) {
+            float floatValue;
+            auto bits = static_cast<uint32_t>(raw);
+            std::memcpy(&floatValue, &bits, sizeof(floatValue));
+            value = floatValue;
+        } else if constexpr (S.valueType == FLOAT64) {
+            std::memcpy(&value, &raw, sizeof(value));
+        } else if constexpr (S.isSigned) {
+            value = static_cast<double>(bitfield::signExtend(raw, S.length));
+        } else {
+            value = static_cast<double>(raw);
+        }
+
+        return value * S.factor + S.offset;
+    }
+
+    /**
+     * Converts a physical value to the raw value with saturation, see DbcCodec::toRaw.
+     */
+    template<const SignalDescriptor &S>
+    inline uint64_t toRaw(double physical) {
+
+        if constexpr (S.minimum < S.maximum) {
+            physical = std::clamp(physical, S.minimum, S.maximum);
+        }
+
+        double scaled = (physical - S.offset) / S.factor;
+
+        if constexpr (S.valueType == FLOAT32) {
+            auto floatValue = static_cast<float>(scaled);
+            uint32_t bits;
+            std::memcpy(&bits, &floatValue, sizeof(bits));
+            return bits;
+        } else if constexpr (S.valueType == FLOAT64) {
+            uint64_t bits;
+            std::memcpy(&bits, &scaled, sizeof(bits));
+            return bits;
+        } else if constexpr (S.isSigned) {
+            constexpr auto maxRaw = static_cast<int64_t>((uint64_t{1} << (S.length - 1)) - 1);
+            constexpr int64_t minRaw = -maxRaw - 1;
+            int64_t raw;
+            if (std::isnan(scaled)) {
+                raw = 0;
+            } else if (scaled >= static_cast<double>(maxRaw)) {
+                raw = maxRaw;
+            } else if (scaled <= static_cast<double>(minRaw)) {
+                raw = minRaw;
+            } else {
+                raw = std::llround(scaled);
+            }
+            return static_cast<uint64_t>(raw);
+        } else {
+            constexpr uint64_t maxRaw = bitfield::lowMask(S.length);
+            if (std::isnan(scaled) || scaled <= 0) {
+                return 0;
+            } else if (scaled >= static_cast<double>(maxRaw)) {
+                return maxRaw;
+            }
+            return static_cast<uint64_t>(std::round(scaled));
+        }
+    }
+
+    /**
+     * Packs the physical value of a signal.
+     */
+    template<const SignalDescriptor &S>
+    inline void packSignal(__u8 data[], double physical) {
+        packRaw<S>(data, toRaw<S>(physical));
+    }
+
+    /**
+     * Writes a checksum over the payload of the message, see DbcDatabase::checksumValue.
+     */
+    template<const SignalDescriptor &S, uint8_t LENGTH>
+    inline void packChecksum(__u8 data[]) {
+        packRaw<S>(data, DbcDatabase::checksumValue(data, LENGTH, bitField(S)));
+    }
+
+    /**
+     * Unpacks the physical value of a signal.
+     */
+    template<const SignalDescriptor &S>
+    inline double unpackSignal(const __u8 data[]) {
+        return toPhysical<S>(unpackRaw<S>(data));
+    }
+
+    /**
+     * Reads the numeric value of a SimEvent.
+     *
+     * @param event - The simulation event.
+     *
+     * @return The value as double.
+     */
+    inline double eventValue(const SimEvent &event) {
+        if (event.value.type() == typeid(double)) {
+            return boost::get<double>(event.value);
+        } else if (event.value.type() == typeid(int)) {
+            return boost::get<int>(event.value);
+        }
+        throw std::invalid_argument("Generated Codec: SimEvent value type invalid");
+    }
+
+}
+
+#endif //SIM_TO_DUT_INTERFACE_GENERATEDCODECSUPPORT_H
@@ -0,0 +1,335 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+// Project includes
+#include "SignalBatchKernels.h"
+
+// System includes
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace sim_interface::dut_connector::can {
+
+    namespace {
+
+        /**
+         * Adding 1.5 * 2^52 moves an integer of at most 51 bits into the mantissa of a double.
+         * The bits of the sum are then the integer plus MAGIC_BITS, so both conversions are an add and a subtract.
+         * From double to integer the add rounds to nearest even, the pack kernels correct the ties afterwards.
+         */
+        constexpr double MAGIC = 6755399441055744.0;
+        constexpr int64_t MAGIC_BITS = 0x4338000000000000;
+
+        /**
+         * Precomputed constants of a signal that are shared by all frames of a batch.
+         */
+        struct BatchConstants {
+            uint64_t mask;     /**< Mask of the raw value.                                     */
+            uint64_t signBit;  /**< Sign bit of the raw value, zero for unsigned signals.      */
+            double minimumRaw; /**< The smallest raw value.                                    */
+            double maximumRaw; /**< The largest raw value.                                     */
+            bool clamp;        /**< Flag if the physical value is saturated to min and max.     */
+
+            explicit BatchConstants(const BatchSignalLayout &layout) :
+                    mask(bitfield::lowMask(layout.length)),
+                    signBit(layout.isSigned ? uint64_t{1} << (layout.length - 1) : 0),
+                    minimumRaw(layout.isSigned ? -static_cast<double>(uint64_t{1} << (layout.length - 1)) : 0),
+                    maximumRaw(layout.isSigned ? static_cast<double>((uint64_t{1} << (layout.length - 1)) - 1)
+                                               : static_cast<double>(mask)),
+                    clamp(layout.minimum < layout.maximum) {}
+        };
+
+        inline uint64_t loadWindow(const struct canfd_frame &frame, const BatchSignalLayout &layout) {
+            return bitfield::load<uint64_t>(&frame.data[layout.windowByte], layout.bigEndian);
+        }
+
+        inline void storeWindow(struct canfd_frame &frame, const BatchSignalLayout &layout, uint64_t word) {
+            bitfield::store<uint64_t>(&frame.data[layout.windowByte], word, layout.bigEndian);
+        }
+
+        /**
+         * Replaces the bits of the signal in the window of a frame.
+         */
+        inline void insertRaw(struct canfd_frame &frame, const BatchSignalLayout &layout, const BatchConstants &constants,
+                              uint64_t raw) {
+            uint64_t word = loadWindow(frame, layout);
+            word = (word & ~(constants.mask << layout.windowShift)) | ((raw & constants.mask) << layout.windowShift);
+            storeWindow(frame, layout, word);
+        }
+
+        // Scalar kernels, they use the same operations as the SIMD kernels so all paths give the same results
+
+        void unpackScalar(const BatchSignalLayout &layout, const BatchConstants &constants,
+                          const struct canfd_frame frames[], size_t begin, size_t count, double values[]) {
+            for (size_t index = begin; index < count; index++) {
+                uint64_t raw = (loadWindow(frames[index], layout) >> layout.windowShift) & constants.mask;
+                raw = (raw ^ constants.signBit) - constants.signBit;
+                values[index] = static_cast<double>(static_cast<int64_t>(raw)) * layout.factor + layout.offset;
+            }
+        }
+
+        void packScalar(const BatchSignalLayout &layout, const BatchConstants &constants, const double values[],
+                        size_t begin, size_t count, struct canfd_frame frames[]) {
+            for (size_t index = begin; index < count; index++) {
+                // Keeps NaN like std::clamp in DbcCodec::toRaw
+                double value = values[index];
+                if (constants.clamp) {
+                    value = layout.minimum > value ? layout.minimum : value;
+                    value = layout.maximum < value ? layout.maximum : value;
+                }
+                double scaled = (value - layout.offset) / layout.factor;
+                scaled = scaled == scaled ? scaled : 0;
+                scaled = constants.minimumRaw > scaled ? constants.minimumRaw : scaled;
+                scaled = constants.maximumRaw < scaled ? constants.maximumRaw : scaled;
+
+                // Round to nearest even, then move the ties away from zero like std::round
+                double shifted = scaled + MAGIC;
+                int64_t bits;
+                std::memcpy(&bits, &shifted, sizeof(bits));
+                double remainder = scaled - (shifted - MAGIC);
+                int64_t raw = bits - MAGIC_BITS + (remainder == 0.5 && scaled > 0) - (remainder == -0.5 && scaled < 0);
+                insertRaw(frames[index], layout, constants, static_cast<uint64_t>(raw));
+            }
+        }
+
+#if defined(__x86_64__)
+
+        // SSE2 is part of x86-64, so these kernels need no CPU check
+
+        void unpackSse2(const BatchSignalLayout &layout, const BatchConstants &constants,
+                        const struct canfd_frame frames[], size_t count, double values[]) {
+            const __m128i shift = _mm_cvtsi32_si128(layout.windowShift);
+            const __m128i mask = _mm_set1_epi64x(static_cast<int64_t>(constants.mask));
+            const __m128i signBit = _mm_set1_epi64x(static_cast<int64_t>(constants.signBit));
+            const __m128i magicBits = _mm_set1_epi64x(MAGIC_BITS);
+            const __m128d magic = _mm_set1_pd(MAGIC);
+            const __m128d factor = _mm_set1_pd(layout.factor);
+            const __m128d offset = _mm_set1_pd(layout.offset);
+
+            size_t index = 0;
+            for (; index + 2 <= count; index += 2) {
+                __m128i raw = _mm_set_epi64x(static_cast<int64_t>(loadWindow(frames[index + 1], layout)),
+                                             static_cast<int64_t>(loadWindow(frames[index], layout)));
+                raw = _mm_and_si128(_mm_srl_epi64(raw, shift), mask);
+                raw = _mm_sub_epi64(_mm_xor_si128(raw, signBit), signBit);
+                __m128d value = _mm_sub_pd(_mm_castsi128_pd(_mm_add_epi64(raw, magicBits)), magic);
+                _mm_storeu_pd(&values[index], _mm_add_pd(_mm_mul_pd(value, factor), offset));
+            }
+
+            unpackScalar(layout, constants, frames, index, count, values);
+        }
+
+        void packSse2(const BatchSignalLayout &layout, const BatchConstants &constants, const double values[],
+                      size_t count, struct canfd_frame frames[]) {
+            const __m128d minimum = _mm_set1_pd(layout.minimum);
+            const __m128d maximum = _mm_set1_pd(layout.maximum);
+            const __m128d minimumRaw = _mm_set1_pd(constants.minimumRaw);
+            const __m128d maximumRaw = _mm_set1_pd(constants.maximumRaw);
+            const __m128d factor = _mm_set1_pd(layout.factor);
+            const __m128d offset = _mm_set1_pd(layout.offset);
+            const __m128d magic = _mm_set1_pd(MAGIC);
+            const __m128i magicBits = _mm_set1_epi64x(MAGIC_BITS);
+            const __m128d zero = _mm_setzero_pd();
+            const __m128d half = _mm_set1_pd(0.5);
+            const __m128d minusHalf = _mm_set1_pd(-0.5);
+            alignas(16) int64_t raw[2];
+
+            size_t index = 0;
+            for (; index + 2 <= count; index += 2) {
+                // max and min return the second operand for NaN, so the value is the second one like in packScalar
+                __m128d value = _mm_loadu_pd(&values[index]);
+                if (constants.clamp) {
+                    value = _mm_min_pd(maximum, _mm_max_pd(minimum, value));
+                }
+                __m128d scaled = _mm_div_pd(_mm_sub_pd(value, offset), factor);
+                scaled = _mm_andnot_pd(_mm_cmpunord_pd(scaled, scaled), scaled);
+                scaled = _mm_min_pd(maximumRaw, _mm_max_pd(minimumRaw, scaled));
+
+                // The comparison masks are -1, so subtracting up adds one and adding down subtracts one
+                __m128d shifted = _mm_add_pd(scaled, magic);
+                __m128d remainder = _mm_sub_pd(scaled, _mm_sub_pd(shifted, magic));
+                __m128i up = _mm_castpd_si128(_mm_and_pd(_mm_cmpeq_pd(remainder, half), _mm_cmpgt_pd(scaled, zero)));
+                __m128i down = _mm_castpd_si128(
+                        _mm_and_pd(_mm_cmpeq_pd(remainder, minusHalf), _mm_cmplt_pd(scaled, zero)));
+                __m128i bits = _mm_sub_epi64(_mm_castpd_si128(shifted), magicBits);
+                bits = _mm_add_epi64(_mm_sub_epi64(bits, up), down);
+                _mm_store_si128(reinterpret_cast<__m128i *>(raw), bits);
+
+                insertRaw(frames[index], layout, constants, static_cast<uint64_t>(raw[0]));
+                insertRaw(frames[index + 1], layout, constants, static_cast<uint64_t>(raw[1]));
+            }
+
+            packScalar(layout, constants, values, index, count, frames);
+        }
+
+        __attribute__((target("avx2")))
+        void unpackAvx2(const BatchSignalLayout &layout, const BatchConstants &constants,
+                        const struct canfd_frame frames[], size_t count, double values[]) {
+            const __m128i shift = _mm_cvtsi32_si128(layout.windowShift);
+            const __m256i mask = _mm256_set1_epi64x(static_cast<int64_t>(constants.mask));
+            const __m256i signBit = _mm256_set1_epi64x(static_cast<int64_t>(constants.signBit));
+            const __m256i magicBits = _mm256_set1_epi64x(MAGIC_BITS);
+            const __m256d magic = _mm256_set1_pd(MAGIC);
+            const __m256d factor = _mm256_set1_pd(layout.factor);
+            const __m256d offset = _mm256_set1_pd(layout.offset);
+
+            // The windows of four frames are one frame apart, Motorola windows are byte swapped after the gather
+            const __m256i frameOffsets = _mm256_setr_epi64x(0, sizeof(struct canfd_frame),
+                                                            2 * sizeof(struct canfd_frame),
+                                                            3 * sizeof(struct canfd_frame));
+            const __m256i byteSwap = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                                      7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+
+            size_t index = 0;
+            for (; index + 4 <= count; index += 4) {
+                auto window = reinterpret_cast<const long long *>(&frames[index].data[layout.windowByte]);
+                __m256i raw = _mm256_i64gather_epi64(window, frameOffsets, 1);
+                if (layout.bigEndian) {
+                    raw = _mm256_shuffle_epi8(raw, byteSwap);
+                }
+                raw = _mm256_and_si256(_mm256_srl_epi64(raw, shift), mask);
+                raw = _mm256_sub_epi64(_mm256_xor_si256(raw, signBit), signBit);
+                __m256d value = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(raw, magicBits)), magic);
+                _mm256_storeu_pd(&values[index], _mm256_add_pd(_mm256_mul_pd(value, factor), offset));
+            }
+
+            unpackScalar(layout, constants, frames, index, count, values);
+        }
+
+        __attribute__((target("avx2")))
+        void packAvx2(const BatchSignalLayout &layout, const BatchConstants &constants, const double values[],
+                      size_t count, struct canfd_frame frames[]) {
+            const __m256d minimum = _mm256_set1_pd(layout.minimum);
+            const __m256d maximum = _mm256_set1_pd(layout.maximum);
+            const __m256d minimumRaw = _mm256_set1_pd(constants.minimumRaw);
+            const __m256d maximumRaw = _mm256_set1_pd(constants.maximumRaw);
+            const __m256d factor = _mm256_set1_pd(layout.factor);
+            const __m256d offset = _mm256_set1_pd(layout.offset);
+            const __m256d magic = _mm256_set1_pd(MAGIC);
+            const __m256i magicBits = _mm256_set1_epi64x(MAGIC_BITS);
+            const __m256d zero = _mm256_setzero_pd();
+            const __m256d half = _mm256_set1_pd(0.5);
+            const __m256d minusHalf = _mm256_set1_pd(-0.5);
+            alignas(32) int64_t raw[4];
+
+            size_t index = 0;
+            for (; index + 4 <= count; index += 4) {
+                // Same operations as packSse2, see there
+                __m256d value = _mm256_loadu_pd(&values[index]);
+                if (constants.clamp) {
+                    value = _mm256_min_pd(maximum, _mm256_max_pd(minimum, value));
+                }
+                __m256d scaled = _mm256_div_pd(_mm256_sub_pd(value, offset), factor);
+                scaled = _mm256_andnot_pd(_mm256_cmp_pd(scaled, scaled, _CMP_UNORD_Q), scaled);
+                scaled = _mm256_min_pd(maximumRaw, _mm256_max_pd(minimumRaw, scaled));
+
+                __m256d shifted = _mm256_add_pd(scaled, magic);
+                __m256d remainder = _mm256_sub_pd(scaled, _mm256_sub_pd(shifted, magic));
+                __m256i up = _mm256_castpd_si256(_mm256_and_pd(_mm256_cmp_pd(remainder, half, _CMP_EQ_OQ),
+                                                               _mm256_cmp_pd(scaled, zero, _CMP_GT_OQ)));
+                __m256i down = _mm256_castpd_si256(_mm256_and_pd(_mm256_cmp_pd(remainder, minusHalf, _CMP_EQ_OQ),
+                                                                 _mm256_cmp_pd(scaled, zero, _CMP_LT_OQ)));
+                __m256i bits = _mm256_sub_epi64(_mm256_castpd_si256(shifted), magicBits);
+                bits = _mm256_add_epi64(_mm256_sub_epi64(bits, up), down);
+                _mm256_store_si256(reinterpret_cast<__m256i *>(raw), bits);
+
+                for (size_t lane = 0; lane < 4; lane++) {
+                    insertRaw(frames[index + lane], layout, constants, static_cast<uint64_t>(raw[lane]));
+                }
+            }
+
+            packScalar(layout, constants, values, index, count, frames);
+        }
+
+        bool hasAvx2() {
+            static const bool avx2 = __builtin_cpu_supports("avx2");
+            return avx2;
+        }
+
+#endif
+
+    }
+
+    BatchSignalLayout makeBatchLayout(const DbcSignal &signal) {
+
+        BatchSignalLayout layout;
+        layout.length = signal.length;
+        layout.isSigned = signal.isSigned;
+        layout.factor = signal.factor;
+        layout.offset = signal.offset;
+        layout.minimum = signal.minimum;
+        layout.maximum = signal.maximum;
+        layout.bigEndian = signal.byteOrder == MOTOROLA;
+
+        if (layout.bigEndian) {
+            // The window ends with the byte of the least significant bit, the bytes before it are more significant
+            layout.windowByte = signal.lsbByte >= 7 ? signal.lsbByte - 7 : 0;
+            layout.windowShift = (7 - (signal.lsbByte - layout.windowByte)) * 8 + signal.lsbBit;
+        } else {
+            // The window starts with the byte of the least significant bit, but must stay inside the 64 bytes
+            layout.windowByte = signal.lsbByte <= CANFD_MAX_DLEN - 8 ? signal.lsbByte : CANFD_MAX_DLEN - 8;
+            layout.windowShift = (signal.lsbByte - layout.windowByte) * 8 + signal.lsbBit;
+        }
+
+        layout.vectorizable = signal.valueType == INTEGER && signal.length <= 51 &&
+                              layout.windowShift + signal.length <= 64;
+        return layout;
+    }
+
+    void unpackSignalBatch(const BatchSignalLayout &layout, const struct canfd_frame frames[], size_t count,
+                           double values[]) {
+
+        BatchConstants constants(layout);
+
+#if defined(__x86_64__)
+        if (hasAvx2()) {
+            unpackAvx2(layout, constants, frames, count, values);
+        } else {
+            unpackSse2(layout, constants, frames, count, values);
+        }
+#else
+        unpackScalar(layout, constants, frames, 0, count, values);
+#endif
+    }
+
+    void packSignalBatch(const BatchSignalLayout &layout, const double values[], size_t count,
+                         struct canfd_frame frames[]) {
+
+        BatchConstants constants(layout);
+
+#if defined(__x86_64__)
+        if (hasAvx2()) {
+            packAvx2(layout, constants, values, count, frames);
+        } else {
+            packSse2(layout, constants, values, count, frames);
+        }
+#else
+        packScalar(layout, constants, values, 0, count, frames);
+#endif
+    }
+
+}
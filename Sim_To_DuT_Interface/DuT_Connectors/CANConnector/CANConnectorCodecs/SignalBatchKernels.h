@@ -0,0 +1,98 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_SIGNALBATCHKERNELS_H
+#define SIM_TO_DUT_INTERFACE_SIGNALBATCHKERNELS_H
+
+// Project includes
+#include "DbcDatabase.h"
+
+// System includes
+#include <cstddef>
+#include <cstdint>
+#include <linux/can.h>
+
+namespace sim_interface::dut_connector::can {
+
+    /**
+     * <summary>
+     * Position of a signal inside an aligned 64 bit window of the payload, used by the batch kernels.
+     * </summary>
+     * Every signal that touches at most 8 bytes lies in one 64 bit word of the payload: Intel signals in the little
+     * endian word, Motorola signals in the big endian word at windowByte. Extracting the signal is then a shift and a
+     * mask that is the same for all frames, which the SIMD kernels apply to several frames at once.
+     */
+    struct BatchSignalLayout {
+        uint8_t windowByte = 0;    /**< The first byte of the 64 bit window.                            */
+        uint8_t windowShift = 0;   /**< The position of the least significant bit in the window.        */
+        bool bigEndian = false;    /**< Flag if the window is read in big endian order (Motorola).      */
+        uint8_t length = 0;        /**< The length of the signal in bits.                               */
+        bool isSigned = false;     /**< Flag for two's complement signals.                              */
+        bool vectorizable = false; /**< Flag if the batch kernels can handle the signal.                */
+        double factor = 1;         /**< physical = raw * factor + offset                                */
+        double offset = 0;         /**< physical = raw * factor + offset                                */
+        double minimum = 0;        /**< The minimum physical value, unused if not smaller than maximum. */
+        double maximum = 0;        /**< The maximum physical value, unused if not larger than minimum.  */
+    };
+
+    /**
+     * Computes the batch layout of a signal. Signals are vectorizable if they are integer signals of at most 51 bits
+     * that fit into one 64 bit window, so the raw values convert exactly from and to doubles.
+     *
+     * @param signal - The signal.
+     *
+     * @return The layout of the signal for the batch kernels.
+     */
+    BatchSignalLayout makeBatchLayout(const DbcSignal &signal);
+
+    /**
+     * Unpacks and scales one vectorizable signal of count frames of the same message.
+     * Uses AVX2 (the windows of four frames are read with one gather) or SSE2 if the CPU supports it, otherwise
+     * the scalar kernel.
+     *
+     * @param layout - The layout of the signal.
+     * @param frames - The frames.
+     * @param count  - The number of frames.
+     * @param values - The physical values, one per frame.
+     */
+    void unpackSignalBatch(const BatchSignalLayout &layout, const struct canfd_frame frames[], size_t count,
+                           double values[]);
+
+    /**
+     * Scales and packs one vectorizable signal into count frames of the same message. The other bits of the frames
+     * are kept. The raw values are the same as DbcCodec::toRaw: saturated to the physical and the raw range,
+     * rounded half away from zero and NaN results in zero. Uses AVX2 or SSE2 for the conversion if the CPU supports
+     * it, otherwise the scalar kernel. The raw values are written into the frames one by one.
+     *
+     * @param layout - The layout of the signal.
+     * @param values - The physical values, one per frame.
+     * @param count  - The number of frames.
+     * @param frames - The frames.
+     */
+    void packSignalBatch(const BatchSignalLayout &layout, const double values[], size_t count,
+                         struct canfd_frame frames[]);
+
+}
+
+#endif //SIM_TO_DUT_INTERFACE_SIGNALBATCHKERNELS_H
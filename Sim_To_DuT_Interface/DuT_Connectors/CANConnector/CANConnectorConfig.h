@@ -30,6 +30,9 @@
 #include "../ConnectorConfig.h"
 #include "CANConnectorReceiveOperation.h"
 #include "CANConnectorSendOperation.h"
+#include "CANGateway.h"
+#include "CANBusMonitor.h"
+#include "CANIsoTp.h"
 
 // System includes
 #include <set>
@@ -37,6 +40,17 @@
 #include <vector>
 #include <string>
 
+/**
+ * The name of the BCM backend. All frames are sent and received over the BCM socket.
+ */
+#define CAN_BACKEND_BCM "BCM"
+
+/**
+ * The name of the CAN_RAW backend. Non cyclic frames are sent and all frames are received over a CAN_RAW socket.
+ * Cyclic frames are still sent over the BCM socket.
+ */
+#define CAN_BACKEND_RAW "RAW"
+
 namespace sim_interface::dut_connector::can {
 
     /**
@@ -70,6 +84,18 @@ namespace sim_interface::dut_connector::can {
 
         std::string interfaceName; /**< The name of the interface that should be used. */
         std::string codecName;     /**< The name of the codec that should be used.     */
+        std::string backend = CAN_BACKEND_BCM; /**< The socket backend (CAN_BACKEND_BCM or CAN_BACKEND_RAW). */
+        std::string dbcFile;                   /**< The DBC file that is loaded by the DBC codec.            */
+        bool autoMasks = true;                 /**< Flag if the codecs create the receive masks.             */
+        int containerTimeout = 1000;           /**< Microseconds a container collects PDUs before it is sent.*/
+        bool txMonitor = false;                /**< Flag if the transmissions are confirmed and timestamped. */
+
+        /**
+         * Further codecs of the connector, e.g. one per ECU on the bus. The key is the name that the receive
+         * operations use in their codec entry, the value is the name of the codec or the path of a DBC file
+         * (ending in .dbc) for a DbcCodec. Receive operations without a codec entry use the codec of codecName.
+         */
+        std::map<std::string, std::string> codecs;
 
         /**
          * This map is used to set up the RX filters of the BCM socket based on the receive operation data
@@ -77,12 +103,37 @@ namespace sim_interface::dut_connector::can {
          */
         std::map<canid_t, CANConnectorReceiveOperation> frameToOperation;
 
+        /**
+         * The receive operations of further interfaces of the connector by the interface name, like frameToOperation
+         * for interfaceName. All interfaces are handled by the same io context and codecs, each has its own sockets
+         * and routing table. Send operations select their interface with their interfaceName.
+         */
+        std::map<std::string, std::map<canid_t, CANConnectorReceiveOperation>> interfaceFrameToOperation;
+
         /**
          * This map is used to get the send operation data (like the CAN ID, interval information etc.) that
          * was defined in the XML configuration file. The Key that is used is returned by the Codec and must
          * therefore match with a sendOperation entry that is defined in the XML configuration file.
          */
         std::map<std::string, CANConnectorSendOperation> operationToFrame;
+
+        /**
+         * Routes of the kernel CAN gateway that forward frames between interfaces without passing the simulation,
+         * e.g. from the DuT bus to the restbus. The connector creates them and removes them when it is destroyed.
+         */
+        std::vector<CANGatewayRoute> gatewayRoutes;
+
+        /**
+         * The bus load and error frame monitor of the interfaces, disabled with a window of 0 (default).
+         * The bitrates apply to all interfaces of the connector.
+         */
+        CANBusMonitorConfig busMonitor;
+
+        /**
+         * The ISO-TP operations of the connector. Their payloads are segmented by the kernel and exchanged with the
+         * simulation as string values of the simulation events, the operations have to be part of the operations.
+         */
+        std::vector<CANIsoTpOperation> isoTpOperations;
     };
 
 }
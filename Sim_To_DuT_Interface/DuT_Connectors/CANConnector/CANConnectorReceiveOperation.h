@@ -26,6 +26,9 @@
 #ifndef SIM_TO_DUT_INTERFACE_CANCONNECTORRECEIVEOPERATION_H
 #define SIM_TO_DUT_INTERFACE_CANCONNECTORRECEIVEOPERATION_H
 
+// Project includes
+#include "CANConnectorCodecs/E2EProtection.h"
+
 // System includes
 #include <string>
 #include <cstring>
@@ -33,6 +36,11 @@
 #include <linux/can.h>
 #include <linux/can/bcm.h>
 
+/**
+ * Suffix of the operation of the timeout events of a receive operation without a timeoutOperation.
+ */
+#define RX_TIMEOUT_OPERATION_SUFFIX "_Timeout"
+
 namespace sim_interface::dut_connector::can {
 
     /**
@@ -65,6 +73,12 @@ namespace sim_interface::dut_connector::can {
         bool hasMask;                     /**< Flag if a mask should be used to filter for content changes in the frames.*/
         int maskLength;                   /**< The length of the mask data.                                              */
         struct canfd_frame mask = {0};    /**< The mask that should be used to filter for content changes in the frames. */
+        std::string codec;                /**< The codec (see CANConnectorConfig::codecs) that decodes the frames.      */
+        E2EConfig e2e;                    /**< The E2E check of the frames, failed frames are not decoded.              */
+        bool isContainer = false;         /**< Flag for container frames, their PDUs are routed by the header ID.       */
+        bool isContained = false;         /**< Flag for PDUs that are only received in containers, the key is the ID.   */
+        int timeout = 0;                  /**< Milliseconds without a frame until the BCM reports a timeout, 0 for none.*/
+        std::string timeoutOperation;     /**< The operation of the timeout events, empty for operation + suffix.      */
     };
 
 }
@@ -34,14 +34,21 @@ namespace sim_interface::dut_connector::can {
                                                          bool announce,
                                                          __u32 count,
                                                          struct bcm_timeval ival1,
-                                                         struct bcm_timeval ival2) :
+                                                         struct bcm_timeval ival2,
+                                                         __u32 nframes) :
             canID(canID),
             isCANFD(isCANFD),
             isCyclic(isCyclic),
             announce(announce),
             count(count),
             ival1(ival1),
-            ival2(ival2) {
+            ival2(ival2),
+            nframes(nframes) {
+
+        // Assert that the sequence fits into a single BCM message (see MAXFRAMES of the CAN Connector)
+        if (this->nframes == 0 || this->nframes > 256) {
+            throw std::invalid_argument("CAN Connector Send Operation: nframes must be between 1 and 256");
+        }
 
         // Check if it is a cyclic operation
         if (this->isCyclic) {
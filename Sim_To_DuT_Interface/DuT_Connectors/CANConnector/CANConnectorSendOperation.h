@@ -26,12 +26,26 @@
 #ifndef SIM_TO_DUT_INTERFACE_CANCONNECTORSENDOPERATION_H
 #define SIM_TO_DUT_INTERFACE_CANCONNECTORSENDOPERATION_H
 
+// Project includes
+#include "CANConnectorCodecs/E2EProtection.h"
+
 // System includes
 #include <string>
 #include <stdexcept>
 #include <linux/can.h>
 #include <linux/can/bcm.h>
 
+/**
+ * Cyclic send operations are sent by the BCM in the kernel with a static payload.
+ */
+#define CAN_CYCLIC_ENGINE_BCM "BCM"
+
+/**
+ * Cyclic send operations are sent by the userspace scheduler of the CAN Connector, which lets the codec
+ * patch alive counters and checksums for each transmission.
+ */
+#define CAN_CYCLIC_ENGINE_USERSPACE "USERSPACE"
+
 namespace sim_interface::dut_connector::can {
 
     /**
@@ -54,6 +68,8 @@ namespace sim_interface::dut_connector::can {
          * @param count     - Number of times the frame is send with the first interval.
          * @param ival1     - First Interval.
          * @param ival2     - Second Interval.
+         * @param nframes   - Number of frames in the sequence (1 - 256). The codec must return this many
+         *                    frames. A cyclic sequence is sent by the BCM one frame per interval.
          */
         CANConnectorSendOperation(canid_t canID,
                                   bool isCANFD,
@@ -61,7 +77,8 @@ namespace sim_interface::dut_connector::can {
                                   bool announce = false,
                                   __u32 count = 0,
                                   struct bcm_timeval ival1 = {0},
-                                  struct bcm_timeval ival2 = {0});
+                                  struct bcm_timeval ival2 = {0},
+                                  __u32 nframes = 1);
 
         // Data members
         canid_t canID;                  /**< The CAN ID of the frame.                                   */
@@ -71,6 +88,11 @@ namespace sim_interface::dut_connector::can {
         __u32 count;                    /**< Number of times the frame is send with the first interval. */
         struct bcm_timeval ival1;       /**< First Interval.                                            */
         struct bcm_timeval ival2;       /**< Second Interval.                                           */
+        __u32 nframes;                  /**< Number of frames in the sequence.                          */
+        std::string cyclicEngine = CAN_CYCLIC_ENGINE_BCM; /**< The engine that sends the cyclic frames. */
+        E2EConfig e2e;                  /**< The E2E protection of the frames.                          */
+        std::string container;          /**< The container send operation the frames are packed into.   */
+        std::string interfaceName;      /**< The interface the frames are sent on, empty for the default.*/
     };
 
 }
@@ -0,0 +1,147 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+// Project includes
+#include "CANContainerPacker.h"
+
+// System includes
+#include <sstream>
+#include <stdexcept>
+
+namespace sim_interface::dut_connector::can {
+
+    /**
+     * The valid lengths of CANFD frames, a container is padded to the next one.
+     */
+    static constexpr __u8 CANFD_LENGTHS[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64};
+
+    CANContainerPacker::Container::Container(boost::asio::io_context &ioContext, canid_t canID, std::string name)
+            : canID(canID), name(std::move(name)), timer(ioContext) {}
+
+    CANContainerPacker::CANContainerPacker(boost::asio::io_context &ioContext, std::chrono::microseconds timeout,
+                                           SendFunction send)
+            : ioContext(ioContext), timeout(timeout), send(std::move(send)) {}
+
+    size_t CANContainerPacker::addContainer(canid_t canID, const std::string &name) {
+        containers.push_back(std::make_unique<Container>(ioContext, canID, name));
+        return containers.size() - 1;
+    }
+
+    void CANContainerPacker::pack(size_t index, uint32_t headerID, const struct canfd_frame &pdu) {
+
+        if (headerID == 0 || headerID > CONTAINER_MAX_HEADER_ID || pdu.len > CONTAINER_MAX_PDU_LENGTH) {
+            throw std::invalid_argument("CAN Container Packer: The PDU does not fit into a container");
+        }
+
+        Container &container = *containers[index];
+        std::lock_guard<std::mutex> lock(container.mutex);
+
+        // A container without room for the PDU is sent before the PDU starts the next one
+        struct canfd_frame full;
+        if (container.frame.len + CONTAINER_HEADER_SIZE + pdu.len > CANFD_MAX_DLEN && take(container, full)) {
+            send(index, full);
+        }
+
+        __u8 *header = &container.frame.data[container.frame.len];
+        header[0] = static_cast<__u8>(headerID >> 16);
+        header[1] = static_cast<__u8>(headerID >> 8);
+        header[2] = static_cast<__u8>(headerID);
+        header[3] = pdu.len;
+        std::memcpy(header + CONTAINER_HEADER_SIZE, pdu.data, pdu.len);
+
+        // The first PDU starts the collection timeout
+        if (container.frame.len == 0) {
+            uint64_t generation = container.generation;
+            container.timer.expires_after(timeout);
+            container.timer.async_wait([this, index, generation](const boost::system::error_code &errorCode) {
+                expire(index, generation, errorCode);
+            });
+        }
+
+        container.frame.len += CONTAINER_HEADER_SIZE + pdu.len;
+        container.pdus++;
+    }
+
+    bool CANContainerPacker::take(Container &container, struct canfd_frame &frame) {
+
+        if (container.frame.len == 0) {
+            return false;
+        }
+
+        container.packedPdus.fetch_add(container.pdus, std::memory_order_relaxed);
+        container.sentFrames.fetch_add(1, std::memory_order_relaxed);
+        container.generation++;
+
+        frame = container.frame;
+        frame.can_id = container.canID;
+
+        // Pad with zeros, a zero header ID ends the unpacking
+        for (__u8 length: CANFD_LENGTHS) {
+            if (length >= frame.len) {
+                std::memset(&frame.data[frame.len], 0, length - frame.len);
+                frame.len = length;
+                break;
+            }
+        }
+
+        container.frame = {0};
+        container.pdus = 0;
+        return true;
+    }
+
+    void CANContainerPacker::expire(size_t index, uint64_t generation, const boost::system::error_code &errorCode) {
+
+        // A container that was sent because it was full restarts the timeout with its next PDU
+        if (errorCode == boost::asio::error::operation_aborted) {
+            return;
+        }
+
+        Container &container = *containers[index];
+        std::lock_guard<std::mutex> lock(container.mutex);
+
+        struct canfd_frame frame;
+        if (container.generation == generation && take(container, frame)) {
+            container.timeoutFrames.fetch_add(1, std::memory_order_relaxed);
+            send(index, frame);
+        }
+    }
+
+    std::string CANContainerPacker::getStatistics() const {
+
+        std::stringstream statistics;
+        statistics << "CAN Container Packer: " << containers.size() << " containers";
+
+        for (const auto &container: containers) {
+            uint64_t frames = container->sentFrames.load();
+            uint64_t pdus = container->packedPdus.load();
+            statistics << "\n  " << container->name << ": " << frames << " frames with " << pdus << " PDUs ("
+                       << (frames == 0 ? 0.0 : static_cast<double>(pdus) / static_cast<double>(frames))
+                       << " per frame), " << container->timeoutFrames.load() << " sent by the timeout, "
+                       << frames - container->timeoutFrames.load() << " sent full";
+        }
+
+        return statistics.str();
+    }
+
+}
@@ -0,0 +1,209 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_CANCONTAINERPACKER_H
+#define SIM_TO_DUT_INTERFACE_CANCONTAINERPACKER_H
+
+// System includes
+#include <atomic>
+#include <cstring>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <linux/can.h>
+#include <boost/asio.hpp>
+
+/**
+ * Size of the short header in front of every contained PDU: 3 bytes header ID and 1 byte length, big endian.
+ */
+#define CONTAINER_HEADER_SIZE 4
+
+/**
+ * Largest header ID of the short header. The header ID 0 is reserved, it marks the padding of a container.
+ */
+#define CONTAINER_MAX_HEADER_ID 0xFFFFFFu
+
+/**
+ * Largest payload of a contained PDU, a container frame holds at least one PDU.
+ */
+#define CONTAINER_MAX_PDU_LENGTH (CANFD_MAX_DLEN - CONTAINER_HEADER_SIZE)
+
+namespace sim_interface::dut_connector::can {
+
+    /**
+     * <summary>
+     * Packs the PDUs of several send operations into CANFD container frames and unpacks received containers.
+     * </summary>
+     * Each contained PDU is preceded by a short header with its header ID and its length (AUTOSAR IpduM
+     * container with short headers). A container collects the PDUs until the next PDU does not fit anymore or the
+     * collection timeout after its first PDU expired, then it is padded with zeros to the next valid CANFD length
+     * and handed to the send function.
+     *
+     * Note: pack is called by the thread that handles the simulation events, the timeouts expire on the
+     * io context. The state of each container is guarded by its own mutex, which is also held while the send
+     * function runs, so the frames of a container are sent in order. The send function must not block.
+     */
+    class CANContainerPacker {
+
+    public:
+
+        /**
+         * Sends a complete container frame.
+         * The first parameter is the index of the container, the second the container frame.
+         */
+        using SendFunction = std::function<void(size_t, struct canfd_frame &)>;
+
+        /**
+         * Constructor.
+         *
+         * @param ioContext - The io context that runs the collection timeouts.
+         * @param timeout   - The time a container collects PDUs after its first PDU.
+         * @param send      - Sends the complete container frames.
+         */
+        CANContainerPacker(boost::asio::io_context &ioContext, std::chrono::microseconds timeout, SendFunction send);
+
+        /**
+         * Adds a container.
+         *
+         * @param canID - The CAN ID of the container frames.
+         * @param name  - The name of the container for logging.
+         *
+         * @return The index of the container.
+         */
+        size_t addContainer(canid_t canID, const std::string &name);
+
+        /**
+         * Adds a PDU to a container. A container that has no room left for the PDU is sent first.
+         *
+         * @param container - The index of the container.
+         * @param headerID  - The header ID of the PDU (1 - CONTAINER_MAX_HEADER_ID).
+         * @param pdu       - The PDU, len bytes of its data are packed (at most CONTAINER_MAX_PDU_LENGTH).
+         */
+        void pack(size_t container, uint32_t headerID, const struct canfd_frame &pdu);
+
+        /**
+         * Unpacks the PDUs of a received container frame. Unpacking stops at the padding (header ID 0) or at
+         * the end of the frame. A PDU that does not fit into the rest of the frame is malformed.
+         *
+         * @param container - The container frame.
+         * @param visitor   - Called with every PDU as a frame with the header ID as CAN ID.
+         *
+         * @return False if the container was malformed, the PDUs before the malformed one were visited.
+         */
+        template<typename Visitor>
+        static bool unpack(const struct canfd_frame &container, Visitor &&visitor) {
+
+            size_t offset = 0;
+            while (offset + CONTAINER_HEADER_SIZE <= container.len) {
+                const __u8 *header = &container.data[offset];
+                uint32_t headerID = (uint32_t(header[0]) << 16) | (uint32_t(header[1]) << 8) | header[2];
+                __u8 length = header[3];
+
+                if (headerID == 0) {
+                    return true;
+                }
+
+                offset += CONTAINER_HEADER_SIZE;
+                if (offset + length > container.len) {
+                    return false;
+                }
+
+                struct canfd_frame pdu = {0};
+                pdu.can_id = headerID;
+                pdu.len = length;
+                std::memcpy(pdu.data, &container.data[offset], length);
+                visitor(static_cast<const struct canfd_frame &>(pdu));
+
+                offset += length;
+            }
+            return true;
+        }
+
+        /**
+         * @return One line per container with the sent frames, the packed PDUs and the reason of the sends.
+         */
+        std::string getStatistics() const;
+
+    private:
+
+        /**
+         * <summary>
+         * The frame a container collects its PDUs in.
+         * </summary>
+         */
+        struct Container {
+            canid_t canID;                                  /**< The CAN ID of the container frames.          */
+            std::string name;                               /**< The name of the container.                   */
+            std::mutex mutex;                               /**< Guards the frame, the timer and the send.    */
+            struct canfd_frame frame = {0};                 /**< The collected PDUs.                          */
+            uint32_t pdus = 0;                              /**< Number of collected PDUs.                    */
+            uint64_t generation = 0;                        /**< Number of frames taken, identifies a timeout.*/
+            boost::asio::steady_timer timer;                /**< The collection timeout.                      */
+            std::atomic<uint64_t> sentFrames{0};            /**< Number of sent container frames.             */
+            std::atomic<uint64_t> packedPdus{0};            /**< Number of PDUs in the sent frames.           */
+            std::atomic<uint64_t> timeoutFrames{0};         /**< Number of frames sent by the timeout.        */
+
+            /**
+             * Constructor.
+             *
+             * @param ioContext - The io context of the timer.
+             * @param canID     - The CAN ID of the container frames.
+             * @param name      - The name of the container.
+             */
+            Container(boost::asio::io_context &ioContext, canid_t canID, std::string name);
+        };
+
+        /**
+         * Takes the collected PDUs of a container and pads the frame to the next valid CANFD length.
+         * The mutex of the container must be held.
+         *
+         * @param container - The container.
+         * @param frame     - The frame that is sent.
+         *
+         * @return False if the container is empty.
+         */
+        bool take(Container &container, struct canfd_frame &frame);
+
+        /**
+         * Sends the collected PDUs of a container when its timeout expired.
+         *
+         * @param index      - The index of the container.
+         * @param generation - The generation of the container when the timeout was started.
+         * @param errorCode  - The result of the timer wait.
+         */
+        void expire(size_t index, uint64_t generation, const boost::system::error_code &errorCode);
+
+        boost::asio::io_context &ioContext;                 /**< The io context of the timers.           */
+        std::chrono::microseconds timeout;                  /**< The collection timeout.                 */
+        SendFunction send;                                  /**< Sends the complete container frames.    */
+        std::vector<std::unique_ptr<Container>> containers; /**< The containers by the index.            */
+    };
+
+}
+
+#endif //SIM_TO_DUT_INTERFACE_CANCONTAINERPACKER_H
@@ -0,0 +1,384 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+// Project includes
+#include "CANCyclicScheduler.h"
+#include "../../Interface_Logger/InterfaceLogger.h"
+
+// System includes
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <sys/timerfd.h>
+#include <linux/can/bcm.h>
+
+namespace sim_interface::dut_connector::can {
+
+    CANCyclicScheduler::PeriodGroup::PeriodGroup(boost::asio::io_context &ioContext, std::chrono::nanoseconds period)
+            : period(period), timer(ioContext) {
+
+        int timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (timerFd < 0) {
+            InterfaceLogger::logMessage("CAN Connector: Could not create a timerfd for the cyclic scheduler: " +
+                                        std::string(std::strerror(errno)), LOG_LEVEL::ERROR);
+            throw std::runtime_error("CAN Connector: Could not create a timerfd for the cyclic scheduler");
+        }
+
+        timer.assign(timerFd);
+    }
+
+    CANCyclicScheduler::CANCyclicScheduler(boost::asio::io_context &ioContext,
+                                           std::unique_ptr<boost::asio::generic::raw_protocol::socket> socket,
+                                           const std::vector<CANConnectorSendOperation> &sendOperations,
+                                           const std::vector<std::string> &sendOperationNames,
+                                           const std::vector<int> &interfaceIndexes,
+                                           const std::vector<std::unique_ptr<E2EProtection>> &protection)
+            : ioContext(ioContext), strand(boost::asio::make_strand(ioContext)), socket(std::move(socket)) {
+
+        tasks.resize(sendOperations.size());
+
+        for (size_t handle = 0; handle < sendOperations.size(); handle++) {
+            const CANConnectorSendOperation &sendOperation = sendOperations[handle];
+
+            if (!isScheduled(sendOperation)) {
+                continue;
+            }
+
+            CyclicPayload initial;
+            initial.frames.resize(sendOperation.nframes);
+
+            auto task = std::make_unique<CyclicTask>(initial);
+            task->handle = static_cast<int>(handle);
+            task->name = sendOperationNames[handle];
+            task->isCANFD = sendOperation.isCANFD;
+            task->announce = sendOperation.announce;
+            task->count = sendOperation.count;
+            task->firstGroup = sendOperation.count > 0 ? findGroup(sendOperation.ival1) : -1;
+            task->secondGroup = findGroup(sendOperation.ival2);
+            task->protection = protection[handle].get();
+            task->address.can_family = AF_CAN;
+            task->address.can_ifindex = interfaceIndexes[handle];
+            tasks[handle] = std::move(task);
+        }
+
+        // Reserve the batches for all tasks that can be in a group, so the timer handlers do not allocate
+        for (auto &group: groups) {
+            size_t capacity = 0;
+            for (const auto &task: tasks) {
+                if (task && ((task->firstGroup >= 0 && groups[task->firstGroup] == group) ||
+                             (task->secondGroup >= 0 && groups[task->secondGroup] == group))) {
+                    capacity++;
+                }
+            }
+
+            group->tasks.reserve(capacity);
+            group->batchTasks.resize(capacity);
+            group->batchFrames.resize(capacity);
+            group->batchIovecs.resize(capacity);
+            group->batchHeaders.resize(capacity);
+        }
+
+        announceIovec.iov_base = &announceFrame;
+        announceHeader.msg_hdr.msg_iov = &announceIovec;
+        announceHeader.msg_hdr.msg_iovlen = 1;
+
+        InterfaceLogger::logMessage("CAN Connector: Created the cyclic scheduler with " +
+                                    std::to_string(groups.size()) + " timers", LOG_LEVEL::INFO);
+    }
+
+    bool CANCyclicScheduler::isScheduled(const CANConnectorSendOperation &sendOperation) {
+        return sendOperation.isCyclic && sendOperation.cyclicEngine == CAN_CYCLIC_ENGINE_USERSPACE;
+    }
+
+    int CANCyclicScheduler::findGroup(const struct bcm_timeval &interval) {
+
+        auto period = std::chrono::seconds(interval.tv_sec) + std::chrono::microseconds(interval.tv_usec);
+        if (period.count() == 0) {
+            return -1;
+        }
+
+        for (size_t index = 0; index < groups.size(); index++) {
+            if (groups[index]->period == period) {
+                return static_cast<int>(index);
+            }
+        }
+
+        groups.push_back(std::make_unique<PeriodGroup>(ioContext, period));
+        return static_cast<int>(groups.size() - 1);
+    }
+
+    void CANCyclicScheduler::update(int sendOperation, const struct canfd_frame frames[], __u32 nframes,
+                                    const CANConnectorCodecV2 *codec) {
+
+        // The payload slots have a single writer, a second thread in here would corrupt the back buffer
+        if (isUpdating.exchange(true, std::memory_order_acquire)) {
+            InterfaceLogger::logMessage("CAN Connector: Concurrent update of the cyclic scheduler, the events of "
+                                        "a connector must be handled by one thread at a time", LOG_LEVEL::ERROR);
+            throw std::logic_error("CAN Connector: Concurrent update of the cyclic scheduler");
+        }
+
+        CyclicTask &task = *tasks[sendOperation];
+
+        // Replace the frames in place, the timer handler takes them with the next transmission
+        task.payload.storeInPlace([&](CyclicPayload &payload) {
+            std::copy(frames, frames + std::min<size_t>(nframes, payload.frames.size()), payload.frames.begin());
+            payload.codec = codec;
+        });
+
+        isUpdating.store(false, std::memory_order_release);
+
+        if (!task.isStarted.exchange(true)) {
+            boost::asio::post(strand, [this, &task]() {
+                start(task);
+            });
+        } else if (task.announce) {
+            boost::asio::post(strand, [this, &task]() {
+                prepareFrame(task, announceFrame, announceIovec);
+                announceHeader.msg_hdr.msg_name = &task.address;
+                announceHeader.msg_hdr.msg_namelen = sizeof(task.address);
+                CyclicTask *announceTask = &task;
+                sendBatch(&announceTask, &announceHeader, 1, nullptr);
+            });
+        }
+    }
+
+    void CANCyclicScheduler::start(CyclicTask &task) {
+
+        task.remainingCount = task.count;
+        join(task, task.count > 0 ? task.firstGroup : task.secondGroup);
+
+        // Like TX_ANNOUNCE of the BCM the first frame is sent immediately
+        if (task.announce) {
+            prepareFrame(task, announceFrame, announceIovec);
+            announceHeader.msg_hdr.msg_name = &task.address;
+            announceHeader.msg_hdr.msg_namelen = sizeof(task.address);
+            CyclicTask *announceTask = &task;
+            sendBatch(&announceTask, &announceHeader, 1, nullptr);
+        }
+
+        InterfaceLogger::logMessage("CAN Connector: Started the cyclic send operation <" + task.name + ">",
+                                    LOG_LEVEL::DEBUG);
+    }
+
+    void CANCyclicScheduler::join(CyclicTask &task, int group) {
+
+        if (group < 0) {
+            return;
+        }
+
+        PeriodGroup &periodGroup = *groups[group];
+        periodGroup.tasks.push_back(&task);
+
+        if (periodGroup.isArmed) {
+            return;
+        }
+
+        // Start the timerfd on an absolute schedule: the first expiration is one period from now
+        auto now = std::chrono::steady_clock::now();
+        auto first = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()) + periodGroup.period;
+
+        struct itimerspec schedule = {};
+        schedule.it_value.tv_sec = static_cast<time_t>(first.count() / 1000000000);
+        schedule.it_value.tv_nsec = static_cast<long>(first.count() % 1000000000);
+        schedule.it_interval.tv_sec = static_cast<time_t>(periodGroup.period.count() / 1000000000);
+        schedule.it_interval.tv_nsec = static_cast<long>(periodGroup.period.count() % 1000000000);
+
+        if (timerfd_settime(periodGroup.timer.native_handle(), TFD_TIMER_ABSTIME, &schedule, nullptr) < 0) {
+            InterfaceLogger::logMessage("CAN Connector: Could not start the timerfd of the cyclic scheduler: " +
+                                        std::string(std::strerror(errno)), LOG_LEVEL::ERROR);
+            return;
+        }
+
+        // The deadline is advanced by the expirations of each read, starting one period before the first one
+        periodGroup.deadline = std::chrono::steady_clock::time_point(
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(first - periodGroup.period));
+        periodGroup.isArmed = true;
+        wait(periodGroup);
+    }
+
+    void CANCyclicScheduler::wait(PeriodGroup &group) {
+        boost::asio::async_read(group.timer, boost::asio::buffer(&group.expirations, sizeof(group.expirations)),
+                                boost::asio::bind_executor(strand, [this, &group](
+                                        const boost::system::error_code &errorCode, std::size_t) {
+                                    tick(group, errorCode);
+                                }));
+    }
+
+    void CANCyclicScheduler::tick(PeriodGroup &group, const boost::system::error_code &errorCode) {
+
+        if (errorCode) {
+            if (errorCode != boost::asio::error::operation_aborted) {
+                InterfaceLogger::logMessage("CAN Connector: The timerfd of the cyclic scheduler failed: " +
+                                            errorCode.message(), LOG_LEVEL::ERROR);
+            }
+            return;
+        }
+
+        // More than one expiration means that we missed intervals, only the current one is sent
+        uint64_t expirations = std::max<uint64_t>(group.expirations, 1);
+        group.deadline += std::chrono::duration_cast<std::chrono::steady_clock::duration>(group.period * expirations);
+
+        size_t count = 0;
+        size_t keep = 0;
+        for (CyclicTask *task: group.tasks) {
+
+            if (expirations > 1) {
+                task->missedCycles.fetch_add(expirations - 1, std::memory_order_relaxed);
+            }
+
+            prepareFrame(*task, group.batchFrames[count], group.batchIovecs[count]);
+            group.batchTasks[count] = task;
+            group.batchHeaders[count] = {};
+            group.batchHeaders[count].msg_hdr.msg_iov = &group.batchIovecs[count];
+            group.batchHeaders[count].msg_hdr.msg_iovlen = 1;
+            group.batchHeaders[count].msg_hdr.msg_name = &task->address;
+            group.batchHeaders[count].msg_hdr.msg_namelen = sizeof(task->address);
+            count++;
+
+            // After count transmissions with ival1 the task continues with ival2. Without ival2 it stops like
+            // the BCM, the next update starts it again.
+            if (task->remainingCount > 0 && --task->remainingCount == 0) {
+                if (task->secondGroup < 0) {
+                    task->isStarted = false;
+                    continue;
+                }
+
+                if (groups[task->secondGroup].get() != &group) {
+                    join(*task, task->secondGroup);
+                    continue;
+                }
+            }
+
+            group.tasks[keep++] = task;
+        }
+        group.tasks.resize(keep);
+
+        sendBatch(group.batchTasks.data(), group.batchHeaders.data(), count, &group.deadline);
+
+        // A group without tasks does not wake up the strand any more, the next join starts it again
+        if (group.tasks.empty()) {
+            disarm(group);
+            return;
+        }
+
+        wait(group);
+    }
+
+    void CANCyclicScheduler::disarm(PeriodGroup &group) {
+
+        // A zero it_value stops the timerfd and discards expirations that were not read yet
+        struct itimerspec stop = {};
+        if (timerfd_settime(group.timer.native_handle(), 0, &stop, nullptr) < 0) {
+            InterfaceLogger::logMessage("CAN Connector: Could not stop the timerfd of the cyclic scheduler: " +
+                                        std::string(std::strerror(errno)), LOG_LEVEL::ERROR);
+        }
+
+        group.isArmed = false;
+    }
+
+    void CANCyclicScheduler::prepareFrame(CyclicTask &task, struct canfd_frame &frame, struct iovec &iovec) {
+
+        const CyclicPayload &payload = task.payload.load();
+
+        if (task.nextFrame >= payload.frames.size()) {
+            task.nextFrame = 0;
+        }
+
+        frame = payload.frames[task.nextFrame];
+        task.nextFrame++;
+
+        // Let the codec write the alive counters and checksums of this transmission
+        uint64_t transmission = task.transmissions.fetch_add(1, std::memory_order_relaxed);
+        if (payload.codec != nullptr) {
+            payload.codec->patchCyclicFrame(task.handle, transmission, frame);
+        }
+
+        // The E2E counter and CRC cover the patched payload
+        if (task.protection != nullptr) {
+            task.protection->protect(frame);
+        }
+
+        // The CAN_RAW socket expects exactly one CAN_MTU or CANFD_MTU sized frame per message
+        iovec.iov_base = &frame;
+        iovec.iov_len = task.isCANFD ? CANFD_MTU : CAN_MTU;
+    }
+
+    void CANCyclicScheduler::sendBatch(CyclicTask *batchTasks[], struct mmsghdr headers[], size_t count,
+                                       const std::chrono::steady_clock::time_point *deadline) {
+
+        size_t offset = 0;
+        while (offset < count) {
+
+            auto nmsgs = static_cast<unsigned int>(std::min<size_t>(count - offset, CYCLIC_BATCH_SIZE));
+            int sent = sendmmsg(socket->native_handle(), &headers[offset], nmsgs, MSG_DONTWAIT);
+
+            if (sent < 0) {
+
+                // A full socket buffer drops the rest of the batch, the next interval sends new frames anyway
+                bool isBusy = errno == EAGAIN || errno == EWOULDBLOCK;
+                if (!isBusy) {
+                    InterfaceLogger::logMessage("CAN Connector: Cyclic send of <" + batchTasks[offset]->name +
+                                                "> failed: " + std::strerror(errno), LOG_LEVEL::ERROR);
+                }
+
+                size_t dropped = isBusy ? count - offset : 1;
+                for (size_t index = offset; index < offset + dropped; index++) {
+                    batchTasks[index]->droppedFrames.fetch_add(1, std::memory_order_relaxed);
+                    batchTasks[index] = nullptr;
+                }
+                offset += dropped;
+                continue;
+            }
+
+            // The frames of this call were handed to the kernel now, later calls of the batch have more jitter
+            if (deadline != nullptr) {
+                auto jitter = std::chrono::steady_clock::now() - *deadline;
+                for (size_t index = offset; index < offset + static_cast<size_t>(sent); index++) {
+                    batchTasks[index]->jitter.record(jitter);
+                }
+            }
+
+            offset += static_cast<size_t>(sent);
+        }
+    }
+
+    std::string CANCyclicScheduler::getStatistics() const {
+
+        std::stringstream statistics;
+        for (const auto &task: tasks) {
+            if (!task) {
+                continue;
+            }
+
+            statistics << "CAN Connector: Cyclic send operation <" << task->name << "> sent "
+                       << task->transmissions.load() << " frames, " << task->missedCycles.load()
+                       << " missed cycles, " << task->droppedFrames.load() << " dropped frames, jitter "
+                       << task->jitter.summary() << "\n";
+        }
+
+        return statistics.str();
+    }
+
+}
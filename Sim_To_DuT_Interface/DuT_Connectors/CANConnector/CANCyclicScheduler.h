@@ -0,0 +1,273 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_CANCYCLICSCHEDULER_H
+#define SIM_TO_DUT_INTERFACE_CANCYCLICSCHEDULER_H
+
+// Project includes
+#include "CANConnectorCodecV2.h"
+#include "CANConnectorSendOperation.h"
+#include "../../Utility/LatestValueSlot.h"
+#include "../../Utility/TimingHistogram.h"
+
+// System includes
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include <linux/can.h>
+#include <boost/asio.hpp>
+
+/**
+ * Maximum number of frames the cyclic scheduler sends with one sendmmsg call.
+ */
+#define CYCLIC_BATCH_SIZE 64
+
+namespace sim_interface::dut_connector::can {
+
+    /**
+     * <summary>
+     * Userspace engine for cyclic send operations whose payload has to change with every transmission.
+     * </summary>
+     * The send operations are grouped by their interval. Each group has one timerfd with an absolute schedule,
+     * so the wake-up latency does not accumulate. On every expiration the frames of all operations of the group
+     * are taken from the last encode, patched by the codec (alive counters), E2E protected and sent together with
+     * one sendmmsg call over a CAN_RAW socket. Like the BCM, a sequence sends one frame per interval and an operation
+     * with count sends count frames with ival1 before it continues with ival2.
+     *
+     * The send-time jitter (the time the sendmmsg call that carried the frame returned minus its deadline) is
+     * recorded per send operation, together with missed cycles and dropped frames. A group is stopped again when
+     * its last task left it.
+     *
+     * Note: the payload of a task is a single writer slot. update must not be called concurrently, the connector
+     * serializes it with the other event handling of the connector (the event thread and the timer threads).
+     * Concurrent calls are detected and rejected. All timer handlers run on one strand of the io context.
+     */
+    class CANCyclicScheduler {
+
+    public:
+
+        /**
+         * Constructor. Creates the period groups of all send operations that use the userspace engine.
+         * The timers are started with the first update of a send operation of the group.
+         *
+         * @param ioContext          - The io context that runs the timer handlers.
+         * @param socket             - The CAN_RAW socket the frames are sent with, bound to the interface.
+         * @param sendOperations     - The send operations by the handle.
+         * @param sendOperationNames - The names of the send operations by the handle.
+         * @param interfaceIndexes   - The index of the interface each send operation is sent on by the handle.
+         *                             Frames for other interfaces than the bound one are addressed per message.
+         * @param protection         - The E2E protection of the send operations by the handle (may be nullptr),
+         *                             applied after the codec patched a frame. Must outlive the scheduler.
+         */
+        CANCyclicScheduler(boost::asio::io_context &ioContext,
+                           std::unique_ptr<boost::asio::generic::raw_protocol::socket> socket,
+                           const std::vector<CANConnectorSendOperation> &sendOperations,
+                           const std::vector<std::string> &sendOperationNames,
+                           const std::vector<int> &interfaceIndexes,
+                           const std::vector<std::unique_ptr<E2EProtection>> &protection);
+
+        /**
+         * Checks if a send operation is sent by the userspace scheduler.
+         *
+         * @param sendOperation - The send operation.
+         *
+         * @return True for cyclic send operations with the userspace engine.
+         */
+        static bool isScheduled(const CANConnectorSendOperation &sendOperation);
+
+        /**
+         * Replaces the frames of a send operation from the next transmission on, without touching the schedule.
+         * The first update starts the send operation. With announce the frames are also sent immediately.
+         * Must not be called concurrently (single writer of the payloads).
+         *
+         * @param sendOperation - The handle of the send operation.
+         * @param frames        - The complete frames.
+         * @param nframes       - The number of frames, the nframes of the send operation.
+         * @param codec         - The codec that encoded the frames and patches them before each transmission.
+         *
+         * @throws std::logic_error if another thread is in update at the same time.
+         */
+        void update(int sendOperation, const struct canfd_frame frames[], __u32 nframes,
+                    const CANConnectorCodecV2 *codec);
+
+        /**
+         * @return One line per send operation with the transmissions, the jitter, missed cycles and dropped frames.
+         */
+        std::string getStatistics() const;
+
+    private:
+
+        /**
+         * <summary>
+         * The frames of a send operation and the codec that patches them.
+         * </summary>
+         */
+        struct CyclicPayload {
+            std::vector<struct canfd_frame> frames;        /**< The frames of the last update.           */
+            const CANConnectorCodecV2 *codec = nullptr;    /**< The codec that patches the frames.       */
+        };
+
+        /**
+         * <summary>
+         * State of a send operation of the userspace engine.
+         * </summary>
+         */
+        struct CyclicTask {
+            int handle = INVALID_SEND_OPERATION;           /**< The handle of the send operation.                   */
+            std::string name;                              /**< The name of the send operation.                     */
+            bool isCANFD = false;                          /**< Flag for CANFD frames.                              */
+            bool announce = false;                         /**< Flag for immediately sending out updates once.      */
+            __u32 count = 0;                               /**< Number of transmissions with the first interval.    */
+            int firstGroup = -1;                           /**< The group of ival1, -1 if count is zero.            */
+            int secondGroup = -1;                          /**< The group of ival2, -1 if ival2 is zero.            */
+            E2EProtection *protection = nullptr;           /**< The E2E protection, nullptr for none.               */
+            struct sockaddr_can address = {};              /**< The address of the interface the task is sent on.   */
+            LatestValueSlot<CyclicPayload> payload;        /**< The frames, written by update.                      */
+            std::atomic<bool> isStarted{false};            /**< Flag if the task is sending, set by update.         */
+            __u32 remainingCount = 0;                      /**< Transmissions left with the first interval.         */
+            __u32 nextFrame = 0;                           /**< The frame of the sequence that is sent next.        */
+            std::atomic<uint64_t> transmissions{0};        /**< Number of frames handed to the socket.              */
+            std::atomic<uint64_t> missedCycles{0};         /**< Number of intervals without a transmission.         */
+            std::atomic<uint64_t> droppedFrames{0};        /**< Number of frames the socket did not take.           */
+            TimingHistogram jitter;                        /**< Send time minus deadline of each transmission.      */
+
+            /**
+             * Constructor.
+             *
+             * @param initial - The initial payload with the frames of the sequence.
+             */
+            explicit CyclicTask(const CyclicPayload &initial) : payload(initial) {}
+        };
+
+        /**
+         * <summary>
+         * The send operations with the same interval and their timer.
+         * </summary>
+         */
+        struct PeriodGroup {
+            std::chrono::nanoseconds period;                           /**< The interval of the group.          */
+            boost::asio::posix::stream_descriptor timer;               /**< The timerfd of the group.           */
+            bool isArmed = false;                                      /**< Flag if the timerfd was started.    */
+            uint64_t expirations = 0;                                  /**< Read buffer of the timerfd.         */
+            std::chrono::steady_clock::time_point deadline;            /**< The deadline of the last expiration.*/
+            std::vector<CyclicTask *> tasks;                           /**< The tasks that are in the group.    */
+            std::vector<CyclicTask *> batchTasks;                      /**< The task of each frame of a batch.  */
+            std::vector<struct canfd_frame> batchFrames;               /**< The frames of a batch.              */
+            std::vector<struct iovec> batchIovecs;                     /**< IO vectors for sendmmsg.            */
+            std::vector<struct mmsghdr> batchHeaders;                  /**< Message headers for sendmmsg.       */
+
+            /**
+             * Constructor.
+             *
+             * @param ioContext - The io context of the timer.
+             * @param period    - The interval of the group.
+             */
+            PeriodGroup(boost::asio::io_context &ioContext, std::chrono::nanoseconds period);
+        };
+
+        /**
+         * Finds or creates the group of an interval.
+         *
+         * @param interval - The interval.
+         *
+         * @return The index of the group, -1 for a zero interval.
+         */
+        int findGroup(const struct bcm_timeval &interval);
+
+        /**
+         * Starts a task with its first interval. Runs on the strand.
+         *
+         * @param task - The task.
+         */
+        void start(CyclicTask &task);
+
+        /**
+         * Adds a task to a group and starts the timerfd of the group if it is not running yet. Runs on the strand.
+         *
+         * @param task  - The task.
+         * @param group - The index of the group, -1 stops the task.
+         */
+        void join(CyclicTask &task, int group);
+
+        /**
+         * Waits for the next expiration of the timerfd of a group.
+         *
+         * @param group - The group.
+         */
+        void wait(PeriodGroup &group);
+
+        /**
+         * Stops the timerfd of a group that has no tasks left. Runs on the strand.
+         *
+         * @param group - The group.
+         */
+        void disarm(PeriodGroup &group);
+
+        /**
+         * Sends the next frame of every task of the group. Runs on the strand.
+         *
+         * @param group      - The group.
+         * @param errorCode  - The result of the timerfd read.
+         */
+        void tick(PeriodGroup &group, const boost::system::error_code &errorCode);
+
+        /**
+         * Takes the next frame of the sequence of a task and lets the codec patch it. Runs on the strand.
+         *
+         * @param task  - The task.
+         * @param frame - The frame that is sent.
+         * @param iovec - The IO vector of the frame.
+         */
+        void prepareFrame(CyclicTask &task, struct canfd_frame &frame, struct iovec &iovec);
+
+        /**
+         * Sends the prepared frames with as few sendmmsg calls as possible. Frames the socket did not take are
+         * counted as dropped and their task is removed from the batch. The jitter of the sent frames is recorded
+         * when the sendmmsg call that carried them returned.
+         *
+         * @param tasks    - The task of each frame.
+         * @param headers  - The message headers of the frames.
+         * @param count    - The number of frames.
+         * @param deadline - The deadline of the frames, nullptr for frames outside the schedule (announce).
+         */
+        void sendBatch(CyclicTask *tasks[], struct mmsghdr headers[], size_t count,
+                       const std::chrono::steady_clock::time_point *deadline);
+
+        boost::asio::io_context &ioContext;                                 /**< The io context of the timers.       */
+        boost::asio::strand<boost::asio::io_context::executor_type> strand; /**< Serializes the timer handlers.      */
+        std::unique_ptr<boost::asio::generic::raw_protocol::socket> socket; /**< The CAN_RAW socket.                 */
+        std::vector<std::unique_ptr<CyclicTask>> tasks;                     /**< The tasks by the handle.            */
+        std::vector<std::unique_ptr<PeriodGroup>> groups;                   /**< The period groups.                  */
+        std::atomic<bool> isUpdating{false};                                /**< Detects concurrent update calls.    */
+        struct canfd_frame announceFrame = {0};                             /**< The frame of an announce send.      */
+        struct iovec announceIovec = {nullptr, 0};                          /**< IO vector of an announce send.      */
+        struct mmsghdr announceHeader = {};                                 /**< Message header of an announce send. */
+    };
+
+}
+
+#endif //SIM_TO_DUT_INTERFACE_CANCYCLICSCHEDULER_H
@@ -0,0 +1,375 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+// Project includes
+#include "CANGateway.h"
+#include "../../Interface_Logger/InterfaceLogger.h"
+
+// System includes
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <net/if.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/can/gw.h>
+
+namespace sim_interface::dut_connector::can {
+
+    /**
+     * <summary>
+     * A netlink request of the CAN gateway with room for the attributes of a route.
+     * </summary>
+     */
+    struct GatewayRequest {
+        struct nlmsghdr header;                     /**< The netlink header.                 */
+        struct rtcanmsg message;                    /**< The CAN gateway message.            */
+        char attributes[512];                       /**< The attributes of the route.        */
+    };
+
+    /**
+     * Appends an attribute to a netlink request.
+     *
+     * @param request - The request.
+     * @param type    - The type of the attribute.
+     * @param data    - The data of the attribute.
+     * @param length  - The length of the data.
+     */
+    static void addAttribute(GatewayRequest &request, uint16_t type, const void *data, size_t length) {
+        auto *attribute = reinterpret_cast<struct rtattr *>(reinterpret_cast<char *>(&request) +
+                                                            NLMSG_ALIGN(request.header.nlmsg_len));
+        attribute->rta_type = type;
+        attribute->rta_len = RTA_LENGTH(length);
+        std::memcpy(RTA_DATA(attribute), data, length);
+        request.header.nlmsg_len = NLMSG_ALIGN(request.header.nlmsg_len) + RTA_ALIGN(attribute->rta_len);
+    }
+
+    /**
+     * Creates a netlink request of the CAN gateway without attributes.
+     *
+     * @param type  - The message type.
+     * @param flags - The netlink flags.
+     *
+     * @return The request.
+     */
+    static GatewayRequest createRequest(uint16_t type, uint16_t flags) {
+        GatewayRequest request = {};
+        request.header.nlmsg_len = NLMSG_LENGTH(sizeof(struct rtcanmsg));
+        request.header.nlmsg_type = type;
+        request.header.nlmsg_flags = flags;
+        request.message.can_family = AF_CAN;
+        request.message.gwtype = CGW_TYPE_CAN_CAN;
+        return request;
+    }
+
+    CANGateway::CANGateway(std::vector<CANGatewayRoute> gatewayRoutes, const std::string &defaultInterface)
+            : routes(std::move(gatewayRoutes)) {
+
+        for (CANGatewayRoute &route: routes) {
+            if (route.sourceInterface.empty()) {
+                route.sourceInterface = defaultInterface;
+            }
+
+            uint32_t sourceIndex = if_nametoindex(route.sourceInterface.c_str());
+            uint32_t destinationIndex = if_nametoindex(route.destinationInterface.c_str());
+            if (sourceIndex == 0 || destinationIndex == 0) {
+                InterfaceLogger::logMessage("CAN Connector: Unknown interface of the gateway route from <" +
+                                            route.sourceInterface + "> to <" + route.destinationInterface + ">",
+                                            LOG_LEVEL::ERROR);
+                throw std::invalid_argument("CAN Connector: Unknown interface of the gateway route from <" +
+                                            route.sourceInterface + "> to <" + route.destinationInterface + ">");
+            }
+
+            sourceIndexes.push_back(sourceIndex);
+            destinationIndexes.push_back(destinationIndex);
+        }
+
+        netlinkSocket = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+        if (netlinkSocket < 0) {
+            InterfaceLogger::logMessage("CAN Connector: Could not create the netlink socket of the gateway: " +
+                                        std::string(std::strerror(errno)), LOG_LEVEL::ERROR);
+            throw std::runtime_error("CAN Connector: Could not create the netlink socket of the gateway");
+        }
+
+        // Do not wait forever if the kernel does not answer
+        struct timeval timeout = {1, 0};
+        setsockopt(netlinkSocket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        // The kernel updates a route with the same modification ID instead of creating a new one, so the IDs must not
+        // collide with the routes of other processes or the routes a crashed process left behind
+        try {
+            std::map<uint32_t, CANGatewayCounters> installedRoutes;
+            dumpRoutes(installedRoutes);
+            for (size_t index = 0; index < routes.size(); index++) {
+                uids.push_back(createUid(installedRoutes));
+            }
+        } catch (const std::runtime_error &) {
+            close(netlinkSocket);
+            throw;
+        }
+
+        try {
+            for (; installed < routes.size(); installed++) {
+                sendRoute(installed, RTM_NEWROUTE);
+            }
+        } catch (const std::runtime_error &) {
+            // The destructor does not run, remove the routes that were created
+            while (installed > 0) {
+                installed--;
+                try {
+                    sendRoute(installed, RTM_DELROUTE);
+                } catch (const std::runtime_error &) {}
+            }
+            close(netlinkSocket);
+            throw;
+        }
+
+        InterfaceLogger::logMessage("CAN Connector: Created " + std::to_string(routes.size()) +
+                                    " kernel gateway routes", LOG_LEVEL::INFO);
+    }
+
+    CANGateway::~CANGateway() {
+
+        for (size_t index = 0; index < installed; index++) {
+            try {
+                sendRoute(index, RTM_DELROUTE);
+            } catch (const std::runtime_error &) {
+                // Already logged, the remaining routes are still removed
+            }
+        }
+
+        close(netlinkSocket);
+    }
+
+    void CANGateway::sendRoute(size_t index, uint16_t type) const {
+
+        const CANGatewayRoute &route = routes[index];
+        uint16_t flags = NLM_F_REQUEST | NLM_F_ACK;
+        if (type == RTM_NEWROUTE) {
+            flags |= NLM_F_CREATE | NLM_F_EXCL;
+        }
+
+        GatewayRequest request = createRequest(type, flags);
+        request.message.flags = route.isCANFD ? CGW_FLAGS_CAN_FD : 0;
+
+        // The removal has to repeat all attributes of the route
+        if (route.rewriteID) {
+            if (route.isCANFD) {
+                struct cgw_fdframe_mod modification = {};
+                modification.cf.can_id = route.newID;
+                modification.modtype = CGW_MOD_ID;
+                addAttribute(request, CGW_FDMOD_SET, &modification, sizeof(modification));
+            } else {
+                struct cgw_frame_mod modification = {};
+                modification.cf.can_id = route.newID;
+                modification.modtype = CGW_MOD_ID;
+                addAttribute(request, CGW_MOD_SET, &modification, sizeof(modification));
+            }
+        }
+
+        addAttribute(request, CGW_MOD_UID, &uids[index], sizeof(uint32_t));
+
+        struct can_filter filter = {route.filterID, route.filterMask};
+        addAttribute(request, CGW_FILTER, &filter, sizeof(filter));
+
+        if (route.hopLimit > 0) {
+            auto hopLimit = static_cast<__u8>(route.hopLimit);
+            addAttribute(request, CGW_LIM_HOPS, &hopLimit, sizeof(hopLimit));
+        }
+
+        addAttribute(request, CGW_SRC_IF, &sourceIndexes[index], sizeof(uint32_t));
+        addAttribute(request, CGW_DST_IF, &destinationIndexes[index], sizeof(uint32_t));
+
+        int error = transact(&request);
+        if (error != 0) {
+            std::string action = type == RTM_NEWROUTE ? "create" : "remove";
+            InterfaceLogger::logMessage("CAN Connector: Could not " + action + " the gateway route from <" +
+                                        route.sourceInterface + "> to <" + route.destinationInterface + ">: " +
+                                        std::strerror(-error), LOG_LEVEL::ERROR);
+            throw std::runtime_error("CAN Connector: Could not " + action + " the gateway route from <" +
+                                     route.sourceInterface + "> to <" + route.destinationInterface + ">");
+        }
+    }
+
+    int CANGateway::transact(const void *request) const {
+
+        const auto *header = static_cast<const struct nlmsghdr *>(request);
+        if (send(netlinkSocket, request, header->nlmsg_len, 0) < 0) {
+            return -errno;
+        }
+
+        alignas(struct nlmsghdr) char buffer[CAN_GATEWAY_BUFFER_SIZE];
+        ssize_t length = recv(netlinkSocket, buffer, sizeof(buffer), 0);
+        if (length < 0) {
+            return -errno;
+        }
+
+        for (auto *answer = reinterpret_cast<struct nlmsghdr *>(buffer);
+             NLMSG_OK(answer, static_cast<uint32_t>(length)); answer = NLMSG_NEXT(answer, length)) {
+            if (answer->nlmsg_type == NLMSG_ERROR) {
+                return static_cast<struct nlmsgerr *>(NLMSG_DATA(answer))->error;
+            }
+        }
+        return -EPROTO;
+    }
+
+    uint32_t CANGateway::createUid(const std::map<uint32_t, CANGatewayCounters> &installedRoutes) {
+
+        // The lower bits of the process ID and a route counter of the process, shared by all gateways of the process
+        static std::atomic<uint32_t> routeCounter{0};
+        const uint32_t processMask = (uint32_t{1} << (32 - CAN_GATEWAY_ROUTE_BITS)) - 1;
+        const uint32_t processBits = (static_cast<uint32_t>(getpid()) & processMask) << CAN_GATEWAY_ROUTE_BITS;
+
+        while (true) {
+            uint32_t counter = ++routeCounter;
+            if (counter >= (uint32_t{1} << CAN_GATEWAY_ROUTE_BITS)) {
+                InterfaceLogger::logMessage("CAN Connector: The process created too many gateway routes, no free "
+                                            "modification ID is left", LOG_LEVEL::ERROR);
+                throw std::runtime_error("CAN Connector: No free modification ID for the gateway route");
+            }
+
+            // Processes whose IDs only differ in the upper bits get the same IDs, they are found in the kernel
+            uint32_t uid = processBits | counter;
+            if (installedRoutes.find(uid) == installedRoutes.end()) {
+                return uid;
+            }
+
+            std::stringstream message;
+            message << "CAN Connector: The modification ID 0x" << std::hex << uid
+                    << " is already used by a gateway route of the host, it is skipped";
+            InterfaceLogger::logMessage(message.str(), LOG_LEVEL::WARNING);
+        }
+    }
+
+    bool CANGateway::dumpRoutes(std::map<uint32_t, CANGatewayCounters> &installedRoutes) const {
+
+        GatewayRequest request = createRequest(RTM_GETROUTE, NLM_F_REQUEST | NLM_F_DUMP);
+        if (send(netlinkSocket, &request, request.header.nlmsg_len, 0) < 0) {
+            InterfaceLogger::logMessage("CAN Connector: Could not read the gateway routes: " +
+                                        std::string(std::strerror(errno)), LOG_LEVEL::WARNING);
+            return false;
+        }
+
+        // The dump answers with one message per route of the host and ends with NLMSG_DONE
+        alignas(struct nlmsghdr) char buffer[CAN_GATEWAY_BUFFER_SIZE];
+        while (true) {
+            ssize_t length = recv(netlinkSocket, buffer, sizeof(buffer), 0);
+            if (length < 0) {
+                InterfaceLogger::logMessage("CAN Connector: Could not read the gateway routes: " +
+                                            std::string(std::strerror(errno)), LOG_LEVEL::WARNING);
+                return false;
+            }
+
+            for (auto *answer = reinterpret_cast<struct nlmsghdr *>(buffer);
+                 NLMSG_OK(answer, static_cast<uint32_t>(length)); answer = NLMSG_NEXT(answer, length)) {
+
+                if (answer->nlmsg_type == NLMSG_DONE || answer->nlmsg_type == NLMSG_ERROR) {
+                    return answer->nlmsg_type == NLMSG_DONE;
+                }
+                if (answer->nlmsg_type != RTM_NEWROUTE) {
+                    continue;
+                }
+
+                // The kernel only reports the counters that are not zero
+                uint32_t uid = 0;
+                CANGatewayCounters route;
+                route.isInstalled = true;
+
+                auto *attribute = reinterpret_cast<struct rtattr *>(static_cast<char *>(NLMSG_DATA(answer)) +
+                                                                    NLMSG_ALIGN(sizeof(struct rtcanmsg)));
+                int attributeLength = static_cast<int>(answer->nlmsg_len) -
+                                      NLMSG_LENGTH(NLMSG_ALIGN(sizeof(struct rtcanmsg)));
+                for (; RTA_OK(attribute, attributeLength); attribute = RTA_NEXT(attribute, attributeLength)) {
+                    uint32_t value;
+                    if (RTA_PAYLOAD(attribute) != sizeof(value)) {
+                        continue;
+                    }
+                    std::memcpy(&value, RTA_DATA(attribute), sizeof(value));
+                    switch (attribute->rta_type) {
+                        case CGW_MOD_UID:
+                            uid = value;
+                            break;
+                        case CGW_HANDLED:
+                            route.handled = value;
+                            break;
+                        case CGW_DROPPED:
+                            route.dropped = value;
+                            break;
+                        case CGW_DELETED:
+                            route.deleted = value;
+                            break;
+                        default:
+                            break;
+                    }
+                }
+
+                if (uid != 0) {
+                    installedRoutes[uid] = route;
+                }
+            }
+        }
+    }
+
+    std::vector<CANGatewayCounters> CANGateway::readCounters() const {
+
+        std::map<uint32_t, CANGatewayCounters> installedRoutes;
+        dumpRoutes(installedRoutes);
+
+        std::vector<CANGatewayCounters> counters(routes.size());
+        for (size_t index = 0; index < uids.size(); index++) {
+            auto installedRoute = installedRoutes.find(uids[index]);
+            if (installedRoute != installedRoutes.end()) {
+                counters[index] = installedRoute->second;
+            }
+        }
+        return counters;
+    }
+
+    std::string CANGateway::getStatistics() const {
+
+        std::vector<CANGatewayCounters> counters = readCounters();
+
+        std::stringstream statistics;
+        statistics << "CAN Gateway: " << routes.size() << " routes";
+
+        for (size_t index = 0; index < routes.size(); index++) {
+            const CANGatewayRoute &route = routes[index];
+            statistics << "\n  " << route.sourceInterface << " -> " << route.destinationInterface << std::hex
+                       << " (filter 0x" << route.filterID << "/0x" << route.filterMask << ")" << std::dec;
+            if (counters[index].isInstalled) {
+                statistics << ": " << counters[index].handled << " forwarded, " << counters[index].dropped
+                           << " dropped, " << counters[index].deleted << " deleted by the hop limit";
+            } else {
+                statistics << ": not found in the kernel";
+            }
+        }
+
+        return statistics.str();
+    }
+
+}
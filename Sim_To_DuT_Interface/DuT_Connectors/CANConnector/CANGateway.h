@@ -0,0 +1,167 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_CANGATEWAY_H
+#define SIM_TO_DUT_INTERFACE_CANGATEWAY_H
+
+// System includes
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <linux/can.h>
+
+/**
+ * Size of the buffer for the netlink messages of the CAN gateway.
+ */
+#define CAN_GATEWAY_BUFFER_SIZE 8192
+
+/**
+ * Number of bits of the route counter in the modification ID of a gateway route, the bits above hold the process ID.
+ */
+#define CAN_GATEWAY_ROUTE_BITS 12
+
+namespace sim_interface::dut_connector::can {
+
+    /**
+     * <summary>
+     * A route of the kernel CAN gateway (CAN_GW) that forwards frames from one interface to another.
+     * </summary>
+     */
+    struct CANGatewayRoute {
+        std::string sourceInterface;      /**< The interface the frames are received on, empty for the connector's. */
+        std::string destinationInterface; /**< The interface the frames are sent on.                               */
+        canid_t filterID = 0;             /**< The CAN ID filter on the source interface.                          */
+        canid_t filterMask = 0;           /**< The mask of the filter, 0 forwards all frames.                       */
+        bool isCANFD = false;             /**< Flag for routing CANFD frames instead of CAN frames.                 */
+        bool rewriteID = false;           /**< Flag if the CAN ID of the forwarded frames is replaced.              */
+        canid_t newID = 0;                /**< The CAN ID of the forwarded frames if rewriteID is set.              */
+        int hopLimit = 0;                 /**< Limit of the gateway hops of a frame, 0 for the kernel default.      */
+    };
+
+    /**
+     * <summary>
+     * The counters of a route that the kernel keeps.
+     * </summary>
+     */
+    struct CANGatewayCounters {
+        bool isInstalled = false;         /**< Flag if the route was found in the kernel.                 */
+        uint32_t handled = 0;             /**< Number of forwarded frames.                                */
+        uint32_t dropped = 0;             /**< Number of frames that could not be sent.                   */
+        uint32_t deleted = 0;             /**< Number of frames that were deleted because of the hop limit. */
+    };
+
+    /**
+     * <summary>
+     * Programs the routes of the kernel CAN gateway over rtnetlink.
+     * </summary>
+     * The frames of the routes are forwarded by the kernel on the receive path of the source interface, without
+     * passing the connector or the simulation. The routes are created by the constructor and removed by the
+     * destructor. Each route gets a modification ID (CGW_MOD_UID) that no other route of the host uses, which
+     * identifies it in the route dump of the kernel and on removal.
+     *
+     * Note: Needs the can-gw kernel module and the CAP_NET_ADMIN capability.
+     */
+    class CANGateway {
+
+    public:
+
+        /**
+         * Constructor. Creates the routes in the kernel.
+         *
+         * @param routes           - The routes.
+         * @param defaultInterface - The source interface of routes without one.
+         */
+        CANGateway(std::vector<CANGatewayRoute> routes, const std::string &defaultInterface);
+
+        /**
+         * Destructor. Removes the routes from the kernel.
+         */
+        ~CANGateway();
+
+        CANGateway(const CANGateway &) = delete;
+
+        CANGateway &operator=(const CANGateway &) = delete;
+
+        /**
+         * Reads the counters of the routes from the kernel.
+         *
+         * @return The counters by the index of the route.
+         */
+        std::vector<CANGatewayCounters> readCounters() const;
+
+        /**
+         * @return One line per route with the interfaces, the filter and the counters of the kernel.
+         */
+        std::string getStatistics() const;
+
+    private:
+
+        /**
+         * Creates or removes a route.
+         *
+         * @param index   - The index of the route.
+         * @param type    - RTM_NEWROUTE or RTM_DELROUTE.
+         */
+        void sendRoute(size_t index, uint16_t type) const;
+
+        /**
+         * Sends a netlink request and waits for its acknowledgement.
+         *
+         * @param request - The request.
+         *
+         * @return Zero or the negative error code of the kernel.
+         */
+        int transact(const void *request) const;
+
+        /**
+         * Reads all routes of the host that have a modification ID from the kernel.
+         *
+         * @param installedRoutes - The counters of the routes by their modification ID.
+         *
+         * @return False if the routes could not be read completely, otherwise true.
+         */
+        bool dumpRoutes(std::map<uint32_t, CANGatewayCounters> &installedRoutes) const;
+
+        /**
+         * Creates a modification ID that no route of the host uses yet.
+         *
+         * @param installedRoutes - The routes of the host by their modification ID.
+         *
+         * @return The modification ID.
+         * @throws std::runtime_error if the route counter of the process is exhausted.
+         */
+        static uint32_t createUid(const std::map<uint32_t, CANGatewayCounters> &installedRoutes);
+
+        int netlinkSocket;                          /**< The rtnetlink socket.                        */
+        std::vector<CANGatewayRoute> routes;        /**< The routes.                                  */
+        std::vector<uint32_t> sourceIndexes;        /**< The interface index of the source of each route. */
+        std::vector<uint32_t> destinationIndexes;   /**< The interface index of the destination of each route. */
+        std::vector<uint32_t> uids;                 /**< The modification ID of each route.           */
+        size_t installed = 0;                       /**< Number of routes created in the kernel.      */
+    };
+
+}
+
+#endif //SIM_TO_DUT_INTERFACE_CANGATEWAY_H
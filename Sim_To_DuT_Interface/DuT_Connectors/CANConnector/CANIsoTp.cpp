@@ -0,0 +1,272 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+// Project includes
+#include "CANIsoTp.h"
+#include "../../Interface_Logger/InterfaceLogger.h"
+
+// System includes
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <linux/can/isotp.h>
+
+namespace sim_interface::dut_connector::can {
+
+    CANIsoTpTransport::CANIsoTpTransport(boost::asio::io_context &ioContext, int interfaceIndex,
+                                         std::string interfaceName, const CANIsoTpOperation &operation,
+                                         PayloadHandler payloadHandler)
+            : operation(operation.operation),
+              interfaceName(std::move(interfaceName)),
+              payloadHandler(std::move(payloadHandler)),
+              strand(boost::asio::make_strand(ioContext)),
+              socket(strand, boost::asio::generic::datagram_protocol(PF_CAN, CAN_ISOTP)),
+              rxBuffer(ISOTP_MAX_PAYLOAD) {
+
+        // STmin is either 0 to 127 ms or 100 to 900 µs
+        bool isValidStMin = (operation.stMin >= 0x00 && operation.stMin <= 0x7F) ||
+                            (operation.stMin >= 0xF1 && operation.stMin <= 0xF9);
+        if (!isValidStMin || operation.blockSize < 0 || operation.blockSize > 0xFF || operation.padding > 0xFF) {
+            InterfaceLogger::logMessage("CAN Connector: Invalid STmin, block size or padding of the ISO-TP "
+                                        "operation <" + this->operation + ">", LOG_LEVEL::ERROR);
+            throw std::invalid_argument("CAN Connector: Invalid ISO-TP operation <" + this->operation + ">");
+        }
+
+        // The options have to be set before the socket is bound
+        struct can_isotp_options options = {0};
+        options.flags = CAN_ISOTP_DEFAULT_FLAGS;
+        options.frame_txtime = CAN_ISOTP_DEFAULT_FRAME_TXTIME;
+        options.txpad_content = CAN_ISOTP_DEFAULT_PAD_CONTENT;
+        options.rxpad_content = CAN_ISOTP_DEFAULT_PAD_CONTENT;
+
+        if (operation.frameTxTime == 0) {
+            options.frame_txtime = CAN_ISOTP_FRAME_TXTIME_ZERO;
+        } else if (operation.frameTxTime > 0) {
+            options.frame_txtime = static_cast<__u32>(operation.frameTxTime) * 1000;
+        }
+
+        if (operation.padding >= 0) {
+            options.flags |= CAN_ISOTP_TX_PADDING;
+            options.txpad_content = static_cast<__u8>(operation.padding);
+        }
+
+        struct can_isotp_fc_options flowControl = {0};
+        flowControl.bs = static_cast<__u8>(operation.blockSize);
+        flowControl.stmin = static_cast<__u8>(operation.stMin);
+        flowControl.wftmax = CAN_ISOTP_DEFAULT_RECV_WFTMAX;
+
+        if (setsockopt(socket.native_handle(), SOL_CAN_ISOTP, CAN_ISOTP_OPTS, &options, sizeof(options)) < 0 ||
+            setsockopt(socket.native_handle(), SOL_CAN_ISOTP, CAN_ISOTP_RECV_FC, &flowControl,
+                       sizeof(flowControl)) < 0) {
+            InterfaceLogger::logMessage("CAN Connector: Could not set the options of the ISO-TP operation <" +
+                                        this->operation + ">: " + std::string(std::strerror(errno)),
+                                        LOG_LEVEL::ERROR);
+            throw std::runtime_error("CAN Connector: Could not set the options of the ISO-TP operation");
+        }
+
+        // CANFD transfers use frames with up to 64 bytes and the bitrate switch
+        if (operation.isCANFD) {
+            struct can_isotp_ll_options linkLayer = {0};
+            linkLayer.mtu = CANFD_MTU;
+            linkLayer.tx_dl = CANFD_MAX_DLEN;
+            linkLayer.tx_flags = CANFD_BRS;
+
+            if (setsockopt(socket.native_handle(), SOL_CAN_ISOTP, CAN_ISOTP_LL_OPTS, &linkLayer,
+                           sizeof(linkLayer)) < 0) {
+                InterfaceLogger::logMessage("CAN Connector: Could not enable CANFD frames on the ISO-TP operation <" +
+                                            this->operation + ">: " + std::string(std::strerror(errno)),
+                                            LOG_LEVEL::ERROR);
+                throw std::runtime_error("CAN Connector: Could not enable CANFD frames on the ISO-TP operation");
+            }
+        }
+
+        // Bind the socket to the interface and the CAN IDs of the transfers
+        sockaddr_can addr = {0};
+        addr.can_family = AF_CAN;
+        addr.can_ifindex = interfaceIndex;
+        addr.can_addr.tp.tx_id = operation.txID;
+        addr.can_addr.tp.rx_id = operation.rxID;
+
+        boost::system::error_code errorCode;
+        socket.bind(boost::asio::generic::datagram_protocol::endpoint{&addr, sizeof(addr)}, errorCode);
+        if (errorCode) {
+            InterfaceLogger::logMessage("CAN Connector: Could not bind the ISO-TP operation <" + this->operation +
+                                        "> to <" + this->interfaceName + ">: " + errorCode.message(),
+                                        LOG_LEVEL::ERROR);
+            throw std::runtime_error("CAN Connector: Could not bind the ISO-TP operation to the interface");
+        }
+
+        receivePayloads();
+
+        InterfaceLogger::logMessage("CAN Connector: Created the ISO-TP operation <" + this->operation + "> on <" +
+                                    this->interfaceName + ">", LOG_LEVEL::INFO);
+    }
+
+    bool CANIsoTpTransport::send(std::string payload) {
+
+        if (payload.empty() || payload.size() > ISOTP_MAX_PAYLOAD) {
+            InterfaceLogger::logMessage("CAN Connector: The payload of the ISO-TP operation <" + operation +
+                                        "> has an invalid length of " + std::to_string(payload.size()) + " bytes",
+                                        LOG_LEVEL::WARNING);
+            return false;
+        }
+
+        boost::asio::post(strand, [this, payload = std::move(payload)]() mutable {
+            if (pending.size() == ISOTP_MAX_PENDING) {
+                droppedPayloads.fetch_add(1, std::memory_order_relaxed);
+                InterfaceLogger::logMessage("CAN Connector: Dropped a payload of the ISO-TP operation <" + operation +
+                                            ">, " + std::to_string(ISOTP_MAX_PENDING) + " transfers are pending",
+                                            LOG_LEVEL::WARNING);
+                return;
+            }
+
+            pending.push_back(std::move(payload));
+            sendNext();
+        });
+
+        return true;
+    }
+
+    void CANIsoTpTransport::sendNext() {
+
+        if (isSending || pending.empty()) {
+            return;
+        }
+
+        isSending = true;
+        transferStart = std::chrono::steady_clock::now();
+
+        socket.async_send(boost::asio::buffer(pending.front()),
+                          boost::asio::bind_executor(strand, [this](boost::system::error_code errorCode,
+                                                                    std::size_t length) {
+
+            if (errorCode == boost::asio::error::operation_aborted) {
+                return;
+            }
+
+            if (errorCode) {
+                transferErrors.fetch_add(1, std::memory_order_relaxed);
+                InterfaceLogger::logMessage("CAN Connector: Could not send the payload of the ISO-TP operation <" +
+                                            operation + ">: " + errorCode.message(), LOG_LEVEL::ERROR);
+                pending.pop_front();
+                isSending = false;
+                sendNext();
+                return;
+            }
+
+            // The kernel has taken the payload, the socket is writable again when the last frame was sent
+            socket.async_wait(boost::asio::socket_base::wait_write,
+                              boost::asio::bind_executor(strand, [this](boost::system::error_code errorCode) {
+
+                if (errorCode == boost::asio::error::operation_aborted) {
+                    return;
+                }
+
+                // An aborted transfer also makes the socket writable, its error is either still pending on the
+                // socket or was already taken by the receive operation
+                boost::system::error_code transferError = errorCode ? errorCode : takeSocketError();
+                if (!transferError) {
+                    transferError = sendError;
+                }
+                sendError.clear();
+
+                if (transferError) {
+                    transferErrors.fetch_add(1, std::memory_order_relaxed);
+                    InterfaceLogger::logMessage("CAN Connector: The transfer of the ISO-TP operation <" + operation +
+                                                "> failed: " + transferError.message(), LOG_LEVEL::ERROR);
+                } else {
+                    std::chrono::nanoseconds duration = std::chrono::steady_clock::now() - transferStart;
+                    transferTime.record(duration);
+                    transferTotal += duration;
+                    sentPayloads.fetch_add(1, std::memory_order_relaxed);
+                    sentBytes.fetch_add(pending.front().size(), std::memory_order_relaxed);
+                }
+
+                pending.pop_front();
+                isSending = false;
+                sendNext();
+            }));
+        }));
+    }
+
+    void CANIsoTpTransport::receivePayloads() {
+
+        socket.async_receive(boost::asio::buffer(rxBuffer),
+                             boost::asio::bind_executor(strand, [this](boost::system::error_code errorCode,
+                                                                       std::size_t length) {
+
+            if (errorCode == boost::asio::error::operation_aborted) {
+                return;
+            }
+
+            // The kernel reports the errors of both directions, e.g. a timeout of the flow control, on the socket
+            if (errorCode && isSending) {
+                // The error may belong to the running transfer, the send handler counts it
+                sendError = errorCode;
+            } else if (errorCode) {
+                transferErrors.fetch_add(1, std::memory_order_relaxed);
+                InterfaceLogger::logMessage("CAN Connector: ISO-TP error of the operation <" + operation + ">: " +
+                                            errorCode.message(), LOG_LEVEL::WARNING);
+            } else {
+                receivedPayloads.fetch_add(1, std::memory_order_relaxed);
+                receivedBytes.fetch_add(length, std::memory_order_relaxed);
+                payloadHandler(std::string(rxBuffer.data(), length));
+            }
+
+            // Create the next receive operation
+            receivePayloads();
+        }));
+    }
+
+    boost::system::error_code CANIsoTpTransport::takeSocketError() {
+
+        int error = 0;
+        socklen_t length = sizeof(error);
+        if (getsockopt(socket.native_handle(), SOL_SOCKET, SO_ERROR, &error, &length) < 0) {
+            error = errno;
+        }
+        return {error, boost::system::system_category()};
+    }
+
+    std::string CANIsoTpTransport::getStatistics() const {
+
+        std::stringstream statistics;
+        statistics << "CAN Connector: ISO-TP operation <" << operation << "> on <" << interfaceName << "> sent "
+                   << sentPayloads.load() << " payloads with " << sentBytes.load() << " bytes, received "
+                   << receivedPayloads.load() << " payloads with " << receivedBytes.load() << " bytes, "
+                   << droppedPayloads.load() << " dropped, " << transferErrors.load() << " errors\n";
+
+        if (transferTime.count() > 0) {
+            double seconds = std::chrono::duration<double>(transferTotal).count();
+            statistics << "  throughput " << (seconds > 0 ? sentBytes.load() / seconds / 1024 : 0) << " KiB/s\n"
+                       << "  transfer time " << transferTime.summary() << "\n"
+                       << transferTime.toString();
+        }
+
+        return statistics.str();
+    }
+
+}
@@ -0,0 +1,167 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_CANISOTP_H
+#define SIM_TO_DUT_INTERFACE_CANISOTP_H
+
+// Project includes
+#include "../../Utility/TimingHistogram.h"
+
+// System includes
+#include <deque>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <functional>
+#include <linux/can.h>
+#include <boost/asio.hpp>
+
+/**
+ * Maximum payload of an ISO-TP transfer, the default max_pdu_size of the kernel. Payloads above 4095 bytes use
+ * the 32 bit first frame length of ISO 15765-2:2016, which older kernels do not support.
+ */
+#define ISOTP_MAX_PAYLOAD 8300
+
+/**
+ * Maximum number of payloads of an ISO-TP operation that wait for the running transfer. Further payloads are dropped.
+ */
+#define ISOTP_MAX_PENDING 16
+
+namespace sim_interface::dut_connector::can {
+
+    /**
+     * <summary>
+     * An ISO-TP (ISO 15765-2) operation that transfers payloads of more than one frame, e.g. diagnostic requests.
+     * </summary>
+     */
+    struct CANIsoTpOperation {
+        std::string operation;     /**< The operation of the simulation events in both directions.                 */
+        std::string interfaceName; /**< The interface of the transfers, empty for the connector's.                 */
+        canid_t txID = 0;          /**< The CAN ID of the sent frames, with CAN_EFF_FLAG for 29 bit IDs.           */
+        canid_t rxID = 0;          /**< The CAN ID of the received frames, with CAN_EFF_FLAG for 29 bit IDs.       */
+        int stMin = 0;             /**< The STmin of the sent flow control frames (0x00-0x7F ms, 0xF1-0xF9 µs).   */
+        int blockSize = 0;         /**< The block size of the sent flow control frames, 0 for no flow control.    */
+        int frameTxTime = -1;      /**< Microseconds between sent frames if the receiver sets no STmin, -1 for the
+                                        kernel default (50 µs).                                                    */
+        bool isCANFD = false;      /**< Flag for transfers with CANFD frames.                                      */
+        int padding = -1;          /**< The padding byte of the sent frames, -1 for no padding.                    */
+    };
+
+    /**
+     * <summary>
+     * Transfers the payloads of an ISO-TP operation over a CAN_ISOTP socket.
+     * </summary>
+     * The kernel segments the sent payloads, reassembles the received ones and handles the flow control, so a
+     * payload is a single datagram on the socket. Each transfer has to finish before the next one can start:
+     * the socket reports writable again when the kernel is idle, which ends the transfer and starts the next
+     * pending payload.
+     *
+     * The transfer time and the throughput of the sent payloads are recorded. Errors of the kernel, like a missing
+     * flow control frame (ECOMM) or a wrong sequence number (EILSEQ), are reported on the receive operation.
+     *
+     * Note: send is called by the thread that handles the simulation events, all other handlers run on one strand
+     * of the io context.
+     */
+    class CANIsoTpTransport {
+
+    public:
+
+        /**
+         * Handler of a received payload.
+         */
+        using PayloadHandler = std::function<void(std::string payload)>;
+
+        /**
+         * Constructor. Creates the socket and starts receiving the payloads.
+         *
+         * @param ioContext      - The io context of the transfers.
+         * @param interfaceIndex - The index of the interface.
+         * @param interfaceName  - The name of the interface.
+         * @param operation      - The ISO-TP operation.
+         * @param payloadHandler - Called with every received payload.
+         */
+        CANIsoTpTransport(boost::asio::io_context &ioContext, int interfaceIndex, std::string interfaceName,
+                          const CANIsoTpOperation &operation, PayloadHandler payloadHandler);
+
+        CANIsoTpTransport(const CANIsoTpTransport &) = delete;
+
+        CANIsoTpTransport &operator=(const CANIsoTpTransport &) = delete;
+
+        /**
+         * Queues a payload for the transfer.
+         *
+         * @param payload - The payload.
+         * @return False if the payload is too long, otherwise true.
+         */
+        bool send(std::string payload);
+
+        /**
+         * @return The sent and received payloads, the errors and the transfer time and throughput of the sent
+         *         payloads.
+         */
+        std::string getStatistics() const;
+
+    private:
+
+        /**
+         * Receives the next payload. After handling it the next receive operation is created (function calls itself).
+         */
+        void receivePayloads();
+
+        /**
+         * Starts the transfer of the next pending payload if no transfer is running. Runs on the strand.
+         */
+        void sendNext();
+
+        /**
+         * Reads and clears the pending error of the socket (SO_ERROR), e.g. ECOMM if the kernel aborted a transfer.
+         *
+         * @return The pending error, empty if there is none.
+         */
+        boost::system::error_code takeSocketError();
+
+        std::string operation;                                              /**< The name of the operation.       */
+        std::string interfaceName;                                          /**< The name of the interface.       */
+        PayloadHandler payloadHandler;                                      /**< Handler of received payloads.    */
+        boost::asio::strand<boost::asio::io_context::executor_type> strand; /**< Serializes the handlers.         */
+        boost::asio::generic::datagram_protocol::socket socket;             /**< The CAN_ISOTP socket.            */
+        std::deque<std::string> pending;                                    /**< Payloads that wait for transfer. */
+        bool isSending = false;                                             /**< Flag if a transfer is running.   */
+        boost::system::error_code sendError;                                /**< Error received during a transfer.*/
+        std::chrono::steady_clock::time_point transferStart;                /**< Start of the running transfer.   */
+        std::vector<char> rxBuffer;                                         /**< Receive buffer of a payload.     */
+        std::atomic<uint64_t> sentPayloads{0};                              /**< Number of sent payloads.         */
+        std::atomic<uint64_t> sentBytes{0};                                 /**< Number of sent payload bytes.    */
+        std::atomic<uint64_t> receivedPayloads{0};                          /**< Number of received payloads.     */
+        std::atomic<uint64_t> receivedBytes{0};                             /**< Number of received payload bytes.*/
+        std::atomic<uint64_t> droppedPayloads{0};                           /**< Payloads dropped by the queue.   */
+        std::atomic<uint64_t> transferErrors{0};                            /**< Errors reported by the kernel.   */
+        std::chrono::nanoseconds transferTotal{0};                          /**< Summed time of all transfers.    */
+        TimingHistogram transferTime;                                       /**< Time of the sent transfers.      */
+    };
+
+}
+
+#endif //SIM_TO_DUT_INTERFACE_CANISOTP_H
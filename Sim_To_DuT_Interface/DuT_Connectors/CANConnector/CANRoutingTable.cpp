@@ -0,0 +1,96 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+// Project includes
+#include "CANRoutingTable.h"
+
+// System includes
+#include <string>
+#include <stdexcept>
+
+/**
+ * Initial number of slots of the hash table for the extended identifiers.
+ */
+#define CAN_ROUTING_INITIAL_SLOTS 16
+
+namespace sim_interface::dut_connector::can {
+
+    CANRoutingTable::CANRoutingTable() : extendedSlots(CAN_ROUTING_INITIAL_SLOTS),
+                                         hashShift(32 - __builtin_ctz(CAN_ROUTING_INITIAL_SLOTS)) {}
+
+    void CANRoutingTable::add(canid_t canID, const CANRoute &route) {
+
+        if (route.codec == CAN_ROUTE_NONE) {
+            throw std::invalid_argument("CAN Routing Table: Empty route for the CAN ID <" + std::to_string(canID) + ">");
+        }
+
+        if (find(canID) != nullptr) {
+            throw std::invalid_argument(
+                    "CAN Routing Table: The CAN ID <" + std::to_string(canID) + "> already has a route");
+        }
+
+        if (canID < CAN_ROUTING_STANDARD_IDS) {
+            standardRoutes[canID] = route;
+            standardCount++;
+            return;
+        }
+
+        // Keep the hash table at most half full, so the probe sequences stay short
+        if (2 * (extendedCount + 1) > extendedSlots.size()) {
+            grow();
+        }
+
+        insertExtended(canID, route);
+        extendedCount++;
+    }
+
+    size_t CANRoutingTable::size() const {
+        return standardCount + extendedCount;
+    }
+
+    void CANRoutingTable::grow() {
+
+        std::vector<ExtendedSlot> oldSlots(2 * extendedSlots.size());
+        oldSlots.swap(extendedSlots);
+        hashShift--;
+
+        for (const auto &slot: oldSlots) {
+            if (slot.canID != EMPTY_SLOT) {
+                insertExtended(slot.canID, slot.route);
+            }
+        }
+    }
+
+    void CANRoutingTable::insertExtended(canid_t canID, const CANRoute &route) {
+
+        size_t slot = hash(canID);
+        while (extendedSlots[slot].canID != EMPTY_SLOT) {
+            slot = (slot + 1) & (extendedSlots.size() - 1);
+        }
+
+        extendedSlots[slot].canID = canID;
+        extendedSlots[slot].route = route;
+    }
+
+}
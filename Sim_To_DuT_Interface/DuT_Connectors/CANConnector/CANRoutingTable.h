@@ -0,0 +1,158 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_CANROUTINGTABLE_H
+#define SIM_TO_DUT_INTERFACE_CANROUTINGTABLE_H
+
+// System includes
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <linux/can.h>
+
+namespace sim_interface::dut_connector::can {
+
+    /**
+     * Number of directly indexed CAN IDs, all 11 bit identifiers.
+     */
+    constexpr size_t CAN_ROUTING_STANDARD_IDS = CAN_SFF_MASK + 1;
+
+    /**
+     * Codec index of an empty route.
+     */
+    constexpr uint16_t CAN_ROUTE_NONE = UINT16_MAX;
+
+    /**
+     * <summary>
+     * Handler of a received CAN ID.
+     * </summary>
+     */
+    struct CANRoute {
+        uint16_t codec = CAN_ROUTE_NONE;   /**< Index of the codec of the connector that decodes the frames.     */
+        int32_t contentFilter = -1;        /**< Index of the content filter of the CAN_RAW backend, -1 for none. */
+        int32_t e2eCheck = -1;             /**< Index of the E2E check of the receive operation, -1 for none.    */
+        bool isContainer = false;          /**< Flag for container frames, their PDUs are routed by header ID.   */
+        int32_t liveness = -1;             /**< Index of the timeout monitoring of the receive operation, or -1. */
+    };
+
+    /**
+     * <summary>
+     * Maps the received CAN IDs to their handlers in constant time.
+     * </summary>
+     * The table is built once when the connector is created. Standard (11 bit) identifiers index an array with
+     * CAN_ROUTING_STANDARD_IDS entries directly. All other identifiers (29 bit identifiers carry the CAN_EFF_FLAG)
+     * are stored in an open addressing hash table with linear probing that is kept at most half full.
+     */
+    class CANRoutingTable {
+
+    public:
+
+        CANRoutingTable();
+
+        /**
+         * Adds the route of a CAN ID.
+         *
+         * @param canID - The CAN ID as it is found in the received frames.
+         * @param route - The handler of the CAN ID.
+         *
+         * @throws std::invalid_argument if the CAN ID already has a route or the route is empty.
+         */
+        void add(canid_t canID, const CANRoute &route);
+
+        /**
+         * Gets the route of a CAN ID.
+         *
+         * @param canID - The CAN ID of the received frame.
+         *
+         * @return The route or nullptr if the CAN ID has no route.
+         */
+        const CANRoute *find(canid_t canID) const {
+
+            if (canID < CAN_ROUTING_STANDARD_IDS) {
+                const CANRoute &route = standardRoutes[canID];
+                return route.codec == CAN_ROUTE_NONE ? nullptr : &route;
+            }
+
+            // Probe until the CAN ID or an empty slot is found, the table always has empty slots
+            for (size_t slot = hash(canID);; slot = (slot + 1) & (extendedSlots.size() - 1)) {
+                const ExtendedSlot &entry = extendedSlots[slot];
+                if (entry.canID == canID) {
+                    return &entry.route;
+                }
+                if (entry.canID == EMPTY_SLOT) {
+                    return nullptr;
+                }
+            }
+        }
+
+        /**
+         * @return The number of routed CAN IDs.
+         */
+        size_t size() const;
+
+    private:
+
+        /**
+         * Marks an empty slot of the hash table. Identifiers below CAN_ROUTING_STANDARD_IDS are never stored there.
+         */
+        static constexpr canid_t EMPTY_SLOT = 0;
+
+        /**
+         * <summary>
+         * Slot of the hash table for the extended identifiers.
+         * </summary>
+         */
+        struct ExtendedSlot {
+            canid_t canID = EMPTY_SLOT;    /**< The CAN ID or EMPTY_SLOT. */
+            CANRoute route;                /**< The handler of the CAN ID. */
+        };
+
+        /**
+         * Fibonacci hashing, the upper bits of the product select the slot.
+         */
+        size_t hash(canid_t canID) const {
+            return static_cast<uint32_t>(canID * 0x9E3779B1u) >> hashShift;
+        }
+
+        /**
+         * Doubles the hash table and inserts all routes again.
+         */
+        void grow();
+
+        /**
+         * Inserts a route into the hash table, which must have a free slot.
+         */
+        void insertExtended(canid_t canID, const CANRoute &route);
+
+        std::array<CANRoute, CAN_ROUTING_STANDARD_IDS> standardRoutes{};  /**< Routes of the 11 bit identifiers.      */
+        std::vector<ExtendedSlot> extendedSlots;                          /**< Hash table, the size is a power of two. */
+        uint32_t hashShift;                                               /**< 32 - log2 of the hash table size.       */
+        size_t extendedCount = 0;                                         /**< Number of used hash table slots.        */
+        size_t standardCount = 0;                                         /**< Number of routed 11 bit identifiers.     */
+    };
+
+}
+
+#endif //SIM_TO_DUT_INTERFACE_CANROUTINGTABLE_H
@@ -0,0 +1,267 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+// Project includes
+#include "CANTxMonitor.h"
+#include "../../Interface_Logger/InterfaceLogger.h"
+
+// System includes
+#include <ctime>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <linux/can/raw.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+
+namespace sim_interface::dut_connector::can {
+
+    CANTxMonitor::CANTxMonitor(boost::asio::io_context &ioContext, int interfaceIndex, std::string interfaceName,
+                               const std::vector<const CANConnectorSendOperation *> &sendOperations,
+                               const std::vector<std::string> &sendOperationNames)
+            : interfaceName(std::move(interfaceName)),
+              socket(ioContext, boost::asio::generic::raw_protocol(PF_CAN, CAN_RAW)) {
+
+        // Monitor the CAN IDs that are on the bus, the PDUs of a container are sent with the container
+        for (size_t index = 0; index < sendOperations.size(); index++) {
+            const CANConnectorSendOperation &sendOperation = *sendOperations[index];
+            if (!sendOperation.container.empty() || monitoredIDs.count(sendOperation.canID) > 0) {
+                continue;
+            }
+
+            auto monitoredID = std::make_unique<MonitoredID>();
+            monitoredID->name = sendOperationNames[index];
+            if (sendOperation.isCyclic) {
+                bool hasSecondInterval = sendOperation.ival2.tv_sec != 0 || sendOperation.ival2.tv_usec != 0;
+                const struct bcm_timeval &interval = hasSecondInterval ? sendOperation.ival2 : sendOperation.ival1;
+                monitoredID->interval = std::chrono::seconds(interval.tv_sec) +
+                                        std::chrono::microseconds(interval.tv_usec);
+            }
+            monitoredIDs[sendOperation.canID] = std::move(monitoredID);
+        }
+
+        int enable = 1;
+        if (setsockopt(socket.native_handle(), SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &enable, sizeof(enable)) < 0) {
+            InterfaceLogger::logMessage("CAN Connector: Could not enable CANFD frames on the TX monitor socket: " +
+                                        std::string(std::strerror(errno)), LOG_LEVEL::WARNING);
+        }
+
+        // Only receive the CAN IDs of the send operations
+        std::vector<struct can_filter> filters;
+        for (auto const&[canID, monitoredID]: monitoredIDs) {
+            struct can_filter filter = {0};
+            filter.can_id = canID;
+            filter.can_mask = (canID & CAN_EFF_FLAG) ? (CAN_EFF_FLAG | CAN_RTR_FLAG | CAN_EFF_MASK)
+                                                     : (CAN_EFF_FLAG | CAN_RTR_FLAG | CAN_SFF_MASK);
+            filters.push_back(filter);
+        }
+
+        if (setsockopt(socket.native_handle(), SOL_CAN_RAW, CAN_RAW_FILTER, filters.data(),
+                       filters.size() * sizeof(struct can_filter)) < 0) {
+            InterfaceLogger::logMessage("CAN Connector: Could not set the TX monitor filters: " +
+                                        std::string(std::strerror(errno)), LOG_LEVEL::ERROR);
+            throw std::runtime_error("CAN Connector: Could not set the TX monitor filters");
+        }
+
+        // Software receive timestamps are always available, hardware timestamps only with a capable driver
+        int timestamping = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE |
+                           SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+        if (setsockopt(socket.native_handle(), SOL_SOCKET, SO_TIMESTAMPING, &timestamping, sizeof(timestamping)) < 0) {
+            InterfaceLogger::logMessage("CAN Connector: Could not enable the timestamps of the TX monitor: " +
+                                        std::string(std::strerror(errno)), LOG_LEVEL::ERROR);
+            throw std::runtime_error("CAN Connector: Could not enable the timestamps of the TX monitor");
+        }
+
+        // Bind the socket to the interface
+        sockaddr_can addr = {0};
+        addr.can_family = AF_CAN;
+        addr.can_ifindex = interfaceIndex;
+
+        boost::system::error_code errorCode;
+        socket.bind(boost::asio::generic::raw_protocol::endpoint{&addr, sizeof(addr)}, errorCode);
+        if (errorCode) {
+            InterfaceLogger::logMessage("CAN Connector: Could not bind the TX monitor to <" + this->interfaceName +
+                                        ">: " + errorCode.message(), LOG_LEVEL::ERROR);
+            throw std::runtime_error("CAN Connector: Could not bind the TX monitor to the interface");
+        }
+
+        receiveEchoes();
+
+        InterfaceLogger::logMessage("CAN Connector: Created the TX monitor of <" + this->interfaceName + "> for " +
+                                    std::to_string(monitoredIDs.size()) + " CAN IDs", LOG_LEVEL::INFO);
+    }
+
+    void CANTxMonitor::recordSend(canid_t canID, int nframes) {
+
+        auto monitoredID = monitoredIDs.find(canID);
+        if (monitoredID == monitoredIDs.end()) {
+            return;
+        }
+
+        std::chrono::nanoseconds sendTime = now();
+        std::lock_guard<std::mutex> lock(pendingMutex);
+
+        std::deque<std::chrono::nanoseconds> &pending = monitoredID->second->pending;
+        for (int index = 0; index < nframes; index++) {
+            if (pending.size() == TX_MONITOR_MAX_PENDING) {
+                pending.pop_front();
+                monitoredID->second->unconfirmedFrames.fetch_add(1, std::memory_order_relaxed);
+            }
+            pending.push_back(sendTime);
+        }
+    }
+
+    void CANTxMonitor::receiveEchoes() {
+
+        socket.async_wait(boost::asio::socket_base::wait_read, [this](boost::system::error_code errorCode) {
+
+            if (errorCode == boost::asio::error::operation_aborted) {
+                return;
+            }
+
+            if (!errorCode) {
+                readEchoes();
+            } else {
+                InterfaceLogger::logMessage("CAN Connector: An error occurred on the TX monitor wait operation: " +
+                                            errorCode.message(), LOG_LEVEL::ERROR);
+            }
+
+            // Create the next wait operation
+            receiveEchoes();
+        });
+    }
+
+    void CANTxMonitor::readEchoes() {
+
+        while (true) {
+
+            struct iovec iov = {&rxFrame, sizeof(rxFrame)};
+            struct msghdr message = {};
+            message.msg_iov = &iov;
+            message.msg_iovlen = 1;
+            message.msg_control = rxControl;
+            message.msg_controllen = sizeof(rxControl);
+
+            ssize_t received = recvmsg(socket.native_handle(), &message, MSG_DONTWAIT);
+            if (received < 0) {
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    InterfaceLogger::logMessage("CAN Connector: An error occurred on the TX monitor receive: " +
+                                                std::string(std::strerror(errno)), LOG_LEVEL::ERROR);
+                }
+                return;
+            }
+
+            // Frames of other nodes with the same CAN ID are not echoes of our sends
+            if (!(message.msg_flags & MSG_DONTROUTE)) {
+                continue;
+            }
+
+            const struct scm_timestamping *timestamps = nullptr;
+            for (struct cmsghdr *control = CMSG_FIRSTHDR(&message); control != nullptr;
+                 control = CMSG_NXTHDR(&message, control)) {
+                if (control->cmsg_level == SOL_SOCKET && control->cmsg_type == SCM_TIMESTAMPING) {
+                    timestamps = reinterpret_cast<const struct scm_timestamping *>(CMSG_DATA(control));
+                }
+            }
+
+            if (timestamps == nullptr) {
+                timestampErrors.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            // ts[0] is the software timestamp, ts[2] the raw hardware timestamp
+            auto softwareTime = std::chrono::seconds(timestamps->ts[0].tv_sec) +
+                                std::chrono::nanoseconds(timestamps->ts[0].tv_nsec);
+            auto hardwareTime = std::chrono::seconds(timestamps->ts[2].tv_sec) +
+                                std::chrono::nanoseconds(timestamps->ts[2].tv_nsec);
+
+            handleEcho(rxFrame.can_id, softwareTime, hardwareTime.count() != 0 ? hardwareTime : softwareTime);
+        }
+    }
+
+    void CANTxMonitor::handleEcho(canid_t canID, std::chrono::nanoseconds softwareTime,
+                                  std::chrono::nanoseconds busTime) {
+
+        auto found = monitoredIDs.find(canID);
+        if (found == monitoredIDs.end()) {
+            return;
+        }
+
+        MonitoredID &monitoredID = *found->second;
+        monitoredID.confirmedFrames.fetch_add(1, std::memory_order_relaxed);
+
+        // The echo of a non cyclic send confirms the oldest send of the CAN ID
+        {
+            std::lock_guard<std::mutex> lock(pendingMutex);
+            if (!monitoredID.pending.empty()) {
+                monitoredID.latency.record(softwareTime - monitoredID.pending.front());
+                monitoredID.pending.pop_front();
+            }
+        }
+
+        // Cyclic frames are compared with the interval of the send operation
+        if (monitoredID.interval.count() > 0 && monitoredID.lastEcho.count() > 0) {
+            std::chrono::nanoseconds error = busTime - monitoredID.lastEcho - monitoredID.interval;
+            monitoredID.intervalError.record(error.count() < 0 ? -error : error);
+        }
+        monitoredID.lastEcho = busTime;
+    }
+
+    std::chrono::nanoseconds CANTxMonitor::now() {
+        struct timespec time = {0, 0};
+        clock_gettime(CLOCK_REALTIME, &time);
+        return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+    }
+
+    std::string CANTxMonitor::getStatistics() const {
+
+        std::stringstream statistics;
+        for (auto const&[canID, monitoredID]: monitoredIDs) {
+
+            statistics << "CAN Connector: TX monitor <" << interfaceName << "> send operation <" << monitoredID->name
+                       << "> confirmed " << monitoredID->confirmedFrames.load() << " frames, "
+                       << monitoredID->unconfirmedFrames.load() << " unconfirmed\n";
+
+            if (monitoredID->latency.count() > 0) {
+                statistics << "  latency " << monitoredID->latency.summary() << "\n"
+                           << monitoredID->latency.toString();
+            }
+
+            if (monitoredID->intervalError.count() > 0) {
+                statistics << "  interval error " << monitoredID->intervalError.summary() << "\n"
+                           << monitoredID->intervalError.toString();
+            }
+        }
+
+        if (timestampErrors.load() > 0) {
+            statistics << "CAN Connector: TX monitor <" << interfaceName << "> received " << timestampErrors.load()
+                       << " echoes without a timestamp\n";
+        }
+
+        return statistics.str();
+    }
+
+}
@@ -0,0 +1,162 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_CANTXMONITOR_H
+#define SIM_TO_DUT_INTERFACE_CANTXMONITOR_H
+
+// Project includes
+#include "CANConnectorSendOperation.h"
+#include "../../Utility/TimingHistogram.h"
+
+// System includes
+#include <map>
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <linux/can.h>
+#include <boost/asio.hpp>
+
+/**
+ * Maximum number of sends of a CAN ID that wait for their echo. Older sends count as unconfirmed.
+ */
+#define TX_MONITOR_MAX_PENDING 64
+
+/**
+ * Size of the control buffer for the timestamps of a received frame.
+ */
+#define TX_MONITOR_CONTROL_SIZE 256
+
+namespace sim_interface::dut_connector::can {
+
+    /**
+     * <summary>
+     * Confirms the transmissions of the send operations of an interface and timestamps them on the bus.
+     * </summary>
+     * A CAN_RAW socket with SO_TIMESTAMPING receives the local echo of every frame that the sockets of the connector
+     * send with the CAN IDs of the send operations. Drivers with IFF_ECHO echo a frame when it was transmitted,
+     * so the timestamp is the time the frame was on the bus; virtual interfaces echo it immediately. Echoes are
+     * told apart from frames of other nodes by MSG_DONTROUTE, which CAN_RAW sets for locally sent frames.
+     *
+     * Non cyclic sends are matched in order to their echo and their send-to-wire latency is recorded. The echoes
+     * of cyclic send operations, which are sent by the BCM or the cyclic scheduler, record the deviation of their
+     * distance from the interval of the send operation. A hardware timestamp is used for the interval if the
+     * driver provides one.
+     *
+     * Note: recordSend is called by the thread that handles the simulation events and by the io context,
+     * the echoes are received by the io context.
+     */
+    class CANTxMonitor {
+
+    public:
+
+        /**
+         * Constructor. Creates the socket and starts receiving the echoes.
+         *
+         * @param ioContext          - The io context that receives the echoes.
+         * @param interfaceIndex     - The index of the interface.
+         * @param interfaceName      - The name of the interface.
+         * @param sendOperations     - The send operations of the interface.
+         * @param sendOperationNames - The names of the send operations of the interface.
+         */
+        CANTxMonitor(boost::asio::io_context &ioContext, int interfaceIndex, std::string interfaceName,
+                     const std::vector<const CANConnectorSendOperation *> &sendOperations,
+                     const std::vector<std::string> &sendOperationNames);
+
+        CANTxMonitor(const CANTxMonitor &) = delete;
+
+        CANTxMonitor &operator=(const CANTxMonitor &) = delete;
+
+        /**
+         * Remembers the time a non cyclic send was handed to the socket, until its echo is received.
+         *
+         * @param canID   - The CAN ID of the frames.
+         * @param nframes - The number of frames.
+         */
+        void recordSend(canid_t canID, int nframes = 1);
+
+        /**
+         * @return Per send operation the confirmed and unconfirmed frames, the latency and the interval error
+         *         with their histograms.
+         */
+        std::string getStatistics() const;
+
+    private:
+
+        /**
+         * <summary>
+         * The echoes of a CAN ID.
+         * </summary>
+         */
+        struct MonitoredID {
+            std::string name;                                 /**< The name of the send operation.              */
+            std::chrono::nanoseconds interval{0};             /**< The interval of a cyclic send operation.     */
+            std::deque<std::chrono::nanoseconds> pending;     /**< Send times that wait for their echo.         */
+            std::chrono::nanoseconds lastEcho{0};             /**< Bus time of the last echo.                   */
+            std::atomic<uint64_t> confirmedFrames{0};         /**< Number of received echoes.                   */
+            std::atomic<uint64_t> unconfirmedFrames{0};       /**< Number of sends without an echo.             */
+            TimingHistogram latency;                          /**< Send-to-wire latency of non cyclic sends.    */
+            TimingHistogram intervalError;                    /**< Deviation of the echo distance from interval.*/
+        };
+
+        /**
+         * Waits until the socket is readable and reads the echoes. After processing the echoes the next
+         * wait operation is created (function calls itself).
+         */
+        void receiveEchoes();
+
+        /**
+         * Reads all echoes that are available on the socket.
+         */
+        void readEchoes();
+
+        /**
+         * Matches an echo to its send.
+         *
+         * @param canID        - The CAN ID of the frame.
+         * @param softwareTime - The software receive timestamp (CLOCK_REALTIME).
+         * @param busTime      - The hardware timestamp if available, otherwise the software timestamp.
+         */
+        void handleEcho(canid_t canID, std::chrono::nanoseconds softwareTime, std::chrono::nanoseconds busTime);
+
+        /**
+         * @return The current time of the clock of the software timestamps.
+         */
+        static std::chrono::nanoseconds now();
+
+        std::string interfaceName;                                       /**< The name of the interface.        */
+        boost::asio::generic::raw_protocol::socket socket;               /**< The CAN_RAW socket of the echoes. */
+        std::map<canid_t, std::unique_ptr<MonitoredID>> monitoredIDs;    /**< The monitored CAN IDs.            */
+        std::mutex pendingMutex;                                         /**< Protects the pending sends.       */
+        std::atomic<uint64_t> timestampErrors{0};                        /**< Echoes without a timestamp.       */
+        struct canfd_frame rxFrame = {0};                                /**< Receive buffer of an echo.        */
+        alignas(struct cmsghdr) char rxControl[TX_MONITOR_CONTROL_SIZE]; /**< Control buffer of an echo.        */
+    };
+
+}
+
+#endif //SIM_TO_DUT_INTERFACE_CANTXMONITOR_H
@@ -0,0 +1,92 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+// Project includes
+#include "LegacyCodecAdapter.h"
+
+// System includes
+#include <cstring>
+
+namespace sim_interface::dut_connector::can {
+
+    LegacyCodecAdapter::LegacyCodecAdapter(CANConnectorCodec *codec) : codec(codec) {}
+
+    void LegacyCodecAdapter::bindSendOperations(const std::vector<std::string> &sendOperations) {
+        handles.clear();
+        for (size_t index = 0; index < sendOperations.size(); index++) {
+            handles[sendOperations[index]] = static_cast<int>(index);
+        }
+    }
+
+    EncodeResult LegacyCodecAdapter::encode(const SimEvent &event, struct canfd_frame frames[], __u32 maxFrames) {
+
+        EncodeResult result;
+        auto data = codec->convertSimEventToFrames(event);
+
+        // The legacy codec already reported the events it could not convert
+        if (data.second.empty() || data.first.empty()) {
+            return result;
+        }
+
+        // Look up the handle of the send operation
+        auto handle = handles.find(data.second);
+        if (handle == handles.end()) {
+            InterfaceLogger::logMessage("CAN Connector: Codec returned the unknown sendOperation <" + data.second + ">",
+                                        LOG_LEVEL::ERROR);
+            return result;
+        }
+
+        if (data.first.size() > maxFrames) {
+            InterfaceLogger::logMessage("CAN Connector: Codec returned more frame payloads than frames are available",
+                                        LOG_LEVEL::ERROR);
+            return result;
+        }
+
+        // Copy the payloads into the frames
+        for (size_t index = 0; index < data.first.size(); index++) {
+            const auto &payload = data.first[index];
+
+            if (payload.size() > CANFD_MAX_DLEN) {
+                InterfaceLogger::logMessage(
+                        "CAN Connector: Codec returned a frame payload that is bigger than the CANFD frame",
+                        LOG_LEVEL::ERROR);
+                return result;
+            }
+
+            frames[index].len = payload.size();
+            std::memcpy(frames[index].data, payload.data(), payload.size());
+        }
+
+        result.sendOperation = handle->second;
+        result.nframes = data.first.size();
+        return result;
+    }
+
+    void LegacyCodecAdapter::decode(const struct canfd_frame &frame, bool isCanfd, SimEventSink &sink) {
+        for (auto &event: codec->convertFrameToSimEvent(frame, isCanfd)) {
+            sink.push(std::move(event));
+        }
+    }
+
+}
@@ -0,0 +1,70 @@
+/**
+ * CAN Connector.
+ * The Connector enables the communication over a CAN/CANFD interface.
+ *
+ * Copyright (C) 2021 Matthias Bank
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface". If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_LEGACYCODECADAPTER_H
+#define SIM_TO_DUT_INTERFACE_LEGACYCODECADAPTER_H
+
+// Project includes
+#include "CANConnectorCodec.h"
+#include "CANConnectorCodecV2.h"
+
+// System includes
+#include <map>
+#include <memory>
+
+namespace sim_interface::dut_connector::can {
+
+    /**
+     * <summary>
+     * Runs a codec that implements the legacy CANConnectorCodec interface behind the CANConnectorCodecV2 interface.
+     * </summary>
+     * The legacy codec still allocates its payloads and events, the adapter only copies them into the
+     * frames and the sink and maps the send operation names to the handles.
+     */
+    class LegacyCodecAdapter : public CANConnectorCodecV2 {
+
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param codec - The legacy codec, the adapter takes the ownership.
+         */
+        explicit LegacyCodecAdapter(CANConnectorCodec *codec);
+
+        void bindSendOperations(const std::vector<std::string> &sendOperations) override;
+
+        EncodeResult encode(const SimEvent &event, struct canfd_frame frames[], __u32 maxFrames) override;
+
+        void decode(const struct canfd_frame &frame, bool isCanfd, SimEventSink &sink) override;
+
+    private:
+
+        std::unique_ptr<CANConnectorCodec> codec; /**< The legacy codec.                           */
+        std::map<std::string, int> handles;       /**< Handles of the send operations by the name. */
+    };
+
+}
+
+#endif //SIM_TO_DUT_INTERFACE_LEGACYCODECADAPTER_H
@@ -32,6 +32,28 @@
 #include <stdexcept>
 
 namespace sim_interface::dut_connector {
+    /**
+     * <summary>
+     * Limits how often events of a single operation are forwarded to the DuT
+     * </summary>
+     * All limits are optional and applied in this order: decimation, minimum interval, token bucket.
+     * An event is only forwarded if it passes all enabled limits.
+     */
+    class OperationRateLimit {
+    public:
+        /** Forward only every n-th event (1 = every event) */
+        unsigned int decimation = 1;
+
+        /** Minimum time between two forwarded events in milliseconds (0 = disabled) */
+        unsigned int minIntervalMs = 0;
+
+        /** Refill rate of the token bucket in events per second (0 = disabled) */
+        double tokenRate = 0;
+
+        /** Capacity of the token bucket, i.e. the maximum burst (0 = one second worth of tokens, at least 1) */
+        double tokenBurst = 0;
+    };
+
     /**
      * <summary>
      * Configuration for a single DuTConnector
@@ -67,6 +89,18 @@ namespace sim_interface::dut_connector {
 
         /** Enable periodic timer on Connector level */
         bool periodicTimerEnabled = false;
+
+        /**
+         * Fire missed periods of the periodic timer as fast as possible (true)
+         * or skip them and stay on the original schedule (false)
+         */
+        bool periodicCatchUp = false;
+
+        /**
+         * Map of operations to their rate limits, events exceeding the limit are not forwarded to the DuT.
+         * Periodic timers of an operation keep running with the latest event.
+         */
+        std::map<std::string, OperationRateLimit> rateLimits{};
     };
 }
 
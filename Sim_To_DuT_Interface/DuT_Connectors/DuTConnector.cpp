@@ -25,6 +25,7 @@
 
 #include "DuTConnector.h"
 #include "../Interface_Logger/InterfaceLogger.h"
+#include "../Utility/Executor.h"
 
 #include <utility>
 #include <boost/asio.hpp>
@@ -33,7 +34,16 @@ namespace sim_interface::dut_connector {
     DuTConnector::DuTConnector(std::shared_ptr<SharedQueue<SimEvent>> queueDuTEventToSim,
                                const sim_interface::dut_connector::ConnectorConfig &config)
             : queueDuTToSim(std::move(queueDuTEventToSim)), processableOperations(config.operations),
-              periodicTimerEnabled(config.periodicTimerEnabled) {
+              periodicTimerEnabled(config.periodicTimerEnabled),
+              periodicOverrunPolicy(config.periodicCatchUp ? OverrunPolicy::CATCH_UP : OverrunPolicy::SKIP) {
+        for (const auto &rateLimit: config.rateLimits) {
+            if (processableOperations.find(rateLimit.first) == processableOperations.end()) {
+                InterfaceLogger::logMessage("DuTConnector: Rate limit for unknown operation " + rateLimit.first,
+                                            LOG_LEVEL::WARNING);
+                continue;
+            }
+            rateLimiters.emplace(rateLimit.first, std::make_unique<RateLimiter>(rateLimit.second));
+        }
         if (periodicTimerEnabled) {
             io = std::make_shared<boost::asio::io_service>();
 
@@ -43,16 +53,28 @@ namespace sim_interface::dut_connector {
             // have one timer (doing nothing) running at any given time to avoid io->run() to return
             aliveTimer = std::make_unique<PeriodicTimer>(io, 1000000000, SimEvent(), [](const SimEvent &event) {});
             aliveTimer->start();
-            timerRunner = std::thread([&]() {
+            timerRunners = Executor::createThreadGroup(TIMER_ROLE, "timer", [this]() {
                 this->io->run();
             });
         }
     }
 
     DuTConnector::~DuTConnector() {
+        for (const auto &rateLimiter: rateLimiters) {
+            InterfaceLogger::logMessage(fmt::format("DuTConnector: Rate limit {}: {}", rateLimiter.first,
+                                                    rateLimiter.second->summary()), LOG_LEVEL::INFO);
+        }
+        if (!periodicTimerEnabled) {
+            return;
+        }
+        for (const auto &periodicTimer: periodicTimers) {
+            logTimerStatistics(periodicTimer.first, *periodicTimer.second);
+        }
         aliveTimer->stop();
         io->stop();
-        timerRunner.join();
+        for (auto &timerRunner: timerRunners) {
+            timerRunner.join();
+        }
     }
 
     ConnectorInfo DuTConnector::getConnectorInfo() {
@@ -67,14 +89,22 @@ namespace sim_interface::dut_connector {
         if (canHandleSimEvent(simEvent)) {
             InterfaceLogger::logMessage("DuTConnector: Handling event " + simEvent.operation, LOG_LEVEL::INFO);
             if (isPeriodicEnabled(simEvent)) {
-                InterfaceLogger::logMessage("DuTConnector: Enabling periodic timer for event " + simEvent.operation,
-                                            LOG_LEVEL::INFO);
                 setupTimer(simEvent);
             }
-            handleEventSingle(simEvent);
+            if (!isWithinRateLimit(simEvent)) {
+                InterfaceLogger::logMessage("DuTConnector: Rate limit suppressed event " + simEvent.operation,
+                                            LOG_LEVEL::DEBUG);
+                return;
+            }
+            handleEventSerialized(simEvent);
         }
     }
 
+    void DuTConnector::handleEventSerialized(const SimEvent &simEvent) {
+        std::lock_guard<std::mutex> lock(eventMutex);
+        handleEventSingle(simEvent);
+    }
+
     bool DuTConnector::canHandleSimEvent(const SimEvent &simEvent) {
         return processableOperations.find(simEvent.operation) != processableOperations.end();
     }
@@ -87,19 +117,45 @@ namespace sim_interface::dut_connector {
         return periodicTimerEnabled && periodicIntervals.find(simEvent.operation) != periodicIntervals.end();
     }
 
+    bool DuTConnector::isWithinRateLimit(const SimEvent &simEvent) {
+        auto rateLimiter = rateLimiters.find(simEvent.operation);
+        if (rateLimiter == rateLimiters.end()) {
+            return true;
+        }
+        return rateLimiter->second->allow(std::chrono::steady_clock::now());
+    }
+
     void DuTConnector::setupTimer(const SimEvent &simEvent) {
         if (periodicTimerEnabled) {
-            // stop timer if already running
-            if (periodicTimers.find(simEvent.operation) != periodicTimers.end()) {
-                periodicTimers.at(simEvent.operation)->stop();
-                periodicTimers.erase(simEvent.operation);
+            // timer already running, only swap in the new payload and keep the phase
+            auto periodicTimer = periodicTimers.find(simEvent.operation);
+            if (periodicTimer != periodicTimers.end()) {
+                periodicTimer->second->updateEvent(simEvent);
+                return;
             }
-            periodicTimers.emplace(simEvent.operation,
-                                   std::make_unique<PeriodicTimer>(io, periodicIntervals[simEvent.operation], simEvent,
-                                                                   [this](const SimEvent &event) {
-                                                                       this->handleEventSingle(event);
-                                                                   }));
-            periodicTimers[simEvent.operation]->start();
+            InterfaceLogger::logMessage("DuTConnector: Enabling periodic timer for event " + simEvent.operation,
+                                        LOG_LEVEL::INFO);
+            auto &timer = periodicTimers.emplace(simEvent.operation,
+                                                 std::make_unique<PeriodicTimer>(io, periodicIntervals[simEvent.operation],
+                                                                                 simEvent, [this](const SimEvent &event) {
+                                                                                     this->handleEventSerialized(event);
+                                                                                 }, periodicOverrunPolicy)).first->second;
+            // start the timer on the timer thread, the timer object is only touched there from now on
+            PeriodicTimer *timerPtr = timer.get();
+            boost::asio::post(*io, [timerPtr]() {
+                timerPtr->start();
+            });
+        }
+    }
+
+    void DuTConnector::logTimerStatistics(const std::string &operation, const PeriodicTimer &timer) {
+        InterfaceLogger::logMessage(fmt::format("DuTConnector: Periodic timer {} lateness: {}", operation,
+                                                timer.getLatenessHistogram().summary()), LOG_LEVEL::INFO);
+        InterfaceLogger::logMessage(fmt::format("DuTConnector: Periodic timer {} jitter: {}", operation,
+                                                timer.getJitterHistogram().summary()), LOG_LEVEL::INFO);
+        if (timer.getSkippedPeriods() > 0) {
+            InterfaceLogger::logMessage(fmt::format("DuTConnector: Periodic timer {} skipped {} periods", operation,
+                                                    timer.getSkippedPeriods()), LOG_LEVEL::WARNING);
         }
     }
 
@@ -30,11 +30,15 @@
 #include <iostream>
 #include <set>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <boost/asio.hpp>
 #include "../DuT_Connectors/ConnectorInfo.h"
 #include "../Events/SimEvent.h"
 #include "../Utility/SharedQueue.h"
 #include "../Utility/PeriodicTimer.h"
+#include "../Utility/RateLimiter.h"
 #include "ConnectorConfig.h"
 
 namespace sim_interface::dut_connector {
@@ -83,7 +87,8 @@ namespace sim_interface::dut_connector {
     protected:
         /**
          * Handles an single event asynchronously from the simulation.
-         * Called whenever a new event for the device arrives.
+         * Called whenever a new event for the device arrives, from the event thread and from the periodic timers.
+         * The calls of one connector are serialized, so the connector does not need to lock its send state.
          * Please override this methode!
          * @param simEvent Event that should be processed by the device.
          */
@@ -96,12 +101,22 @@ namespace sim_interface::dut_connector {
 
         bool isPeriodicEnabled(const SimEvent &simEvent);
 
+        // check the rate limit of the operation and count the event as forwarded or suppressed
+        bool isWithinRateLimit(const SimEvent &simEvent);
+
+        // pass the event to handleEventSingle while holding the event mutex
+        void handleEventSerialized(const SimEvent &simEvent);
+
+        // create the timer for the operation on the first event, only update its event afterwards
         void setupTimer(const SimEvent &simEvent);
 
         void enablePeriodicSending(const std::string &operation, int periodMs);
 
+        // log the lateness and jitter statistics of a periodic timer
+        static void logTimerStatistics(const std::string &operation, const PeriodicTimer &timer);
+
         std::shared_ptr<boost::asio::io_service> io;
-        std::thread timerRunner;;
+        std::vector<std::thread> timerRunners;
 
         std::set<std::string> processableOperations;
 
@@ -110,7 +125,11 @@ namespace sim_interface::dut_connector {
         std::map<std::string, std::unique_ptr<sim_interface::PeriodicTimer>> periodicTimers;
         std::map<std::string, int> periodicIntervals;
         std::unique_ptr<PeriodicTimer> aliveTimer;
+        std::map<std::string, std::unique_ptr<RateLimiter>> rateLimiters;
+        // serializes handleEventSingle between the event thread and the timer threads
+        std::mutex eventMutex;
         bool periodicTimerEnabled;
+        OverrunPolicy periodicOverrunPolicy;
     };
 }
 
@@ -30,6 +30,7 @@
 #include "RESTDummyConnector.h"
 #include "ReceiveEndpoint.h"
 #include "../../Interface_Logger/InterfaceLogger.h"
+#include "../../Utility/Executor.h"
 
 namespace sim_interface::dut_connector::rest_dummy {
     RESTDummyConnector::RESTDummyConnector(std::shared_ptr<SharedQueue<SimEvent>> queueDuTToSim,
@@ -93,7 +94,7 @@ namespace sim_interface::dut_connector::rest_dummy {
         if (!receiveEndpoint) {
             receiveEndpoint = std::make_unique<ReceiveEndpoint>();
         }
-        receiveThread = std::thread([this]() {
+        receiveThread = Executor::createThread(REST_ROLE, "rest-receive", [this]() {
             receiveEndpoint->startService(this->port,
                                           [this](auto &&PH1) { sendEventToSim(std::forward<decltype(PH1)>(PH1)); });
         });
@@ -32,6 +32,7 @@
 #include <net/if.h>
 #include "EthernetPacket.h"
 #include "../../Interface_Logger/InterfaceLogger.h"
+#include "../../Utility/Executor.h"
 
 namespace sim_interface::dut_connector::v2x {
     V2XConnector::V2XConnector(std::shared_ptr<SharedQueue<SimEvent>> queueDuTToSim,
@@ -55,7 +56,7 @@ namespace sim_interface::dut_connector::v2x {
                                         LOG_LEVEL::ERROR);
         }
         startReceive();
-        sockRunner = std::thread([&]() {
+        sockRunners = Executor::createThreadGroup(V2X_ROLE, "v2x-" + config.ifname, [this]() {
             this->ioService.run();
         });
 
@@ -76,7 +77,9 @@ namespace sim_interface::dut_connector::v2x {
 
     V2XConnector::~V2XConnector() {
         ioService.stop();
-        sockRunner.join();
+        for (auto &sockRunner: sockRunners) {
+            sockRunner.join();
+        }
     }
 
     void V2XConnector::receiveCallback(const std::vector<unsigned char> &msg) {
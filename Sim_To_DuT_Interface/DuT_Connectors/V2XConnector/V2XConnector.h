@@ -123,9 +123,9 @@ namespace sim_interface::dut_connector::v2x {
         boost::asio::generic::raw_protocol::endpoint receiveEndpoint;
 
         /**
-         * Thread to run ioService in
+         * Threads to run ioService in
          */
-        std::thread sockRunner;
+        std::vector<std::thread> sockRunners;
 
         /**
          * two bytes to set the ethernet frame type with
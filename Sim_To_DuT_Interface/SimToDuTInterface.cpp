@@ -23,6 +23,7 @@
  */
 
 #include "SimToDuTInterface.h"
+#include "Utility/Executor.h"
 
 namespace sim_interface {
     SimToDuTInterface::SimToDuTInterface() {
@@ -50,8 +51,12 @@ namespace sim_interface {
     }
 
     void SimToDuTInterface::run() {
-        threadSimToInterface = std::thread(&SimToDuTInterface::handleEventsFromSim, this);
-        threadDuTToSim = std::thread(&SimToDuTInterface::handleEventsFromDuT, this);
+        threadSimToInterface = Executor::createThread(INTERFACE_ROLE, "sim-to-dut", [this]() {
+            handleEventsFromSim();
+        });
+        threadDuTToSim = Executor::createThread(INTERFACE_ROLE, "dut-to-sim", [this]() {
+            handleEventsFromDuT();
+        });
     }
 
     std::shared_ptr<SharedQueue<SimEvent>> SimToDuTInterface::getQueueDuTToSim() {
@@ -0,0 +1,97 @@
+/**
+ * Sim To DuT Interface
+ *
+ * Copyright (C) 2021 Lukas Wagenlehner
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface".  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#include "IngressChangeFilter.h"
+#include <cmath>
+#include <utility>
+
+namespace sim_interface {
+    IngressChangeFilter::IngressChangeFilter(IngressFilterConfig config) : config(std::move(config)) {}
+
+    bool IngressChangeFilter::isChanged(const std::string &operation,
+                                        const boost::variant<int, double, std::string> &value,
+                                        std::chrono::steady_clock::time_point now) {
+        if (!config.enabled) {
+            forwarded++;
+            return true;
+        }
+
+        auto cached = cache.find(operation);
+        if (cached == cache.end()) {
+            OperationChangeDetection detection;
+            auto configured = config.operations.find(operation);
+            if (configured != config.operations.end()) {
+                detection = configured->second;
+            }
+            if (detection.forcedRefreshMs < 0) {
+                detection.forcedRefreshMs = config.forcedRefreshMs;
+            }
+            cache.emplace(operation, CachedValue{value, now, detection});
+            forwarded++;
+            return true;
+        }
+
+        CachedValue &entry = cached->second;
+        bool refresh = entry.detection.forcedRefreshMs > 0 &&
+                       now - entry.lastForwarded >= std::chrono::milliseconds(entry.detection.forcedRefreshMs);
+        if (!refresh && !differs(entry, value)) {
+            suppressed++;
+            return false;
+        }
+
+        entry.value = value;
+        entry.lastForwarded = now;
+        forwarded++;
+        return true;
+    }
+
+    uint64_t IngressChangeFilter::getForwarded() const {
+        return forwarded;
+    }
+
+    uint64_t IngressChangeFilter::getSuppressed() const {
+        return suppressed;
+    }
+
+    bool IngressChangeFilter::differs(const CachedValue &cached,
+                                      const boost::variant<int, double, std::string> &value) {
+        if (cached.value.which() != value.which()) {
+            return true;
+        }
+        const auto *text = boost::get<std::string>(&value);
+        if (text != nullptr || cached.detection.mode == CHANGE_EXACT) {
+            return !(cached.value == value);
+        }
+
+        auto toDouble = [](const boost::variant<int, double, std::string> &v) {
+            const auto *i = boost::get<int>(&v);
+            return i != nullptr ? static_cast<double>(*i) : boost::get<double>(v);
+        };
+        double last = toDouble(cached.value);
+        double difference = std::fabs(toDouble(value) - last);
+        if (cached.detection.mode == CHANGE_DEADBAND_RELATIVE) {
+            return difference > cached.detection.deadband * std::fabs(last);
+        }
+        return difference > cached.detection.deadband;
+    }
+}
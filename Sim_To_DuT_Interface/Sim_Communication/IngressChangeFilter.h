@@ -0,0 +1,87 @@
+/**
+ * Sim To DuT Interface
+ *
+ * Copyright (C) 2021 Lukas Wagenlehner
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface".  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_INGRESSCHANGEFILTER_H
+#define SIM_TO_DUT_INTERFACE_INGRESSCHANGEFILTER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <boost/variant.hpp>
+#include "IngressFilterConfig.h"
+
+namespace sim_interface {
+    /**
+     * <summary>
+     * Last value cache for the values received from the simulation.
+     * </summary>
+     * Decides per operation if a received value changed compared to the last forwarded value.
+     * Not thread safe, used by the receive thread of the SimComHandler only.
+     */
+    class IngressChangeFilter {
+    public:
+        /**
+         * Create a filter.
+         * @param config Configuration of the filter.
+         */
+        explicit IngressChangeFilter(IngressFilterConfig config);
+
+        /**
+         * Check if the value should be forwarded and remember it as the last forwarded value if so.
+         * @param operation The operation of the value.
+         * @param value The received value.
+         * @param now Time the value was received.
+         * @return TRUE if the value changed (or the refresh interval elapsed) and should be forwarded.
+         */
+        bool isChanged(const std::string &operation, const boost::variant<int, double, std::string> &value,
+                       std::chrono::steady_clock::time_point now);
+
+        /**
+         * @return number of forwarded values
+         */
+        uint64_t getForwarded() const;
+
+        /**
+         * @return number of suppressed (unchanged) values
+         */
+        uint64_t getSuppressed() const;
+
+    private:
+        struct CachedValue {
+            boost::variant<int, double, std::string> value;
+            std::chrono::steady_clock::time_point lastForwarded;
+            OperationChangeDetection detection;
+        };
+
+        // compare the value with the cached value according to the change detection of the operation
+        static bool differs(const CachedValue &cached, const boost::variant<int, double, std::string> &value);
+
+        IngressFilterConfig config;
+        std::unordered_map<std::string, CachedValue> cache;
+        uint64_t forwarded = 0;
+        uint64_t suppressed = 0;
+    };
+}
+
+#endif //SIM_TO_DUT_INTERFACE_INGRESSCHANGEFILTER_H
@@ -0,0 +1,114 @@
+/**
+ * Sim To DuT Interface
+ *
+ * Copyright (C) 2021 Lukas Wagenlehner
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface".  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_INGRESSFILTERCONFIG_H
+#define SIM_TO_DUT_INTERFACE_INGRESSFILTERCONFIG_H
+
+#include <map>
+#include <string>
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/string.hpp>
+
+namespace sim_interface {
+
+    /**
+     * Defines when a received value counts as changed.
+     * EXACT: any difference, DEADBAND_ABSOLUTE: |new - last| > deadband,
+     * DEADBAND_RELATIVE: |new - last| > deadband * |last|.
+     * Strings are always compared exactly.
+     */
+    enum CHANGE_DETECTION {
+        CHANGE_EXACT, CHANGE_DEADBAND_ABSOLUTE, CHANGE_DEADBAND_RELATIVE
+    };
+
+    /**
+     * <summary>
+     * Change detection settings of a single operation.
+     * </summary>
+     */
+    class OperationChangeDetection {
+    public:
+        /**
+         * Creates the settings for an exact comparison.
+         */
+        OperationChangeDetection() = default;
+
+        /**
+         * How the value is compared with the last forwarded value.
+         */
+        CHANGE_DETECTION mode = CHANGE_EXACT;
+        /**
+         * Absolute deadband or relative deadband (e.g. 0.01 = 1%) depending on the mode.
+         */
+        double deadband = 0;
+        /**
+         * Forced refresh interval of this operation in milliseconds, -1 uses the default of the filter.
+         */
+        int forcedRefreshMs = -1;
+
+    private:
+        friend class boost::serialization::access;
+
+        template<class Archive>
+        void serialize(Archive &ar, const unsigned int version) {
+            ar & BOOST_SERIALIZATION_NVP(mode);
+            ar & BOOST_SERIALIZATION_NVP(deadband);
+            ar & BOOST_SERIALIZATION_NVP(forcedRefreshMs);
+        }
+    };
+
+    /**
+     * <summary>
+     * Configuration of the change detection for values received from the simulation.
+     * </summary>
+     * Operations without an entry in operations are compared exactly.
+     */
+    class IngressFilterConfig {
+    public:
+        /**
+         * Creates the configuration with the filter disabled.
+         */
+        IngressFilterConfig() = default;
+
+        /** Forward only changed values (true) or every received value (false) */
+        bool enabled = false;
+        /** Forward an unchanged value anyway if the last forwarded value is older (milliseconds, 0 = never) */
+        int forcedRefreshMs = 1000;
+        /** Change detection settings per operation */
+        std::map<std::string, OperationChangeDetection> operations;
+
+    private:
+        friend class boost::serialization::access;
+
+        template<class Archive>
+        void serialize(Archive &ar, const unsigned int version) {
+            ar & BOOST_SERIALIZATION_NVP(enabled);
+            ar & BOOST_SERIALIZATION_NVP(forcedRefreshMs);
+            ar & BOOST_SERIALIZATION_NVP(operations);
+        }
+    };
+}
+
+#endif //SIM_TO_DUT_INTERFACE_INGRESSFILTERCONFIG_H
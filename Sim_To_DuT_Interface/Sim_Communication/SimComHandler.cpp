@@ -30,6 +30,7 @@
 #include "../DuT_Connectors/RESTDummyConnector/RESTDummyConnector.h"
 #include "../DuT_Connectors/CANConnector/CANConnector.h"
 #include "../DuT_Connectors/V2XConnector/V2XConnector.h"
+#include "../Utility/Executor.h"
 
 
 #include <exception>
@@ -57,7 +58,8 @@ namespace sim_interface {
     SimComHandler::SimComHandler(SimToDuTInterface *interface, const SystemConfig &config)
             : interface(interface), socketSimPub_(context_sub, zmq::socket_type::pub),
               socketSimSub_(context_sub, zmq::socket_type::sub),
-              socketSimSubConfig_(context_sub, zmq::socket_type::sub) {
+              socketSimSubConfig_(context_sub, zmq::socket_type::sub),
+              ingressFilter(config.ingressFilterConfig) {
 
         // zmq Subscriber
         socketSimAddressSub = config.socketSimAddressSub;
@@ -295,7 +297,11 @@ namespace sim_interface {
             }
 
 
+            auto now = std::chrono::steady_clock::now();
             for (auto const &element: receiveMapSimData) {
+                if (!ingressFilter.isChanged(element.first, element.second, now)) {
+                    continue;
+                }
                 SimEvent event(element.first, element.second, "Simulation Traci");
                 sendEventToInterface(event);
             }
@@ -359,13 +365,18 @@ namespace sim_interface {
     }
 
     void SimComHandler::run() {
-        simComHandlerThread = std::thread(&sim_interface::SimComHandler::receive, this);
+        simComHandlerThread = Executor::createThread(SIM_COM_ROLE, "simcom-receive", [this]() {
+            receive();
+        });
 
     }
 
     SimComHandler::~SimComHandler() {
         stopThread = false;
         simComHandlerThread.join();
+        InterfaceLogger::logMessage(fmt::format("SimComHandler: Ingress filter forwarded {} and suppressed {} values",
+                                                ingressFilter.getForwarded(), ingressFilter.getSuppressed()),
+                                    LOG_LEVEL::INFO);
         unbindPublisher();
         disconnectSubscriber();
         disconnectReceiveConfig();
@@ -31,6 +31,7 @@
 #include "../Events/SimEvent.h"
 #include "../SystemConfig.h"
 #include "../SimToDuTInterface.h"
+#include "IngressChangeFilter.h"
 #include <zmq.hpp>
 
 namespace sim_interface {
@@ -102,6 +103,7 @@ namespace sim_interface {
          * writing the archive into the map with exception handling
          * start logging, if writing failed
          * for each loop: run through element from the receiveMapSimData
+         * skip values that did not change since the last forwarded value (if the ingress filter is enabled)
          * create for each key and value an event
          * Send the Simulation Event to the Interface
          */
@@ -207,6 +209,7 @@ namespace sim_interface {
         std::thread simComHandlerThread; /**< Thread for receiving simulation data. */
         bool stopThread = true; /**< boolean for starting/stopping the thread. */
         SimToDuTInterface *interface; /**< Pointer form object SimToDuTInterface for adding connectors. */
+        IngressChangeFilter ingressFilter; /**< Last value cache to suppress unchanged simulation values. */
     };
 }
 
@@ -27,8 +27,11 @@
 
 #include <boost/archive/xml_oarchive.hpp>
 #include <boost/archive/xml_iarchive.hpp>
+#include <boost/serialization/version.hpp>
 #include <fstream>
 #include "Interface_Logger/InterfaceLogger.h"
+#include "Utility/ExecutorConfig.h"
+#include "Sim_Communication/IngressFilterConfig.h"
 
 namespace sim_interface {
     /**
@@ -63,6 +66,16 @@ namespace sim_interface {
          */
         std::string socketSimAddressReciverConfig = "tcp://localhost:7779";
 
+        /**
+         * Config of the threads (names, CPU affinity, scheduling policy per role).
+         */
+        ExecutorConfig executorConfig;
+
+        /**
+         * Config of the change detection for values received from the simulation.
+         */
+        IngressFilterConfig ingressFilterConfig;
+
         /**
          * Save the config to a File.
          * Does not create a new folder if it dose not exist!
@@ -111,8 +124,16 @@ namespace sim_interface {
             ar & BOOST_SERIALIZATION_NVP(socketSimAddressSub);
             ar & BOOST_SERIALIZATION_NVP(socketSimAddressPub);
             ar & BOOST_SERIALIZATION_NVP(socketSimAddressReciverConfig);
+            if (version >= 1) {
+                ar & BOOST_SERIALIZATION_NVP(executorConfig);
+            }
+            if (version >= 2) {
+                ar & BOOST_SERIALIZATION_NVP(ingressFilterConfig);
+            }
         }
     };
 }
 
+BOOST_CLASS_VERSION(sim_interface::SystemConfig, 2)
+
 #endif //SIM_TO_DUT_INTERFACE_SYSTEMCONFIG_H
@@ -145,6 +145,22 @@ namespace boost::serialization {
     template<class Archive>
     void serialize(Archive &ar, sim_interface::dut_connector::ConnectorConfig &config, const unsigned int version) {}
 
+    /**
+    * method: serialize
+    * @param ar: address of an archive
+    * @param rateLimit: address of an OperationRateLimit of the rateLimits of a ConnectorConfig
+    * @param version: const unsigned int --> unused
+    * serialize now the attributes of the OperationRateLimit, 0 disables the minimum interval and the token bucket
+    */
+    template<class Archive>
+    void serialize(Archive &ar, sim_interface::dut_connector::OperationRateLimit &rateLimit,
+                   const unsigned int version) {
+        ar & boost::serialization::make_nvp("decimation", rateLimit.decimation);
+        ar & boost::serialization::make_nvp("minIntervalMs", rateLimit.minIntervalMs);
+        ar & boost::serialization::make_nvp("tokenRate", rateLimit.tokenRate);
+        ar & boost::serialization::make_nvp("tokenBurst", rateLimit.tokenBurst);
+    }
+
     /**
     * method: save_construct_data --> serialize ConnectorConfig
     * @param ar: address of an archive to serialize
@@ -152,7 +168,7 @@ namespace boost::serialization {
     * @param version: constant unsigned int --> unused
     *
     * serialize now the attributes of the ConnectorConfig object:
-    * @param operations, periodicOperations, periodicTimerEnabled:
+    * @param operations, periodicOperations, periodicTimerEnabled, periodicCatchUp, rateLimits:
     * find tag in the serialized xml and get the same attribute via pointer
     */
 
@@ -162,15 +178,18 @@ namespace boost::serialization {
         ar & boost::serialization::make_nvp("operations", config->operations);
         ar & boost::serialization::make_nvp("periodicOperations", config->periodicOperations);
         ar & boost::serialization::make_nvp("periodicTimerEnabled", config->periodicTimerEnabled);
+        ar & boost::serialization::make_nvp("periodicCatchUp", config->periodicCatchUp);
+        ar & boost::serialization::make_nvp("rateLimits", config->rateLimits);
     }
 
     /**
     * method: load_construct_data --> deserialize ConnectorConfig
     * @param ar: address of an archive to deserialize
     * @param instance: pointer of a ConnectorConfig object to deserialized
-    * @param file_version: constant unsigned int --> unused
+    * @param file_version: constant unsigned int --> periodicCatchUp is only part of version 1 and newer,
+    * rateLimits are only part of version 2 and newer
     *
-    * @param _operations, _periodicOperations, _periodicTimerEnabled:
+    * @param _operations, _periodicOperations, _periodicTimerEnabled, _periodicCatchUp, _rateLimits:
     * create helping attributes for deserializing
     * deserialize now the helping attributes of the ConnectorConfig object
     * overwrite the current object from class with the helping variables
@@ -187,9 +206,21 @@ namespace boost::serialization {
         ar >> boost::serialization::make_nvp("periodicOperations", _periodicOperations);
         ar >> boost::serialization::make_nvp("periodicTimerEnabled", _periodicTimerEnabled);
 
+        bool _periodicCatchUp = false;
+        if (file_version >= 1) {
+            ar >> boost::serialization::make_nvp("periodicCatchUp", _periodicCatchUp);
+        }
+
+        std::map<std::string, sim_interface::dut_connector::OperationRateLimit> _rateLimits;
+        if (file_version >= 2) {
+            ar >> boost::serialization::make_nvp("rateLimits", _rateLimits);
+        }
+
         ::new(instance)sim_interface::dut_connector::ConnectorConfig(_operations,
                                                                      _periodicOperations,
                                                                      _periodicTimerEnabled);
+        instance->periodicCatchUp = _periodicCatchUp;
+        instance->rateLimits = _rateLimits;
     }
 
     /**
@@ -215,7 +246,8 @@ namespace boost::serialization {
     * @param version: constant unsigned int --> unused
     *
     * serialize now the attributes of the RESTConnectorConfig object:
-    * @param baseUrlDuT, baseCallbackUrl, port, operations, periodicOperations, periodicTimerEnabled:
+    * @param baseUrlDuT, baseCallbackUrl, port, operations, periodicOperations, periodicTimerEnabled, periodicCatchUp,
+    * rateLimits:
     * find tag in the serialized xml and get the same attribute via pointer
     */
     template<class Archive>
@@ -229,15 +261,19 @@ namespace boost::serialization {
         ar & boost::serialization::make_nvp("operations", config->operations);
         ar & boost::serialization::make_nvp("periodicOperations", config->periodicOperations);
         ar & boost::serialization::make_nvp("periodicTimerEnabled", config->periodicTimerEnabled);
+        ar & boost::serialization::make_nvp("periodicCatchUp", config->periodicCatchUp);
+        ar & boost::serialization::make_nvp("rateLimits", config->rateLimits);
     }
 
     /**
     * method: load_construct_data --> deserialize RESTConnectorConfig
     * @param ar: address of an archive to deserialize
     * @param instance: pointer of a RESTConnectorConfig object to sdeerialize
-    * @param file_version: constant unsigned int --> unused
+    * @param file_version: constant unsigned int --> periodicCatchUp is only part of version 1 and newer,
+    * rateLimits are only part of version 2 and newer
     *
-    * @param _baseUrlDuT, _baseCallbackUrl, _port, _operations, _periodicOperations, _periodicTimerEnabled:
+    * @param _baseUrlDuT, _baseCallbackUrl, _port, _operations, _periodicOperations, _periodicTimerEnabled, _periodicCatchUp,
+    * _rateLimits:
     * create helping attributes for deserializing
     * deserialize now the helping attributes of the RESTConnectorConfig object
     * overwrite the current object from class with the helping variables
@@ -260,10 +296,22 @@ namespace boost::serialization {
         ar >> boost::serialization::make_nvp("periodicOperations", _periodicOperations);
         ar >> boost::serialization::make_nvp("periodicTimerEnabled", _periodicTimerEnabled);
 
+        bool _periodicCatchUp = false;
+        if (file_version >= 1) {
+            ar >> boost::serialization::make_nvp("periodicCatchUp", _periodicCatchUp);
+        }
+
+        std::map<std::string, sim_interface::dut_connector::OperationRateLimit> _rateLimits;
+        if (file_version >= 2) {
+            ar >> boost::serialization::make_nvp("rateLimits", _rateLimits);
+        }
+
         ::new(instance)sim_interface::dut_connector::rest_dummy::RESTConnectorConfig(_baseUrlDuT, _baseCallbackUrl,
                                                                                      _port, _operations,
                                                                                      _periodicOperations,
                                                                                      _periodicTimerEnabled);
+        instance->periodicCatchUp = _periodicCatchUp;
+        instance->rateLimits = _rateLimits;
     }
 
 
@@ -289,7 +337,7 @@ namespace boost::serialization {
     * @param version: constant unsigned int --> unused
     *
     * serialize now the attributes of the V2XConnectorConfig object:
-    * @param ifname, ethernetFrameType:
+    * @param ifname, ethernetFrameType, rateLimits:
     * find tag in the serialized xml and get the same attribute via pointer
     */
 
@@ -300,6 +348,7 @@ namespace boost::serialization {
 
         ar & boost::serialization::make_nvp("ifname", config->ifname);
         ar & boost::serialization::make_nvp("ethernetFrameType", config->ethernetFrameType);
+        ar & boost::serialization::make_nvp("rateLimits", config->rateLimits);
 
     }
 
@@ -307,9 +356,9 @@ namespace boost::serialization {
      * method: load_construct_data --> deserialize V2XConnectorConfig
      * @param ar: address of an archive to deserialize
      * @param instance: pointer of a V2XConnectorConfig object to deserialize
-     * @param file_version: constant unsigned int --> unused
+     * @param file_version: constant unsigned int --> rateLimits are only part of version 1 and newer
      *
-     * @param _ifname, _ethernetFrameType:
+     * @param _ifname, _ethernetFrameType, _rateLimits:
      * create helping attributes for serializing and creating a new xml-file for checking
      * deserialize now the helping attributes of the V2XConnectorConfig object
      * @param _helper: String for handling hex-values
@@ -349,10 +398,19 @@ namespace boost::serialization {
             ss >> _ethernetFrameType;
         }
 
+        std::map<std::string, sim_interface::dut_connector::OperationRateLimit> _rateLimits;
+        if (file_version >= 1) {
+            ar & boost::serialization::make_nvp("rateLimits", _rateLimits);
+        }
 
         ::new(instance)sim_interface::dut_connector::v2x::V2XConnectorConfig(_ifname, _ethernetFrameType);
+        instance->rateLimits = _rateLimits;
     }
 
 }
 
+BOOST_CLASS_VERSION(sim_interface::dut_connector::ConnectorConfig, 2)
+BOOST_CLASS_VERSION(sim_interface::dut_connector::rest_dummy::RESTConnectorConfig, 2)
+BOOST_CLASS_VERSION(sim_interface::dut_connector::v2x::V2XConnectorConfig, 1)
+
 #endif //SIM_TO_DUT_INTERFACE_CONFIGSERIALIZER_H
\ No newline at end of file
@@ -10,8 +10,10 @@
 #include <boost/serialization/set.hpp>
 
 #include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
 #include <boost/serialization/scoped_ptr.hpp>
 #include <boost/serialization/shared_ptr.hpp>
+#include <boost/serialization/version.hpp>
 #include <boost/algorithm//string.hpp>
 #include <fstream>
 #include <linux/can.h>
@@ -65,15 +67,43 @@ namespace boost::serialization {
         ar & boost::serialization::make_nvp("operationToFrame", operationToFramePointer);
         ar & boost::serialization::make_nvp("periodicOperations", config->periodicOperations);
         ar & boost::serialization::make_nvp("periodicTimerEnabled", config->periodicTimerEnabled);
+        ar & boost::serialization::make_nvp("backend", config->backend);
+        ar & boost::serialization::make_nvp("dbcFile", config->dbcFile);
+        ar & boost::serialization::make_nvp("codecs", config->codecs);
+        ar & boost::serialization::make_nvp("autoMasks", config->autoMasks);
+        ar & boost::serialization::make_nvp("containerTimeout", config->containerTimeout);
+        ar & boost::serialization::make_nvp("gatewayRoutes", config->gatewayRoutes);
+
+        // The receive operations of each further interface are stored like frameToOperation
+        unsigned long interfaceCount = config->interfaceFrameToOperation.size();
+        ar & boost::serialization::make_nvp("interfaceCount", interfaceCount);
+        for (auto const &[interfaceName, frameToOperation]: config->interfaceFrameToOperation) {
+            const std::map<canid_t, sim_interface::dut_connector::can::CANConnectorReceiveOperation> *interfaceFrameToOperationPointer = &frameToOperation;
+            ar & boost::serialization::make_nvp("interfaceName", interfaceName);
+            ar & boost::serialization::make_nvp("interfaceFrameToOperation", interfaceFrameToOperationPointer);
+        }
+        ar & boost::serialization::make_nvp("txMonitor", config->txMonitor);
+        ar & boost::serialization::make_nvp("busMonitor", config->busMonitor);
+        ar & boost::serialization::make_nvp("isoTpOperations", config->isoTpOperations);
+        ar & boost::serialization::make_nvp("periodicCatchUp", config->periodicCatchUp);
+        ar & boost::serialization::make_nvp("rateLimits", config->rateLimits);
     }
 
     /**
     * method: load_construct_data --> deserialize CANConnectorConfig
     * @param ar: address of an archive to deserialize
     * @param instance: pointer of a CANConnectorConfig object to deserialize
-    * @param file_version: constant unsigned int --> unused
+    * @param file_version: constant unsigned int --> the backend is only part of version 1 and newer,
+    * the dbcFile is only part of version 2 and newer, the codecs are only part of version 3 and newer,
+    * autoMasks is only part of version 4 and newer, containerTimeout is only part of version 5 and newer,
+    * gatewayRoutes are only part of version 6 and newer, interfaceFrameToOperation is only part of version 7 and newer,
+    * txMonitor is only part of version 8 and newer,
+    * busMonitor is only part of version 9 and newer,
+    * isoTpOperations is only part of version 10 and newer,
+    * periodicCatchUp is only part of version 11 and newer,
+    * rateLimits is only part of version 12 and newer
     *
-    * @param _interfaceName, _codecName, _operations, *_frameToOperationPointer, *_operationToFramePointer, _periodicOperations, _periodicTimerEnabled:
+    * @param _interfaceName, _codecName, _operations, *_frameToOperationPointer, *_operationToFramePointer, _periodicOperations, _periodicTimerEnabled, _backend, _dbcFile, _codecs, _autoMasks, _containerTimeout, _gatewayRoutes, _interfaceFrameToOperation, _txMonitor, _busMonitor, _isoTpOperations, _periodicCatchUp, _rateLimits:
     * create helping attributes for deserializing
     * deserialize now the helping attributes of the CANConnectorConfig object
     * overwrite the current object from class with the helping variables
@@ -103,12 +133,91 @@ namespace boost::serialization {
         ar & boost::serialization::make_nvp("periodicOperations", _periodicOperations);
         ar & boost::serialization::make_nvp("periodicTimerEnabled", _periodicTimerEnabled);
 
+        std::string _backend = CAN_BACKEND_BCM;
+        if (file_version >= 1) {
+            ar & boost::serialization::make_nvp("backend", _backend);
+        }
+
+        std::string _dbcFile;
+        if (file_version >= 2) {
+            ar & boost::serialization::make_nvp("dbcFile", _dbcFile);
+        }
+
+        std::map<std::string, std::string> _codecs;
+        if (file_version >= 3) {
+            ar & boost::serialization::make_nvp("codecs", _codecs);
+        }
+
+        bool _autoMasks = true;
+        if (file_version >= 4) {
+            ar & boost::serialization::make_nvp("autoMasks", _autoMasks);
+        }
+
+        int _containerTimeout = 1000;
+        if (file_version >= 5) {
+            ar & boost::serialization::make_nvp("containerTimeout", _containerTimeout);
+        }
+
+        std::vector<sim_interface::dut_connector::can::CANGatewayRoute> _gatewayRoutes;
+        if (file_version >= 6) {
+            ar & boost::serialization::make_nvp("gatewayRoutes", _gatewayRoutes);
+        }
+
+        std::map<std::string, std::map<canid_t, sim_interface::dut_connector::can::CANConnectorReceiveOperation>> _interfaceFrameToOperation;
+        if (file_version >= 7) {
+            unsigned long interfaceCount = 0;
+            ar & boost::serialization::make_nvp("interfaceCount", interfaceCount);
+            for (unsigned long index = 0; index < interfaceCount; index++) {
+                std::string interfaceName;
+                std::map<canid_t, sim_interface::dut_connector::can::CANConnectorReceiveOperation> *_interfaceFrameToOperationPointer;
+                ar & boost::serialization::make_nvp("interfaceName", interfaceName);
+                ar & boost::serialization::make_nvp("interfaceFrameToOperation", _interfaceFrameToOperationPointer);
+                _interfaceFrameToOperation.emplace(interfaceName, *_interfaceFrameToOperationPointer);
+            }
+        }
+
+        bool _txMonitor = false;
+        if (file_version >= 8) {
+            ar & boost::serialization::make_nvp("txMonitor", _txMonitor);
+        }
+
+        sim_interface::dut_connector::can::CANBusMonitorConfig _busMonitor = {};
+        if (file_version >= 9) {
+            ar & boost::serialization::make_nvp("busMonitor", _busMonitor);
+        }
+
+        std::vector<sim_interface::dut_connector::can::CANIsoTpOperation> _isoTpOperations = {};
+        if (file_version >= 10) {
+            ar & boost::serialization::make_nvp("isoTpOperations", _isoTpOperations);
+        }
+
+        bool _periodicCatchUp = false;
+        if (file_version >= 11) {
+            ar & boost::serialization::make_nvp("periodicCatchUp", _periodicCatchUp);
+        }
+
+        std::map<std::string, sim_interface::dut_connector::OperationRateLimit> _rateLimits = {};
+        if (file_version >= 12) {
+            ar & boost::serialization::make_nvp("rateLimits", _rateLimits);
+        }
 
         ::new(instance)sim_interface::dut_connector::can::CANConnectorConfig(_interfaceName, _codecName,
                                                                              _operations, *_frameToOperationPointer,
                                                                              *_operationToFramePointer,
                                                                              _periodicOperations,
                                                                              _periodicTimerEnabled);
+        instance->backend = _backend;
+        instance->dbcFile = _dbcFile;
+        instance->codecs = _codecs;
+        instance->autoMasks = _autoMasks;
+        instance->containerTimeout = _containerTimeout;
+        instance->gatewayRoutes = _gatewayRoutes;
+        instance->interfaceFrameToOperation = _interfaceFrameToOperation;
+        instance->txMonitor = _txMonitor;
+        instance->busMonitor = _busMonitor;
+        instance->isoTpOperations = _isoTpOperations;
+        instance->periodicCatchUp = _periodicCatchUp;
+        instance->rateLimits = _rateLimits;
     }
 
     /**
@@ -278,7 +387,8 @@ namespace boost::serialization {
     * @param version: constant unsigned int --> unused
     *
     * serialize now the attributes of the CANConnectorSendOperation object:
-    * @param canID, isCANFD, isCyclic, announce, countIval1, ival1, ival2:
+    * @param canID, isCANFD, isCyclic, announce, countIval1, ival1, ival2, nframes, cyclicEngine, e2e, container,
+    * interfaceName:
     * find tag in the serialized xml and get the same attribute via pointer
     */
     template<class Archive>
@@ -293,6 +403,92 @@ namespace boost::serialization {
         ar & boost::serialization::make_nvp("countIval1", instance->count);
         ar & boost::serialization::make_nvp("ival1", instance->ival1);
         ar & boost::serialization::make_nvp("ival2", instance->ival2);
+        ar & boost::serialization::make_nvp("nframes", instance->nframes);
+        ar & boost::serialization::make_nvp("cyclicEngine", instance->cyclicEngine);
+        ar & boost::serialization::make_nvp("e2e", instance->e2e);
+        ar & boost::serialization::make_nvp("container", instance->container);
+        ar & boost::serialization::make_nvp("interfaceName", instance->interfaceName);
+
+    }
+
+    /**
+    * method: serialize
+    * @param ar: address of an archive
+    * @param config: address of the E2EConfig of a send or receive operation
+    * @param version: const unsigned int --> unused
+    * serialize now the attributes of the E2EConfig, profile is empty for operations without E2E protection
+    */
+    template<class Archive>
+    void serialize(Archive &ar, sim_interface::dut_connector::can::E2EConfig &config,
+                   const unsigned int version) {
+        ar & boost::serialization::make_nvp("profile", config.profile);
+        ar & boost::serialization::make_nvp("dataID", config.dataID);
+        ar & boost::serialization::make_nvp("dataIDList", config.dataIDList);
+        ar & boost::serialization::make_nvp("dataIDMode", config.dataIDMode);
+        ar & boost::serialization::make_nvp("crcOffset", config.crcOffset);
+        ar & boost::serialization::make_nvp("counterOffset", config.counterOffset);
+        ar & boost::serialization::make_nvp("dataIDNibbleOffset", config.dataIDNibbleOffset);
+        ar & boost::serialization::make_nvp("maxDeltaCounter", config.maxDeltaCounter);
+
+    }
+
+    /**
+    * method: serialize
+    * @param ar: address of an archive
+    * @param route: address of a CANGatewayRoute of the CANConnectorConfig
+    * @param version: const unsigned int --> unused
+    * serialize now the attributes of the CANGatewayRoute, an empty sourceInterface is the interface of the connector
+    */
+    template<class Archive>
+    void serialize(Archive &ar, sim_interface::dut_connector::can::CANGatewayRoute &route,
+                   const unsigned int version) {
+        ar & boost::serialization::make_nvp("sourceInterface", route.sourceInterface);
+        ar & boost::serialization::make_nvp("destinationInterface", route.destinationInterface);
+        ar & boost::serialization::make_nvp("filterID", route.filterID);
+        ar & boost::serialization::make_nvp("filterMask", route.filterMask);
+        ar & boost::serialization::make_nvp("isCANFD", route.isCANFD);
+        ar & boost::serialization::make_nvp("rewriteID", route.rewriteID);
+        ar & boost::serialization::make_nvp("newID", route.newID);
+        ar & boost::serialization::make_nvp("hopLimit", route.hopLimit);
+
+    }
+
+    /**
+    * method: serialize
+    * @param ar: address of an archive
+    * @param config: address of the CANBusMonitorConfig of the CANConnectorConfig
+    * @param version: const unsigned int --> unused
+    * serialize now the attributes of the CANBusMonitorConfig, a window of 0 disables the bus monitor
+    */
+    template<class Archive>
+    void serialize(Archive &ar, sim_interface::dut_connector::can::CANBusMonitorConfig &config,
+                   const unsigned int version) {
+        ar & boost::serialization::make_nvp("window", config.window);
+        ar & boost::serialization::make_nvp("bitrate", config.bitrate);
+        ar & boost::serialization::make_nvp("dataBitrate", config.dataBitrate);
+        ar & boost::serialization::make_nvp("loadWarning", config.loadWarning);
+
+    }
+
+    /**
+    * method: serialize
+    * @param ar: address of an archive
+    * @param operation: address of a CANIsoTpOperation of the CANConnectorConfig
+    * @param version: const unsigned int --> unused
+    * serialize now the attributes of the CANIsoTpOperation, an empty interfaceName is the interface of the connector
+    */
+    template<class Archive>
+    void serialize(Archive &ar, sim_interface::dut_connector::can::CANIsoTpOperation &operation,
+                   const unsigned int version) {
+        ar & boost::serialization::make_nvp("operation", operation.operation);
+        ar & boost::serialization::make_nvp("interfaceName", operation.interfaceName);
+        ar & boost::serialization::make_nvp("txID", operation.txID);
+        ar & boost::serialization::make_nvp("rxID", operation.rxID);
+        ar & boost::serialization::make_nvp("stMin", operation.stMin);
+        ar & boost::serialization::make_nvp("blockSize", operation.blockSize);
+        ar & boost::serialization::make_nvp("frameTxTime", operation.frameTxTime);
+        ar & boost::serialization::make_nvp("isCANFD", operation.isCANFD);
+        ar & boost::serialization::make_nvp("padding", operation.padding);
 
     }
 
@@ -315,9 +511,12 @@ namespace boost::serialization {
     * method: load_construct_data --> deserialize CANConnectorSendOperation
     * @param ar: address of an archive to deserialize
     * @param instance: pointer of a CANConnectorSendOperation object to deserialize
-    * @param file_version: constant unsigned int --> unused
+    * @param file_version: constant unsigned int --> nframes is only part of version 1 and newer,
+    * cyclicEngine is only part of version 2 and newer, e2e is only part of version 3 and newer,
+    * container is only part of version 4 and newer, interfaceName is only part of version 5 and newer
     *
-    * @param _canID, _isCANFD, _isCyclic, _announce, _countIval1, _ival1, _ival2:
+    * @param _canID, _isCANFD, _isCyclic, _announce, _countIval1, _ival1, _ival2, _nframes, _cyclicEngine, _e2e,
+    * _container, _interfaceName:
     * create helping attributes for deserializing
     * deserialize now the helping attributes of the CANConnectorSendOperation object
     *
@@ -354,6 +553,31 @@ namespace boost::serialization {
         ar & boost::serialization::make_nvp("ival1", _ival1);
         ar & boost::serialization::make_nvp("ival2", _ival2);
 
+        __u32 _nframes = 1;
+        if (file_version >= 1) {
+            ar & boost::serialization::make_nvp("nframes", _nframes);
+        }
+
+        std::string _cyclicEngine = CAN_CYCLIC_ENGINE_BCM;
+        if (file_version >= 2) {
+            ar & boost::serialization::make_nvp("cyclicEngine", _cyclicEngine);
+        }
+
+        sim_interface::dut_connector::can::E2EConfig _e2e;
+        if (file_version >= 3) {
+            ar & boost::serialization::make_nvp("e2e", _e2e);
+        }
+
+        std::string _container;
+        if (file_version >= 4) {
+            ar & boost::serialization::make_nvp("container", _container);
+        }
+
+        std::string _interfaceName;
+        if (file_version >= 5) {
+            ar & boost::serialization::make_nvp("interfaceName", _interfaceName);
+        }
+
         //  Logic that the key can be Hex value
         if (boost::algorithm::contains(helper, "0x")) {
             std::stringstream ss;
@@ -367,8 +591,13 @@ namespace boost::serialization {
 
         ::new(instance)sim_interface::dut_connector::can::CANConnectorSendOperation(_canID, _isCANFD,
                                                                                     _isCyclic, _announce,
-                                                                                    _count, _ival1, _ival2
+                                                                                    _count, _ival1, _ival2,
+                                                                                    _nframes
         );
+        instance->cyclicEngine = _cyclicEngine;
+        instance->e2e = _e2e;
+        instance->container = _container;
+        instance->interfaceName = _interfaceName;
     }
 
     /**
@@ -393,7 +622,8 @@ namespace boost::serialization {
     * @param instance: pointer of a CANConnectorReceiveOperation object to serialize
     * @param version: constant unsigned int --> unused
     * serialize now the attributes of the CANConnectorReceiveOperation object:
-    * @param operation, isCANFD, hasMask, maskLength, mask:
+    * @param operation, isCANFD, hasMask, maskLength, mask, codec, e2e, isContainer, isContained, timeout,
+    * timeoutOperation:
     * find tag in the serialized xml and get the same attribute via pointer
     */
 
@@ -421,6 +651,12 @@ namespace boost::serialization {
 
         std::string stringHexValue = hex.str();
         ar & boost::serialization::make_nvp("mask", stringHexValue);
+        ar & boost::serialization::make_nvp("codec", config->codec);
+        ar & boost::serialization::make_nvp("e2e", config->e2e);
+        ar & boost::serialization::make_nvp("isContainer", config->isContainer);
+        ar & boost::serialization::make_nvp("isContained", config->isContained);
+        ar & boost::serialization::make_nvp("timeout", config->timeout);
+        ar & boost::serialization::make_nvp("timeoutOperation", config->timeoutOperation);
 
     }
 
@@ -428,9 +664,12 @@ namespace boost::serialization {
     * method: load_construct_data --> deserialize CANConnectorReceiveOperation
     * @param ar: address of an archive to deserialize
     * @param instance: pointer of a CANConnectorReceiveOperation object to deserialize
-    * @param file_version: constant unsigned int --> unused
+    * @param file_version: constant unsigned int --> the codec is only part of version 1 and newer,
+    * e2e is only part of version 2 and newer, isContainer and isContained are only part of version 3 and newer,
+    * timeout and timeoutOperation are only part of version 4 and newer
     *
-    * @param _operation, _isCANFD, _hasMask, _maskLength, _mask:
+    * @param _operation, _isCANFD, _hasMask, _maskLength, _mask, _codec, _e2e, _isContainer, _isContained, _timeout,
+    * _timeoutOperation:
     * create helping attributes for serializing
     * deserialize now the helping attributes of the CANConnectorReceiveOperation object
     * overwrite the current object from class with the helping variables
@@ -453,6 +692,30 @@ namespace boost::serialization {
         ar & boost::serialization::make_nvp("hasMask", _hasMask);
         ar & boost::serialization::make_nvp("mask", hexMask);
 
+        std::string _codec;
+        if (file_version >= 1) {
+            ar & boost::serialization::make_nvp("codec", _codec);
+        }
+
+        sim_interface::dut_connector::can::E2EConfig _e2e;
+        if (file_version >= 2) {
+            ar & boost::serialization::make_nvp("e2e", _e2e);
+        }
+
+        bool _isContainer = false;
+        bool _isContained = false;
+        if (file_version >= 3) {
+            ar & boost::serialization::make_nvp("isContainer", _isContainer);
+            ar & boost::serialization::make_nvp("isContained", _isContained);
+        }
+
+        int _timeout = 0;
+        std::string _timeoutOperation;
+        if (file_version >= 4) {
+            ar & boost::serialization::make_nvp("timeout", _timeout);
+            ar & boost::serialization::make_nvp("timeoutOperation", _timeoutOperation);
+        }
+
         __u8 _maskCANLength[CAN_MAX_DLEN] = {0};
         __u8 _maskCANFDLength[CANFD_MAX_DLEN] = {0};
         __u8 *_mask = _maskCANLength;
@@ -471,6 +734,12 @@ namespace boost::serialization {
         ::new(instance)sim_interface::dut_connector::can::CANConnectorReceiveOperation(_operation, _isCANFD,
                                                                                        _hasMask, _maskLength, _mask
         );
+        instance->codec = _codec;
+        instance->e2e = _e2e;
+        instance->isContainer = _isContainer;
+        instance->isContained = _isContained;
+        instance->timeout = _timeout;
+        instance->timeoutOperation = _timeoutOperation;
     }
 
     /**
@@ -642,4 +911,8 @@ namespace boost::serialization {
 
 }
 
+BOOST_CLASS_VERSION(sim_interface::dut_connector::can::CANConnectorConfig, 12)
+BOOST_CLASS_VERSION(sim_interface::dut_connector::can::CANConnectorSendOperation, 5)
+BOOST_CLASS_VERSION(sim_interface::dut_connector::can::CANConnectorReceiveOperation, 4)
+
 #endif //SIM_TO_DUT_INTERFACE_CONFIGSERIALIZERCANCONNECTOR_H
\ No newline at end of file
@@ -0,0 +1,194 @@
+/**
+ * Sim To DuT Interface
+ *
+ * Copyright (C) 2021 Lukas Wagenlehner
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface".  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#include "Executor.h"
+#include "TimingHistogram.h"
+#include "../Interface_Logger/InterfaceLogger.h"
+
+#include <algorithm>
+#include <pthread.h>
+#include <sched.h>
+#include <ctime>
+#include <cstring>
+#include <stdexcept>
+#include <boost/algorithm/string.hpp>
+
+namespace sim_interface {
+    ExecutorConfig Executor::config;
+
+    /**
+     * Parse a cpu list like "0-3,6" into a cpu set.
+     *
+     * @param cpuList the cpu list
+     * @param cpuSet the resulting cpu set
+     * @return false if the list could not be parsed
+     */
+    static bool parseCpuList(const std::string &cpuList, cpu_set_t &cpuSet) {
+        CPU_ZERO(&cpuSet);
+        std::vector<std::string> ranges;
+        boost::algorithm::split(ranges, cpuList, boost::algorithm::is_any_of(","));
+        try {
+            for (auto &range: ranges) {
+                boost::algorithm::trim(range);
+                if (range.empty()) {
+                    continue;
+                }
+                auto separator = range.find('-');
+                int first = std::stoi(range.substr(0, separator));
+                int last = separator == std::string::npos ? first : std::stoi(range.substr(separator + 1));
+                if (first < 0 || last < first || last >= CPU_SETSIZE) {
+                    return false;
+                }
+                for (int cpu = first; cpu <= last; cpu++) {
+                    CPU_SET(cpu, &cpuSet);
+                }
+            }
+        } catch (std::exception &e) {
+            return false;
+        }
+        return CPU_COUNT(&cpuSet) > 0;
+    }
+
+    void Executor::initialize(const ExecutorConfig &executorConfig) {
+
+        // The handlers of the CAN and V2X connectors share their state without strands or locks, so their
+        // io_context must only be run by a single thread. The periodic timers serialize their events in the
+        // DuTConnector and can use several threads.
+        for (THREAD_ROLE role: {CAN_ROLE, V2X_ROLE}) {
+            int threadCount = executorConfig.getRoleConfig(role).threadCount;
+            if (threadCount > 1) {
+                InterfaceLogger::logMessage(
+                        fmt::format("Executor: Role {} only supports one thread, but threadCount is {}",
+                                    getRoleName(role), threadCount), LOG_LEVEL::ERROR);
+                throw std::invalid_argument("Executor: Role " + getRoleName(role) + " only supports one thread");
+            }
+        }
+
+        config = executorConfig;
+    }
+
+    std::thread Executor::createThread(THREAD_ROLE role, const std::string &name, std::function<void()> function) {
+        return std::thread([role, name, function = std::move(function)]() {
+            applyRoleConfig(role, name);
+            function();
+        });
+    }
+
+    std::vector<std::thread>
+    Executor::createThreadGroup(THREAD_ROLE role, const std::string &name, const std::function<void()> &function) {
+        int threadCount = std::max(1, config.getRoleConfig(role).threadCount);
+
+        std::vector<std::thread> threads;
+        for (int index = 0; index < threadCount; index++) {
+            threads.push_back(createThread(role, threadCount == 1 ? name : name + std::to_string(index), function));
+        }
+        return threads;
+    }
+
+    void Executor::applyRoleConfig(THREAD_ROLE role, const std::string &name) {
+        const ThreadRoleConfig &roleConfig = config.getRoleConfig(role);
+        pthread_t self = pthread_self();
+
+        // the kernel limits thread names to 16 bytes including the terminating null byte
+        pthread_setname_np(self, name.substr(0, 15).c_str());
+
+        if (!roleConfig.cpuAffinity.empty()) {
+            cpu_set_t cpuSet;
+            if (!parseCpuList(roleConfig.cpuAffinity, cpuSet)) {
+                InterfaceLogger::logMessage(
+                        fmt::format("Executor: Invalid cpuAffinity <{}> for role {}", roleConfig.cpuAffinity,
+                                    getRoleName(role)), LOG_LEVEL::WARNING);
+            } else {
+                int error = pthread_setaffinity_np(self, sizeof(cpuSet), &cpuSet);
+                if (error != 0) {
+                    InterfaceLogger::logMessage(
+                            fmt::format("Executor: Could not pin thread {} to cpus <{}>: {}", name,
+                                        roleConfig.cpuAffinity, std::strerror(error)), LOG_LEVEL::WARNING);
+                }
+            }
+        }
+
+        if (roleConfig.schedPolicy != SCHED_POLICY_OTHER) {
+            sched_param param{};
+            param.sched_priority = roleConfig.priority;
+            int policy = roleConfig.schedPolicy == SCHED_POLICY_FIFO ? SCHED_FIFO : SCHED_RR;
+            int error = pthread_setschedparam(self, policy, &param);
+            if (error != 0) {
+                InterfaceLogger::logMessage(
+                        fmt::format("Executor: Could not set {} priority {} for thread {}: {}",
+                                    policy == SCHED_FIFO ? "SCHED_FIFO" : "SCHED_RR", roleConfig.priority, name,
+                                    std::strerror(error)), LOG_LEVEL::WARNING);
+            }
+        }
+
+        InterfaceLogger::logMessage(fmt::format("Executor: Started thread {} with role {}", name, getRoleName(role)),
+                                    LOG_LEVEL::DEBUG);
+    }
+
+    void Executor::measureSchedulingLatency() {
+        if (!config.measureSchedulingLatency || config.latencySamples <= 0 || config.latencyIntervalUs <= 0) {
+            return;
+        }
+        for (THREAD_ROLE role: {INTERFACE_ROLE, SIM_COM_ROLE, TIMER_ROLE, CAN_ROLE, V2X_ROLE, REST_ROLE}) {
+            TimingHistogram latency;
+            std::thread probe = createThread(role, "latency-probe", [&latency]() {
+                timespec deadline{};
+                clock_gettime(CLOCK_MONOTONIC, &deadline);
+                for (int sample = 0; sample < config.latencySamples; sample++) {
+                    deadline.tv_nsec += config.latencyIntervalUs * 1000L;
+                    while (deadline.tv_nsec >= 1000000000L) {
+                        deadline.tv_nsec -= 1000000000L;
+                        deadline.tv_sec++;
+                    }
+                    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr);
+                    timespec now{};
+                    clock_gettime(CLOCK_MONOTONIC, &now);
+                    latency.record(std::chrono::seconds(now.tv_sec - deadline.tv_sec) +
+                                   std::chrono::nanoseconds(now.tv_nsec - deadline.tv_nsec));
+                }
+            });
+            probe.join();
+            InterfaceLogger::logMessage(
+                    fmt::format("Executor: Scheduling latency of role {}: {}", getRoleName(role), latency.summary()),
+                    LOG_LEVEL::INFO);
+        }
+    }
+
+    std::string Executor::getRoleName(THREAD_ROLE role) {
+        switch (role) {
+            case INTERFACE_ROLE:
+                return "interface";
+            case SIM_COM_ROLE:
+                return "simcom";
+            case TIMER_ROLE:
+                return "timer";
+            case CAN_ROLE:
+                return "can";
+            case V2X_ROLE:
+                return "v2x";
+            case REST_ROLE:
+                return "rest";
+        }
+        return "unknown";
+    }
+}
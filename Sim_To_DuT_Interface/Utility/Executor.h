@@ -0,0 +1,97 @@
+/**
+ * Sim To DuT Interface
+ *
+ * Copyright (C) 2021 Lukas Wagenlehner
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface".  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_EXECUTOR_H
+#define SIM_TO_DUT_INTERFACE_EXECUTOR_H
+
+#include "ExecutorConfig.h"
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sim_interface {
+    /**
+     * <summary>
+     * Creates all threads of the interface with the name, CPU affinity and scheduling policy of their role.
+     * </summary>
+     * Like the logger the executor is static and should be initialized with the ExecutorConfig from the SystemConfig
+     * before any connector is created. Threads created before the initialization use the default settings.
+     * Failing to apply a setting (e.g. missing permission for SCHED_FIFO) is logged as a warning, the thread is
+     * started nevertheless.
+     */
+    class Executor {
+    public:
+        /**
+         * Set the configuration used for all threads created afterwards.
+         *
+         * @param config the executor configuration
+         * @throws std::invalid_argument if CAN_ROLE or V2X_ROLE has more than one thread
+         */
+        static void initialize(const ExecutorConfig &config);
+
+        /**
+         * Start a new thread with the settings of the given role.
+         *
+         * @param role role of the thread
+         * @param name name of the thread, truncated to 15 characters
+         * @param function function executed by the thread
+         * @return the started thread
+         */
+        static std::thread createThread(THREAD_ROLE role, const std::string &name, std::function<void()> function);
+
+        /**
+         * Start the configured number of threads (threadCount) of the role all running the given function,
+         * typically the run() method of an io_context.
+         *
+         * @param role role of the threads
+         * @param name name of the threads, an index is appended if more than one thread is started
+         * @param function function executed by all threads
+         * @return the started threads
+         */
+        static std::vector<std::thread>
+        createThreadGroup(THREAD_ROLE role, const std::string &name, const std::function<void()> &function);
+
+        /**
+         * Measure the scheduling latency (wake-up time - requested wake-up time) of each role with its settings
+         * and log the results. Does nothing if disabled in the configuration.
+         */
+        static void measureSchedulingLatency();
+
+        /**
+         * @param role role of a thread
+         * @return human readable name of the role
+         */
+        static std::string getRoleName(THREAD_ROLE role);
+
+    private:
+        /**
+         * Apply name, affinity and scheduling policy of the role to the calling thread.
+         */
+        static void applyRoleConfig(THREAD_ROLE role, const std::string &name);
+
+        static ExecutorConfig config;
+    };
+}
+
+#endif //SIM_TO_DUT_INTERFACE_EXECUTOR_H
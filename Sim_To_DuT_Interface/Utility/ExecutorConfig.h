@@ -0,0 +1,167 @@
+/**
+ * Sim To DuT Interface
+ *
+ * Copyright (C) 2021 Lukas Wagenlehner
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface".  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_EXECUTORCONFIG_H
+#define SIM_TO_DUT_INTERFACE_EXECUTORCONFIG_H
+
+#include <string>
+#include <stdexcept>
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/nvp.hpp>
+
+namespace sim_interface {
+
+    /**
+     * Defines the roles of the threads started by the interface.
+     * Each role can be configured separately in the ExecutorConfig.
+     */
+    enum THREAD_ROLE {
+        INTERFACE_ROLE, SIM_COM_ROLE, TIMER_ROLE, CAN_ROLE, V2X_ROLE, REST_ROLE
+    };
+
+    /**
+     * Defines the scheduling policy of a thread (SCHED_OTHER, SCHED_FIFO or SCHED_RR)
+     */
+    enum SCHED_POLICY {
+        SCHED_POLICY_OTHER, SCHED_POLICY_FIFO, SCHED_POLICY_RR
+    };
+
+    /**
+     * <summary>
+     * Scheduling configuration for all threads of one role.
+     * </summary>
+     */
+    class ThreadRoleConfig {
+    public:
+        /**
+         * Creates a role config without affinity and with the default scheduling policy.
+         */
+        ThreadRoleConfig() = default;
+
+        /**
+         * Number of threads running the io_context of the role (only used by roles based on an io_context).
+         * CAN_ROLE and V2X_ROLE only support one thread, their handlers are not thread safe. The periodic timers of
+         * TIMER_ROLE serialize their events, so they can use several threads.
+         */
+        int threadCount = 1;
+        /**
+         * CPUs the threads are pinned to in the cpu list format of taskset, e.g. "2,3" or "0-3,6".
+         * An empty string disables the pinning.
+         */
+        std::string cpuAffinity;
+        /**
+         * Scheduling policy, SCHED_FIFO and SCHED_RR need CAP_SYS_NICE (or root).
+         */
+        SCHED_POLICY schedPolicy = SCHED_POLICY_OTHER;
+        /**
+         * Real time priority (1-99), only used with SCHED_FIFO and SCHED_RR.
+         */
+        int priority = 0;
+
+    private:
+        friend class boost::serialization::access;
+
+        template<class Archive>
+        void serialize(Archive &ar, const unsigned int version) {
+            ar & BOOST_SERIALIZATION_NVP(threadCount);
+            ar & BOOST_SERIALIZATION_NVP(cpuAffinity);
+            ar & BOOST_SERIALIZATION_NVP(schedPolicy);
+            ar & BOOST_SERIALIZATION_NVP(priority);
+        }
+    };
+
+    /**
+     * <summary>
+     * Configuration of the threads of the interface, connectors and timers.
+     * </summary>
+     * Default settings leave all threads with the default scheduling of the system.
+     */
+    class ExecutorConfig {
+    public:
+        /**
+         * Creates the executor configuration with default settings.
+         */
+        ExecutorConfig() = default;
+
+        /**
+         * Returns the configuration for the given role.
+         * @param role the role of the thread
+         * @return the configuration of the role
+         */
+        const ThreadRoleConfig &getRoleConfig(THREAD_ROLE role) const {
+            switch (role) {
+                case INTERFACE_ROLE:
+                    return interfaceThreads;
+                case SIM_COM_ROLE:
+                    return simComThreads;
+                case TIMER_ROLE:
+                    return timerThreads;
+                case CAN_ROLE:
+                    return canThreads;
+                case V2X_ROLE:
+                    return v2xThreads;
+                case REST_ROLE:
+                    return restThreads;
+            }
+            throw std::invalid_argument("Unknown thread role");
+        }
+
+        /** Threads forwarding events between the queues of the interface */
+        ThreadRoleConfig interfaceThreads;
+        /** Thread receiving from the simulation */
+        ThreadRoleConfig simComThreads;
+        /** Threads running the periodic timers of the connectors */
+        ThreadRoleConfig timerThreads;
+        /** Threads running the io_context of the CAN connectors */
+        ThreadRoleConfig canThreads;
+        /** Threads running the io_service of the V2X connectors */
+        ThreadRoleConfig v2xThreads;
+        /** Threads running the receive endpoint of the REST connectors */
+        ThreadRoleConfig restThreads;
+        /** Measure and log the scheduling latency of each role on startup, delays the startup by about a second */
+        bool measureSchedulingLatency = false;
+        /** Number of sleep cycles per role for the latency measurement */
+        int latencySamples = 200;
+        /** Sleep interval of the latency measurement in microseconds */
+        int latencyIntervalUs = 1000;
+
+    private:
+        friend class boost::serialization::access;
+
+        template<class Archive>
+        void serialize(Archive &ar, const unsigned int version) {
+            ar & BOOST_SERIALIZATION_NVP(interfaceThreads);
+            ar & BOOST_SERIALIZATION_NVP(simComThreads);
+            ar & BOOST_SERIALIZATION_NVP(timerThreads);
+            ar & BOOST_SERIALIZATION_NVP(canThreads);
+            ar & BOOST_SERIALIZATION_NVP(v2xThreads);
+            ar & BOOST_SERIALIZATION_NVP(restThreads);
+            ar & BOOST_SERIALIZATION_NVP(measureSchedulingLatency);
+            ar & BOOST_SERIALIZATION_NVP(latencySamples);
+            ar & BOOST_SERIALIZATION_NVP(latencyIntervalUs);
+        }
+    };
+
+}
+
+#endif //SIM_TO_DUT_INTERFACE_EXECUTORCONFIG_H
@@ -0,0 +1,115 @@
+/**
+ * Sim To DuT Interface
+ *
+ * Copyright (C) 2021 Lukas Wagenlehner
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface".  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_LATESTVALUESLOT_H
+#define SIM_TO_DUT_INTERFACE_LATESTVALUESLOT_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+namespace sim_interface {
+    /**
+     * <summary>
+     * Wait-free slot that always holds the latest value written by one writer thread for one reader thread.
+     * </summary>
+     * The slot is a triple buffer: the writer owns the back buffer, the reader owns the front buffer and the
+     * third buffer is exchanged between them with a single atomic operation. Neither side ever blocks or retries,
+     * intermediate values the reader did not pick up are overwritten (only the newest value is of interest).
+     * Unlike a seqlock this also works for types that are not trivially copyable (e.g. SimEvent with strings).
+     */
+    template<class T>
+    class LatestValueSlot {
+    public:
+        /**
+         * Create a slot.
+         * @param initial Value the reader sees until the first store.
+         */
+        explicit LatestValueSlot(const T &initial = T()) : buffers{initial, initial, initial} {}
+
+        LatestValueSlot(const LatestValueSlot<T> &) = delete;
+
+        LatestValueSlot<T> &operator=(const LatestValueSlot<T> &) = delete;
+
+        /**
+         * Publish a new value. Must only be called by the writer thread.
+         * @param value The new value.
+         */
+        void store(T value) {
+            buffers[backIndex] = std::move(value);
+            publish();
+        }
+
+        /**
+         * Publish a new value that is written in place into the back buffer, so its memory is reused.
+         * The back buffer holds an older value that must be overwritten completely. Must only be called by the
+         * writer thread.
+         * @param write Function that takes a reference to the back buffer and writes the new value.
+         */
+        template<class Writer>
+        void storeInPlace(Writer &&write) {
+            write(buffers[backIndex]);
+            publish();
+        }
+
+        /**
+         * Get the latest published value. Must only be called by the reader thread.
+         * The reference stays valid until the next call of load().
+         * @return Reference to the latest value.
+         */
+        const T &load() {
+            if (middle.load(std::memory_order_relaxed) & DIRTY) {
+                uint8_t previous = middle.exchange(frontIndex, std::memory_order_acq_rel);
+                frontIndex = previous & INDEX_MASK;
+            }
+            return buffers[frontIndex];
+        }
+
+        /**
+         * @return TRUE if a value was stored that was not yet loaded by the reader.
+         */
+        bool hasUpdate() const {
+            return (middle.load(std::memory_order_relaxed) & DIRTY) != 0;
+        }
+
+    private:
+        void publish() {
+            uint8_t previous = middle.exchange(static_cast<uint8_t>(backIndex | DIRTY), std::memory_order_acq_rel);
+            backIndex = previous & INDEX_MASK;
+        }
+
+        static constexpr uint8_t INDEX_MASK = 0x03;
+        static constexpr uint8_t DIRTY = 0x04;
+
+        std::array<T, 3> buffers;
+        // index of the buffer in the middle and a flag if it holds a new value, shared by writer and reader
+        alignas(64) std::atomic<uint8_t> middle{1};
+        // owned by the writer
+        alignas(64) uint8_t backIndex = 0;
+        // owned by the reader
+        alignas(64) uint8_t frontIndex = 2;
+    };
+}
+
+#endif //SIM_TO_DUT_INTERFACE_LATESTVALUESLOT_H
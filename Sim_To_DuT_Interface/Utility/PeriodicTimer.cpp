@@ -30,16 +30,20 @@
 
 namespace sim_interface {
     PeriodicTimer::PeriodicTimer(const std::shared_ptr<boost::asio::io_service> &io, int periodMs,
-                                 SimEvent event, std::function<void(const SimEvent &)> callback) :
-            periodMs(periodMs), event(std::move(event)), callback(std::move(callback)),
-            timer(*io) {
-        timer.expires_from_now(boost::asio::chrono::milliseconds(periodMs));
+                                 SimEvent event, std::function<void(const SimEvent &)> callback,
+                                 OverrunPolicy overrunPolicy) :
+            periodMs(periodMs), event(event), callback(std::move(callback)),
+            overrunPolicy(overrunPolicy), timer(*io) {
     }
 
     /**
      * Start the async waiting on the constructed timer with tick() as callback
+     * The first deadline is one period after the start
      */
     void PeriodicTimer::start() {
+        hasTicked = false;
+        deadline = boost::asio::steady_timer::clock_type::now() + boost::asio::chrono::milliseconds(periodMs);
+        timer.expires_at(deadline);
         timer.async_wait([&](boost::system::error_code e) { this->tick(e); });
     }
 
@@ -50,18 +54,68 @@ namespace sim_interface {
         timer.cancel();
     }
 
+    /**
+     * Publish a new event for the following ticks, the deadline and period stay as they are
+     */
+    void PeriodicTimer::updateEvent(SimEvent newEvent) {
+        event.store(std::move(newEvent));
+    }
+
+    const TimingHistogram &PeriodicTimer::getLatenessHistogram() const {
+        return lateness;
+    }
+
+    const TimingHistogram &PeriodicTimer::getJitterHistogram() const {
+        return jitter;
+    }
+
+    uint64_t PeriodicTimer::getSkippedPeriods() const {
+        return skippedPeriods.load(std::memory_order_relaxed);
+    }
+
     /**
      * Called everytime the timer elapsed or an error is thrown
-     * Calls the callback given when this PeriodicTimer was constructed with given SimEvent
+     * Records lateness and jitter of this tick and calls the callback given when this PeriodicTimer was constructed
+     * with the latest SimEvent
      *
      * @param e boost error code (aborted timer)
      */
     void PeriodicTimer::tick(const boost::system::error_code &e) {
         if (e == boost::asio::error::operation_aborted) return;
-        InterfaceLogger::logMessage(fmt::format("PeriodicTimer: Period elapsed for {}", event.operation),
+        auto now = boost::asio::steady_timer::clock_type::now();
+        lateness.record(now - deadline);
+        if (hasTicked) {
+            auto interval = now - lastTick;
+            auto period = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    boost::asio::chrono::milliseconds(periodMs));
+            jitter.record(interval > period ? interval - period : period - interval);
+        }
+        lastTick = now;
+        hasTicked = true;
+
+        const SimEvent &currentEvent = event.load();
+        InterfaceLogger::logMessage(fmt::format("PeriodicTimer: Period elapsed for {}", currentEvent.operation),
                                     LOG_LEVEL::DEBUG);
-        callback(event);
-        timer.expires_from_now(boost::asio::chrono::milliseconds(periodMs));
+        callback(currentEvent);
+        scheduleNext();
+    }
+
+    /**
+     * Advance the deadline by one period relative to the previous deadline (not relative to now) and re-arm the timer
+     * If the new deadline already passed the overrun policy decides if the missed periods are caught up or skipped
+     */
+    void PeriodicTimer::scheduleNext() {
+        auto period = boost::asio::chrono::milliseconds(periodMs);
+        deadline += period;
+
+        auto now = boost::asio::steady_timer::clock_type::now();
+        if (overrunPolicy == OverrunPolicy::SKIP && deadline <= now) {
+            auto missed = (now - deadline) / period + 1;
+            deadline += missed * period;
+            skippedPeriods.fetch_add(missed, std::memory_order_relaxed);
+        }
+
+        timer.expires_at(deadline);
         timer.async_wait([&](boost::system::error_code e) { this->tick(e); });
     }
 }
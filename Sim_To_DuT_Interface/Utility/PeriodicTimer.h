@@ -29,29 +29,80 @@
 #include <boost/asio.hpp>
 #include <boost/asio/steady_timer.hpp>
 #include "../Events/SimEvent.h"
+#include "TimingHistogram.h"
+#include "LatestValueSlot.h"
 
 namespace sim_interface {
+    /**
+     * Defines what happens if the timer could not fire in time for one or more periods
+     * (e.g. because the callback took longer than the period)
+     */
+    enum class OverrunPolicy {
+        /** Fire once for every missed period as fast as possible until the schedule is reached again */
+        CATCH_UP,
+        /** Drop the missed periods and continue with the next deadline on the original schedule */
+        SKIP
+    };
+
     /**
      * <summary>
      * Timer to call given callback periodically with given event
      * </summary>
+     * The timer is scheduled on absolute deadlines (next deadline = previous deadline + period), so neither the
+     * runtime of the callback nor the wake-up latency accumulate over time.
+     * For every tick the lateness (actual wake-up - deadline) and the jitter (deviation of the actual interval
+     * between two ticks from the period) are recorded.
+     * The event can be replaced while the timer is running (updateEvent), the schedule is not touched by an update.
      */
     class PeriodicTimer {
     public:
         explicit PeriodicTimer(const std::shared_ptr<boost::asio::io_service> &io, int periodMs, SimEvent event,
-                               std::function<void(const SimEvent &)> callback);
+                               std::function<void(const SimEvent &)> callback,
+                               OverrunPolicy overrunPolicy = OverrunPolicy::SKIP);
 
         void start();
 
         void stop();
 
+        /**
+         * Replace the event that is passed to the callback from the next tick on without touching the schedule.
+         * Wait-free, must only be called from one thread at a time.
+         *
+         * @param newEvent the new event
+         */
+        void updateEvent(SimEvent newEvent);
+
+        /**
+         * @return histogram of the lateness of each tick relative to its deadline
+         */
+        const TimingHistogram &getLatenessHistogram() const;
+
+        /**
+         * @return histogram of the deviation of the interval between two ticks from the period
+         */
+        const TimingHistogram &getJitterHistogram() const;
+
+        /**
+         * @return number of periods dropped by the SKIP overrun policy
+         */
+        uint64_t getSkippedPeriods() const;
+
     private:
         void tick(const boost::system::error_code &e);
 
+        void scheduleNext();
+
         boost::asio::steady_timer timer;
         std::function<void(const SimEvent &)> callback;
-        SimEvent event;
+        LatestValueSlot<SimEvent> event;
         int periodMs;
+        OverrunPolicy overrunPolicy;
+        boost::asio::steady_timer::time_point deadline;
+        boost::asio::steady_timer::time_point lastTick;
+        bool hasTicked = false;
+        TimingHistogram lateness;
+        TimingHistogram jitter;
+        std::atomic<uint64_t> skippedPeriods{0};
     };
 }
 
@@ -0,0 +1,90 @@
+/**
+ * Sim To DuT Interface
+ *
+ * Copyright (C) 2021 Lukas Wagenlehner
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface".  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#include "RateLimiter.h"
+#include <algorithm>
+#include <sstream>
+
+namespace sim_interface {
+    RateLimiter::RateLimiter(const dut_connector::OperationRateLimit &limit)
+            : limit(limit), tokenBurst(limit.tokenBurst > 0 ? limit.tokenBurst : std::max(1.0, limit.tokenRate)),
+              tokens(tokenBurst) {
+        if (this->limit.decimation == 0) {
+            this->limit.decimation = 1;
+        }
+    }
+
+    bool RateLimiter::allow(std::chrono::steady_clock::time_point now) {
+        // decimation: forward the first and then every n-th event
+        if (decimationCounter++ % limit.decimation != 0) {
+            suppressedByDecimation.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // minimum interval since the last forwarded event
+        if (limit.minIntervalMs > 0 && hasForwarded &&
+            now - lastForwarded < std::chrono::milliseconds(limit.minIntervalMs)) {
+            suppressedByInterval.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // token bucket, refilled with tokenRate per second up to tokenBurst
+        if (limit.tokenRate > 0) {
+            if (hasRefilled) {
+                std::chrono::duration<double> elapsed = now - lastRefill;
+                tokens = std::min(tokenBurst, tokens + elapsed.count() * limit.tokenRate);
+            }
+            lastRefill = now;
+            hasRefilled = true;
+            if (tokens < 1.0) {
+                suppressedByTokenBucket.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            tokens -= 1.0;
+        }
+
+        lastForwarded = now;
+        hasForwarded = true;
+        forwarded.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    uint64_t RateLimiter::getForwarded() const {
+        return forwarded.load(std::memory_order_relaxed);
+    }
+
+    uint64_t RateLimiter::getSuppressed() const {
+        return suppressedByDecimation.load(std::memory_order_relaxed) +
+               suppressedByInterval.load(std::memory_order_relaxed) +
+               suppressedByTokenBucket.load(std::memory_order_relaxed);
+    }
+
+    std::string RateLimiter::summary() const {
+        std::stringstream ss;
+        ss << "forwarded=" << getForwarded()
+           << " suppressed(decimation)=" << suppressedByDecimation.load(std::memory_order_relaxed)
+           << " suppressed(interval)=" << suppressedByInterval.load(std::memory_order_relaxed)
+           << " suppressed(tokenBucket)=" << suppressedByTokenBucket.load(std::memory_order_relaxed);
+        return ss.str();
+    }
+}
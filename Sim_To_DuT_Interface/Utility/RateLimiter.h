@@ -0,0 +1,88 @@
+/**
+ * Sim To DuT Interface
+ *
+ * Copyright (C) 2021 Lukas Wagenlehner
+ *
+ * This file is part of "Sim To DuT Interface".
+ *
+ * "Sim To DuT Interface" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "Sim To DuT Interface" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "Sim To DuT Interface".  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_RATELIMITER_H
+#define SIM_TO_DUT_INTERFACE_RATELIMITER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "../DuT_Connectors/ConnectorConfig.h"
+
+namespace sim_interface {
+    /**
+     * <summary>
+     * Enforces the rate limit of a single operation (decimation, minimum interval, token bucket)
+     * </summary>
+     * allow() must be called from one thread at a time, the counters can be read from any thread.
+     */
+    class RateLimiter {
+    public:
+        /**
+         * Create a rate limiter.
+         * @param limit The limits to enforce.
+         */
+        explicit RateLimiter(const dut_connector::OperationRateLimit &limit);
+
+        /**
+         * Decide if an event arriving at the given time may be forwarded and update the counters.
+         * @param now Arrival time of the event.
+         * @return TRUE if the event should be forwarded, FALSE if it is suppressed.
+         */
+        bool allow(std::chrono::steady_clock::time_point now);
+
+        /**
+         * @return number of forwarded events
+         */
+        uint64_t getForwarded() const;
+
+        /**
+         * @return number of suppressed events (all reasons)
+         */
+        uint64_t getSuppressed() const;
+
+        /**
+         * @return one line summary of the counters for logging
+         */
+        std::string summary() const;
+
+    private:
+        dut_connector::OperationRateLimit limit;
+        double tokenBurst;
+
+        uint64_t decimationCounter = 0;
+        bool hasForwarded = false;
+        std::chrono::steady_clock::time_point lastForwarded;
+        double tokens;
+        std::chrono::steady_clock::time_point lastRefill;
+        bool hasRefilled = false;
+
+        std::atomic<uint64_t> forwarded{0};
+        std::atomic<uint64_t> suppressedByDecimation{0};
+        std::atomic<uint64_t> suppressedByInterval{0};
+        std::atomic<uint64_t> suppressedByTokenBucket{0};
+    };
+}
+
+#endif //SIM_TO_DUT_INTERFACE_RATELIMITER_H
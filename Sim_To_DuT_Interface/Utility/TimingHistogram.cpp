@@ -0,0 +1,135 @@
+/**
+ * HIL - Timing Histogram
+ * This an utility to record timing deviations (lateness, jitter, latency)
+ *
+ * Copyright (C) 2021 Michael Schmitz
+ *
+ * This file is part of "HIL - Timing Histogram".
+ *
+ * "HIL - Timing Histogram" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "HIL - Timing Histogram" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "HIL - Timing Histogram".  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#include "TimingHistogram.h"
+#include <algorithm>
+#include <sstream>
+
+namespace sim_interface {
+    void TimingHistogram::record(std::chrono::nanoseconds value) {
+        uint64_t valueNs = value.count() > 0 ? static_cast<uint64_t>(value.count()) : 0;
+
+        buckets[bucketIndex(valueNs)].fetch_add(1, std::memory_order_relaxed);
+        samples.fetch_add(1, std::memory_order_relaxed);
+        sumNs.fetch_add(valueNs, std::memory_order_relaxed);
+
+        uint64_t currentMin = minNs.load(std::memory_order_relaxed);
+        while (valueNs < currentMin && !minNs.compare_exchange_weak(currentMin, valueNs, std::memory_order_relaxed)) {}
+        uint64_t currentMax = maxNs.load(std::memory_order_relaxed);
+        while (valueNs > currentMax && !maxNs.compare_exchange_weak(currentMax, valueNs, std::memory_order_relaxed)) {}
+    }
+
+    void TimingHistogram::reset() {
+        for (auto &bucket: buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        samples.store(0, std::memory_order_relaxed);
+        sumNs.store(0, std::memory_order_relaxed);
+        minNs.store(UINT64_MAX, std::memory_order_relaxed);
+        maxNs.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t TimingHistogram::count() const {
+        return samples.load(std::memory_order_relaxed);
+    }
+
+    std::chrono::nanoseconds TimingHistogram::min() const {
+        uint64_t value = minNs.load(std::memory_order_relaxed);
+        return std::chrono::nanoseconds(value == UINT64_MAX ? 0 : value);
+    }
+
+    std::chrono::nanoseconds TimingHistogram::max() const {
+        return std::chrono::nanoseconds(maxNs.load(std::memory_order_relaxed));
+    }
+
+    std::chrono::nanoseconds TimingHistogram::mean() const {
+        uint64_t n = count();
+        return std::chrono::nanoseconds(n == 0 ? 0 : sumNs.load(std::memory_order_relaxed) / n);
+    }
+
+    std::chrono::nanoseconds TimingHistogram::percentile(double percentile) const {
+        uint64_t n = count();
+        if (n == 0) {
+            return std::chrono::nanoseconds(0);
+        }
+        auto rank = static_cast<uint64_t>(static_cast<double>(n) * percentile / 100.0);
+        uint64_t seen = 0;
+        for (std::size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+            seen += bucketCount(bucket);
+            if (seen > rank) {
+                // the overflow bucket has no upper bound, report the maximum instead
+                if (bucket == BUCKET_COUNT - 1) {
+                    return max();
+                }
+                return std::min<std::chrono::nanoseconds>(std::chrono::microseconds(bucketUpperBoundUs(bucket)),
+                                                          max());
+            }
+        }
+        return max();
+    }
+
+    uint64_t TimingHistogram::bucketCount(std::size_t bucket) const {
+        return buckets.at(bucket).load(std::memory_order_relaxed);
+    }
+
+    uint64_t TimingHistogram::bucketUpperBoundUs(std::size_t bucket) {
+        return uint64_t{1} << bucket;
+    }
+
+    std::string TimingHistogram::summary() const {
+        std::stringstream ss;
+        ss << "n=" << count()
+           << " min=" << std::chrono::duration_cast<std::chrono::microseconds>(min()).count() << "us"
+           << " mean=" << std::chrono::duration_cast<std::chrono::microseconds>(mean()).count() << "us"
+           << " p99<=" << std::chrono::duration_cast<std::chrono::microseconds>(percentile(99)).count() << "us"
+           << " max=" << std::chrono::duration_cast<std::chrono::microseconds>(max()).count() << "us";
+        return ss.str();
+    }
+
+    std::string TimingHistogram::toString() const {
+        std::stringstream ss;
+        for (std::size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+            uint64_t n = bucketCount(bucket);
+            if (n == 0) {
+                continue;
+            }
+            if (bucket == BUCKET_COUNT - 1) {
+                ss << ">=" << bucketUpperBoundUs(bucket - 1) << "us: " << n << std::endl;
+            } else {
+                ss << "<" << bucketUpperBoundUs(bucket) << "us: " << n << std::endl;
+            }
+        }
+        return ss.str();
+    }
+
+    std::size_t TimingHistogram::bucketIndex(uint64_t valueNs) {
+        uint64_t valueUs = valueNs / 1000;
+        if (valueUs == 0) {
+            return 0;
+        }
+        // index of the highest set bit + 1, i.e. 1us -> 1, 2..3us -> 2, 4..7us -> 3 ...
+        auto index = static_cast<std::size_t>(64 - __builtin_clzll(valueUs));
+        return index < BUCKET_COUNT ? index : BUCKET_COUNT - 1;
+    }
+}
@@ -0,0 +1,127 @@
+/**
+ * HIL - Timing Histogram
+ * This an utility to record timing deviations (lateness, jitter, latency)
+ *
+ * Copyright (C) 2021 Michael Schmitz
+ *
+ * This file is part of "HIL - Timing Histogram".
+ *
+ * "HIL - Timing Histogram" is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * "HIL - Timing Histogram" is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with "HIL - Timing Histogram".  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version 1.0
+ */
+
+#ifndef SIM_TO_DUT_INTERFACE_TIMINGHISTOGRAM_H
+#define SIM_TO_DUT_INTERFACE_TIMINGHISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace sim_interface {
+    /**
+     * <summary>
+     * Lock free histogram of durations with logarithmic (power of two) microsecond buckets
+     * </summary>
+     * Bucket 0 holds all values below 1us, bucket n holds values in [2^(n-1)us, 2^n us).
+     * The last bucket collects everything above the covered range.
+     * Recording is wait-free and can be done from a timer thread while another thread reads the statistics.
+     */
+    class TimingHistogram {
+    public:
+        /** Number of buckets, the last one is the overflow bucket (>= ~1s) */
+        static constexpr std::size_t BUCKET_COUNT = 22;
+
+        TimingHistogram() = default;
+
+        TimingHistogram(const TimingHistogram &) = delete;
+
+        TimingHistogram &operator=(const TimingHistogram &) = delete;
+
+        /**
+         * Record a single sample, negative durations are recorded as zero
+         *
+         * @param value duration to record
+         */
+        void record(std::chrono::nanoseconds value);
+
+        /**
+         * Reset all buckets and statistics
+         */
+        void reset();
+
+        /**
+         * @return number of recorded samples
+         */
+        uint64_t count() const;
+
+        /**
+         * @return smallest recorded sample, zero if no samples were recorded
+         */
+        std::chrono::nanoseconds min() const;
+
+        /**
+         * @return largest recorded sample
+         */
+        std::chrono::nanoseconds max() const;
+
+        /**
+         * @return arithmetic mean of all samples
+         */
+        std::chrono::nanoseconds mean() const;
+
+        /**
+         * Approximates the given percentile by the upper bound of the bucket it falls into
+         *
+         * @param percentile value between 0 and 100
+         * @return upper bound of the bucket containing the percentile (at most the maximum)
+         */
+        std::chrono::nanoseconds percentile(double percentile) const;
+
+        /**
+         * @param bucket index of the bucket
+         * @return number of samples in the bucket
+         */
+        uint64_t bucketCount(std::size_t bucket) const;
+
+        /**
+         * @param bucket index of the bucket
+         * @return exclusive upper bound of the bucket in microseconds
+         */
+        static uint64_t bucketUpperBoundUs(std::size_t bucket);
+
+        /**
+         * @return one line summary (count, min, mean, p99, max) for logging
+         */
+        std::string summary() const;
+
+        /**
+         * @return all non empty buckets, one per line, for logging
+         */
+        std::string toString() const;
+
+    private:
+        static std::size_t bucketIndex(uint64_t valueNs);
+
+        std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets{};
+        std::atomic<uint64_t> samples{0};
+        std::atomic<uint64_t> sumNs{0};
+        std::atomic<uint64_t> minNs{UINT64_MAX};
+        std::atomic<uint64_t> maxNs{0};
+    };
+}
+
+#endif //SIM_TO_DUT_INTERFACE_TIMINGHISTOGRAM_H
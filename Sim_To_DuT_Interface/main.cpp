@@ -33,6 +33,7 @@
 #include "Sim_Communication/SimComHandler.h"
 #include "Interface_Logger/InterfaceLogger.h"
 #include "SystemConfig.h"
+#include "Utility/Executor.h"
 
 // System includes
 #include <iostream>
@@ -44,6 +45,7 @@
 * get path from SystemConfig.xml and load configurations
 *
 * Create logger object and start logger
+* Initialize the executor with the thread config and measure the scheduling latency
 * Create interface object
 *
 * Create SimComHandler object and set object to interface
@@ -65,6 +67,10 @@ int main() {
     sim_interface::InterfaceLogger::initializeLogger(systemConfig.loggerConfig);
     sim_interface::InterfaceLogger::logMessage("Start Application", sim_interface::LOG_LEVEL::INFO);
 
+    // initialize the executor before any thread is created
+    sim_interface::Executor::initialize(systemConfig.executorConfig);
+    sim_interface::Executor::measureSchedulingLatency();
+
     // Create interface
     sim_interface::SimToDuTInterface interface;
 